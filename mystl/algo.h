@@ -1312,8 +1312,8 @@ is_permutation_aux(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
     constexpr bool is_ra_it = mystl::is_random_iterator<ForwardIter1>::value &&
                               mystl::is_random_iterator<ForwardIter2>::value;
     if (is_ra_it) {
-        auto len1 = last1 - first1;
-        auto len2 = last2 - first2;
+        auto len1 = mystl::distance(first1, last1);
+        auto len2 = mystl::distance(first2, last2);
         if (len1 != len2) {
             return false;
         }
@@ -1568,7 +1568,7 @@ merge_backward(BidirectionalIter1 first1, BidirectionalIter1 last1, Bidirectiona
     --last2;
     while (true) {
         if (*last2 < *last1) {
-            *--result = last1;
+            *--result = *last1;
             if (first1 == last1) {
                 return mystl::copy_backward(first2, ++last2, result);
             }
@@ -1649,7 +1649,7 @@ inplace_merge_aux(BidirectionalIter first, BidirectionalIter middle, Bidirection
     if (!buf.begin()) {
         mystl::merge_without_buffer(first, middle, last, len1, len2);
     } else {
-        mystl::merge_adaptive(first, middle, last, len1, len2, buf.begin(), buf.size);
+        mystl::merge_adaptive(first, middle, last, len1, len2, buf.begin(), buf.size());
     }
 }
 
@@ -1712,7 +1712,7 @@ merge_backward(BidirectionalIter1 first1, BidirectionalIter1 last1, Bidirectiona
     --last2;
     while (true) {
         if (comp(*last2, *last1)) {
-            *--result = last1;
+            *--result = *last1;
             if (first1 == last1) {
                 return mystl::copy_backward(first2, ++last2, result);
             }
@@ -1773,7 +1773,7 @@ inplace_merge_aux(BidirectionalIter first, BidirectionalIter middle, Bidirection
     if (!buf.begin()) {
         mystl::merge_without_buffer(first, middle, last, len1, len2, comp);
     } else {
-        mystl::merge_adaptive(first, middle, last, len1, len2, buf.begin(), buf.size, comp);
+        mystl::merge_adaptive(first, middle, last, len1, len2, buf.begin(), buf.size(), comp);
     }
 }
 
@@ -1796,7 +1796,10 @@ partial_sort(RandomIter first, RandomIter middle, RandomIter last)
     mystl::make_heap(first, middle);
     for (auto i = middle; i < last; ++i) {
         if (*i < *first) {
-            mystl::pop_heap_aux(first, middle, i, *i, distance_type(first));
+            typename iterator_traits<RandomIter>::value_type value =
+                mystl::move(*i);
+            mystl::pop_heap_aux(first, middle, i, mystl::move(value),
+                                distance_type(first));
         }
     }
     mystl::sort_heap(first, middle);
@@ -1809,7 +1812,10 @@ partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp
     mystl::make_heap(first, middle, comp);
     for (auto i = middle; i < last; ++i) {
         if (comp(*i, *first)) {
-            mystl::pop_heap_aux(first, middle, i, *i, distance_type(first), comp);
+            typename iterator_traits<RandomIter>::value_type value =
+                mystl::move(*i);
+            mystl::pop_heap_aux(first, middle, i, mystl::move(value),
+                                distance_type(first), comp);
         }
     }
     mystl::sort_heap(first, middle, comp);
@@ -1969,7 +1975,7 @@ intro_sort(RandomIter first, RandomIter last, Size depth_limit)
             return;
         }
         --depth_limit;
-        auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
+        typename iterator_traits<RandomIter>::value_type mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
         auto cut = mystl::unchecked_partition(first, last, mid);
         mystl::intro_sort(cut, last, depth_limit);
         last = cut;
@@ -1995,7 +2001,8 @@ void
 unchecked_insertion_sort(RandomIter first, RandomIter last)
 {
     for (auto i = first; i != last; ++i) {
-        mystl::unchecked_linear_insert(i, *i);
+        typename iterator_traits<RandomIter>::value_type value = *i;
+        mystl::unchecked_linear_insert(i, value);
     }
 }
 
@@ -2007,7 +2014,7 @@ insertion_sort(RandomIter first, RandomIter last)
         return;
     }
     for (auto i = first + 1; i != last; ++i) {
-        auto value = *i;
+        typename iterator_traits<RandomIter>::value_type value = *i;
         if (value < *first) {
             mystl::copy_backward(first, i, i + 1);
             *first = value;
@@ -2066,7 +2073,7 @@ intro_sort(RandomIter first, RandomIter last, Size depth_limit, Compared comp)
             return;
         }
         --depth_limit;
-        auto mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1));
+        typename iterator_traits<RandomIter>::value_type mid = mystl::median(*(first), *(first + (last - first) / 2), *(last - 1), comp);
         auto cut = mystl::unchecked_partition(first, last, mid, comp);
         mystl::intro_sort(cut, last, depth_limit, comp);
         last = cut;
@@ -2092,7 +2099,8 @@ void
 unchecked_insertion_sort(RandomIter first, RandomIter last, Compared comp)
 {
     for (auto i = first; i != last; ++i) {
-        mystl::unchecked_linear_insert(i, *i, comp);
+        typename iterator_traits<RandomIter>::value_type value = *i;
+        mystl::unchecked_linear_insert(i, value, comp);
     }
 }
 
@@ -2103,7 +2111,7 @@ insertion_sort(RandomIter first, RandomIter last, Compared comp)
     if (first == last)
         return;
     for (auto i = first + 1; i != last; ++i) {
-        auto value = *i;
+        typename iterator_traits<RandomIter>::value_type value = *i;
         if (comp(value, *first)) {
             mystl::copy_backward(first, i, i + 1);
             *first = value;
@@ -2144,8 +2152,8 @@ nth_element(RandomIter first, RandomIter nth, RandomIter last)
         return;
     }
     while (last - first > 3) {
-        auto cut = mystl::unchecked_partition(
-            first, last, mystl::median(*first, *(first + (last - first) / 2), *(last - 1)));
+        typename iterator_traits<RandomIter>::value_type mid = mystl::median(*first, *(first + (last - first) / 2), *(last - 1));
+        auto cut = mystl::unchecked_partition(first, last, mid);
         if (cut <= nth) {
             first = cut;
         } else {
@@ -2163,8 +2171,8 @@ nth_element(RandomIter first, RandomIter nth, RandomIter last, Compared comp)
         return;
     }
     while (last - first > 3) {
-        auto cut = mystl::unchecked_partition(
-            first, last, mystl::median(*first, *(first + (last - first) / 2), *(last - 1)), comp);
+        typename iterator_traits<RandomIter>::value_type mid = mystl::median(*first, *(first + (last - first) / 2), *(last - 1), comp);
+        auto cut = mystl::unchecked_partition(first, last, mid, comp);
         if (cut <= nth) {
             first = cut;
         } else {
@@ -65,7 +65,9 @@ const T& min(const T& lhs, const T& rhs, Compare comp) {
 
 template <class FIter1, class FIter2>
 void iter_swap(FIter1 lhs, FIter2 rhs) {
-    mystl::swap(*lhs, *rhs);
+    // unqualified so that proxy references (vector<bool>) find their swap
+    using mystl::swap;
+    swap(*lhs, *rhs);
 }
 
 // copy
@@ -301,7 +303,7 @@ BidirectionalIter2 move_backward(BidirectionalIter1 first,
 // equal
 // compare seq1 in range [first, last) equal to seq2 or not.
 template <class InputIter1, class InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter1 first2) {
+bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
     for (; first1 != last1; ++first1, ++first2) {
         if (*first1 != *first2) {
             return false;
@@ -361,7 +363,7 @@ void fill_cat(ForwardIter first, ForwardIter last, const T& value,
 template <class RandomIter, class T>
 void fill_cat(RandomIter first, RandomIter last, const T& value,
               mystl::random_access_iterator_tag) {
-    fill_n(first, last - first, value);
+    mystl::fill_n(first, last - first, value);
 }
 
 template <class ForwardIter, class T>
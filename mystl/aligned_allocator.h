@@ -0,0 +1,158 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_ALIGNED_ALLOCATOR_H_
+#define MYSTL_ALIGNED_ALLOCATOR_H_
+
+// allocator whose blocks start at an Align boundary (a cache line by
+// default), or at alignof(T) if that is stricter. vector data starts on its
+// own cache line, so SIMD kernels can use aligned loads from begin(), and
+// every deque block does too, so padded per-worker slots never share a line
+// with a neighbouring block.
+
+#include <cstddef>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace mystl {
+
+// template class: aligned_allocator
+template <class T, size_t Align = cache_line_size>
+class aligned_allocator {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0,
+                  "aligned_allocator: Align must be a power of two");
+
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef aligned_allocator<U, Align> other;
+    };
+
+    static constexpr size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+   public:
+    aligned_allocator() noexcept {}
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+   public:
+    static T* allocate();
+    static T* allocate(size_type n);
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+    template <class... Args>
+    static void construct(T* ptr, Args&&... args);
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+};
+
+template <class T, size_t Align>
+constexpr size_t aligned_allocator<T, Align>::alignment;
+
+template <class T, size_t Align>
+T* aligned_allocator<T, Align>::allocate() {
+    return allocate(1);
+}
+
+template <class T, size_t Align>
+T* aligned_allocator<T, Align>::allocate(size_type n) {
+    if (n == 0) {
+        return nullptr;
+    }
+    if (n > static_cast<size_type>(-1) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(mystl::aligned_allocate(n * sizeof(T), alignment));
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::deallocate(T* ptr) {
+    mystl::aligned_deallocate(ptr, alignment);
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::deallocate(T* ptr, size_type) {
+    mystl::aligned_deallocate(ptr, alignment);
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::construct(T* ptr) {
+    mystl::construct(ptr);
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::construct(T* ptr, const T& value) {
+    mystl::construct(ptr, value);
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::construct(T* ptr, T&& value) {
+    mystl::construct(ptr, mystl::move(value));
+}
+
+template <class T, size_t Align>
+template <class... Args>
+void aligned_allocator<T, Align>::construct(T* ptr, Args&&... args) {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::destroy(T* ptr) {
+    mystl::destroy(ptr);
+}
+
+template <class T, size_t Align>
+void aligned_allocator<T, Align>::destroy(T* first, T* last) {
+    mystl::destroy(first, last);
+}
+
+template <class T, class U, size_t Align>
+bool operator==(const aligned_allocator<T, Align>&,
+                const aligned_allocator<U, Align>&) noexcept {
+    return true;
+}
+
+template <class T, class U, size_t Align>
+bool operator!=(const aligned_allocator<T, Align>&,
+                const aligned_allocator<U, Align>&) noexcept {
+    return false;
+}
+
+}  // namespace mystl
+#endif
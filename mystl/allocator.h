@@ -26,11 +26,128 @@
 #ifndef MYSTL_ALLOCATOR_H_
 #define MYSTL_ALLOCATOR_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 #include "construct.h"
 #include "util.h"
 
 namespace mystl {
 
+// alignment ::operator new guarantees without being asked
+#ifdef __STDCPP_DEFAULT_NEW_ALIGNMENT__
+constexpr size_t new_align = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+constexpr size_t new_align = alignof(std::max_align_t);
+#endif
+
+constexpr size_t cache_line_size = 64;
+
+// bytes aligned to align, a power of two. Up to new_align this is plain
+// ::operator new (malloc on glibc, so that heap_allocate_at_least can ask
+// malloc_usable_size about the block), stricter alignments use the aligned
+// ::operator new (C++17), posix_memalign, or over-allocate and keep the
+// original pointer in front of the block. Free with aligned_deallocate and
+// the same align.
+inline void* aligned_allocate(size_t bytes, size_t align) {
+    if (align <= new_align) {
+#if defined(__GLIBC__)
+        void* p = std::malloc(bytes == 0 ? 1 : bytes);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+#else
+        return ::operator new(bytes);
+#endif
+    }
+#if defined(__cpp_aligned_new)
+    return ::operator new(bytes, std::align_val_t(align));
+#elif defined(__unix__) || defined(__APPLE__)
+    void* p = nullptr;
+    if (::posix_memalign(&p, align, bytes == 0 ? 1 : bytes) != 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+#else
+    if (bytes > static_cast<size_t>(-1) - align - sizeof(void*)) {
+        throw std::bad_alloc();
+    }
+    char* raw =
+        static_cast<char*>(::operator new(bytes + align + sizeof(void*)));
+    uintptr_t addr = reinterpret_cast<uintptr_t>(raw + sizeof(void*));
+    char* p = reinterpret_cast<char*>((addr + align - 1) & ~(align - 1));
+    reinterpret_cast<void**>(p)[-1] = raw;
+    return p;
+#endif
+}
+
+inline void aligned_deallocate(void* p, size_t align) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+    if (align <= new_align) {
+#if defined(__GLIBC__)
+        std::free(p);
+#else
+        ::operator delete(p);
+#endif
+        return;
+    }
+#if defined(__cpp_aligned_new)
+    ::operator delete(p, std::align_val_t(align));
+#elif defined(__unix__) || defined(__APPLE__)
+    ::free(p);
+#else
+    ::operator delete(static_cast<void**>(p)[-1]);
+#endif
+}
+
+// n objects of T from the heap, aligned for T even when alignof(T) is more
+// than ::operator new gives
+template <class T>
+T* heap_allocate(size_t n) {
+    if (n > static_cast<size_t>(-1) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(mystl::aligned_allocate(n * sizeof(T), alignof(T)));
+}
+
+template <class T>
+void heap_deallocate(T* ptr) noexcept {
+    mystl::aligned_deallocate(ptr, alignof(T));
+}
+
+// what allocate_at_least hands back: the block and the number of objects it
+// really has room for, which may be more than asked for
+template <class Pointer, class SizeType = size_t>
+struct allocation_result {
+    Pointer ptr;
+    SizeType count;
+};
+
+// allocate at least n objects of T from the heap. On glibc the count is
+// what malloc_usable_size reports for the block: the chunk rounding of small
+// blocks and the page rounding of mmap'd large ones. Elsewhere, and for
+// over-aligned blocks, it is exactly n.
+template <class T>
+allocation_result<T*> heap_allocate_at_least(size_t n) {
+    T* p = mystl::heap_allocate<T>(n);
+#if defined(__GLIBC__)
+    if (alignof(T) <= new_align) {
+        const size_t count = ::malloc_usable_size(p) / sizeof(T);
+        return {p, count < n ? n : count};
+    }
+#endif
+    return {p, n};
+}
+
 template <class T>
 class allocator {
    public:
@@ -42,9 +159,21 @@ class allocator {
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
 
+    template <class U>
+    struct rebind {
+        typedef allocator<U> other;
+    };
+
+   public:
+    allocator() noexcept {}
+    template <class U>
+    allocator(const allocator<U>&) noexcept {}
+
    public:
     static T* allocate();
     static T* allocate(size_type n);
+    // mystl extension, C++23 allocate_at_least
+    static allocation_result<T*> allocate_at_least(size_type n);
     static void deallocate(T* ptr);
     static void deallocate(T* ptr, size_type n);
     static void construct(T* ptr);
@@ -58,7 +187,7 @@ class allocator {
 
 template <class T>
 T* allocator<T>::allocate() {
-    return static_cast<T*>(::operator new(sizeof(T)));
+    return mystl::heap_allocate<T>(1);
 }
 
 template <class T>
@@ -66,7 +195,15 @@ T* allocator<T>::allocate(size_type n) {
     if (n == 0) {
         return nullptr;
     }
-    return static_cast<T*>(::operator new(n * sizeof(T)));
+    return mystl::heap_allocate<T>(n);
+}
+
+template <class T>
+allocation_result<T*> allocator<T>::allocate_at_least(size_type n) {
+    if (n == 0) {
+        return {nullptr, 0};
+    }
+    return mystl::heap_allocate_at_least<T>(n);
 }
 
 template <class T>
@@ -74,7 +211,7 @@ void allocator<T>::deallocate(T* ptr) {
     if (ptr == nullptr) {
         return;
     }
-    ::operator delete(ptr);
+    mystl::heap_deallocate(ptr);
 }
 
 template <class T>
@@ -82,7 +219,7 @@ void allocator<T>::deallocate(T* ptr, size_type) {
     if (ptr == nullptr) {
         return;
     }
-    ::operator delete(ptr);
+    mystl::heap_deallocate(ptr);
 }
 
 template <class T>
@@ -116,5 +253,15 @@ void allocator<T>::destroy(T* first, T* last) {
     mystl::destroy(first, last);
 }
 
+template <class T, class U>
+bool operator==(const allocator<T>&, const allocator<U>&) noexcept {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const allocator<T>&, const allocator<U>&) noexcept {
+    return false;
+}
+
 }  // namespace mystl
 #endif
@@ -0,0 +1,362 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_ALLOCATOR_TRAITS_H_
+#define MYSTL_ALLOCATOR_TRAITS_H_
+
+// allocator_traits gives containers one way to talk to any allocator: the
+// static-only ones in allocator.h as well as stateful instances (arenas,
+// pools) stored inside the container.
+// alloc_storage keeps such an instance, taking no room when it is empty.
+
+#include <cstddef>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace mystl {
+
+namespace alloc_detail {
+
+template <class...>
+struct make_void {
+    typedef void type;
+};
+
+// nested typedefs, falling back to a default when the allocator has none
+#define MYSTL_ALLOC_NESTED_TYPE(NAME, DEFAULT)                          \
+    template <class A, class = void>                                    \
+    struct NAME##_of {                                                  \
+        typedef DEFAULT type;                                           \
+    };                                                                  \
+    template <class A>                                                  \
+    struct NAME##_of<A, typename make_void<typename A::NAME>::type> {   \
+        typedef typename A::NAME type;                                  \
+    };
+
+MYSTL_ALLOC_NESTED_TYPE(propagate_on_container_copy_assignment, std::false_type)
+MYSTL_ALLOC_NESTED_TYPE(propagate_on_container_move_assignment, std::false_type)
+MYSTL_ALLOC_NESTED_TYPE(propagate_on_container_swap, std::false_type)
+MYSTL_ALLOC_NESTED_TYPE(is_always_equal, typename std::is_empty<A>::type)
+MYSTL_ALLOC_NESTED_TYPE(size_type, size_t)
+MYSTL_ALLOC_NESTED_TYPE(difference_type, ptrdiff_t)
+
+#undef MYSTL_ALLOC_NESTED_TYPE
+
+// rebind: A::rebind<U>::other, or replace the first template argument
+template <class A, class U>
+struct rebind_first_arg;
+
+template <template <class, class...> class A, class T, class... Args, class U>
+struct rebind_first_arg<A<T, Args...>, U> {
+    typedef A<U, Args...> type;
+};
+
+template <class A, class U, class = void>
+struct rebind_of : rebind_first_arg<A, U> {};
+
+template <class A, class U>
+struct rebind_of<A, U, typename make_void<typename A::template rebind<U>::other>::type> {
+    typedef typename A::template rebind<U>::other type;
+};
+
+template <class A, class T, class... Args>
+struct has_construct {
+    template <class B>
+    static auto test(int) -> decltype(std::declval<B&>().construct(std::declval<T*>(),
+                                                                   std::declval<Args>()...),
+                                      std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+template <class A, class T>
+struct has_destroy {
+    template <class B>
+    static auto test(int) -> decltype(std::declval<B&>().destroy(std::declval<T*>()),
+                                      std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+template <class A>
+struct has_reallocate {
+    template <class B>
+    static auto test(int) -> decltype(std::declval<B&>().reallocate(
+                                          std::declval<typename B::value_type*>(),
+                                          size_t(), size_t()),
+                                      std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+template <class A>
+struct has_release {
+    template <class B>
+    static auto test(int) -> decltype(std::declval<B&>().release(), std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+template <class A>
+struct has_allocate_at_least {
+    template <class B>
+    static auto test(int)
+        -> decltype(std::declval<B&>().allocate_at_least(size_t()), std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+template <class A>
+struct has_max_size {
+    template <class B>
+    static auto test(int) -> decltype(std::declval<const B&>().max_size(), std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+template <class A>
+struct has_select_on_copy {
+    template <class B>
+    static auto test(int)
+        -> decltype(std::declval<const B&>().select_on_container_copy_construction(),
+                    std::true_type());
+    template <class B>
+    static std::false_type test(...);
+    typedef decltype(test<A>(0)) type;
+};
+
+}  // namespace alloc_detail
+
+// template class: allocator_traits
+template <class Alloc>
+struct allocator_traits {
+    typedef Alloc allocator_type;
+    typedef typename Alloc::value_type value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef typename alloc_detail::size_type_of<Alloc>::type size_type;
+    typedef typename alloc_detail::difference_type_of<Alloc>::type difference_type;
+
+    typedef typename alloc_detail::propagate_on_container_copy_assignment_of<Alloc>::type
+        propagate_on_container_copy_assignment;
+    typedef typename alloc_detail::propagate_on_container_move_assignment_of<Alloc>::type
+        propagate_on_container_move_assignment;
+    typedef typename alloc_detail::propagate_on_container_swap_of<Alloc>::type
+        propagate_on_container_swap;
+    typedef typename alloc_detail::is_always_equal_of<Alloc>::type is_always_equal;
+
+    // mystl extension: whether the allocator can resize a block itself
+    typedef typename alloc_detail::has_reallocate<Alloc>::type can_reallocate;
+
+    template <class U>
+    using rebind_alloc = typename alloc_detail::rebind_of<Alloc, U>::type;
+    template <class U>
+    using rebind_traits = allocator_traits<rebind_alloc<U>>;
+
+    static pointer allocate(Alloc& a, size_type n) { return a.allocate(n); }
+
+    // mystl extension (C++23): the block and how many objects it really holds,
+    // exactly n if the allocator can't tell; deallocate with that count
+    static allocation_result<pointer, size_type> allocate_at_least(Alloc& a, size_type n) {
+        return allocate_at_least_aux(
+            typename alloc_detail::has_allocate_at_least<Alloc>::type(), a, n);
+    }
+
+    static void deallocate(Alloc& a, pointer p, size_type n) { a.deallocate(p, n); }
+
+    // mystl extension: resize the block p of old_n objects to new_n objects,
+    // keeping its bytes (the objects are relocated bitwise); nullptr if the
+    // allocator can't, p is then left untouched
+    static pointer reallocate(Alloc& a, pointer p, size_type old_n, size_type new_n) {
+        return reallocate_aux(can_reallocate(), a, p, old_n, new_n);
+    }
+
+    // mystl extension: let a pooling allocator give its memory back in bulk
+    // (pool_allocator), called when a container goes away; nothing for the
+    // others
+    static void release(Alloc& a) {
+        release_aux(typename alloc_detail::has_release<Alloc>::type(), a);
+    }
+
+    template <class T, class... Args>
+    static void construct(Alloc& a, T* p, Args&&... args) {
+        construct_aux(typename alloc_detail::has_construct<Alloc, T, Args...>::type(), a, p,
+                      mystl::forward<Args>(args)...);
+    }
+
+    template <class T>
+    static void destroy(Alloc& a, T* p) {
+        destroy_aux(typename alloc_detail::has_destroy<Alloc, T>::type(), a, p);
+    }
+
+    static size_type max_size(const Alloc& a) noexcept {
+        return max_size_aux(typename alloc_detail::has_max_size<Alloc>::type(), a);
+    }
+
+    static Alloc select_on_container_copy_construction(const Alloc& a) {
+        return select_aux(typename alloc_detail::has_select_on_copy<Alloc>::type(), a);
+    }
+
+   private:
+    template <class T, class... Args>
+    static void construct_aux(std::true_type, Alloc& a, T* p, Args&&... args) {
+        a.construct(p, mystl::forward<Args>(args)...);
+    }
+    template <class T, class... Args>
+    static void construct_aux(std::false_type, Alloc&, T* p, Args&&... args) {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+
+    template <class T>
+    static void destroy_aux(std::true_type, Alloc& a, T* p) {
+        a.destroy(p);
+    }
+    template <class T>
+    static void destroy_aux(std::false_type, Alloc&, T* p) {
+        mystl::destroy(p);
+    }
+
+    static allocation_result<pointer, size_type> allocate_at_least_aux(std::true_type,
+                                                                       Alloc& a,
+                                                                       size_type n) {
+        auto r = a.allocate_at_least(n);
+        return {r.ptr, static_cast<size_type>(r.count)};
+    }
+    static allocation_result<pointer, size_type> allocate_at_least_aux(std::false_type,
+                                                                       Alloc& a,
+                                                                       size_type n) {
+        return {a.allocate(n), n};
+    }
+
+    static void release_aux(std::true_type, Alloc& a) { a.release(); }
+    static void release_aux(std::false_type, Alloc&) {}
+
+    static pointer reallocate_aux(std::true_type, Alloc& a, pointer p, size_type old_n,
+                                  size_type new_n) {
+        return a.reallocate(p, old_n, new_n);
+    }
+    static pointer reallocate_aux(std::false_type, Alloc&, pointer, size_type, size_type) {
+        return nullptr;
+    }
+
+    static size_type max_size_aux(std::true_type, const Alloc& a) { return a.max_size(); }
+    static size_type max_size_aux(std::false_type, const Alloc&) {
+        return static_cast<size_type>(-1) / sizeof(value_type);
+    }
+
+    static Alloc select_aux(std::true_type, const Alloc& a) {
+        return a.select_on_container_copy_construction();
+    }
+    static Alloc select_aux(std::false_type, const Alloc& a) { return a; }
+};
+
+// allocator propagation on container copy assignment / move assignment / swap
+
+template <class Alloc>
+void alloc_on_copy(Alloc& lhs, const Alloc& rhs, std::true_type) {
+    lhs = rhs;
+}
+template <class Alloc>
+void alloc_on_copy(Alloc&, const Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_on_copy(Alloc& lhs, const Alloc& rhs) {
+    mystl::alloc_on_copy(
+        lhs, rhs,
+        typename allocator_traits<Alloc>::propagate_on_container_copy_assignment());
+}
+
+template <class Alloc>
+void alloc_on_move(Alloc& lhs, Alloc& rhs, std::true_type) {
+    lhs = mystl::move(rhs);
+}
+template <class Alloc>
+void alloc_on_move(Alloc&, Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_on_move(Alloc& lhs, Alloc& rhs) {
+    mystl::alloc_on_move(
+        lhs, rhs,
+        typename allocator_traits<Alloc>::propagate_on_container_move_assignment());
+}
+
+template <class Alloc>
+void alloc_on_swap(Alloc& lhs, Alloc& rhs, std::true_type) {
+    mystl::swap(lhs, rhs);
+}
+template <class Alloc>
+void alloc_on_swap(Alloc&, Alloc&, std::false_type) {}
+
+template <class Alloc>
+void alloc_on_swap(Alloc& lhs, Alloc& rhs) {
+    mystl::alloc_on_swap(lhs, rhs,
+                         typename allocator_traits<Alloc>::propagate_on_container_swap());
+}
+
+// whether two instances can free each other's memory
+template <class Alloc>
+bool alloc_equal(const Alloc& lhs, const Alloc& rhs) {
+    return allocator_traits<Alloc>::is_always_equal::value || lhs == rhs;
+}
+
+// template class: alloc_storage
+// containers derive from it privately to keep their allocator instance; an
+// empty allocator becomes an empty base and adds nothing to the container
+template <class Alloc, bool = std::is_empty<Alloc>::value && !__is_final(Alloc)>
+class alloc_storage : private Alloc {
+   public:
+    alloc_storage() : Alloc() {}
+    explicit alloc_storage(const Alloc& a) : Alloc(a) {}
+    explicit alloc_storage(Alloc&& a) : Alloc(mystl::move(a)) {}
+
+    Alloc& get_alloc() noexcept { return *this; }
+    const Alloc& get_alloc() const noexcept { return *this; }
+};
+
+template <class Alloc>
+class alloc_storage<Alloc, false> {
+   public:
+    alloc_storage() : alloc_() {}
+    explicit alloc_storage(const Alloc& a) : alloc_(a) {}
+    explicit alloc_storage(Alloc&& a) : alloc_(mystl::move(a)) {}
+
+    Alloc& get_alloc() noexcept { return alloc_; }
+    const Alloc& get_alloc() const noexcept { return alloc_; }
+
+   private:
+    Alloc alloc_;
+};
+
+}  // namespace mystl
+#endif
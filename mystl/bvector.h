@@ -0,0 +1,895 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_BVECTOR_H_
+#define MYSTL_BVECTOR_H_
+
+// vector<bool>: one bit per element, packed into 64 bit words. Elements are
+// reached through the bit_reference proxy and bit_iterator. count, find,
+// fill, copy and copy_backward have overloads for bit_iterator that work a
+// word at a time with popcount / count-trailing-zeros instead of a bit at a
+// time, and vector<bool> has word wise &=, |=, ^= and flip(). Bits of the
+// last word past size() are unspecified. Included by vector.h.
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "vector.h"
+
+namespace mystl {
+
+typedef uint64_t bit_word;
+constexpr size_t bit_word_bits = 64;
+
+namespace bit_detail {
+
+inline size_t popcount(bit_word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(w));
+#else
+    size_t n = 0;
+    for (; w != 0; w &= w - 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// index of the lowest set bit, w != 0
+inline unsigned ctz(bit_word w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(w));
+#else
+    unsigned n = 0;
+    for (; (w & 1) == 0; w >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// the n lowest bits, 0 < n <= 64
+inline bit_word low_mask(size_t n) noexcept {
+    return n >= bit_word_bits ? ~bit_word(0) : (bit_word(1) << n) - 1;
+}
+
+// bits [off, off + n) of a word, off + n <= 64
+inline bit_word range_mask(unsigned off, size_t n) noexcept {
+    return low_mask(n) << off;
+}
+
+inline size_t words_for(size_t bits) noexcept {
+    return (bits + bit_word_bits - 1) / bit_word_bits;
+}
+
+// copy n bits, neither range crossing a word boundary
+inline void copy_bits(const bit_word* src, unsigned src_off, bit_word* dst,
+                      unsigned dst_off, size_t n) noexcept {
+    const bit_word mask = low_mask(n);
+    const bit_word bits = (*src >> src_off) & mask;
+    *dst = (*dst & ~(mask << dst_off)) | (bits << dst_off);
+}
+
+}  // namespace bit_detail
+
+// proxy for one bit
+class bit_reference {
+   public:
+    bit_reference(bit_word* p, bit_word mask) noexcept : p_(p), mask_(mask) {}
+
+    operator bool() const noexcept { return (*p_ & mask_) != 0; }
+    bool operator~() const noexcept { return (*p_ & mask_) == 0; }
+
+    bit_reference& operator=(bool x) noexcept {
+        if (x) {
+            *p_ |= mask_;
+        } else {
+            *p_ &= ~mask_;
+        }
+        return *this;
+    }
+    bit_reference& operator=(const bit_reference& x) noexcept {
+        return *this = static_cast<bool>(x);
+    }
+
+    void flip() noexcept { *p_ ^= mask_; }
+
+   private:
+    bit_word* p_;
+    bit_word mask_;
+};
+
+// swaps the bits, not the proxies
+inline void swap(bit_reference x, bit_reference y) noexcept {
+    const bool tmp = x;
+    x = y;
+    y = tmp;
+}
+
+inline void swap(bit_reference x, bool& y) noexcept {
+    const bool tmp = x;
+    x = y;
+    y = tmp;
+}
+
+inline void swap(bool& x, bit_reference y) noexcept {
+    const bool tmp = x;
+    x = y;
+    y = tmp;
+}
+
+// bit_iterator: a word pointer and a bit offset 0..63 inside it
+template <bool IsConst>
+struct bit_iterator
+    : public iterator<
+          random_access_iterator_tag, bool, ptrdiff_t,
+          typename std::conditional<IsConst, const bool*, bit_reference*>::type,
+          typename std::conditional<IsConst, bool, bit_reference>::type> {
+    typedef typename std::conditional<IsConst, const bit_word*,
+                                      bit_word*>::type word_pointer;
+    typedef typename std::conditional<IsConst, bool, bit_reference>::type
+        reference;
+    typedef ptrdiff_t difference_type;
+    typedef bit_iterator self;
+
+    word_pointer p;
+    unsigned offset;
+
+    bit_iterator() noexcept : p(nullptr), offset(0) {}
+    bit_iterator(word_pointer word, unsigned off) noexcept
+        : p(word), offset(off) {}
+    // iterator to const_iterator
+    template <bool C, typename std::enable_if<IsConst && !C, int>::type = 0>
+    bit_iterator(const bit_iterator<C>& rhs) noexcept
+        : p(rhs.p), offset(rhs.offset) {}
+
+    reference operator*() const noexcept {
+        return deref(std::integral_constant<bool, IsConst>());
+    }
+    reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    self& operator++() noexcept {
+        if (++offset == bit_word_bits) {
+            offset = 0;
+            ++p;
+        }
+        return *this;
+    }
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() noexcept {
+        if (offset-- == 0) {
+            offset = bit_word_bits - 1;
+            --p;
+        }
+        return *this;
+    }
+    self operator--(int) noexcept {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) noexcept {
+        const difference_type bits =
+            static_cast<difference_type>(offset) + n;
+        difference_type words = bits / static_cast<difference_type>(64);
+        difference_type rest = bits % static_cast<difference_type>(64);
+        if (rest < 0) {
+            rest += 64;
+            --words;
+        }
+        p += words;
+        offset = static_cast<unsigned>(rest);
+        return *this;
+    }
+    self& operator-=(difference_type n) noexcept { return *this += -n; }
+    self operator+(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self operator-(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp -= n;
+    }
+    difference_type operator-(const self& rhs) const noexcept {
+        return (p - rhs.p) * static_cast<difference_type>(bit_word_bits) +
+               static_cast<difference_type>(offset) -
+               static_cast<difference_type>(rhs.offset);
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return p == rhs.p && offset == rhs.offset;
+    }
+    bool operator!=(const self& rhs) const noexcept { return !(*this == rhs); }
+    bool operator<(const self& rhs) const noexcept {
+        return p < rhs.p || (p == rhs.p && offset < rhs.offset);
+    }
+    bool operator>(const self& rhs) const noexcept { return rhs < *this; }
+    bool operator<=(const self& rhs) const noexcept { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const noexcept { return !(*this < rhs); }
+
+   private:
+    bool deref(std::true_type) const noexcept {
+        return (*p >> offset) & 1;
+    }
+    bit_reference deref(std::false_type) const noexcept {
+        return bit_reference(p, bit_word(1) << offset);
+    }
+};
+
+template <bool IsConst>
+bit_iterator<IsConst> operator+(ptrdiff_t n,
+                                const bit_iterator<IsConst>& it) noexcept {
+    return it + n;
+}
+
+// word at a time algorithms for bit_iterator
+
+template <bool C>
+size_t count(bit_iterator<C> first, bit_iterator<C> last, const bool& value) {
+    const size_t total = static_cast<size_t>(last - first);
+    size_t len = total;
+    size_t n = 0;
+    auto p = first.p;
+    if (first.offset != 0 && len != 0) {
+        const size_t k = mystl::min(len, bit_word_bits - first.offset);
+        n += bit_detail::popcount(*p & bit_detail::range_mask(first.offset, k));
+        len -= k;
+        ++p;
+    }
+    for (; len >= bit_word_bits; len -= bit_word_bits, ++p) {
+        n += bit_detail::popcount(*p);
+    }
+    if (len != 0) {
+        n += bit_detail::popcount(*p & bit_detail::low_mask(len));
+    }
+    return value ? n : total - n;
+}
+
+template <bool C>
+bit_iterator<C> find(bit_iterator<C> first, bit_iterator<C> last,
+                     const bool& value) {
+    // look for set bits in w ^ flip
+    const bit_word flip = value ? 0 : ~bit_word(0);
+    size_t len = static_cast<size_t>(last - first);
+    auto p = first.p;
+    if (first.offset != 0 && len != 0) {
+        const size_t k = mystl::min(len, bit_word_bits - first.offset);
+        const bit_word w =
+            (*p ^ flip) & bit_detail::range_mask(first.offset, k);
+        if (w != 0) {
+            return bit_iterator<C>(p, bit_detail::ctz(w));
+        }
+        len -= k;
+        ++p;
+    }
+    for (; len >= bit_word_bits; len -= bit_word_bits, ++p) {
+        const bit_word w = *p ^ flip;
+        if (w != 0) {
+            return bit_iterator<C>(p, bit_detail::ctz(w));
+        }
+    }
+    if (len != 0) {
+        const bit_word w = (*p ^ flip) & bit_detail::low_mask(len);
+        if (w != 0) {
+            return bit_iterator<C>(p, bit_detail::ctz(w));
+        }
+    }
+    return last;
+}
+
+inline void fill(bit_iterator<false> first, bit_iterator<false> last,
+                 const bool& value) {
+    size_t len = static_cast<size_t>(last - first);
+    auto p = first.p;
+    if (first.offset != 0 && len != 0) {
+        const size_t k = mystl::min(len, bit_word_bits - first.offset);
+        const bit_word mask = bit_detail::range_mask(first.offset, k);
+        *p = value ? (*p | mask) : (*p & ~mask);
+        len -= k;
+        ++p;
+    }
+    const size_t words = len / bit_word_bits;
+    if (words != 0) {
+        std::memset(p, value ? 0xff : 0, words * sizeof(bit_word));
+        p += words;
+    }
+    len %= bit_word_bits;
+    if (len != 0) {
+        const bit_word mask = bit_detail::low_mask(len);
+        *p = value ? (*p | mask) : (*p & ~mask);
+    }
+}
+
+inline bit_iterator<false> fill_n(bit_iterator<false> first, size_t n,
+                                  const bool& value) {
+    mystl::fill(first, first + n, value);
+    return first + n;
+}
+
+// copies in pieces that stay inside one source and one destination word,
+// whole words once both offsets line up; safe for result before first
+template <bool C>
+bit_iterator<false> copy(bit_iterator<C> first, bit_iterator<C> last,
+                         bit_iterator<false> result) {
+    size_t len = static_cast<size_t>(last - first);
+    while (len != 0) {
+        const size_t k =
+            mystl::min(len, mystl::min(bit_word_bits - first.offset,
+                                       bit_word_bits - result.offset));
+        bit_detail::copy_bits(first.p, first.offset, result.p, result.offset,
+                              k);
+        first += k;
+        result += k;
+        len -= k;
+    }
+    return result;
+}
+
+// the same from the back, safe for result after first
+template <bool C>
+bit_iterator<false> copy_backward(bit_iterator<C> first, bit_iterator<C> last,
+                                  bit_iterator<false> result) {
+    size_t len = static_cast<size_t>(last - first);
+    while (len != 0) {
+        const size_t src_room = last.offset != 0 ? last.offset : bit_word_bits;
+        const size_t dst_room =
+            result.offset != 0 ? result.offset : bit_word_bits;
+        const size_t k = mystl::min(len, mystl::min(src_room, dst_room));
+        last -= k;
+        result -= k;
+        bit_detail::copy_bits(last.p, last.offset, result.p, result.offset, k);
+        len -= k;
+    }
+    return result;
+}
+
+// template class: vector<bool>
+template <class Alloc>
+class vector<bool, Alloc>
+    : private mystl::alloc_storage<typename mystl::allocator_traits<
+          Alloc>::template rebind_alloc<bit_word>> {
+   public:
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<
+        bit_word>
+        word_allocator;
+    typedef mystl::allocator_traits<word_allocator> word_traits;
+    typedef bool value_type;
+    typedef bit_reference reference;
+    typedef bool const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef bit_iterator<false> iterator;
+    typedef bit_iterator<true> const_iterator;
+    typedef iterator pointer;
+    typedef const_iterator const_pointer;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    allocator_type get_allocator() const {
+        return allocator_type(word_alloc());
+    }
+
+   private:
+    typedef mystl::alloc_storage<word_allocator> alloc_base;
+
+    bit_word* words_;
+    size_type size_;
+    size_type cap_words_;
+
+    word_allocator& word_alloc() noexcept { return alloc_base::get_alloc(); }
+    const word_allocator& word_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
+   public:
+    // construct and deconstruct functions
+    vector() noexcept : words_(nullptr), size_(0), cap_words_(0) {}
+
+    explicit vector(const allocator_type& alloc) noexcept
+        : alloc_base(word_allocator(alloc)),
+          words_(nullptr),
+          size_(0),
+          cap_words_(0) {}
+
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+        : vector(n, false, alloc) {}
+
+    vector(size_type n, const value_type& value,
+           const allocator_type& alloc = allocator_type())
+        : vector(alloc) {
+        reallocate(bit_detail::words_for(n));
+        size_ = n;
+        mystl::fill(begin(), end(), value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    vector(Iter first, Iter last,
+           const allocator_type& alloc = allocator_type())
+        : vector(alloc) {
+        insert(end(), first, last);
+    }
+
+    vector(const vector& rhs)
+        : vector(allocator_type(
+              word_traits::select_on_container_copy_construction(
+                  rhs.word_alloc()))) {
+        copy_from(rhs);
+    }
+
+    vector(const vector& rhs, const allocator_type& alloc) : vector(alloc) {
+        copy_from(rhs);
+    }
+
+    vector(vector&& rhs) noexcept
+        : alloc_base(mystl::move(rhs.word_alloc())),
+          words_(rhs.words_),
+          size_(rhs.size_),
+          cap_words_(rhs.cap_words_) {
+        rhs.words_ = nullptr;
+        rhs.size_ = 0;
+        rhs.cap_words_ = 0;
+    }
+
+    vector(vector&& rhs, const allocator_type& alloc) : vector(alloc) {
+        if (mystl::alloc_equal(word_alloc(), rhs.word_alloc())) {
+            swap_data(rhs);
+        } else {
+            copy_from(rhs);
+            rhs.clear();
+        }
+    }
+
+    vector(std::initializer_list<value_type> ilist,
+           const allocator_type& alloc = allocator_type())
+        : vector(alloc) {
+        insert(end(), ilist.begin(), ilist.end());
+    }
+
+    vector& operator=(const vector& rhs);
+    vector& operator=(vector&& rhs) noexcept(
+        word_traits::propagate_on_container_move_assignment::value ||
+        word_traits::is_always_equal::value);
+    vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~vector() { reallocate(0); }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return iterator(words_, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(words_, 0); }
+
+    iterator end() noexcept { return begin() + size_; }
+
+    const_iterator end() const noexcept { return begin() + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return size_ == 0; }
+
+    size_type size() const noexcept { return size_; }
+
+    size_type max_size() const noexcept {
+        const size_type words = word_traits::max_size(word_alloc());
+        return words > static_cast<size_type>(-1) / bit_word_bits
+                   ? static_cast<size_type>(-1)
+                   : words * bit_word_bits;
+    }
+
+    size_type capacity() const noexcept { return cap_words_ * bit_word_bits; }
+
+    void reserve(size_type n) {
+        if (capacity() < n) {
+            THROW_LENGTH_ERROR_IF(
+                n > max_size(),
+                "n can not larger than max_size() in vector<bool>::reserve()");
+            reallocate(bit_detail::words_for(n));
+        }
+    }
+    void shrink_to_fit() {
+        if (cap_words_ > bit_detail::words_for(size_)) {
+            reallocate(bit_detail::words_for(size_));
+        }
+    }
+
+    // funciont about element visiting
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return reference(words_ + n / bit_word_bits,
+                         bit_word(1) << (n % bit_word_bits));
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return (words_[n / bit_word_bits] >> (n % bit_word_bits)) & 1;
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "vector<bool>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "vector<bool>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    // function about modifying container
+    void assign(size_type n, const value_type& value) {
+        clear();
+        insert(end(), n, value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void assign(Iter first, Iter last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    void assign(std::initializer_list<value_type> il) {
+        assign(il.begin(), il.end());
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        return insert(pos, value_type(mystl::forward<Args>(args)...));
+    }
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        push_back(value_type(mystl::forward<Args>(args)...));
+    }
+    void push_back(const value_type& value) {
+        if (size_ == capacity()) {
+            reallocate(get_new_words(1));
+        }
+        ++size_;
+        back() = value;
+    }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) {
+        return insert(pos, 1, value);
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        auto gap = make_gap(static_cast<size_type>(pos - cbegin()), n);
+        mystl::fill(gap, gap + n, value);
+        return gap;
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return range_insert(static_cast<size_type>(pos - cbegin()), first,
+                            last, iterator_category(first));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        iterator r = begin() + (first - cbegin());
+        mystl::copy(last, cend(), r);
+        size_ -= static_cast<size_type>(last - first);
+        return r;
+    }
+    void clear() noexcept { size_ = 0; }
+
+    void resize(size_type new_size, value_type value = false) {
+        if (new_size < size_) {
+            size_ = new_size;
+        } else {
+            insert(end(), new_size - size_, value);
+        }
+    }
+    void reverse() { mystl::reverse(begin(), end()); }
+
+    // word wise logical operations, rhs must have the same size
+    void flip() noexcept;
+    vector& operator&=(const vector& rhs) noexcept;
+    vector& operator|=(const vector& rhs) noexcept;
+    vector& operator^=(const vector& rhs) noexcept;
+    // number of set bits
+    size_type count() const noexcept { return mystl::count(begin(), end(), true); }
+
+    void swap(vector& rhs) noexcept {
+        if (this != &rhs) {
+            mystl::alloc_on_swap(word_alloc(), rhs.word_alloc());
+            swap_data(rhs);
+        }
+    }
+    static void swap(reference x, reference y) noexcept { mystl::swap(x, y); }
+
+   private:
+    // helper functions
+    void swap_data(vector& rhs) noexcept {
+        mystl::swap(words_, rhs.words_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(cap_words_, rhs.cap_words_);
+    }
+    void reallocate(size_type new_words);
+    size_type get_new_words(size_type add_size) const;
+    void copy_from(const vector& rhs);
+    iterator make_gap(size_type pos, size_type n);
+    template <class IIter>
+    iterator range_insert(size_type pos, IIter first, IIter last,
+                          input_iterator_tag);
+    template <class FIter>
+    iterator range_insert(size_type pos, FIter first, FIter last,
+                          forward_iterator_tag);
+};
+
+template <class Alloc>
+vector<bool, Alloc>& vector<bool, Alloc>::operator=(const vector& rhs) {
+    if (this != &rhs) {
+        if (word_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(word_alloc(), rhs.word_alloc())) {
+            // memory of the old allocator can't outlive it
+            reallocate(0);
+        }
+        mystl::alloc_on_copy(word_alloc(), rhs.word_alloc());
+        copy_from(rhs);
+    }
+    return *this;
+}
+
+template <class Alloc>
+vector<bool, Alloc>& vector<bool, Alloc>::operator=(vector&& rhs) noexcept(
+    word_traits::propagate_on_container_move_assignment::value ||
+    word_traits::is_always_equal::value) {
+    if (this != &rhs) {
+        if (word_traits::propagate_on_container_move_assignment::value ||
+            mystl::alloc_equal(word_alloc(), rhs.word_alloc())) {
+            reallocate(0);
+            mystl::alloc_on_move(word_alloc(), rhs.word_alloc());
+            swap_data(rhs);
+        } else {
+            copy_from(rhs);
+            rhs.clear();
+        }
+    }
+    return *this;
+}
+
+template <class Alloc>
+void vector<bool, Alloc>::flip() noexcept {
+    const size_type words = bit_detail::words_for(size_);
+    for (size_type i = 0; i < words; ++i) {
+        words_[i] = ~words_[i];
+    }
+}
+
+template <class Alloc>
+vector<bool, Alloc>& vector<bool, Alloc>::operator&=(
+    const vector& rhs) noexcept {
+    MYSTL_DEBUG(size_ == rhs.size_);
+    const size_type words = bit_detail::words_for(size_);
+    for (size_type i = 0; i < words; ++i) {
+        words_[i] &= rhs.words_[i];
+    }
+    return *this;
+}
+
+template <class Alloc>
+vector<bool, Alloc>& vector<bool, Alloc>::operator|=(
+    const vector& rhs) noexcept {
+    MYSTL_DEBUG(size_ == rhs.size_);
+    const size_type words = bit_detail::words_for(size_);
+    for (size_type i = 0; i < words; ++i) {
+        words_[i] |= rhs.words_[i];
+    }
+    return *this;
+}
+
+template <class Alloc>
+vector<bool, Alloc>& vector<bool, Alloc>::operator^=(
+    const vector& rhs) noexcept {
+    MYSTL_DEBUG(size_ == rhs.size_);
+    const size_type words = bit_detail::words_for(size_);
+    for (size_type i = 0; i < words; ++i) {
+        words_[i] ^= rhs.words_[i];
+    }
+    return *this;
+}
+
+// helper funcitons
+
+// move the bits into a buffer of new_words words, 0 frees the buffer; the
+// caller makes sure size() fits
+template <class Alloc>
+void vector<bool, Alloc>::reallocate(size_type new_words) {
+    bit_word* new_data = nullptr;
+    if (new_words != 0) {
+        auto r = word_traits::allocate_at_least(word_alloc(), new_words);
+        new_data = r.ptr;
+        new_words = r.count;
+        if (size_ != 0) {
+            std::memcpy(new_data, words_,
+                        bit_detail::words_for(size_) * sizeof(bit_word));
+        }
+    }
+    if (words_ != nullptr) {
+        word_traits::deallocate(word_alloc(), words_, cap_words_);
+    }
+    words_ = new_data;
+    cap_words_ = new_words;
+}
+
+template <class Alloc>
+typename vector<bool, Alloc>::size_type vector<bool, Alloc>::get_new_words(
+    size_type add_size) const {
+    THROW_LENGTH_ERROR_IF(size_ > max_size() - add_size,
+                          "vector<bool>'s size too big");
+    return mystl::max(bit_detail::words_for(size_ + add_size),
+                      cap_words_ + cap_words_ / 2);
+}
+
+template <class Alloc>
+void vector<bool, Alloc>::copy_from(const vector& rhs) {
+    if (capacity() < rhs.size_) {
+        size_ = 0;
+        reallocate(bit_detail::words_for(rhs.size_));
+    }
+    if (rhs.size_ != 0) {
+        std::memcpy(words_, rhs.words_,
+                    bit_detail::words_for(rhs.size_) * sizeof(bit_word));
+    }
+    size_ = rhs.size_;
+}
+
+// open n unspecified bits at pos, reallocating at most once
+template <class Alloc>
+typename vector<bool, Alloc>::iterator vector<bool, Alloc>::make_gap(
+    size_type pos, size_type n) {
+    if (n == 0) {
+        return begin() + pos;
+    }
+    if (capacity() - size_ >= n) {
+        mystl::copy_backward(cbegin() + pos, cend(), end() + n);
+        size_ += n;
+        return begin() + pos;
+    }
+    const size_type new_words = get_new_words(n);
+    auto r = word_traits::allocate_at_least(word_alloc(), new_words);
+    iterator new_begin(r.ptr, 0);
+    mystl::copy(cbegin(), cbegin() + pos, new_begin);
+    mystl::copy(cbegin() + pos, cend(), new_begin + (pos + n));
+    if (words_ != nullptr) {
+        word_traits::deallocate(word_alloc(), words_, cap_words_);
+    }
+    words_ = r.ptr;
+    cap_words_ = r.count;
+    size_ += n;
+    return begin() + pos;
+}
+
+template <class Alloc>
+template <class IIter>
+typename vector<bool, Alloc>::iterator vector<bool, Alloc>::range_insert(
+    size_type pos, IIter first, IIter last, input_iterator_tag) {
+    for (size_type i = pos; first != last; ++first, ++i) {
+        insert(begin() + i, static_cast<bool>(*first));
+    }
+    return begin() + pos;
+}
+
+template <class Alloc>
+template <class FIter>
+typename vector<bool, Alloc>::iterator vector<bool, Alloc>::range_insert(
+    size_type pos, FIter first, FIter last, forward_iterator_tag) {
+    const size_type n = static_cast<size_type>(mystl::distance(first, last));
+    auto gap = make_gap(pos, n);
+    mystl::copy(first, last, gap);
+    return gap;
+}
+
+// whole words first, then the bits of the last one
+template <class Alloc>
+bool operator==(const vector<bool, Alloc>& lhs,
+                const vector<bool, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+    const size_t words = lhs.size() / bit_word_bits;
+    if (words != 0 &&
+        std::memcmp(l.p, r.p, words * sizeof(bit_word)) != 0) {
+        return false;
+    }
+    const size_t rest = lhs.size() % bit_word_bits;
+    return rest == 0 ||
+           ((l.p[words] ^ r.p[words]) & bit_detail::low_mask(rest)) == 0;
+}
+
+}  // namespace mystl
+#endif
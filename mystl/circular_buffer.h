@@ -0,0 +1,670 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_CIRCULAR_BUFFER_H_
+#define MYSTL_CIRCULAR_BUFFER_H_
+
+// circular_buffer<T>: a ring of a fixed, power of two capacity, allocated
+// once. An element's slot is (head + i) & (capacity - 1), so both ends push
+// and pop in O(1) without moving anything. When full, pushes either report
+// an error (the default) or, in overwrite mode, replace the element at the
+// other end: a bounded history that forgets its oldest entries.
+// array_one() and array_two() are the two contiguous pieces of the ring in
+// order, for bulk copies out; append() copies a range in piecewise.
+// Iterators are invalidated by anything that moves the head.
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "span.h"
+#include "util.h"
+
+namespace mystl {
+
+// the smallest power of two not below n, 0 for 0
+inline size_t cb_ceil_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return n == 0 ? 0 : p;
+}
+
+// cb_iterator: the buffer, its index mask and an index that is not wrapped
+// yet, so two iterators subtract without knowing where the head is
+template <class T, bool IsConst>
+struct cb_iterator : public iterator<random_access_iterator_tag, T> {
+    typedef T value_type;
+    typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+    typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+    typedef ptrdiff_t difference_type;
+    typedef cb_iterator self;
+
+    T* buf;
+    size_t mask;
+    size_t idx;
+
+    cb_iterator() noexcept : buf(nullptr), mask(0), idx(0) {}
+    cb_iterator(T* b, size_t m, size_t i) noexcept : buf(b), mask(m), idx(i) {}
+    // iterator to const_iterator
+    template <bool C, typename std::enable_if<IsConst && !C, int>::type = 0>
+    cb_iterator(const cb_iterator<T, C>& rhs) noexcept
+        : buf(rhs.buf), mask(rhs.mask), idx(rhs.idx) {}
+
+    reference operator*() const { return buf[idx & mask]; }
+    pointer operator->() const { return buf + (idx & mask); }
+    reference operator[](difference_type n) const {
+        return buf[(idx + n) & mask];
+    }
+
+    self& operator++() {
+        ++idx;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++idx;
+        return tmp;
+    }
+    self& operator--() {
+        --idx;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --idx;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        idx += n;
+        return *this;
+    }
+    self& operator-=(difference_type n) {
+        idx -= n;
+        return *this;
+    }
+    self operator+(difference_type n) const { return self(buf, mask, idx + n); }
+    self operator-(difference_type n) const { return self(buf, mask, idx - n); }
+    difference_type operator-(const self& rhs) const {
+        return static_cast<difference_type>(idx - rhs.idx);
+    }
+
+    bool operator==(const self& rhs) const { return idx == rhs.idx; }
+    bool operator!=(const self& rhs) const { return idx != rhs.idx; }
+    bool operator<(const self& rhs) const { return idx < rhs.idx; }
+    bool operator>(const self& rhs) const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+template <class T, bool IsConst>
+cb_iterator<T, IsConst> operator+(ptrdiff_t n,
+                                  const cb_iterator<T, IsConst>& it) {
+    return it + n;
+}
+
+// template class: circular_buffer
+template <class T, class Alloc = mystl::allocator<T>>
+class circular_buffer
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>> {
+   public:
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>
+        data_allocator;
+    typedef mystl::allocator_traits<data_allocator> data_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename data_traits::size_type size_type;
+    typedef typename data_traits::difference_type difference_type;
+    typedef cb_iterator<T, false> iterator;
+    typedef cb_iterator<T, true> const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef mystl::span<T> array_range;
+    typedef mystl::span<const T> const_array_range;
+
+    allocator_type get_allocator() const {
+        return allocator_type(data_alloc());
+    }
+
+   private:
+    typedef mystl::alloc_storage<data_allocator> alloc_base;
+
+    pointer buf_;
+    size_type cap_;   // 0 or a power of two
+    size_type head_;  // slot of the front element, below cap_
+    size_type size_;
+    bool overwrite_;
+
+    data_allocator& data_alloc() noexcept { return alloc_base::get_alloc(); }
+    const data_allocator& data_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
+   public:
+    // construct and deconstruct functions
+    circular_buffer() noexcept
+        : buf_(nullptr), cap_(0), head_(0), size_(0), overwrite_(false) {}
+
+    explicit circular_buffer(const allocator_type& alloc) noexcept
+        : alloc_base(data_allocator(alloc)),
+          buf_(nullptr),
+          cap_(0),
+          head_(0),
+          size_(0),
+          overwrite_(false) {}
+
+    // room for capacity elements, rounded up to a power of two
+    explicit circular_buffer(size_type capacity,
+                             const allocator_type& alloc = allocator_type())
+        : circular_buffer(alloc) {
+        set_capacity(capacity);
+    }
+
+    circular_buffer(size_type capacity, bool overwrite,
+                    const allocator_type& alloc = allocator_type())
+        : circular_buffer(capacity, alloc) {
+        overwrite_ = overwrite;
+    }
+
+    circular_buffer(size_type capacity, std::initializer_list<value_type> il,
+                    const allocator_type& alloc = allocator_type())
+        : circular_buffer(mystl::max(capacity, il.size()), alloc) {
+        append(il.begin(), il.end());
+    }
+
+    circular_buffer(const circular_buffer& rhs)
+        : circular_buffer(allocator_type(
+              data_traits::select_on_container_copy_construction(
+                  rhs.data_alloc()))) {
+        copy_from(rhs);
+    }
+
+    circular_buffer(circular_buffer&& rhs) noexcept
+        : alloc_base(mystl::move(rhs.data_alloc())),
+          buf_(rhs.buf_),
+          cap_(rhs.cap_),
+          head_(rhs.head_),
+          size_(rhs.size_),
+          overwrite_(rhs.overwrite_) {
+        rhs.reset();
+    }
+
+    circular_buffer& operator=(const circular_buffer& rhs);
+    circular_buffer& operator=(circular_buffer&& rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value);
+
+    ~circular_buffer() {
+        clear();
+        free_buffer();
+    }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return iterator(buf_, mask(), head_); }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(buf_, mask(), head_);
+    }
+
+    iterator end() noexcept { return iterator(buf_, mask(), head_ + size_); }
+
+    const_iterator end() const noexcept {
+        return const_iterator(buf_, mask(), head_ + size_);
+    }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return size_ == 0; }
+
+    bool full() const noexcept { return size_ == cap_; }
+
+    size_type size() const noexcept { return size_; }
+
+    size_type capacity() const noexcept { return cap_; }
+
+    size_type max_size() const noexcept {
+        return data_traits::max_size(data_alloc());
+    }
+
+    // reallocate to hold n elements, rounded up to a power of two; the
+    // newest ones are kept if they don't all fit
+    void set_capacity(size_type n);
+
+    // whether a push to a full buffer replaces the element at the other end
+    bool overwrite() const noexcept { return overwrite_; }
+
+    void set_overwrite(bool on) noexcept { overwrite_ = on; }
+
+    // funciont about element visiting
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size_);
+        return buf_[slot(n)];
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return buf_[slot(n)];
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(
+            !(n < size_), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(
+            !(n < size_), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return buf_[head_];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return buf_[head_];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return buf_[slot(size_ - 1)];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return buf_[slot(size_ - 1)];
+    }
+
+    // the elements in order are array_one() followed by array_two(); the
+    // second piece is empty unless the ring wraps
+    array_range array_one() noexcept {
+        return array_range(buf_ + head_, first_piece());
+    }
+
+    const_array_range array_one() const noexcept {
+        return const_array_range(buf_ + head_, first_piece());
+    }
+
+    array_range array_two() noexcept {
+        return array_range(buf_, size_ - first_piece());
+    }
+
+    const_array_range array_two() const noexcept {
+        return const_array_range(buf_, size_ - first_piece());
+    }
+
+    // function about modifying container
+    template <class... Args>
+    void emplace_back(Args&&... args);
+    template <class... Args>
+    void emplace_front(Args&&... args);
+
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+    void push_front(const value_type& value) { emplace_front(value); }
+    void push_front(value_type&& value) { emplace_front(mystl::move(value)); }
+
+    // append if there is room; nullptr and nothing changed if full, whatever
+    // the overwrite mode
+    template <class... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if (full()) {
+            return nullptr;
+        }
+        data_traits::construct(data_alloc(), buf_ + slot(size_),
+                               mystl::forward<Args>(args)...);
+        ++size_;
+        return mystl::address_of(back());
+    }
+
+    pointer try_push_back(const value_type& value) {
+        return try_emplace_back(value);
+    }
+
+    pointer try_push_back(value_type&& value) {
+        return try_emplace_back(mystl::move(value));
+    }
+
+    // copy [first, last) to the back, in at most two contiguous pieces while
+    // there is room; past that, per element through push_back
+    template <class FIter,
+              typename std::enable_if<mystl::is_forward_iterator<FIter>::value,
+                                      int>::type = 0>
+    void append(FIter first, FIter last);
+
+    void pop_front() {
+        MYSTL_DEBUG(!empty());
+        data_traits::destroy(data_alloc(), buf_ + head_);
+        head_ = (head_ + 1) & mask();
+        --size_;
+    }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+        data_traits::destroy(data_alloc(), buf_ + slot(size_));
+    }
+
+    // drop the n oldest, e.g. after copying them out through array_one()
+    void pop_front(size_type n) {
+        MYSTL_DEBUG(n <= size_);
+        const size_type k = mystl::min(n, first_piece());
+        mystl::destroy(buf_ + head_, buf_ + head_ + k);
+        mystl::destroy(buf_, buf_ + (n - k));
+        head_ = (head_ + n) & mask();
+        size_ -= n;
+    }
+
+    void clear() noexcept {
+        pop_front(size_);
+        head_ = 0;
+    }
+
+    void swap(circular_buffer& rhs) noexcept {
+        if (this != &rhs) {
+            mystl::alloc_on_swap(data_alloc(), rhs.data_alloc());
+            swap_data(rhs);
+        }
+    }
+
+   private:
+    // helper functions
+    size_type mask() const noexcept { return cap_ - 1; }
+
+    size_type slot(size_type n) const noexcept {
+        return (head_ + n) & mask();
+    }
+
+    // how many elements sit between the head and the end of the buffer
+    size_type first_piece() const noexcept {
+        return mystl::min(size_, cap_ - head_);
+    }
+
+    void reset() noexcept {
+        buf_ = nullptr;
+        cap_ = head_ = size_ = 0;
+    }
+
+    void swap_data(circular_buffer& rhs) noexcept {
+        mystl::swap(buf_, rhs.buf_);
+        mystl::swap(cap_, rhs.cap_);
+        mystl::swap(head_, rhs.head_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(overwrite_, rhs.overwrite_);
+    }
+
+    void free_buffer() noexcept {
+        if (buf_ != nullptr) {
+            data_traits::deallocate(data_alloc(), buf_, cap_);
+        }
+    }
+
+    // rhs's capacity, mode and elements into an empty buffer
+    void copy_from(const circular_buffer& rhs) {
+        if (cap_ != rhs.cap_) {
+            set_capacity(rhs.cap_);
+        }
+        overwrite_ = rhs.overwrite_;
+        append(rhs.begin(), rhs.end());
+    }
+};
+
+template <class T, class Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(
+    const circular_buffer& rhs) {
+    if (this != &rhs) {
+        clear();
+        if (data_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            // memory of the old allocator can't outlive it
+            free_buffer();
+            reset();
+        }
+        mystl::alloc_on_copy(data_alloc(), rhs.data_alloc());
+        copy_from(rhs);
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(
+    circular_buffer&& rhs) noexcept(
+    data_traits::propagate_on_container_move_assignment::value ||
+    data_traits::is_always_equal::value) {
+    if (this == &rhs) {
+        return *this;
+    }
+    clear();
+    if (data_traits::propagate_on_container_move_assignment::value ||
+        mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+        free_buffer();
+        reset();
+        mystl::alloc_on_move(data_alloc(), rhs.data_alloc());
+        swap_data(rhs);
+    } else {
+        if (cap_ != rhs.cap_) {
+            set_capacity(rhs.cap_);
+        }
+        overwrite_ = rhs.overwrite_;
+        for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+            emplace_back(mystl::move(*it));
+        }
+        rhs.clear();
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+void circular_buffer<T, Alloc>::set_capacity(size_type n) {
+    THROW_LENGTH_ERROR_IF(n > max_size() / 2 + 1,
+                          "circular_buffer<T>'s capacity too big");
+    const size_type new_cap = mystl::cb_ceil_pow2(n);
+    if (new_cap == cap_) {
+        return;
+    }
+    const size_type keep = mystl::min(size_, new_cap);
+    pointer new_buf = nullptr;
+    if (new_cap != 0) {
+        new_buf = data_traits::allocate(data_alloc(), new_cap);
+    }
+    // the newest keep elements, linearized at the start of the new buffer
+    size_type done = 0;
+    try {
+        for (auto it = end() - keep; done != keep; ++it, ++done) {
+            data_traits::construct(data_alloc(), new_buf + done,
+                                   mystl::move(*it));
+        }
+    } catch (...) {
+        mystl::destroy(new_buf, new_buf + done);
+        data_traits::deallocate(data_alloc(), new_buf, new_cap);
+        throw;
+    }
+    clear();
+    free_buffer();
+    buf_ = new_buf;
+    cap_ = new_cap;
+    head_ = 0;
+    size_ = keep;
+}
+
+// a full buffer in overwrite mode assigns over its oldest element, which
+// becomes the newest
+template <class T, class Alloc>
+template <class... Args>
+void circular_buffer<T, Alloc>::emplace_back(Args&&... args) {
+    if (!full()) {
+        data_traits::construct(data_alloc(), buf_ + slot(size_),
+                               mystl::forward<Args>(args)...);
+        ++size_;
+        return;
+    }
+    THROW_LENGTH_ERROR_IF(!overwrite_ || cap_ == 0,
+                          "circular_buffer<T> is full");
+    // args may refer to the element about to be replaced
+    value_type tmp(mystl::forward<Args>(args)...);
+    buf_[head_] = mystl::move(tmp);
+    head_ = (head_ + 1) & mask();
+}
+
+// the same at the front, replacing the newest element
+template <class T, class Alloc>
+template <class... Args>
+void circular_buffer<T, Alloc>::emplace_front(Args&&... args) {
+    if (!full()) {
+        const size_type h = (head_ - 1) & mask();
+        data_traits::construct(data_alloc(), buf_ + h,
+                               mystl::forward<Args>(args)...);
+        head_ = h;
+        ++size_;
+        return;
+    }
+    THROW_LENGTH_ERROR_IF(!overwrite_ || cap_ == 0,
+                          "circular_buffer<T> is full");
+    value_type tmp(mystl::forward<Args>(args)...);
+    head_ = (head_ - 1) & mask();
+    buf_[head_] = mystl::move(tmp);
+}
+
+template <class T, class Alloc>
+template <class FIter,
+          typename std::enable_if<mystl::is_forward_iterator<FIter>::value,
+                                  int>::type>
+void circular_buffer<T, Alloc>::append(FIter first, FIter last) {
+    auto n = static_cast<size_type>(mystl::distance(first, last));
+    if (n > cap_ - size_ && overwrite_ && n >= cap_) {
+        // only the last cap_ elements would survive
+        clear();
+        mystl::advance(first, n - cap_);
+        n = cap_;
+    }
+    while (n != 0 && !full()) {
+        // free slots from the back up to the end of the buffer or the head
+        const size_type tail = slot(size_);
+        const size_type room =
+            mystl::min(cap_ - size_, (tail >= head_ ? cap_ : head_) - tail);
+        const size_type k = mystl::min(n, room);
+        auto next = first;
+        mystl::advance(next, k);
+        mystl::uninitialized_copy(first, next, buf_ + tail);
+        size_ += k;
+        n -= k;
+        first = next;
+    }
+    for (; n != 0; --n, ++first) {
+        push_back(*first);
+    }
+}
+
+template <class T, class Alloc>
+bool operator==(const circular_buffer<T, Alloc>& lhs,
+                const circular_buffer<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() &&
+           mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator<(const circular_buffer<T, Alloc>& lhs,
+               const circular_buffer<T, Alloc>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                          rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator!=(const circular_buffer<T, Alloc>& lhs,
+                const circular_buffer<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator>(const circular_buffer<T, Alloc>& lhs,
+               const circular_buffer<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const circular_buffer<T, Alloc>& lhs,
+                const circular_buffer<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const circular_buffer<T, Alloc>& lhs,
+                const circular_buffer<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, class Alloc>
+void swap(circular_buffer<T, Alloc>& lhs,
+          circular_buffer<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class T, class Alloc>
+struct is_trivially_relocatable<circular_buffer<T, Alloc>>
+    : is_trivially_relocatable<Alloc> {};
+
+namespace pmr {
+template <class T>
+using circular_buffer =
+    mystl::circular_buffer<T, polymorphic_allocator<T>>;
+}  // namespace pmr
+
+}  // namespace mystl
+#endif
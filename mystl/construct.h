@@ -29,6 +29,7 @@
 
 #include "iterator.h"
 #include "type_traits.h"
+#include "util.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -62,21 +63,21 @@ void destroy_one(Ty* pointer, std::false_type) {
     }
 }
 
+template <class Ty>
+void destroy(Ty* pointer) {
+    destroy_one(pointer, std::is_trivially_destructible<Ty>{});
+}
+
 template <class ForwardIter>
 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
 
 template <class ForwardIter>
 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
     for (; first != last; ++first) {
-        destroy(&*first);
+        mystl::destroy(&*first);
     }
 }
 
-template <class Ty>
-void destroy(Ty* pointer) {
-    destroy_one(pointer, std::is_trivially_destructible<Ty>{});
-}
-
 template <class ForwardIter>
 void destroy(ForwardIter first, ForwardIter last) {
     destroy_cat(first, last,
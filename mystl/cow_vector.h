@@ -0,0 +1,793 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_COW_VECTOR_H_
+#define MYSTL_COW_VECTOR_H_
+
+// cow_vector<T>: a vector of reference counted chunks of chunk_size
+// elements, for tables that are handed out as read only snapshots. Copying
+// it (snapshot()) takes one more reference to the chunk table, O(1). Writes
+// go through set() / write(), which copy whatever they pass through that a
+// snapshot still shares: the table, the page of the chunk, the chunk. A
+// version that changed k elements since the last snapshot owns about k
+// chunks and shares the rest.
+//
+// The table has two levels: it holds reference counted pages of page_size
+// chunk pointers. The first write after a snapshot copies the page pointers,
+// size() / (chunk_size * page_size) of them, then the one page it touches;
+// for 10M ints in 512 byte chunks that is about 310 + 256 pointers instead
+// of the 80K chunk pointers a flat table would copy.
+//
+// Counts are atomic: versions sharing chunks may live on different threads,
+// but one cow_vector object must not be used from two threads at once. A
+// reference from write() is only good until the next snapshot of this
+// version. Iterators are read only.
+
+#include <initializer_list>
+
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "shared_ptr.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+namespace cow_detail {
+
+constexpr size_t floor_pow2(size_t n) {
+    return n < 2 ? 1 : 2 * floor_pow2(n / 2);
+}
+
+// about 512 bytes per chunk, a power of two elements
+template <class T>
+struct default_chunk_size
+    : std::integral_constant<size_t, floor_pow2(512 / sizeof(T))> {};
+
+// chunk pointers per page of the table, 2KB
+constexpr size_t page_chunks = 256;
+
+}  // namespace cow_detail
+
+// cow_const_iterator: the page table and an element index
+template <class T, size_t ChunkSize, size_t PageSize, class Page>
+class cow_const_iterator
+    : public iterator<random_access_iterator_tag, T, ptrdiff_t, const T*,
+                      const T&> {
+   public:
+    typedef const T& reference;
+    typedef const T* pointer;
+    typedef ptrdiff_t difference_type;
+    typedef cow_const_iterator self;
+
+   public:
+    cow_const_iterator() noexcept : pages_(nullptr), idx_(0) {}
+    cow_const_iterator(Page* const* pages, size_t idx) noexcept
+        : pages_(pages), idx_(idx) {}
+
+    reference operator*() const noexcept {
+        return pages_[idx_ / (ChunkSize * PageSize)]
+            ->chunks[idx_ / ChunkSize % PageSize]
+            ->elems()[idx_ % ChunkSize];
+    }
+    pointer operator->() const noexcept { return &(operator*()); }
+    reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    self& operator++() noexcept {
+        ++idx_;
+        return *this;
+    }
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++idx_;
+        return tmp;
+    }
+    self& operator--() noexcept {
+        --idx_;
+        return *this;
+    }
+    self operator--(int) noexcept {
+        self tmp = *this;
+        --idx_;
+        return tmp;
+    }
+    self& operator+=(difference_type n) noexcept {
+        idx_ += n;
+        return *this;
+    }
+    self& operator-=(difference_type n) noexcept {
+        idx_ -= n;
+        return *this;
+    }
+    self operator+(difference_type n) const noexcept {
+        return self(pages_, idx_ + n);
+    }
+    self operator-(difference_type n) const noexcept {
+        return self(pages_, idx_ - n);
+    }
+    difference_type operator-(const self& rhs) const noexcept {
+        return static_cast<difference_type>(idx_) -
+               static_cast<difference_type>(rhs.idx_);
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return idx_ == rhs.idx_;
+    }
+    bool operator!=(const self& rhs) const noexcept { return idx_ != rhs.idx_; }
+    bool operator<(const self& rhs) const noexcept { return idx_ < rhs.idx_; }
+    bool operator>(const self& rhs) const noexcept { return idx_ > rhs.idx_; }
+    bool operator<=(const self& rhs) const noexcept {
+        return idx_ <= rhs.idx_;
+    }
+    bool operator>=(const self& rhs) const noexcept {
+        return idx_ >= rhs.idx_;
+    }
+
+   private:
+    Page* const* pages_;
+    size_t idx_;
+};
+
+// template class: cow_vector
+template <class T, class Alloc = mystl::allocator<T>>
+class cow_vector : private mystl::alloc_storage<Alloc> {
+   public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef const T* const_pointer;
+
+    static constexpr size_type chunk_size =
+        cow_detail::default_chunk_size<T>::value;
+    static constexpr size_type page_size = cow_detail::page_chunks;
+
+   private:
+    typedef sp_atomic_count count_policy;
+
+    struct chunk {
+        typename count_policy::count_type refs;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type
+            data[chunk_size];
+
+        chunk() noexcept : refs(1) {}
+        T* elems() noexcept { return reinterpret_cast<T*>(data); }
+        const T* elems() const noexcept {
+            return reinterpret_cast<const T*>(data);
+        }
+    };
+
+    // page_size chunk pointers, shared by the versions that have not
+    // written to any of its chunks since they split
+    struct page {
+        typename count_policy::count_type refs;
+        chunk* chunks[page_size];
+
+        page() noexcept : refs(1) {}
+    };
+
+    typedef mystl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<chunk>
+        chunk_allocator;
+    typedef typename alloc_traits::template rebind_alloc<page>
+        page_allocator;
+    typedef typename alloc_traits::template rebind_alloc<page*>
+        ptr_allocator;
+
+    // one version's list of pages; shared by its snapshots
+    struct table {
+        typename count_policy::count_type refs;
+        size_type size;
+        mystl::vector<page*, ptr_allocator> pages;
+
+        explicit table(const ptr_allocator& a) : refs(1), size(0), pages(a) {}
+    };
+
+    typedef typename alloc_traits::template rebind_alloc<table>
+        table_allocator;
+    typedef mystl::alloc_storage<Alloc> alloc_base;
+
+    table* tab_;
+
+   public:
+    typedef cow_const_iterator<T, chunk_size, page_size, page> const_iterator;
+    typedef const_iterator iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+
+    allocator_type get_allocator() const { return alloc_base::get_alloc(); }
+
+   public:
+    // construct and deconstruct functions
+    cow_vector() noexcept : tab_(nullptr) {}
+
+    explicit cow_vector(const allocator_type& alloc) noexcept
+        : alloc_base(alloc), tab_(nullptr) {}
+
+    explicit cow_vector(size_type n, const T& value = T(),
+                        const allocator_type& alloc = allocator_type())
+        : cow_vector(alloc) {
+        resize(n, value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    cow_vector(Iter first, Iter last,
+               const allocator_type& alloc = allocator_type())
+        : cow_vector(alloc) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    cow_vector(std::initializer_list<T> ilist,
+               const allocator_type& alloc = allocator_type())
+        : cow_vector(ilist.begin(), ilist.end(), alloc) {}
+
+    // a snapshot: shares every chunk, unless the allocator of the copy
+    // can't free them; then the elements are copied
+    cow_vector(const cow_vector& rhs)
+        : alloc_base(alloc_traits::select_on_container_copy_construction(
+              rhs.alloc_base::get_alloc())),
+          tab_(nullptr) {
+        assign_from(rhs);
+    }
+
+    cow_vector(cow_vector&& rhs) noexcept
+        : alloc_base(mystl::move(rhs.alloc_base::get_alloc())),
+          tab_(rhs.tab_) {
+        rhs.tab_ = nullptr;
+    }
+
+    cow_vector& operator=(const cow_vector& rhs);
+    cow_vector& operator=(cow_vector&& rhs);
+
+    ~cow_vector() { release_table(tab_); }
+
+    cow_vector snapshot() const { return *this; }
+
+   public:
+    // function about iterator, all read only
+    const_iterator begin() const noexcept {
+        return const_iterator(page_table(), 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(page_table(), size());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type size() const noexcept { return tab_ == nullptr ? 0 : tab_->size; }
+
+    size_type max_size() const noexcept {
+        return static_cast<size_type>(-1) / sizeof(T);
+    }
+
+    // number of chunks, and of those this version shares with another
+    size_type chunk_count() const noexcept {
+        return (size() + chunk_size - 1) / chunk_size;
+    }
+
+    size_type shared_chunk_count() const noexcept;
+
+    // reading never copies
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return tab_->pages[n / (chunk_size * page_size)]
+            ->chunks[n / chunk_size % page_size]
+            ->elems()[n % chunk_size];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "cow_vector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size() - 1];
+    }
+
+    // function about modifying container
+
+    // element n of a chunk owned by this version only
+    reference write(size_type n) {
+        MYSTL_DEBUG(n < size());
+        return own_chunk(n / chunk_size)->elems()[n % chunk_size];
+    }
+
+    void set(size_type n, const T& value) { write(n) = value; }
+
+    void set(size_type n, T&& value) { write(n) = mystl::move(value); }
+
+    template <class... Args>
+    void emplace_back(Args&&... args);
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(mystl::move(value)); }
+
+    void pop_back();
+
+    void resize(size_type new_size) { resize(new_size, T()); }
+
+    void resize(size_type new_size, const T& value);
+
+    void clear() noexcept {
+        release_table(tab_);
+        tab_ = nullptr;
+    }
+
+    void swap(cow_vector& rhs);
+
+    // shared chunks are equal without looking at them
+    bool operator==(const cow_vector& rhs) const;
+
+   private:
+    // helper functions
+    page* const* page_table() const noexcept {
+        return tab_ == nullptr ? nullptr : tab_->pages.data();
+    }
+
+    // elements alive in chunk i of a table of size elements
+    static size_type live(size_type size, size_type i) noexcept {
+        return mystl::min(chunk_size, size - i * chunk_size);
+    }
+
+    // chunks in page p of a table of size elements
+    static size_type page_live(size_type size, size_type p) noexcept {
+        return mystl::min(page_size,
+                          (size + chunk_size - 1) / chunk_size - p * page_size);
+    }
+
+    chunk* new_chunk();
+    void free_chunk(chunk* c) noexcept;
+    void release_chunk(chunk* c, size_type n) noexcept;
+    page* new_page();
+    void free_page(page* p) noexcept;
+    void release_page(page* p, size_type size, size_type index) noexcept;
+    table* new_table();
+    void release_table(table* t) noexcept;
+    table* own_table();
+    page* own_page(table* t, size_type index);
+    chunk* own_chunk(size_type i);
+    void assign_from(const cow_vector& rhs);
+};
+
+template <class T, class Alloc>
+constexpr typename cow_vector<T, Alloc>::size_type
+    cow_vector<T, Alloc>::chunk_size;
+
+template <class T, class Alloc>
+constexpr typename cow_vector<T, Alloc>::size_type
+    cow_vector<T, Alloc>::page_size;
+
+template <class T, class Alloc>
+cow_vector<T, Alloc>& cow_vector<T, Alloc>::operator=(const cow_vector& rhs) {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(alloc_base::get_alloc(),
+                                rhs.alloc_base::get_alloc())) {
+            // chunks of the old allocator can't outlive it
+            clear();
+        }
+        mystl::alloc_on_copy(alloc_base::get_alloc(),
+                             rhs.alloc_base::get_alloc());
+        assign_from(rhs);
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+cow_vector<T, Alloc>& cow_vector<T, Alloc>::operator=(cow_vector&& rhs) {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_move_assignment::value ||
+            mystl::alloc_equal(alloc_base::get_alloc(),
+                               rhs.alloc_base::get_alloc())) {
+            clear();
+            mystl::alloc_on_move(alloc_base::get_alloc(),
+                                 rhs.alloc_base::get_alloc());
+            tab_ = rhs.tab_;
+            rhs.tab_ = nullptr;
+        } else {
+            // the chunks of rhs may be shared with its snapshots, copy them
+            assign_from(rhs);
+            rhs.clear();
+        }
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::swap(cow_vector& rhs) {
+    if (this == &rhs) {
+        return;
+    }
+    if (alloc_traits::propagate_on_container_swap::value ||
+        mystl::alloc_equal(alloc_base::get_alloc(),
+                           rhs.alloc_base::get_alloc())) {
+        mystl::alloc_on_swap(alloc_base::get_alloc(),
+                             rhs.alloc_base::get_alloc());
+        mystl::swap(tab_, rhs.tab_);
+    } else {
+        // each side keeps its allocator and gets a copy of the other's
+        // elements
+        cow_vector lhs_copy(get_allocator());
+        cow_vector rhs_copy(rhs.get_allocator());
+        lhs_copy.assign_from(rhs);
+        rhs_copy.assign_from(*this);
+        mystl::swap(tab_, lhs_copy.tab_);
+        mystl::swap(rhs.tab_, rhs_copy.tab_);
+    }
+}
+
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::size_type
+cow_vector<T, Alloc>::shared_chunk_count() const noexcept {
+    size_type n = 0;
+    if (tab_ != nullptr) {
+        for (size_type i = 0; i < tab_->pages.size(); ++i) {
+            const page* p = tab_->pages[i];
+            const size_type count = page_live(tab_->size, i);
+            if (count_policy::load(p->refs) > 1) {
+                n += count;
+                continue;
+            }
+            for (size_type k = 0; k < count; ++k) {
+                n += count_policy::load(p->chunks[k]->refs) > 1;
+            }
+        }
+    }
+    return n;
+}
+
+template <class T, class Alloc>
+template <class... Args>
+void cow_vector<T, Alloc>::emplace_back(Args&&... args) {
+    table* t = own_table();
+    const size_type n = t->size;
+    if (n % chunk_size == 0) {
+        const size_type i = n / chunk_size;
+        page* p = nullptr;
+        if (i % page_size == 0) {
+            p = new_page();
+            try {
+                t->pages.push_back(p);
+            } catch (...) {
+                free_page(p);
+                throw;
+            }
+        } else {
+            p = own_page(t, i / page_size);
+        }
+        chunk* c = nullptr;
+        try {
+            c = new_chunk();
+            mystl::construct(c->elems(), mystl::forward<Args>(args)...);
+        } catch (...) {
+            if (c != nullptr) {
+                free_chunk(c);
+            }
+            if (i % page_size == 0) {
+                t->pages.pop_back();
+                free_page(p);
+            }
+            throw;
+        }
+        p->chunks[i % page_size] = c;
+    } else {
+        chunk* c = own_chunk(n / chunk_size);
+        mystl::construct(c->elems() + n % chunk_size,
+                         mystl::forward<Args>(args)...);
+    }
+    ++t->size;
+}
+
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    table* t = own_table();
+    const size_type n = t->size - 1;
+    const size_type i = n / chunk_size;
+    if (n % chunk_size == 0 && i % page_size == 0) {
+        // the last element of its page
+        release_page(t->pages.back(), t->size, i / page_size);
+        t->pages.pop_back();
+    } else if (n % chunk_size == 0) {
+        // the last element of its chunk
+        page* p = own_page(t, i / page_size);
+        release_chunk(p->chunks[i % page_size], 1);
+    } else {
+        chunk* c = own_chunk(n / chunk_size);
+        mystl::destroy(c->elems() + n % chunk_size);
+    }
+    t->size = n;
+}
+
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::resize(size_type new_size, const T& value) {
+    if (new_size == 0) {
+        clear();
+        return;
+    }
+    THROW_LENGTH_ERROR_IF(new_size > max_size(),
+                          "cow_vector<T>'s size too big");
+    own_table()->pages.reserve((new_size + chunk_size * page_size - 1) /
+                               (chunk_size * page_size));
+    while (size() > new_size) {
+        pop_back();
+    }
+    while (size() < new_size) {
+        emplace_back(value);
+    }
+}
+
+template <class T, class Alloc>
+bool cow_vector<T, Alloc>::operator==(const cow_vector& rhs) const {
+    if (tab_ == rhs.tab_) {
+        return true;
+    }
+    const size_type n = size();
+    if (n != rhs.size()) {
+        return false;
+    }
+    // an empty version may have no table at all
+    if (n == 0) {
+        return true;
+    }
+    for (size_type i = 0; i < tab_->pages.size(); ++i) {
+        const page* pa = tab_->pages[i];
+        const page* pb = rhs.tab_->pages[i];
+        if (pa == pb) {
+            continue;
+        }
+        for (size_type k = 0; k < page_live(n, i); ++k) {
+            const chunk* a = pa->chunks[k];
+            const chunk* b = pb->chunks[k];
+            const size_type count = live(n, i * page_size + k);
+            if (a != b &&
+                !mystl::equal(a->elems(), a->elems() + count, b->elems())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::chunk* cow_vector<T, Alloc>::new_chunk() {
+    chunk_allocator a(alloc_base::get_alloc());
+    chunk* c = mystl::allocator_traits<chunk_allocator>::allocate(a, 1);
+    mystl::construct(c);
+    return c;
+}
+
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::free_chunk(chunk* c) noexcept {
+    chunk_allocator a(alloc_base::get_alloc());
+    mystl::destroy(c);
+    mystl::allocator_traits<chunk_allocator>::deallocate(a, c, 1);
+}
+
+// drops one reference; the last one destroys the n elements
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::release_chunk(chunk* c, size_type n) noexcept {
+    if (count_policy::load_acquire(c->refs) == 1 ||
+        count_policy::decrement(c->refs) == 0) {
+        mystl::destroy(c->elems(), c->elems() + n);
+        free_chunk(c);
+    }
+}
+
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::page* cow_vector<T, Alloc>::new_page() {
+    page_allocator a(alloc_base::get_alloc());
+    page* p = mystl::allocator_traits<page_allocator>::allocate(a, 1);
+    mystl::construct(p);
+    return p;
+}
+
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::free_page(page* p) noexcept {
+    page_allocator a(alloc_base::get_alloc());
+    mystl::destroy(p);
+    mystl::allocator_traits<page_allocator>::deallocate(a, p, 1);
+}
+
+// drops one reference to page index of a table of size elements; the last
+// one releases its chunks
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::release_page(page* p, size_type size,
+                                        size_type index) noexcept {
+    if (count_policy::load_acquire(p->refs) == 1 ||
+        count_policy::decrement(p->refs) == 0) {
+        for (size_type k = 0; k < page_live(size, index); ++k) {
+            release_chunk(p->chunks[k], live(size, index * page_size + k));
+        }
+        free_page(p);
+    }
+}
+
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::table* cow_vector<T, Alloc>::new_table() {
+    table_allocator a(alloc_base::get_alloc());
+    table* t = mystl::allocator_traits<table_allocator>::allocate(a, 1);
+    try {
+        mystl::construct(t, ptr_allocator(alloc_base::get_alloc()));
+    } catch (...) {
+        mystl::allocator_traits<table_allocator>::deallocate(a, t, 1);
+        throw;
+    }
+    return t;
+}
+
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::release_table(table* t) noexcept {
+    if (t == nullptr) {
+        return;
+    }
+    if (count_policy::load_acquire(t->refs) == 1 ||
+        count_policy::decrement(t->refs) == 0) {
+        for (size_type i = 0; i < t->pages.size(); ++i) {
+            release_page(t->pages[i], t->size, i);
+        }
+        table_allocator a(alloc_base::get_alloc());
+        mystl::destroy(t);
+        mystl::allocator_traits<table_allocator>::deallocate(a, t, 1);
+    }
+}
+
+// the table of this version, copied first if a snapshot shares it; the copy
+// takes a reference to every page
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::table* cow_vector<T, Alloc>::own_table() {
+    if (tab_ != nullptr && count_policy::load_acquire(tab_->refs) == 1) {
+        return tab_;
+    }
+    table* t = new_table();
+    if (tab_ != nullptr) {
+        try {
+            t->pages = tab_->pages;
+        } catch (...) {
+            release_table(t);
+            throw;
+        }
+        t->size = tab_->size;
+        for (auto p : t->pages) {
+            count_policy::increment(p->refs);
+        }
+        release_table(tab_);
+    }
+    tab_ = t;
+    return t;
+}
+
+// page index of the owned table t, copied first if another version shares
+// it; the copy takes a reference to every chunk of the page
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::page* cow_vector<T, Alloc>::own_page(
+    table* t, size_type index) {
+    page* p = t->pages[index];
+    if (count_policy::load_acquire(p->refs) == 1) {
+        return p;
+    }
+    page* copy = new_page();
+    const size_type count = page_live(t->size, index);
+    for (size_type k = 0; k < count; ++k) {
+        copy->chunks[k] = p->chunks[k];
+        count_policy::increment(copy->chunks[k]->refs);
+    }
+    t->pages[index] = copy;
+    release_page(p, t->size, index);
+    return copy;
+}
+
+// chunk i of this version, copied first if another version shares it
+template <class T, class Alloc>
+typename cow_vector<T, Alloc>::chunk* cow_vector<T, Alloc>::own_chunk(
+    size_type i) {
+    table* t = own_table();
+    page* p = own_page(t, i / page_size);
+    chunk* c = p->chunks[i % page_size];
+    if (count_policy::load_acquire(c->refs) == 1) {
+        return c;
+    }
+    chunk* copy = new_chunk();
+    try {
+        mystl::uninitialized_copy(c->elems(), c->elems() + live(t->size, i),
+                                  copy->elems());
+    } catch (...) {
+        free_chunk(copy);
+        throw;
+    }
+    p->chunks[i % page_size] = copy;
+    release_chunk(c, live(t->size, i));
+    return copy;
+}
+
+// take the table of rhs, or a copy of its elements if our allocator can't
+// free what the allocator of rhs allocated
+template <class T, class Alloc>
+void cow_vector<T, Alloc>::assign_from(const cow_vector& rhs) {
+    if (mystl::alloc_equal(alloc_base::get_alloc(),
+                           rhs.alloc_base::get_alloc())) {
+        if (rhs.tab_ != nullptr) {
+            count_policy::increment(rhs.tab_->refs);
+        }
+        release_table(tab_);
+        tab_ = rhs.tab_;
+        return;
+    }
+    cow_vector tmp(get_allocator());
+    if (!rhs.empty()) {
+        tmp.own_table()->pages.reserve(rhs.tab_->pages.size());
+        for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+            tmp.push_back(*it);
+        }
+    }
+    mystl::swap(tab_, tmp.tab_);
+}
+
+template <class T, class Alloc>
+bool operator!=(const cow_vector<T, Alloc>& lhs,
+                const cow_vector<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+void swap(cow_vector<T, Alloc>& lhs, cow_vector<T, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif
@@ -26,11 +26,15 @@
 #ifndef MYSTL_DEQUE_H_
 #define MYSTL_DEQUE_H_
 
+#include <cstring>
 #include <initializer_list>
 
+#include "algo.h"
+#include "aligned_allocator.h"
 #include "exceptdef.h"
 #include "iterator.h"
 #include "memory.h"
+#include "numeric.h"
 #include "util.h"
 
 namespace mystl {
@@ -49,26 +53,40 @@ namespace mystl {
 #define DEQUE_MAP_INIT_SIZE 8
 #endif
 
+// freed blocks the deque keeps for reuse instead of returning them at once
+#ifndef DEQUE_SPARE_BLOCKS
+#define DEQUE_SPARE_BLOCKS 2
+#endif
+static_assert(DEQUE_SPARE_BLOCKS > 0, "DEQUE_SPARE_BLOCKS must be positive");
+
+constexpr size_t deque_floor_pow2(size_t n) {
+    return n < 2 ? 1 : 2 * deque_floor_pow2(n / 2);
+}
+
+// the default block holds a power of two elements, about 4 KB, so that the
+// divisions in the iterator arithmetic become shifts and masks
 template <class T>
 struct deque_buf_size {
-    static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+    static constexpr size_t value =
+        sizeof(T) < 256 ? deque_floor_pow2(4096 / sizeof(T)) : 16;
 };
 
-template <class T, class Ref, class Ptr>
+template <class T, class Ref, class Ptr,
+          size_t BufSize = deque_buf_size<T>::value>
 struct deque_iterator : public iterator<random_access_iterator_tag, T> {
-    typedef deque_iterator<T, T&, T*> iterator;
-    typedef deque_iterator<T, const T&, const T*> const_iterator;
+    typedef deque_iterator<T, T&, T*, BufSize> iterator;
+    typedef deque_iterator<T, const T&, const T*, BufSize> const_iterator;
     typedef deque_iterator self;
 
     typedef T value_type;
     typedef Ptr pointer;
     typedef Ref reference;
     typedef size_t size_type;
-    typedef ptrdiff_t defference_type;
+    typedef ptrdiff_t difference_type;
     typedef T* value_pointer;
     typedef T** map_pointer;
 
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    static constexpr size_type buffer_size = BufSize;
 
     value_pointer cur;
     value_pointer first;
@@ -84,24 +102,14 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
     deque_iterator(const iterator& rhs)
         : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
 
-    deque_iterator(iterator&& rhs)
-        : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {
-        rhs.cur = nullptr;
-        rhs.first = nullptr;
-        rhs.last = nullptr;
-        rhs.node = nullptr;
-    }
-
     deque_iterator(const const_iterator& rhs)
         : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
 
     self& operator=(const iterator& rhs) {
-        if (this != &rhs) {
-            cur = rhs.cur;
-            first = rhs.first;
-            last = rhs.last;
-            node = rhs.node;
-        }
+        cur = rhs.cur;
+        first = rhs.first;
+        last = rhs.last;
+        node = rhs.node;
         return *this;
     }
 
@@ -143,7 +151,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
         return *this;
     }
 
-    self operator(int) {
+    self operator--(int) {
         self tmp = *this;
         --*this;
         return tmp;
@@ -154,7 +162,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
         if (offset >= 0 && offset < static_cast<difference_type>(buffer_size)) {
             cur += n;
         } else {
-            const auto node_offset = offset =
+            const auto node_offset =
                 offset > 0 ? offset / static_cast<difference_type>(buffer_size)
                            : -static_cast<difference_type>((-offset - 1) /
                                                            buffer_size) -
@@ -181,7 +189,7 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
     reference operator[](difference_type n) const { return *(*this + n); }
 
     bool operator==(const self& rhs) const { return cur == rhs.cur; }
-    bool operator<const self& rhs) const {
+    bool operator<(const self& rhs) const {
         return node == rhs.node ? (cur < rhs.cur) : (node < rhs.node);
     }
     bool operator!=(const self& rhs) const { return !(*this == rhs); }
@@ -190,87 +198,302 @@ struct deque_iterator : public iterator<random_access_iterator_tag, T> {
     bool operator>=(const self& rhs) const { return !(*this < rhs); }
 };
 
-template <class T>
-class deque {
+template <class T, class Ref, class Ptr, size_t BufSize>
+constexpr typename deque_iterator<T, Ref, Ptr, BufSize>::size_type
+    deque_iterator<T, Ref, Ptr, BufSize>::buffer_size;
+
+// segment-aware algorithms: a range of deque iterators is walked block by
+// block, each block is a plain array handed to the pointer version of the
+// algorithm, which is a tight loop or a memmove / memset
+
+// the next block of it, which must not be the block of last
+template <class T, class Ref, class Ptr, size_t B>
+void deque_next_block(deque_iterator<T, Ref, Ptr, B>& it) {
+    it.set_node(it.node + 1);
+    it.cur = it.first;
+}
+
+template <class RandomIter, class T, size_t B>
+deque_iterator<T, T&, T*, B> deque_copy_to(RandomIter first, RandomIter last,
+                                           deque_iterator<T, T&, T*, B> result,
+                                           random_access_iterator_tag) {
+    auto n = last - first;
+    while (n > 0) {
+        const auto k = mystl::min(
+            n, static_cast<decltype(n)>(result.last - result.cur));
+        mystl::copy(first, first + k, result.cur);
+        first += k;
+        result += k;
+        n -= k;
+    }
+    return result;
+}
+
+template <class InputIter, class T, size_t B>
+deque_iterator<T, T&, T*, B> deque_copy_to(InputIter first, InputIter last,
+                                           deque_iterator<T, T&, T*, B> result,
+                                           input_iterator_tag) {
+    for (; first != last; ++first, ++result) {
+        *result = *first;
+    }
+    return result;
+}
+
+// copy into a deque, one destination block at a time
+template <class InputIter, class T, size_t B>
+deque_iterator<T, T&, T*, B> copy(InputIter first, InputIter last,
+                                  deque_iterator<T, T&, T*, B> result) {
+    return mystl::deque_copy_to(first, last, result,
+                                iterator_category(first));
+}
+
+// copy out of a deque, one source block at a time
+template <class T, class Ref, class Ptr, size_t B, class OutputIter>
+OutputIter copy(deque_iterator<T, Ref, Ptr, B> first,
+                deque_iterator<T, Ref, Ptr, B> last, OutputIter result) {
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        result = mystl::copy(first.cur, first.last, result);
+    }
+    return mystl::copy(first.cur, last.cur, result);
+}
+
+// deque to deque: each source block is split at destination block ends;
+// safe for result before first
+template <class T1, class Ref, class Ptr, size_t B1, class T2, size_t B2>
+deque_iterator<T2, T2&, T2*, B2> copy(deque_iterator<T1, Ref, Ptr, B1> first,
+                                      deque_iterator<T1, Ref, Ptr, B1> last,
+                                      deque_iterator<T2, T2&, T2*, B2> result) {
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        result = mystl::deque_copy_to(first.cur, first.last, result,
+                                      random_access_iterator_tag());
+    }
+    return mystl::deque_copy_to(first.cur, last.cur, result,
+                                random_access_iterator_tag());
+}
+
+template <class T, size_t B, class U>
+void fill(deque_iterator<T, T&, T*, B> first,
+          deque_iterator<T, T&, T*, B> last, const U& value) {
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        mystl::fill(first.cur, first.last, value);
+    }
+    mystl::fill(first.cur, last.cur, value);
+}
+
+template <class T, class Ref, class Ptr, size_t B, class U>
+deque_iterator<T, Ref, Ptr, B> find(deque_iterator<T, Ref, Ptr, B> first,
+                                    deque_iterator<T, Ref, Ptr, B> last,
+                                    const U& value) {
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        const auto p = mystl::find(first.cur, first.last, value);
+        if (p != first.last) {
+            first.cur = p;
+            return first;
+        }
+    }
+    first.cur = mystl::find(first.cur, last.cur, value);
+    return first;
+}
+
+template <class T, class Ref, class Ptr, size_t B, class Function>
+Function for_each(deque_iterator<T, Ref, Ptr, B> first,
+                  deque_iterator<T, Ref, Ptr, B> last, Function f) {
+    // f is called in place, a lambda can't be assigned back from a copy
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        for (auto p = first.cur; p != first.last; ++p) {
+            f(*p);
+        }
+    }
+    for (auto p = first.cur; p != last.cur; ++p) {
+        f(*p);
+    }
+    return f;
+}
+
+template <class T, class Ref, class Ptr, size_t B, class U>
+U accumulate(deque_iterator<T, Ref, Ptr, B> first,
+             deque_iterator<T, Ref, Ptr, B> last, U init) {
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        init = mystl::accumulate(first.cur, first.last, init);
+    }
+    return mystl::accumulate(first.cur, last.cur, init);
+}
+
+template <class T, class Ref, class Ptr, size_t B, class U, class BinaryOp>
+U accumulate(deque_iterator<T, Ref, Ptr, B> first,
+             deque_iterator<T, Ref, Ptr, B> last, U init, BinaryOp binary_op) {
+    for (; first.node != last.node; mystl::deque_next_block(first)) {
+        init = mystl::accumulate(first.cur, first.last, init, binary_op);
+    }
+    return mystl::accumulate(first.cur, last.cur, init, binary_op);
+}
+
+template <class T, class Ref, class Ptr, size_t B, class InputIter>
+bool equal(deque_iterator<T, Ref, Ptr, B> first1,
+           deque_iterator<T, Ref, Ptr, B> last1, InputIter first2) {
+    for (; first1.node != last1.node; mystl::deque_next_block(first1)) {
+        for (auto p = first1.cur; p != first1.last; ++p, ++first2) {
+            if (*p != *first2) {
+                return false;
+            }
+        }
+    }
+    for (auto p = first1.cur; p != last1.cur; ++p, ++first2) {
+        if (*p != *first2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// both sides by blocks, in pieces that end at either block end
+template <class T1, class Ref1, class Ptr1, size_t B1, class T2, class Ref2,
+          class Ptr2, size_t B2>
+bool equal(deque_iterator<T1, Ref1, Ptr1, B1> first1,
+           deque_iterator<T1, Ref1, Ptr1, B1> last1,
+           deque_iterator<T2, Ref2, Ptr2, B2> first2) {
+    auto n = last1 - first1;
+    while (n > 0) {
+        const auto k = mystl::min(
+            n, static_cast<decltype(n)>(mystl::min(first1.last - first1.cur,
+                                                   first2.last - first2.cur)));
+        const auto p1 = first1.cur;
+        const auto p2 = first2.cur;
+        for (decltype(n) i = 0; i < k; ++i) {
+            if (p1[i] != p2[i]) {
+                return false;
+            }
+        }
+        first1 += k;
+        first2 += k;
+        n -= k;
+    }
+    return true;
+}
+
+// BufSize is the number of elements per block; any positive size works, a
+// power of two is fastest
+template <class T, class Alloc = mystl::allocator<T>,
+          size_t BufSize = deque_buf_size<T>::value>
+class deque
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>> {
    public:
-    typedef mystl::allocator<T> allocator_type;
-    typedef mystl::allocator<T> data_type;
-    typedef mystl::allocator<T*> map_allocator;
-
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>
+        data_allocator;
+    typedef mystl::allocator_traits<data_allocator> data_traits;
+    typedef typename data_traits::template rebind_alloc<T*> map_allocator;
+    typedef mystl::allocator_traits<map_allocator> map_traits;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename data_traits::size_type size_type;
+    typedef typename data_traits::difference_type difference_type;
     typedef pointer* map_pointer;
     typedef const_pointer* const_map_pointer;
 
-    typedef deque_iterator<T, T&, T*> iterator;
-    typedef deque_iterator<T, const T&, const T*> const_iterator;
+    typedef deque_iterator<T, T&, T*, BufSize> iterator;
+    typedef deque_iterator<T, const T&, const T*, BufSize> const_iterator;
     typedef mystl::reverse_iterator<iterator> reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() { return allocator_type(); }
+    allocator_type get_allocator() const {
+        return allocator_type(data_alloc());
+    }
 
-    static const size_type buffer_size = deque_buf_size<T>::value;
+    static constexpr size_type buffer_size = BufSize;
+    static_assert(BufSize > 0, "deque needs at least one element per block");
 
    private:
+    typedef mystl::alloc_storage<data_allocator> alloc_base;
+
     iterator begin_;
     iterator end_;
     map_pointer map_;
     size_type map_size_;
+    // blocks freed by pops and erases, handed out again before allocating
+    pointer spare_[DEQUE_SPARE_BLOCKS];
+    size_type spare_count_;
+
+    data_allocator& data_alloc() noexcept { return alloc_base::get_alloc(); }
+    const data_allocator& data_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
 
    public:
-    deque() { fill_init(0, value_type()); }
+    deque() : spare_(), spare_count_(0) { fill_init(0, value_type()); }
+
+    explicit deque(const allocator_type& alloc)
+        : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
+        fill_init(0, value_type());
+    }
 
-    explicit deque(size_type n) { fill_init(n, value_type()); }
+    explicit deque(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
+        fill_init(n, value_type());
+    }
 
-    deque(size_type n, const value_type& value) { fill_init(n, value); }
+    deque(size_type n, const value_type& value,
+          const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
+        fill_init(n, value);
+    }
 
     template <class IIter,
               typename std::enable_if<mystl::is_input_iterator<IIter>::value,
                                       int>::type = 0>
-    deque(IIter first, IIter last) {
+    deque(IIter first, IIter last,
+          const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
         copy_init(first, last, iterator_category(first));
     }
 
-    deque(std::initializer_list<value_type> ilist) {
+    deque(std::initializer_list<value_type> ilist,
+          const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
         copy_init(ilist.begin(), ilist.end(), mystl::forward_iterator_tag());
     }
 
-    deque(const deque& rhs) {
+    deque(const deque& rhs)
+        : alloc_base(data_traits::select_on_container_copy_construction(
+              rhs.data_alloc())),
+          spare_(),
+          spare_count_(0) {
+        copy_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag());
+    }
+
+    deque(const deque& rhs, const allocator_type& alloc)
+        : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
         copy_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag());
     }
 
     deque(deque&& rhs) noexcept
-        : begin_(mystl::move(rhs.begin_)),
-          end_(mystl::mode(rhs.end_)),
+        : alloc_base(mystl::move(rhs.data_alloc())),
+          begin_(rhs.begin_),
+          end_(rhs.end_),
           map_(rhs.map_),
-          map_size_(rhs.map_size_) {
-        rhs.map_ = nullptr;
-        rhs.map_size_ = 0;
+          map_size_(rhs.map_size_),
+          spare_(),
+          spare_count_(0) {
+        rhs.reset_moved_from();
+        take_spares(rhs);
     }
 
+    deque(deque&& rhs, const allocator_type& alloc);
+
     deque& operator=(const deque& rhs);
     deque& operator=(deque&& rhs);
 
     deque& operator=(std::initializer_list<value_type> ilist) {
-        deque tmp(ilist);
-        swap(tmp);
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag());
         return *this;
     }
 
-    ~deque() {
-        if (map_ != nullptr) {
-            clear();
-            data_allocator::deallocate(*begin_.node, buffer_size);
-            *begin_.node = nullptr;
-            map_allocator::deallocate(map_, map_size_);
-            map_ = nullptr;
-        }
-    }
+    ~deque() { release_storage(); }
 
    public:
     iterator begin() noexcept { return begin_; }
@@ -280,11 +503,11 @@ class deque {
 
     reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
     const_reverse_iterator rbegin() const noexcept {
-        return reverse_iterator(end());
+        return const_reverse_iterator(end());
     }
     reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
     const_reverse_iterator rend() const noexcept {
-        return reverse_iterator(begin());
+        return const_reverse_iterator(begin());
     }
 
     const_iterator cbegin() const noexcept { return begin(); }
@@ -387,7 +610,62 @@ class deque {
 
    private:
     // helper functions
-    map_pointer create_map(size_type size);
+    pointer allocate_buffer() {
+        if (spare_count_ != 0) {
+            return spare_[--spare_count_];
+        }
+        return data_traits::allocate(data_alloc(), buffer_size);
+    }
+    // a block goes to the spare cache while it has room, so a queue going
+    // back and forth over a block boundary doesn't allocate each time
+    void deallocate_buffer(pointer p) {
+        if (p == nullptr) {
+            return;
+        }
+        if (spare_count_ < DEQUE_SPARE_BLOCKS) {
+            spare_[spare_count_++] = p;
+        } else {
+            data_traits::deallocate(data_alloc(), p, buffer_size);
+        }
+    }
+    void release_spares() noexcept {
+        while (spare_count_ != 0) {
+            data_traits::deallocate(data_alloc(), spare_[--spare_count_],
+                                    buffer_size);
+        }
+    }
+    // the spare blocks of rhs, this cache must be empty
+    void take_spares(deque& rhs) noexcept {
+        for (size_type i = 0; i < rhs.spare_count_; ++i) {
+            spare_[i] = rhs.spare_[i];
+        }
+        spare_count_ = rhs.spare_count_;
+        rhs.spare_count_ = 0;
+    }
+    void deallocate_map(map_pointer mp, size_type n) {
+        map_allocator alloc(data_alloc());
+        map_traits::deallocate(alloc, mp, n);
+    }
+    // a moved-from deque is empty and has no map; require_capacity creates
+    // one on its next insertion
+    void reset_moved_from() noexcept {
+        begin_ = iterator();
+        end_ = iterator();
+        map_ = nullptr;
+        map_size_ = 0;
+    }
+    // destroy every element and free every buffer and the map
+    void release_storage() {
+        if (map_ != nullptr) {
+            clear();
+            destroy_buffer(map_, map_ + map_size_ - 1);
+            deallocate_map(map_, map_size_);
+            map_ = nullptr;
+            map_size_ = 0;
+        }
+        release_spares();
+    }
+    map_pointer create_map(size_type& size);
     void create_buffer(map_pointer nstart, map_pointer nfinish);
     void destroy_buffer(map_pointer nstart, map_pointer nfinish);
 
@@ -419,39 +697,79 @@ class deque {
 
     // reallocate
     void require_capacity(size_type n, bool front);
+    static void relocate_forward(iterator first, iterator last,
+                                 iterator result);
+    static void relocate_backward(iterator first, iterator last,
+                                  iterator result);
     void reallocate_map_at_front(size_type need);
     void reallocate_map_at_back(size_type need);
 };
 
-template <class T>
-deque<T>& deque<T>::operator=(const deque& rhs) {
+template <class T, class Alloc, size_t BufSize>
+constexpr typename deque<T, Alloc, BufSize>::size_type
+    deque<T, Alloc, BufSize>::buffer_size;
+
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>::deque(deque&& rhs, const allocator_type& alloc)
+    : alloc_base(data_allocator(alloc)), spare_(), spare_count_(0) {
+    if (mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        map_ = rhs.map_;
+        map_size_ = rhs.map_size_;
+        rhs.reset_moved_from();
+        take_spares(rhs);
+    } else {
+        map_init(0);
+        for (auto it = rhs.begin_; it != rhs.end_; ++it) {
+            emplace_back(mystl::move(*it));
+        }
+    }
+}
+
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>& deque<T, Alloc, BufSize>::operator=(
+    const deque& rhs) {
     if (this != &rhs) {
-        const auto len = size();
-        if (len >= rhs.size()) {
-            erase(mystl::copy(rhs.begin_, rhs.end_, begin_), end_);
-        } else {
-            iterator mid = rhs.begin() + static_cast<difference_type>(len);
-            mystl::copy(rhs.begin_, mid, begin_);
-            insert(end_, mid, rhs.end_);
+        if (data_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            // buffers of the old allocator go back to it first
+            release_storage();
+            mystl::alloc_on_copy(data_alloc(), rhs.data_alloc());
+            map_init(0);
         }
+        copy_assign(rhs.begin_, rhs.end_, mystl::forward_iterator_tag());
     }
     return *this;
 }
 
-template <class T>
-deque<T>& deque<T>::operator=(deque&& rhs) {
-    clear();
-    begin_ = mystl::move(rhs.begin_);
-    end_ = mystl::move(rhs.end_);
-    map_ = rhs.map_;
-    map_size_ = rhs.map_size_;
-    rhs.map_ = nullptr;
-    rhs.map_size_ = 0;
+template <class T, class Alloc, size_t BufSize>
+deque<T, Alloc, BufSize>& deque<T, Alloc, BufSize>::operator=(deque&& rhs) {
+    if (this != &rhs) {
+        if (data_traits::propagate_on_container_move_assignment::value ||
+            mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            release_storage();
+            mystl::alloc_on_move(data_alloc(), rhs.data_alloc());
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            map_ = rhs.map_;
+            map_size_ = rhs.map_size_;
+            rhs.reset_moved_from();
+            take_spares(rhs);
+        } else {
+            clear();
+            for (auto it = rhs.begin_; it != rhs.end_; ++it) {
+                emplace_back(mystl::move(*it));
+            }
+            rhs.clear();
+        }
+    }
     return *this;
 }
 
-template <class T>
-void deque<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::resize(size_type new_size,
+                                      const value_type& value) {
     const auto len = size();
     if (new_size < len) {
         erase(begin_ + new_size, end_);
@@ -460,32 +778,37 @@ void deque<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
-template <class T>
-void deque<T>::shrink_to_fit() noexcept {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::shrink_to_fit() noexcept {
+    if (map_ == nullptr) {
+        release_spares();
+        return;
+    }
     // 至少会留下头部缓冲区
     for (auto cur = map_; cur < begin_.node; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
+        deallocate_buffer(*cur);
         *cur = nullptr;
     }
     for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
-        data_allocator::deallocate(*cur, buffer_size);
+        deallocate_buffer(*cur);
         *cur = nullptr;
     }
+    release_spares();
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-void deque<T>::emplace_front(Args&&... args) {
+void deque<T, Alloc, BufSize>::emplace_front(Args&&... args) {
     if (begin_.cur != begin_.first) {
-        data_allocator::construct(begin_.cur - 1,
-                                  mystl::forward<Args>(args)...);
+        data_traits::construct(data_alloc(), begin_.cur - 1,
+                               mystl::forward<Args>(args)...);
         --begin_.cur;
     } else {
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator::construct(begin_.cur,
-                                      mystl::forward<Args>(args)...);
+            data_traits::construct(data_alloc(), begin_.cur,
+                                   mystl::forward<Args>(args)...);
         } catch (...) {
             ++begin_;
             throw;
@@ -493,22 +816,25 @@ void deque<T>::emplace_front(Args&&... args) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-void deque<T>::emplace_back(Args&&... args) {
-    if (end_.cur != end_.last - 1) {
-        data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+void deque<T, Alloc, BufSize>::emplace_back(Args&&... args) {
+    if (end_.last - end_.cur > 1) {
+        data_traits::construct(data_alloc(), end_.cur,
+                               mystl::forward<Args>(args)...);
         ++end_.cur;
     } else {
         require_capacity(1, false);
-        data_allocator::construct(end_.cur, mystl::forward<Args>(args)...);
+        data_traits::construct(data_alloc(), end_.cur,
+                               mystl::forward<Args>(args)...);
         ++end_;
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&&... args) {
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::emplace(
+    iterator pos, Args&&... args) {
     if (pos.cur == begin_.cur) {
         emplace_front(mystl::forward<Args>(args)...);
         return begin_;
@@ -519,16 +845,16 @@ typename deque<T>::iterator deque<T>::emplace(iterator pos, Args&&... args) {
     return insert_aux(pos, mystl::forward<Args>(args)...);
 }
 
-template <class T>
-void deque<T>::push_front(const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_front(const value_type& value) {
     if (begin_.cur != begin_.first) {
-        data_allocator::construct(begin_.cur - 1, value);
+        data_traits::construct(data_alloc(), begin_.cur - 1, value);
         --begin_.cur;
     } else {
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator::construct(begin_.cur, value);
+            data_traits::construct(data_alloc(), begin_.cur, value);
         } catch (...) {
             ++begin_;
             throw;
@@ -536,47 +862,47 @@ void deque<T>::push_front(const value_type& value) {
     }
 }
 
-template <class T>
-void deque<T>::push_back(const value_type& value) {
-    if (end_.cur != end_.last - 1) {
-        data_allocator::construct(end_.cur, value);
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::push_back(const value_type& value) {
+    if (end_.last - end_.cur > 1) {
+        data_traits::construct(data_alloc(), end_.cur, value);
         ++end_.cur;
     } else {
         require_capacity(1, false);
-        data_allocator::construct(end_.cur, value);
+        data_traits::construct(data_alloc(), end_.cur, value);
         ++end_;
     }
 }
 
-template <class T>
-void deque<T>::pop_front() {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::pop_front() {
     MYSTL_DEBUG(!empty());
     if (begin_.cur != begin_.last - 1) {
-        data_allocator::destroy(begin_.cur);
+        data_traits::destroy(data_alloc(), begin_.cur);
         ++begin_.cur;
     } else {
-        data_allocator::destroy(begin_.cur);
+        data_traits::destroy(data_alloc(), begin_.cur);
         ++begin_;
         destroy_buffer(begin_.node - 1, begin_.node - 1);
     }
 }
 
-template <class T>
-void deque<T>::pop_back() {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::pop_back() {
     MYSTL_DEBUG(!empty());
     if (end_.cur != end_.first) {
         --end_.cur;
-        data_allocator::destroy(end_.cur);
+        data_traits::destroy(data_alloc(), end_.cur);
     } else {
         --end_;
-        data_allocator::destroy(end_.cur);
+        data_traits::destroy(data_alloc(), end_.cur);
         destroy_buffer(end_.node + 1, end_.node + 1);
     }
 }
 
-template <class T>
-typename deque<T>::iterator deque<T>::insert(iterator position,
-                                             const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::insert(
+    iterator position, const value_type& value) {
     if (position.cur == begin_.cur) {
         push_front(value);
         return begin_;
@@ -590,9 +916,9 @@ typename deque<T>::iterator deque<T>::insert(iterator position,
     }
 }
 
-template <class T>
-typename deque<T>::iterator deque<T>::insert(iterator position,
-                                             value_type&& value) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::insert(
+    iterator position, value_type&& value) {
     if (position.cur == begin_.cur) {
         emplace_front(mystl::move(value));
         return begin_;
@@ -606,131 +932,183 @@ typename deque<T>::iterator deque<T>::insert(iterator position,
     }
 }
 
-template <class T>
-void deque<T>::insert(iterator position, size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::insert(iterator position, size_type n,
+                                      const value_type& value) {
+    if (n == 0) {
+        return;
+    }
     if (position.cur == begin_.cur) {
         require_capacity(n, true);
         auto new_begin = begin_ - n;
-        mystl::uninitialized_fill_n(new_begin, n, value);
+        try {
+            mystl::uninitialized_fill_n(new_begin, n, value);
+        } catch (...) {
+            if (new_begin.node != begin_.node)
+                destroy_buffer(new_begin.node, begin_.node - 1);
+            throw;
+        }
         begin_ = new_begin;
     } else if (position.cur == end_.cur) {
         require_capacity(n, false);
         auto new_end = end_ + n;
-        mystl::uninitialized_fill_n(end_, n, value);
+        try {
+            mystl::uninitialized_fill_n(end_, n, value);
+        } catch (...) {
+            if (new_end.node != end_.node)
+                destroy_buffer(end_.node + 1, new_end.node);
+            throw;
+        }
         end_ = new_end;
     } else {
         fill_insert(position, n, value);
     }
 }
 
-template <class T>
-typename deque<T>::iterator deque<T>::erase(iterator position) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::erase(
+    iterator position) {
     auto next = position;
     ++next;
     const size_type elems_before = position - begin_;
+    if (mystl::is_trivially_relocatable<T>::value) {
+        return erase(position, next);
+    }
     if (elems_before < (size() / 2)) {
-        mystl::copy_backward(begin_, position, next);
+        mystl::move_backward(begin_, position, next);
         pop_front();
     } else {
-        mystl::copy(next, end_, position);
+        mystl::move(next, end_, position);
         pop_back();
     }
     return begin_ + elems_before;
 }
 
-template <class T>
-typename deque<T>::iterator deque<T>::erase(iterator first, iterator last) {
-    if (first == begin_ && last == end_) {
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::iterator deque<T, Alloc, BufSize>::erase(
+    iterator first, iterator last) {
+    if (first == last) {
+        return first;
+    } else if (first == begin_ && last == end_) {
         clear();
         return end_;
     } else {
         const size_type len = last - first;
         const size_type elems_before = first - begin_;
+        const bool relocate = mystl::is_trivially_relocatable<T>::value;
+        if (relocate) {
+            // the erased slots become raw memory, the shift below is bitwise
+            mystl::destroy(first, last);
+        }
         if (elems_before < ((size() - len) / 2)) {
-            mystl::copy_backward(begin_, first, last);
             auto new_begin = begin_ + len;
-            data_allocator::destroy(begin_.cur, new_begin.cur);
+            if (relocate) {
+                relocate_backward(begin_, first, last);
+            } else {
+                mystl::move_backward(begin_, first, last);
+                mystl::destroy(begin_, new_begin);
+            }
+            if (begin_.node != new_begin.node)
+                destroy_buffer(begin_.node, new_begin.node - 1);
             begin_ = new_begin;
         } else {
-            mystl::copy(last, end_, first);
             auto new_end = end_ - len;
-            data_allocator::destroy(new_end.cur, end_.cur);
+            if (relocate) {
+                relocate_forward(last, end_, first);
+            } else {
+                mystl::move(last, end_, first);
+                mystl::destroy(new_end, end_);
+            }
+            if (new_end.node != end_.node)
+                destroy_buffer(new_end.node + 1, end_.node);
             end_ = new_end;
         }
         return begin_ + elems_before;
     }
 }
 
-template <class T>
-void deque<T>::clear() {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::clear() {
     for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur) {
-        data_allocator::destroy(*cur, *cur + buffer_size);
+        mystl::destroy(*cur, *cur + buffer_size);
     }
     if (begin_.node != end_.node) {
         mystl::destroy(begin_.cur, begin_.last);
         mystl::destroy(end_.first, end_.cur);
+        // keep only the head buffer
+        destroy_buffer(begin_.node + 1, end_.node);
     } else {
         mystl::destroy(begin_.cur, end_.cur);
     }
-    shrink_to_fit();
     end_ = begin_;
 }
 
-template <class T>
-void deque<T>::swap(deque& rhs) noexcept {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::swap(deque& rhs) noexcept {
     if (this != &rhs) {
+        mystl::alloc_on_swap(data_alloc(), rhs.data_alloc());
         mystl::swap(begin_, rhs.begin_);
         mystl::swap(end_, rhs.end_);
         mystl::swap(map_, rhs.map_);
         mystl::swap(map_size_, rhs.map_size_);
+        for (size_type i = 0; i < DEQUE_SPARE_BLOCKS; ++i) {
+            mystl::swap(spare_[i], rhs.spare_[i]);
+        }
+        mystl::swap(spare_count_, rhs.spare_count_);
     }
 }
 
 // helper functions
 
-template <class T>
-typename deque<T>::map_pointer deque<T>::create_map(size_type size) {
-    map_pointer mp = nullptr;
-    mp = map_allocator::allocate(size);
+// size is raised to the number of node pointers the allocator really handed
+// out, the spare ones only delay the next map reallocation
+template <class T, class Alloc, size_t BufSize>
+typename deque<T, Alloc, BufSize>::map_pointer
+deque<T, Alloc, BufSize>::create_map(size_type& size) {
+    map_allocator alloc(data_alloc());
+    auto r = map_traits::allocate_at_least(alloc, size);
+    map_pointer mp = r.ptr;
+    size = r.count;
     for (size_type i = 0; i < size; ++i) {
         *(mp + i) = nullptr;
     }
     return mp;
 }
 
-template <class T>
-void deque<T>::create_buffer(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::create_buffer(map_pointer nstart,
+                                             map_pointer nfinish) {
     map_pointer cur;
     try {
         for (cur = nstart; cur <= nfinish; ++cur) {
-            *cur = data_allocator::allocate(buffer_size);
+            *cur = allocate_buffer();
         }
     } catch (...) {
         while (cur != nstart) {
             --cur;
-            data_allocator::deallocate(*cur, buffer_size);
+            deallocate_buffer(*cur);
             *cur = nullptr;
         }
         throw;
     }
 }
 
-template <class T>
-void deque<T>::
-destroy_buffer(map_pointer nstart, map_pointer nfinish) {
-    for (map_pointer n = nstart, map_pointer nfinish) {
-        data_allocator::deallocate(*n, buffer_size);
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::destroy_buffer(map_pointer nstart,
+                                              map_pointer nfinish) {
+    for (map_pointer n = nstart; n <= nfinish; ++n) {
+        deallocate_buffer(*n);
         *n = nullptr;
     }
 }
 
-template <class T>
-void deque<T>::
-map_init(size_type nElem) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::map_init(size_type nElem) {
     const size_type nNode = nElem / buffer_size + 1;
-    map_size_ = mystl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE), nNode + 2);
+    map_size_ = mystl::max(static_cast<size_type>(DEQUE_MAP_INIT_SIZE),
+                           nNode + 2);
     try {
-        map_ = create_map(map_size);
+        map_ = create_map(map_size_);
     } catch (...) {
         map_ = nullptr;
         map_size_ = 0;
@@ -742,7 +1120,7 @@ map_init(size_type nElem) {
     try {
         create_buffer(nstart, nfinish);
     } catch (...) {
-        map_allocator::deallocate(map_, map_size_);
+        deallocate_map(map_, map_size_);
         map_ = nullptr;
         map_size_ = 0;
         throw;
@@ -753,43 +1131,45 @@ map_init(size_type nElem) {
     end_.cur = end_.first + (nElem % buffer_size);
 }
 
-template <class T>
-void deque<T>::fill_init(size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::fill_init(size_type n, const value_type& value) {
     map_init(n);
     if (n != 0) {
         for (auto cur = begin_.node; cur < end_.node; ++cur) {
-            mystl::uninitailized_fill(*cur, *cur + buffer_size, value);
+            mystl::uninitialized_fill(*cur, *cur + buffer_size, value);
         }
-        mystl::uninitailized_fill(end_.first, end_.cur, value);
+        mystl::uninitialized_fill(end_.first, end_.cur, value);
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class IIter>
-void deque<T>::copy_init(IIter first, IIter last, input_iterator_tag) {
-    const size_type n = mystl::distance(first, last);
-    map_init(n);
-    for (;first != last; ++first) {
+void deque<T, Alloc, BufSize>::copy_init(IIter first, IIter last,
+                                         input_iterator_tag) {
+    map_init(0);
+    for (; first != last; ++first) {
         emplace_back(*first);
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::copy_init(FIter first, FIter last, forward_iterator_tag) {
+void deque<T, Alloc, BufSize>::copy_init(FIter first, FIter last,
+                                         forward_iterator_tag) {
     const size_type n = mystl::distance(first, last);
     map_init(n);
     for (auto cur = begin_.node; cur < end_.node; ++cur) {
         auto next = first;
         mystl::advance(next, buffer_size);
-        mystl::uninitailized_copy(first, next, *cur);
+        mystl::uninitialized_copy(first, next, *cur);
         first = next;
     }
     mystl::uninitialized_copy(first, last, end_.first);
 }
 
-template <class T>
-void deque<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::fill_assign(size_type n,
+                                           const value_type& value) {
     if (n > size()) {
         mystl::fill(begin(), end(), value);
         insert(end(), n - size(), value);
@@ -799,9 +1179,10 @@ void deque<T>::fill_assign(size_type n, const value_type& value) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class IIter>
-void deque<T>::copy_assign(IIter first, IIter last, input_iterator_tag) {
+void deque<T, Alloc, BufSize>::copy_assign(IIter first, IIter last,
+                                           input_iterator_tag) {
     auto first1 = begin();
     auto last1 = end();
     for (; first != last && first1 != last1; ++first, ++first1) {
@@ -814,9 +1195,10 @@ void deque<T>::copy_assign(IIter first, IIter last, input_iterator_tag) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
+void deque<T, Alloc, BufSize>::copy_assign(FIter first, FIter last,
+                                           forward_iterator_tag) {
     const size_type len1 = size();
     const size_type len2 = mystl::distance(first, last);
     if (len1 < len2) {
@@ -829,14 +1211,51 @@ void deque<T>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class... Args>
-typename deque<T>::iterator deque<T>::insert_aux(iterator position,
-                                                 Args&&... args) {
+typename deque<T, Alloc, BufSize>::iterator
+deque<T, Alloc, BufSize>::insert_aux(iterator position, Args&&... args) {
     const size_type elems_before = position - begin_;
     value_type value_copy = value_type(mystl::forward<Args>(args)...);
+    if (mystl::is_trivially_relocatable<T>::value) {
+        // shift the shorter side by one slot with memmove and construct the
+        // value in the hole
+        if (elems_before < (size() / 2)) {
+            if (begin_.cur == begin_.first) {
+                require_capacity(1, true);
+            }
+            position = begin_ + elems_before;
+            relocate_forward(begin_, position, begin_ - 1);
+            --begin_;
+            --position;
+            try {
+                data_traits::construct(data_alloc(), position.cur,
+                                       mystl::move(value_copy));
+            } catch (...) {
+                relocate_backward(begin_, position, position + 1);
+                ++begin_;
+                throw;
+            }
+        } else {
+            if (end_.cur == end_.last - 1) {
+                require_capacity(1, false);
+            }
+            position = begin_ + elems_before;
+            relocate_backward(position, end_, end_ + 1);
+            ++end_;
+            try {
+                data_traits::construct(data_alloc(), position.cur,
+                                       mystl::move(value_copy));
+            } catch (...) {
+                relocate_forward(position + 1, end_, position);
+                --end_;
+                throw;
+            }
+        }
+        return position;
+    }
     if (elems_before < (size() / 2)) {  // 在前半段插入
-        emplace_front(front());
+        emplace_front(mystl::move(front()));
         auto front1 = begin_;
         ++front1;
         auto front2 = front1;
@@ -844,23 +1263,23 @@ typename deque<T>::iterator deque<T>::insert_aux(iterator position,
         position = begin_ + elems_before;
         auto pos = position;
         ++pos;
-        mystl::copy(front2, pos, front1);
+        mystl::move(front2, pos, front1);
     } else {  // 在后半段插入
-        emplace_back(back());
+        emplace_back(mystl::move(back()));
         auto back1 = end_;
         --back1;
         auto back2 = back1;
         --back2;
         position = begin_ + elems_before;
-        mystl::copy_backward(position, back2, back1);
+        mystl::move_backward(position, back2, back1);
     }
     *position = mystl::move(value_copy);
     return position;
 }
 
-template <class T>
-void deque<T>::fill_insert(iterator position, size_type n,
-                           const value_type& value) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::fill_insert(iterator position, size_type n,
+                                           const value_type& value) {
     const size_type elems_before = position - begin_;
     const size_type len = size();
     auto value_copy = value;
@@ -915,10 +1334,10 @@ void deque<T>::fill_insert(iterator position, size_type n,
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::copy_insert(iterator position, FIter first, FIter last,
-                           size_type n) {
+void deque<T, Alloc, BufSize>::copy_insert(iterator position, FIter first,
+                                           FIter last, size_type n) {
     const size_type elems_before = position - begin_;
     auto len = size();
     if (elems_before < (len / 2)) {
@@ -976,30 +1395,24 @@ void deque<T>::copy_insert(iterator position, FIter first, FIter last,
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class IIter>
-void deque<T>::insert_dispatch(iterator position, IIter first, IIter last,
-                               input_iterator_tag) {
-    if (last <= first) return;
-    const size_type n = mystl::distance(first, last);
+void deque<T, Alloc, BufSize>::insert_dispatch(iterator position, IIter first,
+                                               IIter last,
+                                               input_iterator_tag) {
+    // the length is unknown up front, insert one by one
     const size_type elems_before = position - begin_;
-    if (elems_before < (size() / 2)) {
-        require_capacity(n, true);
-    } else {
-        require_capacity(n, false);
-    }
-    position = begin_ + elems_before;
-    auto cur = --last;
-    for (size_type i = 0; i < n; ++i, --cur) {
-        insert(position, *cur);
+    for (size_type i = elems_before; first != last; ++first, ++i) {
+        insert(begin_ + i, *first);
     }
 }
 
-template <class T>
+template <class T, class Alloc, size_t BufSize>
 template <class FIter>
-void deque<T>::insert_dispatch(iterator position, FIter first, FIter last,
-                               forward_iterator_tag) {
-    if (last <= first) return;
+void deque<T, Alloc, BufSize>::insert_dispatch(iterator position, FIter first,
+                                               FIter last,
+                                               forward_iterator_tag) {
+    if (first == last) return;
     const size_type n = mystl::distance(first, last);
     if (position.cur == begin_.cur) {
         require_capacity(n, true);
@@ -1028,11 +1441,14 @@ void deque<T>::insert_dispatch(iterator position, FIter first, FIter last,
     }
 }
 
-template <class T>
-void deque<T>::require_capacity(size_type n, bool front) {
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::require_capacity(size_type n, bool front) {
+    if (map_ == nullptr) {
+        map_init(0);
+    }
     if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n)) {
         const size_type need_buffer =
-            (n - (begin_.cur - begin_.first)) / buffer_size + 1;
+            (n - (begin_.cur - begin_.first) + buffer_size - 1) / buffer_size;
         if (need_buffer > static_cast<size_type>(begin_.node - map_)) {
             reallocate_map_at_front(need_buffer);
             return;
@@ -1041,7 +1457,7 @@ void deque<T>::require_capacity(size_type n, bool front) {
     } else if (!front &&
                (static_cast<size_type>(end_.last - end_.cur - 1) < n)) {
         const size_type need_buffer =
-            (n - (end_.last - end_.cur - 1)) / buffer_size + 1;
+            (n - (end_.last - end_.cur - 1) + buffer_size - 1) / buffer_size;
         if (need_buffer >
             static_cast<size_type>((map_ + map_size_) - end_.node - 1)) {
             reallocate_map_at_back(need_buffer);
@@ -1051,9 +1467,58 @@ void deque<T>::require_capacity(size_type n, bool front) {
     }
 }
 
-template <class T>
-void deque<T>::reallocate_map_at_front(size_type need_buffer) {
-    const size_type new_map_size = mystl::max(
+// bitwise move of [first, last) to result, one memmove per run that is
+// contiguous in both source and destination; result may overlap the source
+// from below. Only for trivially relocatable elements.
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::relocate_forward(iterator first,
+                                                iterator last,
+                                                iterator result) {
+    size_type n = last - first;
+    while (n > 0) {
+        const size_type run = mystl::min(
+            n, static_cast<size_type>(mystl::min(first.last - first.cur,
+                                                 result.last - result.cur)));
+        std::memmove(static_cast<void*>(result.cur),
+                     static_cast<const void*>(first.cur), run * sizeof(T));
+        first += run;
+        result += run;
+        n -= run;
+    }
+}
+
+// the same towards higher addresses: [first, last) ends up just before
+// result, moving from the back so the source may overlap from above
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::relocate_backward(iterator first,
+                                                 iterator last,
+                                                 iterator result) {
+    size_type n = last - first;
+    while (n > 0) {
+        pointer src = last.cur;
+        pointer dst = result.cur;
+        size_type src_run = last.cur - last.first;
+        size_type dst_run = result.cur - result.first;
+        if (src_run == 0) {
+            src = *(last.node - 1) + buffer_size;
+            src_run = buffer_size;
+        }
+        if (dst_run == 0) {
+            dst = *(result.node - 1) + buffer_size;
+            dst_run = buffer_size;
+        }
+        const size_type run = mystl::min(n, mystl::min(src_run, dst_run));
+        std::memmove(static_cast<void*>(dst - run),
+                     static_cast<const void*>(src - run), run * sizeof(T));
+        last -= run;
+        result -= run;
+        n -= run;
+    }
+}
+
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::reallocate_map_at_front(size_type need_buffer) {
+    size_type new_map_size = mystl::max(
         map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
     map_pointer new_map = create_map(new_map_size);
     const size_type old_buffer = end_.node - begin_.node + 1;
@@ -1062,21 +1527,24 @@ void deque<T>::reallocate_map_at_front(size_type need_buffer) {
     auto begin = new_map + (new_map_size - new_buffer) / 2;
     auto mid = begin + need_buffer;
     auto end = mid + old_buffer;
-    create_buffer(begin, mid - 1);
-    for (auto begin1 = mid, begin2 = begin_.node; begin1 != end;
-         ++begin1, ++begin2)
-        *begin1 = *begin2;
+    try {
+        create_buffer(begin, mid - 1);
+    } catch (...) {
+        deallocate_map(new_map, new_map_size);
+        throw;
+    }
+    std::memcpy(mid, begin_.node, old_buffer * sizeof(*mid));
 
-    map_allocator::deallocate(map_, map_size_);
+    deallocate_map(map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*mid + (begin_.cur - begin_.first), mid);
     end_ = iterator(*(end - 1) + (end_.cur - end_.first), end - 1);
 }
 
-template <class T>
-void deque<T>::reallocate_map_at_back(size_type need_buffer) {
-    const size_type new_map_size = mystl::max(
+template <class T, class Alloc, size_t BufSize>
+void deque<T, Alloc, BufSize>::reallocate_map_at_back(size_type need_buffer) {
+    size_type new_map_size = mystl::max(
         map_size_ << 1, map_size_ + need_buffer + DEQUE_MAP_INIT_SIZE);
     map_pointer new_map = create_map(new_map_size);
     const size_type old_buffer = end_.node - begin_.node + 1;
@@ -1085,55 +1553,73 @@ void deque<T>::reallocate_map_at_back(size_type need_buffer) {
     auto begin = new_map + ((new_map_size - new_buffer) / 2);
     auto mid = begin + old_buffer;
     auto end = mid + need_buffer;
-    for (auto begin1 = begin, begin2 = begin_.node; begin1 != mid;
-         ++begin1, ++begin2)
-        *begin1 = *begin2;
-    create_buffer(mid, end - 1);
+    try {
+        create_buffer(mid, end - 1);
+    } catch (...) {
+        deallocate_map(new_map, new_map_size);
+        throw;
+    }
+    std::memcpy(begin, begin_.node, old_buffer * sizeof(*begin));
 
-    map_allocator::deallocate(map_, map_size_);
+    deallocate_map(map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
     begin_ = iterator(*begin + (begin_.cur - begin_.first), begin);
     end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
 }
 
-template <class T>
-bool operator==(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator==(const deque<T, Alloc, BufSize>& lhs,
+                const deque<T, Alloc, BufSize>& rhs) {
     return lhs.size() == rhs.size() &&
            mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator<(const deque<T, Alloc, BufSize>& lhs,
+               const deque<T, Alloc, BufSize>& rhs) {
     return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
                                           rhs.end());
 }
 
-template <class T>
-bool operator!=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator!=(const deque<T, Alloc, BufSize>& lhs,
+                const deque<T, Alloc, BufSize>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator>(const deque<T, Alloc, BufSize>& lhs,
+               const deque<T, Alloc, BufSize>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator<=(const deque<T, Alloc, BufSize>& lhs,
+                const deque<T, Alloc, BufSize>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+bool operator>=(const deque<T, Alloc, BufSize>& lhs,
+                const deque<T, Alloc, BufSize>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class T>
-void swap(deque<T>& lhs, deque<T>& rhs) {
+template <class T, class Alloc, size_t BufSize>
+void swap(deque<T, Alloc, BufSize>& lhs, deque<T, Alloc, BufSize>& rhs) {
     lhs.swap(rhs);
 }
 
+// the map and the buffers live on the heap, nothing points into the deque
+template <class T, class Alloc, size_t BufSize>
+struct is_trivially_relocatable<deque<T, Alloc, BufSize>>
+    : is_trivially_relocatable<Alloc> {};
+
+// deque whose blocks each start at an Align boundary, a cache line by default
+template <class T, size_t Align = cache_line_size>
+using aligned_deque = deque<T, aligned_allocator<T, Align>>;
+
 }  // namespace mystl
 
-#endif
\ No newline at end of file
+#endif
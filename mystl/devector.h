@@ -0,0 +1,792 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_DEVECTOR_H_
+#define MYSTL_DEVECTOR_H_
+
+// devector<T>: a vector with free room at both ends of one contiguous
+// buffer, so push_front and push_back are both amortized O(1) while
+// iterators stay plain pointers and data() is the whole sequence.
+// When one end runs out of room, a buffer at most half full is recentred in
+// place (memmove for trivially relocatable T); a fuller one is reallocated
+// with the elements recentred in the new buffer. Erase and insert shift the
+// shorter side.
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "util.h"
+
+namespace mystl {
+
+// template class: devector
+template <class T, class Alloc = mystl::allocator<T>>
+class devector
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>> {
+   public:
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>
+        data_allocator;
+    typedef mystl::allocator_traits<data_allocator> data_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename data_traits::size_type size_type;
+    typedef typename data_traits::difference_type difference_type;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    allocator_type get_allocator() const {
+        return allocator_type(data_alloc());
+    }
+
+   private:
+    typedef mystl::alloc_storage<data_allocator> alloc_base;
+
+    pointer buf_;  // the buffer is [buf_, cap_)
+    iterator begin_;
+    iterator end_;
+    pointer cap_;
+
+    data_allocator& data_alloc() noexcept { return alloc_base::get_alloc(); }
+    const data_allocator& data_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
+   public:
+    // construct and deconstruct functions
+    devector() noexcept
+        : buf_(nullptr), begin_(nullptr), end_(nullptr), cap_(nullptr) {}
+
+    explicit devector(const allocator_type& alloc) noexcept
+        : alloc_base(data_allocator(alloc)),
+          buf_(nullptr),
+          begin_(nullptr),
+          end_(nullptr),
+          cap_(nullptr) {}
+
+    explicit devector(size_type n,
+                      const allocator_type& alloc = allocator_type())
+        : devector(alloc) {
+        resize(n);
+    }
+
+    devector(size_type n, const value_type& value,
+             const allocator_type& alloc = allocator_type())
+        : devector(alloc) {
+        assign(n, value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    devector(Iter first, Iter last,
+             const allocator_type& alloc = allocator_type())
+        : devector(alloc) {
+        assign(first, last);
+    }
+
+    devector(const devector& rhs)
+        : devector(allocator_type(
+              data_traits::select_on_container_copy_construction(
+                  rhs.data_alloc()))) {
+        assign(rhs.begin_, rhs.end_);
+    }
+
+    devector(const devector& rhs, const allocator_type& alloc)
+        : devector(alloc) {
+        assign(rhs.begin_, rhs.end_);
+    }
+
+    devector(devector&& rhs) noexcept
+        : alloc_base(mystl::move(rhs.data_alloc())),
+          buf_(rhs.buf_),
+          begin_(rhs.begin_),
+          end_(rhs.end_),
+          cap_(rhs.cap_) {
+        rhs.reset();
+    }
+
+    devector(devector&& rhs, const allocator_type& alloc) : devector(alloc) {
+        if (mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            swap_data(rhs);
+        } else {
+            move_from(rhs);
+        }
+    }
+
+    devector(std::initializer_list<value_type> ilist,
+             const allocator_type& alloc = allocator_type())
+        : devector(alloc) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    devector& operator=(const devector& rhs);
+    devector& operator=(devector&& rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value);
+    devector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~devector() {
+        mystl::destroy(begin_, end_);
+        free_buffer();
+    }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return begin_; }
+
+    const_iterator begin() const noexcept { return begin_; }
+
+    iterator end() noexcept { return end_; }
+
+    const_iterator end() const noexcept { return end_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return begin_ == end_; }
+
+    size_type size() const noexcept {
+        return static_cast<size_type>(end_ - begin_);
+    }
+
+    size_type max_size() const noexcept {
+        return data_traits::max_size(data_alloc());
+    }
+
+    // the whole buffer, and the free room in front of and behind the elements
+    size_type capacity() const noexcept {
+        return static_cast<size_type>(cap_ - buf_);
+    }
+
+    size_type front_free() const noexcept {
+        return static_cast<size_type>(begin_ - buf_);
+    }
+
+    size_type back_free() const noexcept {
+        return static_cast<size_type>(cap_ - end_);
+    }
+
+    void reserve(size_type n) {
+        if (capacity() < n) {
+            THROW_LENGTH_ERROR_IF(n > max_size(),
+                                  "devector<T>'s size too big");
+            relocate(n, (n - size()) / 2);
+        }
+    }
+
+    // room for n more elements at one end without reallocating
+    void reserve_front(size_type n) {
+        if (front_free() < n) {
+            check_size(n);
+            relocate(n + size() + back_free(), n);
+        }
+    }
+
+    void reserve_back(size_type n) {
+        if (back_free() < n) {
+            check_size(n);
+            relocate(front_free() + size() + n, front_free());
+        }
+    }
+
+    void shrink_to_fit();
+
+    // funciont about element visiting
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "devector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "devector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    pointer data() noexcept { return begin_; }
+
+    const_pointer data() const noexcept { return begin_; }
+
+    // function about modifying container
+    void assign(size_type n, const value_type& value);
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void assign(Iter first, Iter last) {
+        assign_aux(first, last, iterator_category(first));
+    }
+
+    void assign(std::initializer_list<value_type> il) {
+        assign(il.begin(), il.end());
+    }
+
+    template <class... Args>
+    void emplace_front(Args&&... args);
+    template <class... Args>
+    void emplace_back(Args&&... args);
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    void push_front(const value_type& value) { emplace_front(value); }
+    void push_front(value_type&& value) { emplace_front(mystl::move(value)); }
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+    void pop_front() {
+        MYSTL_DEBUG(!empty());
+        data_traits::destroy(data_alloc(), begin_);
+        ++begin_;
+        recentre_if_empty();
+    }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --end_;
+        data_traits::destroy(data_alloc(), end_);
+        recentre_if_empty();
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return insert_aux(begin_ + (pos - begin()), first, last,
+                          iterator_category(first));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+        return insert(pos, il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos >= begin() && pos < end());
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear() noexcept {
+        mystl::destroy(begin_, end_);
+        end_ = begin_;
+        recentre_if_empty();
+    }
+
+    void resize(size_type new_size) { return resize(new_size, value_type()); }
+
+    void resize(size_type new_size, const value_type& value);
+
+    void swap(devector& rhs) noexcept {
+        if (this != &rhs) {
+            mystl::alloc_on_swap(data_alloc(), rhs.data_alloc());
+            swap_data(rhs);
+        }
+    }
+
+   private:
+    // helper functions
+    void reset() noexcept { buf_ = begin_ = end_ = cap_ = nullptr; }
+
+    void swap_data(devector& rhs) noexcept {
+        mystl::swap(buf_, rhs.buf_);
+        mystl::swap(begin_, rhs.begin_);
+        mystl::swap(end_, rhs.end_);
+        mystl::swap(cap_, rhs.cap_);
+    }
+
+    void free_buffer() noexcept {
+        if (buf_ != nullptr) {
+            data_traits::deallocate(data_alloc(), buf_, capacity());
+        }
+    }
+
+    // an empty devector starts again from the middle of its buffer
+    void recentre_if_empty() noexcept {
+        if (begin_ == end_) {
+            begin_ = end_ = buf_ + capacity() / 2;
+        }
+    }
+
+    // element-wise move for allocators that can't take over the buffer
+    void move_from(devector& rhs) {
+        clear();
+        reserve(rhs.size());
+        begin_ = end_ = buf_ + (capacity() - rhs.size()) / 2;
+        end_ = mystl::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+        rhs.clear();
+    }
+
+    void check_size(size_type n) const {
+        THROW_LENGTH_ERROR_IF(n > max_size() - size(),
+                              "devector<T>'s size too big");
+    }
+
+    size_type get_new_cap(size_type add_size) const;
+    void relocate(size_type new_cap, size_type front);
+    void make_room_front(size_type n);
+    void make_room_back(size_type n);
+
+    template <class IIter>
+    void assign_aux(IIter first, IIter last, input_iterator_tag);
+    template <class FIter>
+    void assign_aux(FIter first, FIter last, forward_iterator_tag);
+    template <class IIter>
+    iterator insert_aux(iterator pos, IIter first, IIter last,
+                        input_iterator_tag);
+    template <class FIter>
+    iterator insert_aux(iterator pos, FIter first, FIter last,
+                        forward_iterator_tag);
+};
+
+template <class T, class Alloc>
+devector<T, Alloc>& devector<T, Alloc>::operator=(const devector& rhs) {
+    if (this != &rhs) {
+        if (data_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            // memory of the old allocator can't outlive it
+            clear();
+            free_buffer();
+            reset();
+        }
+        mystl::alloc_on_copy(data_alloc(), rhs.data_alloc());
+        assign(rhs.begin_, rhs.end_);
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+devector<T, Alloc>& devector<T, Alloc>::operator=(devector&& rhs) noexcept(
+    data_traits::propagate_on_container_move_assignment::value ||
+    data_traits::is_always_equal::value) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if (data_traits::propagate_on_container_move_assignment::value ||
+        mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+        clear();
+        free_buffer();
+        reset();
+        mystl::alloc_on_move(data_alloc(), rhs.data_alloc());
+        swap_data(rhs);
+    } else {
+        move_from(rhs);
+    }
+    return *this;
+}
+
+template <class T, class Alloc>
+void devector<T, Alloc>::shrink_to_fit() {
+    if (capacity() == size()) {
+        return;
+    }
+    if (empty()) {
+        free_buffer();
+        reset();
+        return;
+    }
+    relocate(size(), 0);
+}
+
+template <class T, class Alloc>
+void devector<T, Alloc>::assign(size_type n, const value_type& value) {
+    const value_type copy = value;
+    clear();
+    if (capacity() < n) {
+        free_buffer();
+        reset();
+        relocate(n, 0);
+    }
+    begin_ = end_ = buf_ + (capacity() - n) / 2;
+    end_ = mystl::uninitialized_fill_n(begin_, n, copy);
+}
+
+template <class T, class Alloc>
+template <class... Args>
+void devector<T, Alloc>::emplace_front(Args&&... args) {
+    if (begin_ != buf_) {
+        data_traits::construct(data_alloc(), mystl::address_of(*(begin_ - 1)),
+                               mystl::forward<Args>(args)...);
+    } else {
+        // args may refer to an element that is about to move
+        value_type tmp(mystl::forward<Args>(args)...);
+        make_room_front(1);
+        data_traits::construct(data_alloc(), mystl::address_of(*(begin_ - 1)),
+                               mystl::move(tmp));
+    }
+    --begin_;
+}
+
+template <class T, class Alloc>
+template <class... Args>
+void devector<T, Alloc>::emplace_back(Args&&... args) {
+    if (end_ != cap_) {
+        data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                               mystl::forward<Args>(args)...);
+    } else {
+        value_type tmp(mystl::forward<Args>(args)...);
+        make_room_back(1);
+        data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                               mystl::move(tmp));
+    }
+    ++end_;
+}
+
+// the new element goes on at the nearer end and is rotated into place
+template <class T, class Alloc>
+template <class... Args>
+typename devector<T, Alloc>::iterator devector<T, Alloc>::emplace(
+    const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    const size_type idx = static_cast<size_type>(pos - begin());
+    if (idx < size() / 2) {
+        emplace_front(mystl::forward<Args>(args)...);
+        mystl::rotate(begin_, begin_ + 1, begin_ + idx + 1);
+    } else {
+        emplace_back(mystl::forward<Args>(args)...);
+        mystl::rotate(begin_ + idx, end_ - 1, end_);
+    }
+    return begin_ + idx;
+}
+
+template <class T, class Alloc>
+typename devector<T, Alloc>::iterator devector<T, Alloc>::insert(
+    const_iterator pos, size_type n, const value_type& value) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    const size_type idx = static_cast<size_type>(pos - begin());
+    if (n == 0) {
+        return begin_ + idx;
+    }
+    const value_type copy = value;
+    if (idx < size() / 2) {
+        if (front_free() < n) {
+            make_room_front(n);
+        }
+        mystl::uninitialized_fill_n(begin_ - n, n, copy);
+        begin_ -= n;
+        mystl::rotate(begin_, begin_ + n, begin_ + n + idx);
+    } else {
+        if (back_free() < n) {
+            make_room_back(n);
+        }
+        mystl::uninitialized_fill_n(end_, n, copy);
+        end_ += n;
+        mystl::rotate(begin_ + idx, end_ - n, end_);
+    }
+    return begin_ + idx;
+}
+
+// the shorter side moves over the gap
+template <class T, class Alloc>
+typename devector<T, Alloc>::iterator devector<T, Alloc>::erase(
+    const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+    iterator f = begin_ + (first - begin());
+    iterator l = begin_ + (last - begin());
+    if (f == l) {
+        return f;
+    }
+    const auto n = l - f;
+    if (f - begin_ < end_ - l) {
+        mystl::move_backward(begin_, f, l);
+        mystl::destroy(begin_, begin_ + n);
+        begin_ += n;
+        f = l;
+    } else {
+        mystl::destroy(mystl::move(l, end_, f), end_);
+        end_ -= n;
+    }
+    recentre_if_empty();
+    return f;
+}
+
+template <class T, class Alloc>
+void devector<T, Alloc>::resize(size_type new_size, const value_type& value) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        insert(end(), new_size - size(), value);
+    }
+}
+
+// helper funcitons
+
+template <class T, class Alloc>
+typename devector<T, Alloc>::size_type devector<T, Alloc>::get_new_cap(
+    size_type add_size) const {
+    const auto old_size = capacity();
+    THROW_LENGTH_ERROR_IF(size() > max_size() - add_size,
+                          "devector<T>'s size too big");
+    if (old_size > max_size() - old_size / 2) {
+        return size() + add_size;
+    }
+    return old_size == 0
+               ? mystl::max(add_size, static_cast<size_type>(16))
+               : mystl::max(old_size + old_size / 2, size() + add_size);
+}
+
+// move the elements to leave front free slots before them in a buffer of
+// new_cap; in place when that is the current buffer and T can be memmoved,
+// into a new buffer otherwise. The old buffer is untouched on an exception.
+template <class T, class Alloc>
+void devector<T, Alloc>::relocate(size_type new_cap, size_type front) {
+    const size_type n = size();
+    MYSTL_DEBUG(front + n <= new_cap);
+    if (new_cap == capacity() && mystl::is_trivially_relocatable<T>::value) {
+        iterator first = buf_ + front;
+        end_ = mystl::uninitialized_relocate(begin_, end_, first);
+        begin_ = first;
+        return;
+    }
+    size_type cap = new_cap;
+    auto r = data_traits::allocate_at_least(data_alloc(), cap);
+    cap = r.count;
+    // the extra room the allocator handed out goes to both ends
+    iterator first = r.ptr + front + (cap - new_cap) / 2;
+    iterator last;
+    if (mystl::is_trivially_relocatable<T>::value) {
+        last = mystl::uninitialized_relocate(begin_, end_, first);
+    } else {
+        try {
+            last = mystl::uninitialized_move(begin_, end_, first);
+        } catch (...) {
+            data_traits::deallocate(data_alloc(), r.ptr, cap);
+            throw;
+        }
+        mystl::destroy(begin_, end_);
+    }
+    free_buffer();
+    buf_ = r.ptr;
+    cap_ = r.ptr + cap;
+    begin_ = first;
+    end_ = last;
+}
+
+// room for n more in front: recentred in a buffer at most half full,
+// otherwise a bigger buffer
+template <class T, class Alloc>
+void devector<T, Alloc>::make_room_front(size_type n) {
+    const size_type cap = capacity();
+    const size_type new_cap =
+        size() + n <= cap / 2 ? cap : get_new_cap(n);
+    relocate(new_cap, n + (new_cap - size() - n) / 2);
+}
+
+template <class T, class Alloc>
+void devector<T, Alloc>::make_room_back(size_type n) {
+    const size_type cap = capacity();
+    const size_type new_cap =
+        size() + n <= cap / 2 ? cap : get_new_cap(n);
+    relocate(new_cap, (new_cap - size() - n) / 2);
+}
+
+template <class T, class Alloc>
+template <class IIter>
+void devector<T, Alloc>::assign_aux(IIter first, IIter last,
+                                    input_iterator_tag) {
+    clear();
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+// a buffer that is big enough keeps the elements centred in it
+template <class T, class Alloc>
+template <class FIter>
+void devector<T, Alloc>::assign_aux(FIter first, FIter last,
+                                    forward_iterator_tag) {
+    const size_type n = static_cast<size_type>(mystl::distance(first, last));
+    clear();
+    if (capacity() < n) {
+        free_buffer();
+        reset();
+        relocate(n, 0);
+    }
+    begin_ = end_ = buf_ + (capacity() - n) / 2;
+    end_ = mystl::uninitialized_copy(first, last, begin_);
+}
+
+template <class T, class Alloc>
+template <class IIter>
+typename devector<T, Alloc>::iterator devector<T, Alloc>::insert_aux(
+    iterator pos, IIter first, IIter last, input_iterator_tag) {
+    const size_type idx = static_cast<size_type>(pos - begin_);
+    const size_type old_size = size();
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+    mystl::rotate(begin_ + idx, begin_ + old_size, end_);
+    return begin_ + idx;
+}
+
+template <class T, class Alloc>
+template <class FIter>
+typename devector<T, Alloc>::iterator devector<T, Alloc>::insert_aux(
+    iterator pos, FIter first, FIter last, forward_iterator_tag) {
+    const size_type idx = static_cast<size_type>(pos - begin_);
+    const size_type n = static_cast<size_type>(mystl::distance(first, last));
+    if (n == 0) {
+        return pos;
+    }
+    if (idx < size() / 2) {
+        if (front_free() < n) {
+            make_room_front(n);
+        }
+        mystl::uninitialized_copy(first, last, begin_ - n);
+        begin_ -= n;
+        mystl::rotate(begin_, begin_ + n, begin_ + n + idx);
+    } else {
+        if (back_free() < n) {
+            make_room_back(n);
+        }
+        end_ = mystl::uninitialized_copy(first, last, end_);
+        mystl::rotate(begin_ + idx, end_ - n, end_);
+    }
+    return begin_ + idx;
+}
+
+template <class T, class Alloc>
+bool operator==(const devector<T, Alloc>& lhs, const devector<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() &&
+           mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Alloc>
+bool operator<(const devector<T, Alloc>& lhs, const devector<T, Alloc>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                          rhs.end());
+}
+
+template <class T, class Alloc>
+bool operator!=(const devector<T, Alloc>& lhs, const devector<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+bool operator>(const devector<T, Alloc>& lhs, const devector<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, class Alloc>
+bool operator<=(const devector<T, Alloc>& lhs, const devector<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+bool operator>=(const devector<T, Alloc>& lhs, const devector<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, class Alloc>
+void swap(devector<T, Alloc>& lhs, devector<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class T, class Alloc>
+struct is_trivially_relocatable<devector<T, Alloc>>
+    : is_trivially_relocatable<Alloc> {};
+
+namespace pmr {
+template <class T>
+using devector = mystl::devector<T, polymorphic_allocator<T>>;
+}  // namespace pmr
+
+}  // namespace mystl
+#endif
@@ -122,13 +122,13 @@ struct ht_value_traits
     }
 };
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 class hashtable;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 struct ht_iterator;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class Alloc>
 struct ht_const_iterator;
 
 template <class T>
@@ -138,13 +138,13 @@ template <class T>
 struct ht_const_local_iterator;
 
 // ht_iterator
-template <class T, class Hash, class KeyEqual>
-struct ht_iterator_base : public mystl::iterator<mystl::forward_iterator_tag>
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_iterator_base : public mystl::iterator<mystl::forward_iterator_tag, T>
 {
-    typedef mystl::hashtable<T, Hash, KeyEqual> hashtable;
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
-    typedef mystl::ht_iterator<T, Hash, KeyEqual> iterator;
-    typedef mystl::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef mystl::hashtable<T, Hash, KeyEqual, Alloc> hashtable;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
+    typedef mystl::ht_iterator<T, Hash, KeyEqual, Alloc> iterator;
+    typedef mystl::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef hashtable_node<T>* node_ptr;
     typedef hashtable* contain_ptr;
     typedef const node_ptr const_node_ptr;
@@ -162,10 +162,10 @@ struct ht_iterator_base : public mystl::iterator<mystl::forward_iterator_tag>
     bool operator!=(const base& rhs) const { return node != rhs.node; }
 };
 
-template <class T, class Hash, class KeyEqual>
-struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual, Alloc>
 {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable hashtable;
     typedef typename base::iterator iterator;
     typedef typename base::const_iterator const_iterator;
@@ -222,9 +222,8 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
         const node_ptr old = node;
         node               = node->next;
         if (node == nullptr) {
-            auto index = ht->hash(value_traits::get_key(old->value))
-                : while (!node && ++index < ht->bucket_size_)
-            {
+            auto index = ht->hash(value_traits::get_key(old->value));
+            while (!node && ++index < ht->bucket_size_) {
                 node = ht->buckets_[index];
             }
         }
@@ -239,10 +238,10 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
     }
 };
 
-template <class T, class Hash, class KeyEqual>
-struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual, Alloc>
 {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, Alloc> base;
     typedef typename base::hashtable hashtable;
     typedef typename base::iterator iterator;
     typedef typename base::const_iterator const_iterator;
@@ -544,10 +543,22 @@ ht_next_prime(size_t n)
     return pos == last ? *(last - 1) : *pos;
 }
 
-template <class T, class Hash, class KeyEqual>
-class hashtable {
-    friend struct mystl::ht_iterator<T, Hash, KeyEqual>;
-    friend struct mystl::ht_const_iterator<T, Hash, KeyEqual>;
+// the bucket array may have room for more than the n buckets asked for: the
+// largest prime of the list that still fits into cap, n if none is above n
+inline size_t
+ht_fit_prime(size_t n, size_t cap)
+{
+    const size_t* first = ht_prime_list;
+    const size_t* pos   = mystl::upper_bound(first, first + PRIME_NUM, cap);
+    return pos != first && *(pos - 1) > n ? *(pos - 1) : n;
+}
+
+template <class T, class Hash, class KeyEqual, class Alloc = mystl::allocator<T>>
+class hashtable
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<hashtable_node<T>>> {
+    friend struct mystl::ht_iterator<T, Hash, KeyEqual, Alloc>;
+    friend struct mystl::ht_const_iterator<T, Hash, KeyEqual, Alloc>;
 
 public:
     typedef ht_value_traits<T> value_traits;
@@ -559,27 +570,32 @@ public:
 
     typedef hashtable_node<T> node_type;
     typedef node_type* node_ptr;
-    typedef mystl::vector<node_ptr> bucket_type;
-
-    typedef mystl::allocator<T> allocator_type;
-    typedef mystl::allocator<T> data_allocator;
-    typedef mystl::allocator<node_type> node_allocator;
 
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
-
-    typedef mystl::ht_iterator<T, Hash, KeyEqual> iterator;
-    typedef mystl::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    typedef Alloc allocator_type;
+    typedef mystl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<T> data_allocator;
+    typedef typename alloc_traits::template rebind_alloc<node_type> node_allocator;
+    typedef typename alloc_traits::template rebind_alloc<node_ptr> bucket_allocator;
+    typedef mystl::allocator_traits<node_allocator> node_alloc_traits;
+    typedef mystl::vector<node_ptr, bucket_allocator> bucket_type;
+
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename node_alloc_traits::size_type size_type;
+    typedef typename node_alloc_traits::difference_type difference_type;
+
+    typedef mystl::ht_iterator<T, Hash, KeyEqual, Alloc> iterator;
+    typedef mystl::ht_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
     typedef mystl::ht_local_iterator<T> local_iterator;
     typedef mystl::ht_const_local_iterator<T> const_local_iterator;
 
-    allocator_type get_allocator() const { return allocator_type(); }
+    allocator_type get_allocator() const { return allocator_type(node_alloc()); }
 
 private:
+    typedef mystl::alloc_storage<node_allocator> alloc_base;
+
     bucket_type buckets_;
     size_type bucket_size_;
     size_type size_;
@@ -588,9 +604,12 @@ private:
     key_equal equal_;
 
 private:
-    bool is_equal(const key_type& key1, const key_type& key2) { return equal(key1, key2); }
+    node_allocator& node_alloc() noexcept { return alloc_base::get_alloc(); }
+    const node_allocator& node_alloc() const noexcept { return alloc_base::get_alloc(); }
 
-    bool is_equal(const key_type& key1, const key_type& key2) const { return equal(key1, key2); }
+    bool is_equal(const key_type& key1, const key_type& key2) { return equal_(key1, key2); }
+
+    bool is_equal(const key_type& key1, const key_type& key2) const { return equal_(key1, key2); }
 
     const_iterator M_cit(node_ptr node) const noexcept
     {
@@ -618,10 +637,13 @@ private:
     }
 
 public:
-    explicit hashtable(size_type bucket_count, const hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
-        : size_(0)
-        , mlf(1.0f)
+    explicit hashtable(size_type bucket_count, const Hash& hash = Hash(),
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
+        : alloc_base(node_allocator(alloc))
+        , buckets_(bucket_allocator(alloc))
+        , size_(0)
+        , mlf_(1.0f)
         , hash_(hash)
         , equal_(equal)
     {
@@ -631,8 +653,10 @@ public:
     template <class Iter,
               typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
     hashtable(Iter first, Iter last, size_type bucket_count, const Hash& hash = Hash(),
-              const KeyEqual& equal = KeyEqual())
-        : size_(mystl::distance(first, last))
+              const KeyEqual& equal = KeyEqual(), const allocator_type& alloc = allocator_type())
+        : alloc_base(node_allocator(alloc))
+        , buckets_(bucket_allocator(alloc))
+        , size_(mystl::distance(first, last))
         , mlf_(1.0f)
         , hash_(hash)
         , equal_(equal)
@@ -641,28 +665,49 @@ public:
     }
 
     hashtable(const hashtable& rhs)
-        : hash_(rhs.hash_)
+        : alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.node_alloc()))
+        , buckets_(bucket_allocator(node_alloc()))
+        , hash_(rhs.hash_)
+        , equal_(rhs.equal_)
+    {
+        copy_init(rhs);
+    }
+
+    hashtable(const hashtable& rhs, const allocator_type& alloc)
+        : alloc_base(node_allocator(alloc))
+        , buckets_(bucket_allocator(alloc))
+        , hash_(rhs.hash_)
         , equal_(rhs.equal_)
     {
         copy_init(rhs);
     }
+
     hashtable(hashtable&& rhs) noexcept
-        : bucket_size_(rhs.bucket_size_)
+        : alloc_base(mystl::move(rhs.node_alloc()))
+        , buckets_(mystl::move(rhs.buckets_))
+        , bucket_size_(rhs.bucket_size_)
         , size_(rhs.size_)
         , mlf_(rhs.mlf_)
         , hash_(rhs.hash_)
         , equal_(rhs.equal_)
     {
-        buckets_         = mystl::move(rhs.buckets_);
         rhs.bucket_size_ = 0;
         rhs.size_        = 0;
         rhs.mlf_         = 0.0f;
     }
 
+    hashtable(hashtable&& rhs, const allocator_type& alloc);
+
     hashtable& operator=(const hashtable& rhs);
-    hashtable& operator=(hashtable&& rhs) noexcept;
+    hashtable& operator=(hashtable&& rhs) noexcept(
+        node_alloc_traits::propagate_on_container_move_assignment::value ||
+        node_alloc_traits::is_always_equal::value);
 
-    ~hashtable() { clear(); }
+    ~hashtable()
+    {
+        clear();
+        node_alloc_traits::release(node_alloc());
+    }
 
     // functions about iterator
     iterator begin() noexcept { return M_begin(); }
@@ -844,6 +889,7 @@ private:
     // init
     void init(size_type n);
     void copy_init(const hashtable& ht);
+    void move_init(hashtable& ht);
 
     // node
     template <class... Args>
@@ -875,35 +921,85 @@ private:
     void erase_bucket(size_type n, node_ptr first, node_ptr last);
     void erase_bucket(size_type n, node_ptr last);
 
+public:
     // comparision
-    bool equal_to_multi(const hashtable& other);
-    bool equal_to_unique(const hashtable& other);
+    bool equal_to_multi(const hashtable& other) const;
+    bool equal_to_unique(const hashtable& other) const;
 };
 
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>&
-hashtable<T, Hash, KeyEqual>::operator=(const hashtable& rhs)
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>::hashtable(hashtable&& rhs, const allocator_type& alloc)
+    : alloc_base(node_allocator(alloc))
+    , buckets_(bucket_allocator(alloc))
+    , hash_(rhs.hash_)
+    , equal_(rhs.equal_)
+{
+    if (mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+        buckets_.swap(rhs.buckets_);
+        bucket_size_     = rhs.bucket_size_;
+        size_            = rhs.size_;
+        mlf_             = rhs.mlf_;
+        rhs.bucket_size_ = 0;
+        rhs.size_        = 0;
+        rhs.mlf_         = 0.0f;
+    } else {
+        move_init(rhs);
+    }
+}
+
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>&
+hashtable<T, Hash, KeyEqual, Alloc>::operator=(const hashtable& rhs)
 {
     if (this != &rhs) {
-        hashtable tmp(rhs);
-        swap(tmp);
+        clear();
+        if (node_alloc_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+            mystl::alloc_on_copy(node_alloc(), rhs.node_alloc());
+            // bucket vector picks up the allocator the same way
+            buckets_ = rhs.buckets_;
+        }
+        hash_  = rhs.hash_;
+        equal_ = rhs.equal_;
+        copy_init(rhs);
     }
     return *this;
 }
 
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>&
-hashtable<T, Hash, KeyEqual>::operator=(hashtable&& rhs) noexcept
+template <class T, class Hash, class KeyEqual, class Alloc>
+hashtable<T, Hash, KeyEqual, Alloc>&
+hashtable<T, Hash, KeyEqual, Alloc>::operator=(hashtable&& rhs) noexcept(
+    node_alloc_traits::propagate_on_container_move_assignment::value ||
+    node_alloc_traits::is_always_equal::value)
 {
-    hashtable tmp(mystl::move(rhs));
-    swap(tmp);
+    if (this == &rhs) {
+        return *this;
+    }
+    clear();
+    hash_  = rhs.hash_;
+    equal_ = rhs.equal_;
+    if (node_alloc_traits::propagate_on_container_move_assignment::value ||
+        mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+        mystl::alloc_on_move(node_alloc(), rhs.node_alloc());
+        buckets_         = mystl::move(rhs.buckets_);
+        bucket_size_     = rhs.bucket_size_;
+        size_            = rhs.size_;
+        mlf_             = rhs.mlf_;
+        rhs.bucket_size_ = 0;
+        rhs.size_        = 0;
+        rhs.mlf_         = 0.0f;
+    } else {
+        // nodes of rhs belong to another allocator, move the values
+        move_init(rhs);
+        rhs.clear();
+    }
     return *this;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class... Args>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::emplace_multi(Args&&... args)
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::emplace_multi(Args&&... args)
 {
     auto np = create_node(mystl::forward<Args>(args)...);
     try {
@@ -917,10 +1013,10 @@ hashtable<T, Hash, KeyEqual>::emplace_multi(Args&&... args)
     return insert_node_multi(np);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class... Args>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::emplace_unique(Args&&... args)
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::emplace_unique(Args&&... args)
 {
     auto np = create_node(mystl::forward<Args>(args)...);
     try {
@@ -934,9 +1030,9 @@ hashtable<T, Hash, KeyEqual>::emplace_unique(Args&&... args)
     return insert_node_unique(np);
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::insert_unique_noresize(const value_type& value)
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::insert_unique_noresize(const value_type& value)
 {
     const auto n = hash(value_traits::get_key(value));
     auto first   = buckets_[n];
@@ -951,9 +1047,9 @@ hashtable<T, Hash, KeyEqual>::insert_unique_noresize(const value_type& value)
     return mystl::make_pair(iterator(tmp, this), true);
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value)
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::insert_multi_noresize(const value_type& value)
 {
     const auto n = hash(value_traits::get_key(value));
     auto first   = buckets_[n];
@@ -972,9 +1068,9 @@ hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value)
     return iterator(tmp, this);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::erase(const_iterator position)
+hashtable<T, Hash, KeyEqual, Alloc>::erase(const_iterator position)
 {
     auto p = position.node;
     if (p) {
@@ -1001,9 +1097,9 @@ hashtable<T, Hash, KeyEqual>::erase(const_iterator position)
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::erase(const_iterator first, const_iterator last)
+hashtable<T, Hash, KeyEqual, Alloc>::erase(const_iterator first, const_iterator last)
 {
     if (first.node == last.node) {
         return;
@@ -1025,21 +1121,22 @@ hashtable<T, Hash, KeyEqual>::erase(const_iterator first, const_iterator last)
     }
 }
 
-template <class T, class Hash, class KeyEqaul>
-typename hashtable<T, Hash, KeyEqaul>::size_type
-hashtable<T, Hash, KeyEqaul>::erase_multi(const key_type& key)
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::erase_multi(const key_type& key)
 {
     auto p = equal_range_multi(key);
     if (p.first.node != nullptr) {
+        const auto n = mystl::distance(p.first, p.second);
         erase(p.first, p.second);
-        return mystl::distance(p.first, p.second);
+        return n;
     }
     return 0;
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::erase_unique(const key_type& key)
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::erase_unique(const key_type& key)
 {
     const auto n = hash(key);
     auto first   = buckets_[n];
@@ -1066,9 +1163,9 @@ hashtable<T, Hash, KeyEqual>::erase_unique(const key_type& key)
     return 0;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::clear()
+hashtable<T, Hash, KeyEqual, Alloc>::clear()
 {
     if (size_ != 0) {
         for (size_type i = 0; i < bucket_size_; ++i) {
@@ -1084,9 +1181,9 @@ hashtable<T, Hash, KeyEqual>::clear()
     }
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::bucket_size(size_type n) const noexcept
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::bucket_size(size_type n) const noexcept
 {
     size_type result = 0;
     for (auto cur = buckets_[n]; cur; cur = cur->next) {
@@ -1095,9 +1192,9 @@ hashtable<T, Hash, KeyEqual>::bucket_size(size_type n) const noexcept
     return result;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::rehash(size_type count)
+hashtable<T, Hash, KeyEqual, Alloc>::rehash(size_type count)
 {
     auto n = ht_next_prime(count);
     if (n > bucket_size_) {
@@ -1110,29 +1207,29 @@ hashtable<T, Hash, KeyEqual>::rehash(size_type count)
     }
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::find(const key_type& key)
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::find(const key_type& key)
 {
     const auto n = hash(key);
-    node_ptr = first = buckets_[n];
-    for (; first && !is_equal(value_traits::get_key(first->vlaue), key); first = first->next) {}
+    node_ptr first = buckets_[n];
+    for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
     return iterator(first, this);
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::const_iterator
-hashtable<T, Hash, KeyEqual>::find(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator
+hashtable<T, Hash, KeyEqual, Alloc>::find(const key_type& key) const
 {
     const auto n = hash(key);
-    node_ptr = first = buckets_[n];
-    for (; first && !is_equal(value_traits::get_key(first->vlaue), key); first = first->next) {}
+    node_ptr first = buckets_[n];
+    for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
     return M_cit(first);
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::count(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::count(const key_type& key) const
 {
     const auto n     = hash(key);
     size_type result = 0;
@@ -1144,10 +1241,10 @@ hashtable<T, Hash, KeyEqual>::count(const key_type& key) const
     return result;
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-     typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key)
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_multi(const key_type& key)
 {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
@@ -1157,7 +1254,7 @@ hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key)
                     return mystl::make_pair(iterator(first, this), iterator(second, this));
                 }
             }
-            for (auto m = n + 1; m < bucket_size; ++m) {
+            for (auto m = n + 1; m < bucket_size_; ++m) {
                 if (buckets_[m]) {
                     return mystl::make_pair(iterator(first, this), iterator(buckets_[m], this));
                 }
@@ -1165,14 +1262,13 @@ hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key)
             return mystl::make_pair(iterator(first, this), end());
         }
     }
-    return mystl::make_pair(end(), end())
-        :
+    return mystl::make_pair(end(), end());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-     typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_multi(const key_type& key) const
 {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
@@ -1182,7 +1278,7 @@ hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) const
                     return mystl::make_pair(M_cit(first), M_cit(second));
                 }
             }
-            for (auto m = n + 1; m < bucket_size; ++m) {
+            for (auto m = n + 1; m < bucket_size_; ++m) {
                 if (buckets_[m]) {
                     return mystl::make_pair(M_cit(first), M_cit(buckets_[m]));
                 }
@@ -1190,14 +1286,13 @@ hashtable<T, Hash, KeyEqual>::equal_range_multi(const key_type& key) const
             return mystl::make_pair(M_cit(first), cend());
         }
     }
-    return mystl::make_pair(cend(), cend())
-        :
+    return mystl::make_pair(cend(), cend());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-     typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key)
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_unique(const key_type& key)
 {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
@@ -1216,10 +1311,10 @@ hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key)
     return mystl::make_pair(end(), end());
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-     typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator,
+     typename hashtable<T, Hash, KeyEqual, Alloc>::const_iterator>
+hashtable<T, Hash, KeyEqual, Alloc>::equal_range_unique(const key_type& key) const
 {
     const auto n = hash(key);
     for (node_ptr first = buckets_[n]; first; first = first->next) {
@@ -1238,11 +1333,12 @@ hashtable<T, Hash, KeyEqual>::equal_range_unique(const key_type& key) const
     return mystl::make_pair(cend(), cend());
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::swap(hashtable& rhs) noexcept
+hashtable<T, Hash, KeyEqual, Alloc>::swap(hashtable& rhs) noexcept
 {
     if (this != &rhs) {
+        mystl::alloc_on_swap(node_alloc(), rhs.node_alloc());
         buckets_.swap(rhs.buckets_);
         mystl::swap(bucket_size_, rhs.bucket_size_);
         mystl::swap(size_, rhs.size_);
@@ -1254,13 +1350,14 @@ hashtable<T, Hash, KeyEqual>::swap(hashtable& rhs) noexcept
 
 // helper functions
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::init(size_type n)
+hashtable<T, Hash, KeyEqual, Alloc>::init(size_type n)
 {
-    const auto bucket_nums = next_size(n);
+    auto bucket_nums = next_size(n);
     try {
         buckets_.reserve(bucket_nums);
+        bucket_nums = ht_fit_prime(bucket_nums, buckets_.capacity());
         buckets_.assign(bucket_nums, nullptr);
     }
     catch (...) {
@@ -1271,81 +1368,132 @@ hashtable<T, Hash, KeyEqual>::init(size_type n)
     bucket_size_ = buckets_.size();
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::copy_init(const hashtable& ht)
+hashtable<T, Hash, KeyEqual, Alloc>::copy_init(const hashtable& ht)
 {
     bucket_size_ = 0;
+    size_        = 0;
     buckets_.reserve(ht.bucket_size_);
     buckets_.assign(ht.bucket_size_, nullptr);
+    bucket_size_ = ht.bucket_size_;
     try {
         for (size_type i = 0; i < ht.bucket_size_; ++i) {
             node_ptr cur = ht.buckets_[i];
             if (cur) {
                 auto copy   = create_node(cur->value);
                 buckets_[i] = copy;
-                for (auto next = cur->next; next; next = cur->next) {
+                ++size_;
+                for (auto next = cur->next; next; next = next->next) {
                     copy->next = create_node(next->value);
                     copy       = copy->next;
+                    ++size_;
+                }
+                copy->next = nullptr;
+            }
+        }
+        mlf_ = ht.mlf_;
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// same layout as ht, every value moved into a node of our own allocator
+template <class T, class Hash, class KeyEqual, class Alloc>
+void
+hashtable<T, Hash, KeyEqual, Alloc>::move_init(hashtable& ht)
+{
+    bucket_size_ = 0;
+    size_        = 0;
+    buckets_.reserve(ht.bucket_size_);
+    buckets_.assign(ht.bucket_size_, nullptr);
+    bucket_size_ = ht.bucket_size_;
+    try {
+        for (size_type i = 0; i < ht.bucket_size_; ++i) {
+            node_ptr cur = ht.buckets_[i];
+            if (cur) {
+                auto copy   = create_node(mystl::move(cur->value));
+                buckets_[i] = copy;
+                ++size_;
+                for (auto next = cur->next; next; next = next->next) {
+                    copy->next = create_node(mystl::move(next->value));
+                    copy       = copy->next;
+                    ++size_;
                 }
                 copy->next = nullptr;
             }
         }
-        bucket_size = ht.bucket_size_;
-        mlf_        = ht.mlf_;
-        size_       = ht.size_;
+        mlf_ = ht.mlf_;
     }
     catch (...) {
         clear();
+        throw;
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class... Args>
-typename hashtable<T, Hash, KeyEqual>::node_ptr
-hashtable<T, Hash, KeyEqual>::create_node(Args&&... args)
+typename hashtable<T, Hash, KeyEqual, Alloc>::node_ptr
+hashtable<T, Hash, KeyEqual, Alloc>::create_node(Args&&... args)
 {
-    node_ptr = tmp = node_allocate(1);
+    node_ptr tmp = node_alloc_traits::allocate(node_alloc(), 1);
     try {
-        data_allocator::construct(mystl::address_of(tmp->value), mystl::forward<Args>(args)...);
+        node_alloc_traits::construct(node_alloc(), mystl::address_of(tmp->value),
+                                     mystl::forward<Args>(args)...);
         tmp->next = nullptr;
     }
     catch (...) {
-        node_allocator::deallocate(tmp);
+        node_alloc_traits::deallocate(node_alloc(), tmp, 1);
         throw;
     }
     return tmp;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::destroy_node(node_ptr node)
+hashtable<T, Hash, KeyEqual, Alloc>::destroy_node(node_ptr node)
 {
-    data_allocator::destroy(mystl::address_of(node->value));
-    node_allocator::deallocate(node);
+    node_alloc_traits::destroy(node_alloc(), mystl::address_of(node->value));
+    node_alloc_traits::deallocate(node_alloc(), node, 1);
     node = nullptr;
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::hash(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::next_size(size_type n) const
+{
+    return ht_next_prime(n);
+}
+
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::hash(const key_type& key, size_type n) const
+{
+    return hash_(key) % n;
+}
+
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, Alloc>::hash(const key_type& key) const
 {
     return hash_(key) % bucket_size_;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::rehash_if_need(size_type n)
+hashtable<T, Hash, KeyEqual, Alloc>::rehash_if_need(size_type n)
 {
     if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor()) {
         rehash(size_ + n);
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class InputIter>
 void
-hashtable<T, Hash, KeyEqual>::copy_insert_multi(InputIter first, InputIter last,
+hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_multi(InputIter first, InputIter last,
                                                 mystl::input_iterator_tag)
 {
     rehash_if_need(mystl::distance(first, last));
@@ -1354,23 +1502,23 @@ hashtable<T, Hash, KeyEqual>::copy_insert_multi(InputIter first, InputIter last,
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ForwardIter>
 void
-hashtable<T, Hash, KeyEqual>::copy_insert_multi(ForwardIter first, ForwardIter last,
+hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_multi(ForwardIter first, ForwardIter last,
                                                 mystl::forward_iterator_tag)
 {
     size_type n = mystl::distance(first, last);
     rehash_if_need(n);
-    for (; n > 0; - n, ++first) {
+    for (; n > 0; --n, ++first) {
         insert_multi_noresize(*first);
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class InputIter>
 void
-hashtable<T, Hash, KeyEqual>::copy_insert_unique(InputIter first, InputIter last,
+hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_unique(InputIter first, InputIter last,
                                                  mystl::input_iterator_tag)
 {
     rehash_if_need(mystl::distance(first, last));
@@ -1379,22 +1527,22 @@ hashtable<T, Hash, KeyEqual>::copy_insert_unique(InputIter first, InputIter last
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 template <class ForwardIter>
 void
-hashtable<T, Hash, KeyEqual>::copy_insert_unique(ForwardIter first, ForwardIter last,
+hashtable<T, Hash, KeyEqual, Alloc>::copy_insert_unique(ForwardIter first, ForwardIter last,
                                                  mystl::forward_iterator_tag)
 {
     size_type n = mystl::distance(first, last);
     rehash_if_need(n);
-    for (; n > 0; - n, ++first) {
+    for (; n > 0; --n, ++first) {
         insert_unique_noresize(*first);
     }
 }
 
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np)
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename hashtable<T, Hash, KeyEqual, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, Alloc>::insert_node_multi(node_ptr np)
 {
     const auto n = hash(value_traits::get_key(np->value));
     auto cur     = buckets_[n];
@@ -1417,9 +1565,9 @@ hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np)
     return iterator(np, this);
 }
 
-template <class T, class Hash, class KeyEqual>
-pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np)
+template <class T, class Hash, class KeyEqual, class Alloc>
+pair<typename hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, Alloc>::insert_node_unique(node_ptr np)
 {
     const auto n = hash(value_traits::get_key(np->value));
     auto cur     = buckets_[n];
@@ -1430,6 +1578,7 @@ hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np)
     }
     for (; cur; cur = cur->next) {
         if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value))) {
+            destroy_node(np);
             return mystl::make_pair(iterator(cur, this), false);
         }
     }
@@ -1439,20 +1588,24 @@ hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np)
     return mystl::make_pair(iterator(np, this), true);
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::replace_bucket(size_type bucket_count)
+hashtable<T, Hash, KeyEqual, Alloc>::replace_bucket(size_type bucket_count)
 {
-    bucket_type bucket(bucket_count);
+    bucket_type bucket(bucket_count, nullptr, buckets_.get_allocator());
+    bucket_count = ht_fit_prime(bucket_count, bucket.capacity());
+    bucket.resize(bucket_count, nullptr);
     if (size_ != 0) {
         for (size_type i = 0; i < bucket_size_; ++i) {
-            for (auto first = buckets_[i]; first; first = first->next) {
-                auto tmp     = create_node(first->value);
-                const auto n = hash(value_traits::get_key(first->value), bucket_count);
-                auto f = bucket[n] bool is_inserted = false;
+            for (auto first = buckets_[i]; first;) {
+                auto tmp     = first;
+                first        = first->next;
+                const auto n = hash(value_traits::get_key(tmp->value), bucket_count);
+                auto f           = bucket[n];
+                bool is_inserted = false;
                 for (auto cur = f; cur; cur = cur->next) {
                     if (is_equal(value_traits::get_key(cur->value),
-                                 value_traits::get_key(first->value))) {
+                                 value_traits::get_key(tmp->value))) {
                         tmp->next   = cur->next;
                         cur->next   = tmp;
                         is_inserted = true;
@@ -1470,9 +1623,9 @@ hashtable<T, Hash, KeyEqual>::replace_bucket(size_type bucket_count)
     bucket_size_ = buckets_.size();
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr first, node_ptr last)
+hashtable<T, Hash, KeyEqual, Alloc>::erase_bucket(size_type n, node_ptr first, node_ptr last)
 {
     auto cur = buckets_[n];
     if (cur == first) {
@@ -1489,9 +1642,9 @@ hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr first, node_ptr
     }
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr last)
+hashtable<T, Hash, KeyEqual, Alloc>::erase_bucket(size_type n, node_ptr last)
 {
     auto cur = buckets_[n];
     while (cur != last) {
@@ -1503,9 +1656,9 @@ hashtable<T, Hash, KeyEqual>::erase_bucket(size_type n, node_ptr last)
     buckets_[n] = last;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 bool
-hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable& other)
+hashtable<T, Hash, KeyEqual, Alloc>::equal_to_multi(const hashtable& other) const
 {
     if (size_ != other.size_) {
         return false;
@@ -1513,23 +1666,23 @@ hashtable<T, Hash, KeyEqual>::equal_to_multi(const hashtable& other)
     for (auto f = begin(), l = end(); f != l;) {
         auto p1 = equal_range_multi(value_traits::get_key(*f));
         auto p2 = other.equal_range_multi(value_traits::get_key(*f));
-        if (mystl::distance(p1.first, p1.last) != mystl::distance(p2.first, p2.last) ||
-            !mystl::is_permutation(p1.first, p1.last, p2.first, p2.last)) {
+        if (mystl::distance(p1.first, p1.second) != mystl::distance(p2.first, p2.second) ||
+            !mystl::is_permutation(p1.first, p1.second, p2.first, p2.second)) {
             return false;
         }
-        f = p1.last;
+        f = p1.second;
     }
     return true;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 bool
-hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable& other)
+hashtable<T, Hash, KeyEqual, Alloc>::equal_to_unique(const hashtable& other) const
 {
     if (size_ != other.size_) {
         return false;
     }
-    for (auto f = begin(), l = end(); f != l;) {
+    for (auto f = begin(), l = end(); f != l; ++f) {
         auto res = other.find(value_traits::get_key(*f));
         if (res.node == nullptr || *res != *f) {
             return false;
@@ -1538,9 +1691,9 @@ hashtable<T, Hash, KeyEqual>::equal_to_unique(const hashtable& other)
     return true;
 }
 
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class Alloc>
 void
-swap(hashtable<T, Hash, KeyEqual>& lhs, hashtable<T, Hash, KeyEqual>& rhs) noexcept
+swap(hashtable<T, Hash, KeyEqual, Alloc>& lhs, hashtable<T, Hash, KeyEqual, Alloc>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
@@ -39,17 +39,19 @@ void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex,
                    T value) {
     auto parent = (holeIndex - 1) / 2;
     while (holeIndex > topIndex && *(first + parent) < value) {
-        *(first + holeIndex) = *(first + parent);
+        *(first + holeIndex) = mystl::move(*(first + parent));
         holeIndex = parent;
         parent = (holeIndex - 1) / 2;
     }
-    *(first + holeIndex) = value;
+    *(first + holeIndex) = mystl::move(value);
 }
 
 template <class RandomIter, class Distance>
 void push_heap_d(RandomIter first, RandomIter last, Distance*) {
+    typename iterator_traits<RandomIter>::value_type value =
+        mystl::move(*(last - 1));
     mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0),
-                         *(last - 1));
+                         mystl::move(value));
 }
 
 template <class RandomIter>
@@ -64,17 +66,19 @@ void push_heap_aux(RandomIter first, Distance holeIndex, Distance topIndex,
                    T value, Compared comp) {
     auto parent = (holeIndex - 1) / 2;
     while (holeIndex > topIndex && comp(*(first + parent), value)) {
-        *(first + holeIndex) = *(first + parent);
+        *(first + holeIndex) = mystl::move(*(first + parent));
         holeIndex = parent;
         parent = (holeIndex - 1) / 2;
     }
-    *(first + holeIndex) = value;
+    *(first + holeIndex) = mystl::move(value);
 }
 
 template <class RandomIter, class Distance, class Compared>
 void push_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp) {
+    typename iterator_traits<RandomIter>::value_type value =
+        mystl::move(*(last - 1));
     mystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0),
-                         *(last - 1), comp);
+                         mystl::move(value), comp);
 }
 
 template <class RandomIter, class Compared>
@@ -92,27 +96,30 @@ void adjust_heap(RandomIter first, Distance htoleIndex, Distance len, T value) {
         if (*(first + rchild) < *(first + rchild - 1)) {
             --rchild;
         }
-        *(first + htoleIndex) = *(first + rchild);
+        *(first + htoleIndex) = mystl::move(*(first + rchild));
         htoleIndex = rchild;
         rchild = 2 * (rchild + 1);
     }
     if (rchild == len) {
-        *(first + htoleIndex) = *(first + (rchild - 1));
+        *(first + htoleIndex) = mystl::move(*(first + (rchild - 1)));
         htoleIndex = rchild - 1;
     }
-    mystl::push_heap_aux(first, htoleIndex, topIndex, value);
+    mystl::push_heap_aux(first, htoleIndex, topIndex, mystl::move(value));
 }
 
 template <class RandomIter, class T, class Distance>
 void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result, T value,
                   Distance*) {
-    *result = *first;
-    mystl::adjust_heap(first, static_cast<Distance>(0), last - first, value);
+    *result = mystl::move(*first);
+    mystl::adjust_heap(first, static_cast<Distance>(0), last - first,
+                       mystl::move(value));
 }
 
 template <class RandomIter>
 void pop_heap(RandomIter first, RandomIter last) {
-    mystl::pop_heap_aux(first, last - 1, last - 1, *(last - 1),
+    typename iterator_traits<RandomIter>::value_type value =
+        mystl::move(*(last - 1));
+    mystl::pop_heap_aux(first, last - 1, last - 1, mystl::move(value),
                         distance_type(first));
 }
 
@@ -124,28 +131,31 @@ void adjust_heap(RandomIter first, Distance holeIndex, Distance len, T value,
     auto rchild = 2 * holeIndex + 2;
     while (rchild < len) {
         if (comp(*(first + rchild), *(first + rchild - 1))) --rchild;
-        *(first + holeIndex) = *(first + rchild);
+        *(first + holeIndex) = mystl::move(*(first + rchild));
         holeIndex = rchild;
         rchild = 2 * (rchild + 1);
     }
     if (rchild == len) {
-        *(first + holeIndex) = *(first + (rchild - 1));
+        *(first + holeIndex) = mystl::move(*(first + (rchild - 1)));
         holeIndex = rchild - 1;
     }
-    mystl::push_heap_aux(first, holeIndex, topIndex, value, comp);
+    mystl::push_heap_aux(first, holeIndex, topIndex, mystl::move(value),
+                         comp);
 }
 
 template <class RandomIter, class T, class Distance, class Compared>
 void pop_heap_aux(RandomIter first, RandomIter last, RandomIter result, T value,
                   Distance*, Compared comp) {
-    *result = *first;
-    mystl::adjust_heap(first, static_cast<Distance>(0), last - first, value,
-                       comp);
+    *result = mystl::move(*first);
+    mystl::adjust_heap(first, static_cast<Distance>(0), last - first,
+                       mystl::move(value), comp);
 }
 
 template <class RandomIter, class Compared>
 void pop_heap(RandomIter first, RandomIter last, Compared comp) {
-    mystl::pop_heap_aux(first, last - 1, last - 1, *(last - 1),
+    typename iterator_traits<RandomIter>::value_type value =
+        mystl::move(*(last - 1));
+    mystl::pop_heap_aux(first, last - 1, last - 1, mystl::move(value),
                         distance_type(first), comp);
 }
 
@@ -173,7 +183,9 @@ void make_heap_aux(RandomIter first, RandomIter last, Distance*) {
     auto len = last - first;
     auto holeIndex = (len - 2) / 2;
     while (true) {
-        mystl::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+        typename iterator_traits<RandomIter>::value_type value =
+            mystl::move(*(first + holeIndex));
+        mystl::adjust_heap(first, holeIndex, len, mystl::move(value));
         if (holeIndex == 0) {
             return;
         }
@@ -196,7 +208,9 @@ void make_heap_aux(RandomIter first, RandomIter last, Distance*,
     auto len = last - first;
     auto holeIndex = (len - 2) / 2;
     while (true) {
-        mystl::adjust_heap(first, holeIndex, len, *(first + holeIndex), comp);
+        typename iterator_traits<RandomIter>::value_type value =
+            mystl::move(*(first + holeIndex));
+        mystl::adjust_heap(first, holeIndex, len, mystl::move(value), comp);
         if (holeIndex == 0) {
             return;
         }
@@ -0,0 +1,530 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_INTRUSIVE_LIST_H_
+#define MYSTL_INTRUSIVE_LIST_H_
+
+// intrusive_list<T>: a doubly linked list of objects that carry their own
+// links in a hook, so linking allocates nothing and an element goes from its
+// address to its position in O(1). The list never owns its elements; they
+// must outlive their membership or use an auto-unlink hook.
+// An element derives from list_base_hook<Tag> (the tag tells several base
+// hooks apart) or holds a list_member_hook<> member, and the list names it
+// with base_hook<T, Tag> or member_hook<T, Hook, &T::member>. An auto-unlink
+// hook leaves its list when the element is destroyed or unlink() is called;
+// a list of those can't keep its size, so size() counts.
+// splice, merge, sort and reverse are the node algorithms of list.h.
+
+#include <cstddef>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "functional.h"
+#include "iterator.h"
+#include "list.h"
+#include "util.h"
+
+namespace mystl {
+
+// the links of a hook; null while the hook is in no list
+struct list_hook_node {
+    list_hook_node* prev;
+    list_hook_node* next;
+};
+
+template <bool AutoUnlink>
+class list_hook : public list_hook_node {
+   public:
+    static constexpr bool auto_unlink = AutoUnlink;
+
+    list_hook() noexcept {
+        prev = nullptr;
+        next = nullptr;
+    }
+
+    // a copied element is a new object, in no list
+    list_hook(const list_hook&) noexcept : list_hook() {}
+    list_hook& operator=(const list_hook&) noexcept { return *this; }
+
+    ~list_hook() {
+        if (AutoUnlink) {
+            unlink_self();
+        } else {
+            MYSTL_DEBUG(!is_linked());
+        }
+    }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+
+    // leave the list in O(1), without the list knowing
+    void unlink() noexcept {
+        static_assert(AutoUnlink, "only an auto-unlink hook can unlink itself");
+        unlink_self();
+    }
+
+   private:
+    void unlink_self() noexcept {
+        if (is_linked()) {
+            mystl::list_unlink_nodes(static_cast<list_hook_node*>(this),
+                                     static_cast<list_hook_node*>(this));
+            prev = nullptr;
+            next = nullptr;
+        }
+    }
+};
+
+template <bool AutoUnlink>
+constexpr bool list_hook<AutoUnlink>::auto_unlink;
+
+struct default_hook_tag {};
+
+template <class Tag = default_hook_tag, bool AutoUnlink = false>
+class list_base_hook : public list_hook<AutoUnlink> {};
+
+template <bool AutoUnlink = false>
+class list_member_hook : public list_hook<AutoUnlink> {};
+
+// the way from an element to its hook and back, for an element deriving
+// from list_base_hook<Tag>
+template <class T, class Tag = default_hook_tag>
+struct base_hook {
+    static constexpr bool auto_unlink =
+        std::is_base_of<list_base_hook<Tag, true>, T>::value;
+    typedef list_base_hook<Tag, auto_unlink> hook_type;
+
+    static_assert(std::is_base_of<hook_type, T>::value,
+                  "T must derive from list_base_hook<Tag>");
+
+    static list_hook_node* to_node(T& value) noexcept {
+        return static_cast<hook_type*>(&value);
+    }
+    static T* to_value(list_hook_node* node) noexcept {
+        return static_cast<T*>(static_cast<hook_type*>(node));
+    }
+};
+
+template <class T, class Tag>
+constexpr bool base_hook<T, Tag>::auto_unlink;
+
+// the same for an element holding the hook as the member Member
+template <class T, class Hook, Hook T::*Member>
+struct member_hook {
+    static constexpr bool auto_unlink = Hook::auto_unlink;
+    typedef Hook hook_type;
+
+    static list_hook_node* to_node(T& value) noexcept {
+        return &(value.*Member);
+    }
+    static T* to_value(list_hook_node* node) noexcept {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(node) - offset());
+    }
+
+   private:
+    // where the member sits, measured on uninitialized storage for a T
+    static ptrdiff_t offset() noexcept {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type probe;
+        T* p = reinterpret_cast<T*>(&probe);
+        return reinterpret_cast<char*>(&(p->*Member)) -
+               reinterpret_cast<char*>(p);
+    }
+};
+
+template <class T, class Hook, Hook T::*Member>
+constexpr bool member_hook<T, Hook, Member>::auto_unlink;
+
+template <class T, class ValueTraits, bool IsConst>
+struct intrusive_list_iterator
+    : public mystl::iterator<mystl::bidirectional_iterator_tag, T> {
+    typedef T value_type;
+    typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+    typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+    typedef intrusive_list_iterator<T, ValueTraits, IsConst> self;
+
+    list_hook_node* node_;
+
+    intrusive_list_iterator() noexcept : node_(nullptr) {}
+    explicit intrusive_list_iterator(list_hook_node* n) noexcept : node_(n) {}
+    // iterator to const_iterator
+    intrusive_list_iterator(
+        const intrusive_list_iterator<T, ValueTraits, false>& rhs) noexcept
+        : node_(rhs.node_) {}
+
+    reference operator*() const { return *ValueTraits::to_value(node_); }
+    pointer operator->() const { return ValueTraits::to_value(node_); }
+
+    self& operator++() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        MYSTL_DEBUG(node_ != nullptr);
+        node_ = node_->prev;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+// template class: intrusive_list
+template <class T, class ValueTraits = base_hook<T>>
+class intrusive_list {
+   public:
+    typedef ValueTraits value_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef intrusive_list_iterator<T, ValueTraits, false> iterator;
+    typedef intrusive_list_iterator<T, ValueTraits, true> const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static constexpr bool constant_time_size = !ValueTraits::auto_unlink;
+
+   private:
+    typedef list_hook_node* node_ptr;
+
+    struct node_value {
+        T& operator()(node_ptr p) const { return *ValueTraits::to_value(p); }
+    };
+
+    // the sentinel; the elements form a ring through it
+    list_hook_node root_;
+    // kept only with constant_time_size
+    size_type size_;
+
+   public:
+    intrusive_list() noexcept : size_(0) { init(); }
+
+    template <class Iter>
+    intrusive_list(Iter first, Iter last) : intrusive_list() {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    intrusive_list(intrusive_list&& rhs) noexcept : intrusive_list() {
+        swap(rhs);
+    }
+
+    intrusive_list& operator=(intrusive_list&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    // the elements are left unlinked
+    ~intrusive_list() { clear(); }
+
+   public:
+    iterator begin() noexcept { return iterator(root_.next); }
+    const_iterator begin() const noexcept {
+        return const_iterator(root_.next);
+    }
+    iterator end() noexcept { return iterator(&root_); }
+    const_iterator end() const noexcept { return const_iterator(root()); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    bool empty() const noexcept { return root_.next == root(); }
+
+    size_type size() const noexcept {
+        if (constant_time_size) {
+            return size_;
+        }
+        size_type n = 0;
+        for (node_ptr p = root_.next; p != root(); p = p->next) {
+            ++n;
+        }
+        return n;
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(--end());
+    }
+
+    // the position of an element of this list, from the element
+    iterator iterator_to(reference value) noexcept {
+        MYSTL_DEBUG(ValueTraits::to_node(value)->next != nullptr);
+        return iterator(ValueTraits::to_node(value));
+    }
+    const_iterator iterator_to(const_reference value) const noexcept {
+        return const_iterator(
+            ValueTraits::to_node(const_cast<reference>(value)));
+    }
+
+    // link value, which must be in no list, before pos
+    iterator insert(const_iterator pos, reference value) {
+        node_ptr n = ValueTraits::to_node(value);
+        MYSTL_DEBUG(n->next == nullptr);
+        mystl::list_link_nodes(pos.node_, n, n);
+        ++size_;
+        return iterator(n);
+    }
+
+    template <class Iter>
+    void insert(const_iterator pos, Iter first, Iter last) {
+        for (; first != last; ++first) {
+            insert(pos, *first);
+        }
+    }
+
+    void push_front(reference value) { insert(begin(), value); }
+    void push_back(reference value) { insert(end(), value); }
+
+    void pop_front() {
+        MYSTL_DEBUG(!empty());
+        erase(begin());
+    }
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        erase(--end());
+    }
+
+    // unlink, nothing is destroyed
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos != cend());
+        node_ptr next = pos.node_->next;
+        unlink_node(pos.node_);
+        --size_;
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last.node_);
+    }
+
+    // erase and hand the element to disposer, e.g. to delete it
+    template <class Disposer>
+    iterator erase_and_dispose(const_iterator pos, Disposer disposer) {
+        pointer value = ValueTraits::to_value(pos.node_);
+        iterator next = erase(pos);
+        disposer(value);
+        return next;
+    }
+
+    void clear() noexcept {
+        clear_and_dispose([](pointer) {});
+    }
+
+    template <class Disposer>
+    void clear_and_dispose(Disposer disposer) {
+        node_ptr p = root_.next;
+        init();
+        size_ = 0;
+        while (p != root()) {
+            node_ptr next = p->next;
+            p->prev = nullptr;
+            p->next = nullptr;
+            disposer(ValueTraits::to_value(p));
+            p = next;
+        }
+    }
+
+    void swap(intrusive_list& rhs) noexcept;
+
+   public:
+    // list operations, moving links only
+    void splice(const_iterator pos, intrusive_list& x);
+    void splice(const_iterator pos, intrusive_list& x, const_iterator it);
+    void splice(const_iterator pos, intrusive_list& x, const_iterator first,
+                const_iterator last);
+
+    template <class UnaryPredicate>
+    void remove_if(UnaryPredicate pred) {
+        for (auto f = begin(); f != end();) {
+            f = pred(*f) ? erase(f) : ++f;
+        }
+    }
+
+    void merge(intrusive_list& x) { merge(x, mystl::less<T>()); }
+
+    template <class Compare>
+    void merge(intrusive_list& x, Compare comp) {
+        if (this != &x) {
+            mystl::list_merge_nodes(&root_, &x.root_, node_value(), comp);
+            size_ += x.size_;
+            x.size_ = 0;
+        }
+    }
+
+    void sort() { sort(mystl::less<T>()); }
+
+    template <class Compare>
+    void sort(Compare comp) {
+        mystl::list_sort_nodes(&root_, node_value(), comp);
+    }
+
+    void reverse() noexcept {
+        if (!empty()) {
+            mystl::list_reverse_nodes(&root_);
+        }
+    }
+
+   private:
+    node_ptr root() const noexcept {
+        return const_cast<node_ptr>(&root_);
+    }
+
+    void init() noexcept {
+        root_.prev = &root_;
+        root_.next = &root_;
+    }
+
+    void unlink_node(node_ptr n) noexcept {
+        mystl::list_unlink_nodes(n, n);
+        n->prev = nullptr;
+        n->next = nullptr;
+    }
+};
+
+template <class T, class ValueTraits>
+constexpr bool intrusive_list<T, ValueTraits>::constant_time_size;
+
+template <class T, class ValueTraits>
+void intrusive_list<T, ValueTraits>::swap(intrusive_list& rhs) noexcept {
+    if (this == &rhs) {
+        return;
+    }
+    list_hook_node tmp;
+    tmp.prev = tmp.next = &tmp;
+    // move each ring onto its new sentinel through tmp
+    if (!empty()) {
+        mystl::list_link_nodes(&tmp, root_.next, root_.prev);
+        init();
+    }
+    if (!rhs.empty()) {
+        mystl::list_link_nodes(&root_, rhs.root_.next, rhs.root_.prev);
+        rhs.init();
+    }
+    if (tmp.next != &tmp) {
+        mystl::list_link_nodes(&rhs.root_, tmp.next, tmp.prev);
+    }
+    mystl::swap(size_, rhs.size_);
+}
+
+template <class T, class ValueTraits>
+void intrusive_list<T, ValueTraits>::splice(const_iterator pos,
+                                            intrusive_list& x) {
+    MYSTL_DEBUG(this != &x);
+    if (!x.empty()) {
+        node_ptr f = x.root_.next;
+        node_ptr l = x.root_.prev;
+        mystl::list_unlink_nodes(f, l);
+        mystl::list_link_nodes(pos.node_, f, l);
+        size_ += x.size_;
+        x.size_ = 0;
+    }
+}
+
+template <class T, class ValueTraits>
+void intrusive_list<T, ValueTraits>::splice(const_iterator pos,
+                                            intrusive_list& x,
+                                            const_iterator it) {
+    if (pos.node_ != it.node_ && pos.node_ != it.node_->next) {
+        node_ptr f = it.node_;
+        mystl::list_unlink_nodes(f, f);
+        mystl::list_link_nodes(pos.node_, f, f);
+        ++size_;
+        --x.size_;
+    }
+}
+
+// counts the range only to keep constant_time_size, and not at all when
+// it moves within this list
+template <class T, class ValueTraits>
+void intrusive_list<T, ValueTraits>::splice(const_iterator pos,
+                                            intrusive_list& x,
+                                            const_iterator first,
+                                            const_iterator last) {
+    if (first != last && pos != last) {
+        if (constant_time_size && this != &x) {
+            size_type n = mystl::distance(first, last);
+            size_ += n;
+            x.size_ -= n;
+        }
+        node_ptr f = first.node_;
+        node_ptr l = last.node_->prev;
+        mystl::list_unlink_nodes(f, l);
+        mystl::list_link_nodes(pos.node_, f, l);
+    }
+}
+
+template <class T, class ValueTraits>
+void swap(intrusive_list<T, ValueTraits>& lhs,
+          intrusive_list<T, ValueTraits>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
+#endif
@@ -26,7 +26,9 @@
 #ifndef MYSTL_LIST_H_
 #define MYSTL_LIST_H_
 // template class: bidirectional list
+#include <cstddef>
 #include <initializer_list>
+#include <type_traits>
 
 #include "exceptdef.h"
 #include "functional.h"
@@ -64,11 +66,11 @@ struct list_node : public list_node_base<T> {
     typedef typename node_traits<T>::node_ptr node_ptr;
     T value;
     list_node() = default;
-    list_node(const T& V) : value(v) {}
+    list_node(const T& v) : value(v) {}
 
     list_node(T&& v) : value(mystl::move(v)) {}
 
-    base_ptr as_node() { return static_cast<base_ptr>(&*this); }
+    base_ptr as_base() { return static_cast<base_ptr>(&*this); }
 
     node_ptr self() { return static_cast<node_ptr>(&*this); }
 };
@@ -88,8 +90,6 @@ struct list_iterator
 
     list_iterator(node_ptr x) : node_(x->as_base()) {}
 
-    list_iterator(const list_iterator& rhs) : node_(rhs.node_) {}
-
     reference operator*() const { return node_->as_node()->value; }
 
     pointer operator->() const { return &(operator*()); }
@@ -107,7 +107,7 @@ struct list_iterator
     }
 
     self& operator--() {
-        MYSTL_DEBUG(node != nullptr);
+        MYSTL_DEBUG(node_ != nullptr);
         node_ = node_->prev;
         return *this;
     }
@@ -139,7 +139,6 @@ struct list_const_iterator : public iterator<bidirectional_iterator_tag, T> {
 
     list_const_iterator(const list_iterator<T>& rhs) : node_(rhs.node_) {}
 
-    list_const_iterator(const list_const_iterator& rhs) : node_(rhs.node_) {}
 
     reference operator*() const { return node_->as_node()->value; }
 
@@ -174,85 +173,349 @@ struct list_const_iterator : public iterator<bidirectional_iterator_tag, T> {
     bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
 };
 
+// the algorithms below work on a ring of nodes linked through prev and next
+// around a sentinel root, for list and intrusive_list alike; value(p) is the
+// element of node p
+
+// link nodes in range [first, last] before pos
+template <class NodePtr>
+void list_link_nodes(NodePtr pos, NodePtr first, NodePtr last) {
+    pos->prev->next = first;
+    first->prev = pos->prev;
+    pos->prev = last;
+    last->next = pos;
+}
+
+template <class NodePtr>
+void list_unlink_nodes(NodePtr first, NodePtr last) {
+    first->prev->next = last->next;
+    last->next->prev = first->prev;
+}
+
+template <class NodePtr>
+void list_reverse_nodes(NodePtr root) {
+    NodePtr p = root;
+    do {
+        mystl::swap(p->prev, p->next);
+        p = p->prev;
+    } while (p != root);
+}
+
+// move the nodes of the sorted ring other into the sorted ring root; nodes of
+// root come first among equal ones
+template <class NodePtr, class Value, class Compare>
+void list_merge_nodes(NodePtr root, NodePtr other, Value value,
+                      Compare& comp) {
+    NodePtr f1 = root->next;
+    NodePtr f2 = other->next;
+    while (f1 != root && f2 != other) {
+        if (comp(value(f2), value(f1))) {
+            NodePtr next = f2->next;
+            for (; next != other && comp(value(next), value(f1));
+                 next = next->next)
+                ;
+            NodePtr l = next->prev;
+            list_unlink_nodes(f2, l);
+            list_link_nodes(f1, f2, l);
+            f2 = next;
+        }
+        f1 = f1->next;
+    }
+
+    if (f2 != other) {
+        NodePtr l = other->prev;
+        list_unlink_nodes(f2, l);
+        list_link_nodes(root, f2, l);
+    }
+}
+
+// merge two runs chained through next and ended by nullptr; a's nodes come
+// first among equal ones
+template <class NodePtr, class Value, class Compare>
+NodePtr list_merge_runs(NodePtr a, NodePtr b, Value& value, Compare& comp) {
+    typename std::remove_pointer<NodePtr>::type head;
+    NodePtr tail = &head;
+    while (a != nullptr && b != nullptr) {
+        if (comp(value(b), value(a))) {
+            tail->next = b;
+            tail = b;
+            b = b->next;
+        } else {
+            tail->next = a;
+            tail = a;
+            a = a->next;
+        }
+    }
+    tail->next = a != nullptr ? a : b;
+    return head.next;
+}
+
+// the last merge also restores prev and closes the ring at root, saving a
+// pass over nodes that are by now scattered in memory
+template <class NodePtr, class Value, class Compare>
+void list_link_runs(NodePtr root, NodePtr a, NodePtr b, Value& value,
+                    Compare& comp) {
+    NodePtr tail = root;
+    while (a != nullptr && b != nullptr) {
+        NodePtr x;
+        if (comp(value(b), value(a))) {
+            x = b;
+            b = b->next;
+        } else {
+            x = a;
+            a = a->next;
+        }
+        tail->next = x;
+        x->prev = tail;
+        tail = x;
+    }
+    for (NodePtr x = a != nullptr ? a : b; x != nullptr; x = x->next) {
+        tail->next = x;
+        x->prev = tail;
+        tail = x;
+    }
+    tail->next = root;
+    root->prev = tail;
+}
+
+// bottom-up merge sort: cut the ring into its natural runs (a strictly
+// descending one is reversed, which keeps it stable) and merge them like a
+// binary counter, bin i holding 2^i runs. Only next is maintained until the
+// last merge
+template <class NodePtr, class Value, class Compare>
+void list_sort_nodes(NodePtr root, Value value, Compare& comp) {
+    if (root->next == root || root->next->next == root) {
+        return;
+    }
+
+    NodePtr bins[64] = {};
+    NodePtr p = root->next;
+    while (p != root) {
+        NodePtr run = p;
+        NodePtr next = p->next;
+        if (next != root && comp(value(next), value(p))) {
+            run->next = nullptr;
+            while (next != root && comp(value(next), value(run))) {
+                NodePtr after = next->next;
+                next->next = run;
+                run = next;
+                next = after;
+            }
+        } else {
+            while (next != root && !comp(value(next), value(p))) {
+                p = next;
+                next = p->next;
+            }
+            p->next = nullptr;
+        }
+        p = next;
+
+        size_t i = 0;
+        for (; bins[i] != nullptr; ++i) {
+            run = list_merge_runs(bins[i], run, value, comp);
+            bins[i] = nullptr;
+        }
+        bins[i] = run;
+    }
+
+    size_t top = 63;
+    while (bins[top] == nullptr) {
+        --top;
+    }
+    NodePtr rest = nullptr;
+    for (size_t i = 0; i != top; ++i) {
+        if (bins[i] == nullptr) {
+            continue;
+        }
+        rest = rest == nullptr ? bins[i]
+                               : list_merge_runs(bins[i], rest, value, comp);
+    }
+    list_link_runs(root, bins[top], rest, value, comp);
+}
+
 template <class T>
-class list {
+struct list_node_value {
+    T& operator()(list_node_base<T>* p) const { return p->as_node()->value; }
+};
+
+template <class T, class Alloc = mystl::allocator<T>>
+class list
+    : private mystl::alloc_storage<typename mystl::allocator_traits<
+          Alloc>::template rebind_alloc<list_node<T>>> {
    public:
-    typedef mystl::allocator<T> allocator_type;
-    typedef mystl::allocator<T> data_allocator;
-    typedef mystl::allocator<list_node_base<T>> base_allocator;
-    typedef mystl::allocator<list_node<T>> node_allocator;
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef mystl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<T> data_allocator;
+    typedef typename alloc_traits::template rebind_alloc<list_node_base<T>>
+        base_allocator;
+    typedef typename alloc_traits::template rebind_alloc<list_node<T>>
+        node_allocator;
+    typedef mystl::allocator_traits<base_allocator> base_alloc_traits;
+    typedef mystl::allocator_traits<node_allocator> node_alloc_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename node_alloc_traits::size_type size_type;
+    typedef typename node_alloc_traits::difference_type difference_type;
     typedef list_iterator<T> iterator;
     typedef list_const_iterator<T> const_iterator;
     typedef mystl::reverse_iterator<iterator> reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
     typedef typename node_traits<T>::base_ptr base_ptr;
     typedef typename node_traits<T>::node_ptr node_ptr;
-    allocator_type get_allocator() { return node_allocator(); }
+    allocator_type get_allocator() const {
+        return allocator_type(node_alloc());
+    }
 
    private:
+    typedef mystl::alloc_storage<node_allocator> alloc_base;
+
     base_ptr node_;
     size_type size_;
 
+    node_allocator& node_alloc() noexcept { return alloc_base::get_alloc(); }
+    const node_allocator& node_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
    public:
     list() { fill_init(0, value_type()); }
 
-    explicit list(size_type n) { fill_init(n, value_type()); }
+    explicit list(const allocator_type& alloc)
+        : alloc_base(node_allocator(alloc)) {
+        fill_init(0, value_type());
+    }
 
-    list(size_type n, const T& value) { fill_init(n, value); }
+    explicit list(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_base(node_allocator(alloc)) {
+        fill_init(n, value_type());
+    }
+
+    list(size_type n, const T& value,
+         const allocator_type& alloc = allocator_type())
+        : alloc_base(node_allocator(alloc)) {
+        fill_init(n, value);
+    }
 
     template <class Iter,
               typename std::enable_if<mystl::is_input_iterator<Iter>::value,
                                       int>::type = 0>
-    list(Iter first, Iter last) {
+    list(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : alloc_base(node_allocator(alloc)) {
         copy_init(first, last);
     }
 
-    list(std::initializer_list<T> ilist) {
+    list(std::initializer_list<T> ilist,
+         const allocator_type& alloc = allocator_type())
+        : alloc_base(node_allocator(alloc)) {
         copy_init(ilist.begin(), ilist.end());
     }
 
-    list(const list& rhs) { copy_init(rhs.cbegin(), rhs.cend()); }
+    list(const list& rhs)
+        : alloc_base(node_alloc_traits::select_on_container_copy_construction(
+              rhs.node_alloc())) {
+        copy_init(rhs.cbegin(), rhs.cend());
+    }
 
-    list(list&& rhs) noexcept : node_(rhs.node_), size_(rhs.size_) {
+    list(const list& rhs, const allocator_type& alloc)
+        : alloc_base(node_allocator(alloc)) {
+        copy_init(rhs.cbegin(), rhs.cend());
+    }
+
+    list(list&& rhs) noexcept
+        : alloc_base(mystl::move(rhs.node_alloc())),
+          node_(rhs.node_),
+          size_(rhs.size_) {
         rhs.node_ = nullptr;
         rhs.size_ = 0;
     }
 
+    list(list&& rhs, const allocator_type& alloc)
+        : alloc_base(node_allocator(alloc)) {
+        fill_init(0, value_type());
+        if (mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+            splice(end(), rhs);
+        } else {
+            for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+                emplace_back(mystl::move(*it));
+            }
+        }
+    }
+
     list& operator=(const list& rhs) {
         if (this != &rhs) {
+            if (node_alloc_traits::propagate_on_container_copy_assignment::
+                    value &&
+                !mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+                // nodes of the old allocator go back to it first
+                release_nodes();
+                mystl::alloc_on_copy(node_alloc(), rhs.node_alloc());
+            }
             assign(rhs.begin(), rhs.end());
         }
 
         return *this;
     }
 
-    list& operator=(list&& rhs) noexcept {
-        clear();
-        splice(end(), rhs);
+    list& operator=(list&& rhs) noexcept(
+        node_alloc_traits::propagate_on_container_move_assignment::value ||
+        node_alloc_traits::is_always_equal::value) {
+        if (this == &rhs) {
+            return *this;
+        }
+        if (mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+            clear();
+            splice(end(), rhs);
+        } else if (node_alloc_traits::propagate_on_container_move_assignment::
+                       value) {
+            release_nodes();
+            mystl::alloc_on_move(node_alloc(), rhs.node_alloc());
+            node_ = rhs.node_;
+            size_ = rhs.size_;
+            rhs.node_ = nullptr;
+            rhs.size_ = 0;
+        } else {
+            // can't steal nodes owned by another allocator
+            auto f1 = begin();
+            auto l1 = end();
+            auto f2 = rhs.begin();
+            auto l2 = rhs.end();
+            for (; f1 != l1 && f2 != l2; ++f1, ++f2) {
+                *f1 = mystl::move(*f2);
+            }
+            erase(f1, l1);
+            for (; f2 != l2; ++f2) {
+                emplace_back(mystl::move(*f2));
+            }
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    list& operator=(std::initializer_list<T> ilist) {
+        copy_assign(ilist.begin(), ilist.end());
         return *this;
     }
 
     ~list() {
         if (node_) {
             clear();
-            base_allocator::deallocate(node_);
-            node_ = nullptr;
+            destroy_sentinel();
             size_ = 0;
+            node_alloc_traits::release(node_alloc());
         }
     }
 
    public:
     // functions about iterator
-    iterator begin() noexcept { return node_->next; }
+    // a list without a sentinel is empty, begin() is end() then
+    iterator begin() noexcept { return node_ ? node_->next : node_; }
 
-    const_iterator begin() const noexcept { return node_->next; }
+    const_iterator begin() const noexcept {
+        return node_ ? node_->next : node_;
+    }
 
     iterator end() noexcept { return node_; }
 
@@ -261,25 +524,25 @@ class list {
     reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
 
     const_reverse_iterator rbegin() const noexcept {
-        return reverse_iterator(end());
+        return const_reverse_iterator(end());
     }
 
     reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
 
     const_reverse_iterator rend() const noexcept {
-        return reverse_iterator(begin());
+        return const_reverse_iterator(begin());
     }
 
     const_iterator cbegin() const noexcept { return begin(); }
 
     const_iterator cend() const noexcept { return end(); }
 
-    const_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
 
-    const_iterator crend() const noexcept { return rend(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
 
     // functions about capacity
-    bool empty() const noexcept { return node_->next == node_; }
+    bool empty() const noexcept { return size_ == 0; }
 
     size_type size() const noexcept { return size_; }
 
@@ -307,7 +570,7 @@ class list {
     }
 
     // functions about modifying list
-    void assign(size_type n, const value_type& value) { fill_assign(n, vlaue); }
+    void assign(size_type n, const value_type& value) { fill_assign(n, value); }
 
     template <class Iter,
               typename std::enable_if<mystl::is_input_iterator<Iter>::value,
@@ -317,21 +580,23 @@ class list {
     }
 
     void assign(std::initializer_list<T> ilist) {
-        copy_assign(ilist.begin(), ilist.end());)
+        copy_assign(ilist.begin(), ilist.end());
     }
 
     template <class... Args>
     void emplace_front(Args&&... args) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
-        auto link_node = create_node(mystl::forward(Args > (args)...));
+        require_sentinel(end());
+        auto link_node = create_node(mystl::forward<Args>(args)...);
         link_nodes_at_front(link_node->as_base(), link_node->as_base());
         ++size_;
     }
 
     template <class... Args>
-    void emplace_front(Args&&... args) {
+    void emplace_back(Args&&... args) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
-        auto link_node = create_node(mystl::forward(Args > (args)...));
+        require_sentinel(end());
+        auto link_node = create_node(mystl::forward<Args>(args)...);
         link_nodes_at_back(link_node->as_base(), link_node->as_base());
         ++size_;
     }
@@ -339,14 +604,16 @@ class list {
     template <class... Args>
     iterator emplace(const_iterator pos, Args&&... args) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
-        auto link_node = create_node(mystl::forward(Args > (args)...));
+        pos = require_sentinel(pos);
+        auto link_node = create_node(mystl::forward<Args>(args)...);
         link_nodes(pos.node_, link_node->as_base(), link_node->as_base());
         ++size_;
         return iterator(link_node);
     }
 
     iterator insert(const_iterator pos, const value_type& value) {
-        THROW_LENGTH_ERROR_IF(size_ > max_size - 1, "list<T>'s size too big");
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+        pos = require_sentinel(pos);
         auto link_node = create_node(value);
         ++size_;
         return link_iter_node(pos, link_node->as_base());
@@ -354,6 +621,7 @@ class list {
 
     iterator insert(const_iterator pos, value_type&& value) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+        pos = require_sentinel(pos);
         auto link_node = create_node(mystl::move(value));
         ++size_;
         return link_iter_node(pos, link_node->as_base());
@@ -361,7 +629,7 @@ class list {
 
     iterator insert(const_iterator pos, size_type n, const value_type& value) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
-        return fill_insert(pos, n, value);
+        return fill_insert(require_sentinel(pos), n, value);
     }
 
     template <class Iter,
@@ -370,11 +638,12 @@ class list {
     iterator insert(const_iterator pos, Iter first, Iter last) {
         size_type n = mystl::distance(first, last);
         THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
-        return copy_insert(pos, n, first);
+        return copy_insert(require_sentinel(pos), n, first);
     }
 
     void push_front(const value_type& value) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+        require_sentinel(end());
         auto link_node = create_node(value);
         link_nodes_at_front(link_node->as_base(), link_node->as_base());
         ++size_;
@@ -384,6 +653,7 @@ class list {
 
     void push_back(const value_type& value) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+        require_sentinel(end());
         auto link_node = create_node(value);
         link_nodes_at_back(link_node->as_base(), link_node->as_base());
         ++size_;
@@ -414,6 +684,7 @@ class list {
 
     void resize(size_type new_size, const value_type& value);
     void swap(list& rhs) noexcept {
+        mystl::alloc_on_swap(node_alloc(), rhs.node_alloc());
         mystl::swap(node_, rhs.node_);
         mystl::swap(size_, rhs.size_);
     }
@@ -436,11 +707,13 @@ class list {
 
     template <class Compred>
     void merge(list& x, Compred comp);
-    void sort() { list_sort(begin(), end(), size(), mystl::less<T>()); }
+    void sort() { sort(mystl::less<T>()); }
 
     template <class Compred>
     void sort(Compred comp) {
-        list_sort(begin(), end(), size(), comp);
+        if (size_ > 1) {
+            mystl::list_sort_nodes(node_, list_node_value<T>(), comp);
+        }
     }
 
     void reverse();
@@ -450,6 +723,10 @@ class list {
     template <class... Args>
     node_ptr create_node(Args&&... args);
     void destroy_node(node_ptr p);
+    void create_sentinel();
+    void destroy_sentinel();
+    const_iterator require_sentinel(const_iterator pos);
+    void release_nodes();
     void fill_init(size_type n, const value_type& value);
     template <class Iter>
     void copy_init(Iter first, Iter last);
@@ -465,13 +742,10 @@ class list {
                          const value_type& vlaue);
     template <class Iter>
     iterator copy_insert(const_iterator pos, size_type n, Iter first);
-    template <class Compred>
-    iterator list_sort(iterator first, iterator last, size_type n,
-                       Compred comp);
 };
 
-template <class T>
-typename list<T>::iterator list<T>::erase(const_iterator pos) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator pos) {
     MYSTL_DEBUG(pos != cend());
     auto n = pos.node_;
     auto next = n->next;
@@ -481,8 +755,8 @@ typename list<T>::iterator list<T>::erase(const_iterator pos) {
     return iterator(next);
 }
 
-template <class T>
-typename list<T>::iterator list<T>::erase(const_iterator first,
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator first,
                                           const_iterator last) {
     if (first != last) {
         unlink_nodes(first.node_, last.node_->prev);
@@ -497,8 +771,8 @@ typename list<T>::iterator list<T>::erase(const_iterator first,
     return iterator(last.node_);
 }
 
-template <class T>
-void list<T>::clear() {
+template <class T, class Alloc>
+void list<T, Alloc>::clear() {
     if (size_ != 0) {
         auto cur = node_->next;
         for (base_ptr next = cur->next; cur != node_;
@@ -511,8 +785,8 @@ void list<T>::clear() {
     }
 }
 
-template <class T>
-void list<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size, const value_type& value) {
     auto i = begin();
     size_type len = 0;
     while (i != end() && len < new_size) {
@@ -527,25 +801,27 @@ void list<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
-template <class T>
-void list<T>::splice(const_iterator pos, list& x) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x) {
     MYSTL_DEBUG(this != &x);
     if (!x.empty()) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_,
                               "list<T>'s size too big");
+        pos = require_sentinel(pos);
         auto f = x.node_->next;
         auto l = x.node_->prev;
         x.unlink_nodes(f, l);
-        link_nodes(pos.node_, f l);
+        link_nodes(pos.node_, f, l);
         size_ += x.size_;
         x.size_ = 0;
     }
 }
 
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator it) {
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator it) {
     if (pos.node_ != it.node_ && pos.node_ != it.node_->next) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - 1, "list<T>'s size too big");
+        pos = require_sentinel(pos);
         auto f = it.node_;
         x.unlink_nodes(f, f);
         link_nodes(pos.node_, f, f);
@@ -554,24 +830,30 @@ void list<T>::splice(const_iterator pos, list& x, const_iterator it) {
     }
 }
 
-template <class T>
-void list<T>::splice(const_iterator pos, list& x, const_iterator first,
+template <class T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& x, const_iterator first,
                      const_iterator last) {
-    if (first != last && this != &x) {
-        size_type n = mystl::distance(first, last);
+    if (first == last || pos == last) {
+        return;
+    }
+    // within one list the size doesn't change, so the range isn't counted
+    size_type n = 0;
+    if (this != &x) {
+        n = mystl::distance(first, last);
         THROW_LENGTH_ERROR_IF(size_ > max_size() - n, "list<T>'s size too big");
-        auto f = first.node_;
-        auto l = last.node_->prev;
-        x.unlink_nodes(f, l);
-        link_nodes(pos.node_, f, l);
-        size_ += n;
-        x.size_ -= n;
+        pos = require_sentinel(pos);
     }
+    auto f = first.node_;
+    auto l = last.node_->prev;
+    x.unlink_nodes(f, l);
+    link_nodes(pos.node_, f, l);
+    size_ += n;
+    x.size_ -= n;
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class UnaryPredicate>
-void list<T>::remove_if(UnaryPredicate pred) {
+void list<T, Alloc>::remove_if(UnaryPredicate pred) {
     auto f = begin();
     auto l = end();
     for (auto next = f; f != l; f = next) {
@@ -582,9 +864,9 @@ void list<T>::remove_if(UnaryPredicate pred) {
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class BinaryPredicate>
-void list<T>::unique(BinaryPredicate pred) {
+void list<T, Alloc>::unique(BinaryPredicate pred) {
     auto i = begin();
     auto e = end();
     auto j = i;
@@ -601,109 +883,108 @@ void list<T>::unique(BinaryPredicate pred) {
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class Compare>
-void list<T>::merge(list& x, Compare comp) {
-    if (this != &x) {
+void list<T, Alloc>::merge(list& x, Compare comp) {
+    if (this != &x && !x.empty()) {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - x.size_,
                               "list<T>'s size too big");
-        auto f1 = begin();
-        auto l1 = end();
-        auto f2 = x.begin();
-        auto l2 = x.end();
-        while (f1 != l1 && f2 != l2) {
-            if (comp(*f2, *f1)) {
-                auto next = f2;
-                ++next;
-                for (; next != l2 && comp(*next, *f1); ++next)
-                    ;
-                auto f = f2.node_;
-                auto l = next.node_->prev;
-                f2 = next;
-                x.unlink_nodes(f, l);
-                link_nodes(f1.node_, f, l);
-                ++f1;
-            } else {
-                ++f1;
-            }
-        }
-
-        if (f2 != l2) {
-            auto f = f2.node_;
-            auto l = l2.node_->prev;
-            x.unlink_nodes(f, l);
-            link_nodes(l1.node, f, l);
-        }
-
+        require_sentinel(end());
+        mystl::list_merge_nodes(node_, x.node_, list_node_value<T>(), comp);
         size_ += x.size_;
         x.size_ = 0;
     }
 }
 
-template <class T>
-void list<T>::reverse() {
+template <class T, class Alloc>
+void list<T, Alloc>::reverse() {
     if (size_ <= 1) {
         return;
     }
 
-    auto i = begin();
-    auto e = end();
-    while (i.node_ != e.node_) {
-        mystl::swap(i.node_->prev, i.node_->next);
-        i.node_ = i.node_->prev;
-    }
-
-    mystl::swap(e.node_->prev, e.node_->next);
+    mystl::list_reverse_nodes(node_);
 }
 
 // helper function
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename list<T>::node_ptr list<T>::create_node(Args&&... args) {
-    node_ptr p = node_allocator::allocate(1);
+typename list<T, Alloc>::node_ptr list<T, Alloc>::create_node(Args&&... args) {
+    node_ptr p = node_alloc_traits::allocate(node_alloc(), 1);
     try {
-        data_allocator::construct(mystl::address_of(p->value),
-                                  mystl::forward<Args>(args)...);
+        node_alloc_traits::construct(node_alloc(), mystl::address_of(p->value),
+                                     mystl::forward<Args>(args)...);
         p->prev = nullptr;
         p->next = nullptr;
     } catch (...) {
-        node_allocator::deallocate(p);
+        node_alloc_traits::deallocate(node_alloc(), p, 1);
         throw;
     }
 
     return p;
 }
 
-template <class T>
-void list<T>::destroy_node(node_ptr p) {
-    data_allocator::destroy(mystl::address_of(p->value));
-    node_allocator::deallocate(p);
+template <class T, class Alloc>
+void list<T, Alloc>::destroy_node(node_ptr p) {
+    node_alloc_traits::destroy(node_alloc(), mystl::address_of(p->value));
+    node_alloc_traits::deallocate(node_alloc(), p, 1);
 }
 
-template <class T>
-void list<T>::fill_init(size_type n, const value_type& value) {
-    node_ = base_allocator::allocate(1);
+template <class T, class Alloc>
+void list<T, Alloc>::create_sentinel() {
+    base_allocator alloc(node_alloc());
+    node_ = base_alloc_traits::allocate(alloc, 1);
     node_->unlink();
+}
+
+template <class T, class Alloc>
+void list<T, Alloc>::destroy_sentinel() {
+    base_allocator alloc(node_alloc());
+    base_alloc_traits::deallocate(alloc, node_, 1);
+    node_ = nullptr;
+}
+
+// a moved-from list has no sentinel until its next insertion creates one;
+// pos can then only be end(), and is returned as the new end()
+template <class T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::require_sentinel(
+    const_iterator pos) {
+    if (node_ == nullptr) {
+        create_sentinel();
+        return end();
+    }
+    return pos;
+}
+
+// drop every node and the sentinel, ahead of an allocator change
+template <class T, class Alloc>
+void list<T, Alloc>::release_nodes() {
+    clear();
+    if (node_ != nullptr) {
+        destroy_sentinel();
+    }
+}
+
+template <class T, class Alloc>
+void list<T, Alloc>::fill_init(size_type n, const value_type& value) {
+    create_sentinel();
     size_ = n;
     try {
         for (; n > 0; --n) {
             auto node = create_node(value);
-            link_nodes_at_back(node->as_base(), node->base());
+            link_nodes_at_back(node->as_base(), node->as_base());
         }
 
     } catch (...) {
         clear();
-        base_allocator::deallocate(node_);
-        node_ = nullptr;
+        destroy_sentinel();
         throw;
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_init(Iter first, Iter last) {
-    node_ = base_allocator::allocate(1);
-    node_->unlink();
+void list<T, Alloc>::copy_init(Iter first, Iter last) {
+    create_sentinel();
     size_type n = mystl::distance(first, last);
     size_ = n;
     try {
@@ -714,15 +995,14 @@ void list<T>::copy_init(Iter first, Iter last) {
 
     } catch (...) {
         clear();
-        base_allocator::deallocate(node_);
-        node_ = nullptr;
+        destroy_sentinel();
         throw;
     }
 }
 
-template <class T>
-typename list<T>::iterator list<T>::link_iter_node(const_iterator pos,
-                                                   base_ptr link_node) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::link_iter_node(
+    const_iterator pos, base_ptr link_node) {
     if (pos == node_->next) {
         link_nodes_at_front(link_node, link_node);
     } else if (pos == node_) {
@@ -735,38 +1015,28 @@ typename list<T>::iterator list<T>::link_iter_node(const_iterator pos,
 }
 
 // link nodes in range [first, last] before pos
-template <class T>
-void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
-    pos->prev->next = first;
-    first->prev = pos->prev;
-    pos->prev = last;
-    last->next = pos;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
+    mystl::list_link_nodes(pos, first, last);
 }
 
-template <class T>
-void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
-    first->prev = node_;
-    last->next = node_->next;
-    last->next->prev = last;
-    node_->next = first;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_front(base_ptr first, base_ptr last) {
+    mystl::list_link_nodes(node_->next, first, last);
 }
 
-template <class T>
-void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
-    last->next = node_;
-    first->prev = node_->prev;
-    first->prev->next = first;
-    node_->prev = last;
+template <class T, class Alloc>
+void list<T, Alloc>::link_nodes_at_back(base_ptr first, base_ptr last) {
+    mystl::list_link_nodes(node_, first, last);
 }
 
-template <class T>
-void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
-    first->prev->next = last->next;
-    last->next->prev = first->prev;
+template <class T, class Alloc>
+void list<T, Alloc>::unlink_nodes(base_ptr first, base_ptr last) {
+    mystl::list_unlink_nodes(first, last);
 }
 
-template <class T>
-void list<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc>
+void list<T, Alloc>::fill_assign(size_type n, const value_type& value) {
     auto i = begin();
     auto e = end();
     for (; n > 0 && i != e; --n, ++i) {
@@ -780,9 +1050,9 @@ void list<T>::fill_assign(size_type n, const value_type& value) {
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void list<T>::copy_assign(Iter f2, Iter l2) {
+void list<T, Alloc>::copy_assign(Iter f2, Iter l2) {
     auto f1 = begin();
     auto l1 = end();
     for (; f1 != l1 && f2 != l2; ++f1, ++f2) {
@@ -796,9 +1066,9 @@ void list<T>::copy_assign(Iter f2, Iter l2) {
     }
 }
 
-template <class T>
-typename list<T>::iterator list<T>::fill_insert(const_iterator pos, size_type n,
-                                                const value_type& value) {
+template <class T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::fill_insert(
+    const_iterator pos, size_type n, const value_type& value) {
     iterator r(pos.node_);
     if (n != 0) {
         const auto add_size = n;
@@ -835,10 +1105,10 @@ typename list<T>::iterator list<T>::fill_insert(const_iterator pos, size_type n,
     return r;
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-typename list<T>::iterator list<T>::copy_insert(const_iterator pos, size_type n,
-                                                Iter first) {
+typename list<T, Alloc>::iterator list<T, Alloc>::copy_insert(
+    const_iterator pos, size_type n, Iter first) {
     iterator r(pos.node_);
     if (n != 0) {
         const auto add_size = n;
@@ -853,9 +1123,10 @@ typename list<T>::iterator list<T>::copy_insert(const_iterator pos, size_type n,
                 next->prev = end.node_;
             }
 
-            size += add_size;
+            size_ += add_size;
         } catch (...) {
-            auto enode = end.node_ while (true) {
+            auto enode = end.node_;
+            while (true) {
                 auto prev = enode->prev;
                 destroy_node(enode->as_node());
                 if (prev == nullptr) {
@@ -874,76 +1145,9 @@ typename list<T>::iterator list<T>::copy_insert(const_iterator pos, size_type n,
     return r;
 }
 
-template <class T>
-template <class Compred>
-typename list<T>::iterator list<T>::list_sort(iterator f1, iterator l2,
-                                              size_type n, Compred comp) {
-    if (n < 2) {
-        return f1;
-    }
-
-    if (n = 2) {
-        if (comp(*--l2, *f1)) {
-            auto ln = l2.node_;
-            unlink_nodes(ln, ln);
-            link_nodes(f1.node_, ln, ln);
-            return l2;
-        }
-
-        return f1;
-    }
-
-    auto n2 = n / 2； auto l1 = f1;
-    mystl::advance(l1, n2);
-    auto result = f1 = list_sort(f1, l1, n2, comp);
-    auto f2 = f1 = list_sort(l1, l2, n - n2, comp);
-    if (comp(*f2, *f1)) {
-        auto m = f2;
-        ++m;
-        for (; m != l2 && comp(*m, *f1); ++m)
-            ;
-        auto f = f2.node_;
-        auto l = m.node_->prev;
-        result = f2;
-        l1 = f2 = m;
-        unlink_nodes(f, l);
-        m = f1;
-        ++m;
-        link_nodes(f1.node_, f, l);
-        f1 = m;
-    } else {
-        ++f1;
-    }
-
-    while (f1 != l1 && f2 != l2) {
-        if (comp(*f2, *f1)) {
-            auto m = f2;
-            ++m;
-            for (; m != l2 && comp(*m, *f1); ++m)
-                ;
-            auto f = f2.node_;
-            auto l = m.node_->prev;
-            if (l1 == f2) {
-                l1 = m;
-            }
-
-            f2 = m;
-            unlink_nodes(f, l);
-            m = f1;
-            ++m;
-            link_nodes(f1.node_, f, l);
-            f1 = m;
-        } else {
-            ++f1;
-        }
-    }
-
-    return result;
-}
-
 // overload comparision operator
-template <class T>
-bool operator==(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     auto f1 = lhs.cbegin();
     auto f2 = rhs.cbegin();
     auto l1 = lhs.cend();
@@ -953,37 +1157,43 @@ bool operator==(const list<T>& lhs, const list<T>& rhs) {
     return f1 == l1 && f2 == l2;
 }
 
-template <class T>
-bool operator<(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return mystl::lexicographical_compare(lhs.cbegin(), lhs.cend(),
                                           rhs.cbegin(), rhs.cend());
 }
 
-template <class T>
-bool operator!=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const list<T>& lhs, const list<T>& rhs) {
+template <class T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 // overload swap
-template <class T>
-void swap(list<T>& lhs, list<T>& rhs) noexcept {
+template <class T, class Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// the sentinel node is on the heap, so the list object itself can be moved
+// bitwise
+template <class T, class Alloc>
+struct is_trivially_relocatable<list<T, Alloc>>
+    : is_trivially_relocatable<Alloc> {};
+
 }  // namespace mystl
 #endif
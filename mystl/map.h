@@ -29,10 +29,12 @@
 #define MYSTL_MAP_H
 
 #include "rb_tree.h"
+#include "memory_resource.h"
 
 namespace mystl {
 
-template <class Key, class T, class Compare = mystl::less<Key>>
+template <class Key, class T, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class map {
    public:
     typedef Key key_type;
@@ -41,7 +43,7 @@ class map {
     typedef Compare key_compare;
 
     class value_compare : public binary_function<value_type, value_type, bool> {
-        friend class map<Key, T, Compare>;
+        friend class map<Key, T, Compare, Alloc>;
 
        private:
         Compare comp;
@@ -54,7 +56,7 @@ class map {
     };
 
    private:
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -77,17 +79,32 @@ class map {
 
     map() = default;
 
+    explicit map(const key_compare& comp,
+                 const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit map(const allocator_type& alloc) : tree_(alloc) {}
+
     template <class InputIterator>
-    map(InputIterator first, InputIterator last) : tree_() {
+    map(InputIterator first, InputIterator last,
+        const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_unique(first, last);
     }
 
-    map(std::initializer_list<value_type> ilist) : tree_() {
+    map(std::initializer_list<value_type> ilist,
+        const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_unique(ilist.begin(), ilist.end());
     }
 
     map(const map& rhs) : tree_(rhs.tree_) {}
     map(map&& rhs) noexcept : tree_(mystl::move(rhs.tree_)) {}
+    map(const map& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {}
+    map(map&& rhs, const allocator_type& alloc)
+        : tree_(mystl::move(rhs.tree_), alloc) {}
 
     map& operator=(const map& rhs) {
         tree_ = rhs.tree_;
@@ -132,14 +149,14 @@ class map {
     size_type max_size() const noexcept { return tree_.max_size(); }
 
     mapped_type& at(const key_type& key) {
-        iterator it = lower_boubd(key);
+        iterator it = lower_bound(key);
         THROW_OUT_OF_RANGE_IF(it == end() || key_comp()(it->first, key),
                               "map<Key, T> no such element exists");
         return it->second;
     }
 
     const mapped_type& at(const key_type& key) const {
-        const_iterator it = lower_boubd(key);
+        const_iterator it = lower_bound(key);
         THROW_OUT_OF_RANGE_IF(it == end() || key_comp()(it->first, key),
                               "map<Key, T> no such element exists");
         return it->second;
@@ -236,49 +253,51 @@ class map {
     }
 };
 
-template <class Key, class T, class Compare>
-bool operator==(const map<Key, T, Compare>& lhs,
-                const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const map<Key, T, Compare, Alloc>& lhs,
+                const map<Key, T, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const map<Key, T, Compare>& lhs,
-               const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const map<Key, T, Compare, Alloc>& lhs,
+               const map<Key, T, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const map<Key, T, Compare>& lhs,
-                const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const map<Key, T, Compare, Alloc>& lhs,
+                const map<Key, T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const map<Key, T, Compare>& lhs,
-               const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const map<Key, T, Compare, Alloc>& lhs,
+               const map<Key, T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const map<Key, T, Compare>& lhs,
-                const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const map<Key, T, Compare, Alloc>& lhs,
+                const map<Key, T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const map<Key, T, Compare>& lhs,
-                const map<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const map<Key, T, Compare, Alloc>& lhs,
+                const map<Key, T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class Key, class T, class Compare>
-void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, class Alloc>
+void swap(map<Key,
+          T, Compare, Alloc>& lhs, map<Key, T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 // template class: multimap
-template <class Key, class T, class Compare = mystl::less<Key>>
+template <class Key, class T, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class multimap {
    public:
     typedef Key key_type;
@@ -287,7 +306,7 @@ class multimap {
     typedef Compare key_compare;
 
     class value_compare : public binary_function<value_type, value_type, bool> {
-        friend class multimap<Key, T, Compare>;
+        friend class multimap<Key, T, Compare, Alloc>;
 
        private:
         Compare comp;
@@ -300,7 +319,7 @@ class multimap {
     };
 
    private:
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -320,16 +339,31 @@ class multimap {
    public:
     multimap() = default;
 
+    explicit multimap(const key_compare& comp,
+                      const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit multimap(const allocator_type& alloc) : tree_(alloc) {}
+
     template <class InputIterator>
-    multimap(InputIterator first, InputIterator last) : tree_() {
+    multimap(InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+                 const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_multi(first, last);
     }
-    multimap(std::initializer_list<value_type> ilist) : tree_() {
+    multimap(std::initializer_list<value_type> ilist,
+             const key_compare& comp = key_compare(),
+                 const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_multi(ilist.begin(), ilist.end());
     }
 
     multimap(const multimap& rhs) : tree_(rhs.tree_) {}
     multimap(multimap&& rhs) noexcept : tree_(mystl::move(rhs.tree_)) {}
+    multimap(const multimap& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {}
+    multimap(multimap&& rhs, const allocator_type& alloc)
+        : tree_(mystl::move(rhs.tree_), alloc) {}
 
     multimap& operator=(const multimap& rhs) {
         tree_ = rhs.tree_;
@@ -448,48 +482,58 @@ class multimap {
     }
 };
 
-template <class Key, class T, class Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs,
-                const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const multimap<Key, T, Compare, Alloc>& lhs,
+                const multimap<Key, T, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs,
-               const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const multimap<Key, T, Compare, Alloc>& lhs,
+               const multimap<Key, T, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs,
-                const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const multimap<Key, T, Compare, Alloc>& lhs,
+                const multimap<Key, T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs,
-               const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>(const multimap<Key, T, Compare, Alloc>& lhs,
+               const multimap<Key, T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class T, class Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs,
-                const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator<=(const multimap<Key, T, Compare, Alloc>& lhs,
+                const multimap<Key, T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs,
-                const multimap<Key, T, Compare>& rhs) {
+template <class Key, class T, class Compare, class Alloc>
+bool operator>=(const multimap<Key, T, Compare, Alloc>& lhs,
+                const multimap<Key, T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class Key, class T, class Compare>
-void swap(multimap<Key, T, Compare>& lhs,
-          multimap<Key, T, Compare>& rhs) noexcept {
+template <class Key, class T, class Compare, class Alloc>
+void swap(multimap<Key, T, Compare, Alloc>& lhs,
+          multimap<Key, T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+namespace pmr {
+template <class Key, class T, class Compare = mystl::less<Key>>
+using map = mystl::map<Key, T, Compare,
+                       polymorphic_allocator<mystl::pair<const Key, T>>>;
+template <class Key, class T, class Compare = mystl::less<Key>>
+using multimap =
+    mystl::multimap<Key, T, Compare,
+                    polymorphic_allocator<mystl::pair<const Key, T>>>;
+}  // namespace pmr
+
 }  // namespace mystl
 
 #endif
\ No newline at end of file
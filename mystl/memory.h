@@ -32,6 +32,7 @@
 
 #include "algobase.h"
 #include "allocator.h"
+#include "allocator_traits.h"
 #include "construct.h"
 #include "uninitialized.h"
 
@@ -42,19 +43,121 @@ constexpr Tp* address_of(Tp& value) noexcept {
     return &value;
 }
 
+// class: scratch_arena
+// per-thread scratch memory behind get_temporary_buffer (inplace_merge and
+// the stable algorithms). Each thread keeps one block, grown geometrically
+// and reused across calls, so repeated merges of small ranges stop paying
+// for malloc/free. Only one buffer can be out at a time; a nested request,
+// or one above max_bytes, goes to the heap instead, so no thread keeps more
+// than max_bytes.
+class scratch_arena {
+   public:
+    // larger buffers come from the heap, their merge costs far more than
+    // the allocation anyway
+    static constexpr size_t max_bytes = 256 * 1024;
+    static constexpr size_t align = cache_line_size;
+    static constexpr size_t min_bytes = 4096;
+
+    // the thread's block, holding at least bytes; nullptr if it is in use,
+    // bytes is too large, or the block can't grow
+    static void* acquire(size_t bytes) noexcept {
+        state& s = local();
+        if (s.in_use || s.gone || bytes > max_bytes) {
+            return nullptr;
+        }
+        if (bytes > s.bytes && !grow(s, bytes)) {
+            return nullptr;
+        }
+        s.in_use = true;
+        return s.data;
+    }
+
+    // false if p is not the thread's block
+    static bool release(void* p) noexcept {
+        state& s = local();
+        if (p == nullptr || p != s.data) {
+            return false;
+        }
+        s.in_use = false;
+        return true;
+    }
+
+    // give the thread's block back to the heap if it is not in use
+    static void trim() noexcept {
+        state& s = local();
+        if (!s.in_use) {
+            mystl::aligned_deallocate(s.data, align);
+            s.data = nullptr;
+            s.bytes = 0;
+        }
+    }
+
+    static size_t capacity() noexcept { return local().bytes; }
+
+   private:
+    // trivially destructible, so still readable after the guard is gone
+    struct state {
+        void* data;
+        size_t bytes;
+        bool in_use;
+        bool gone;
+    };
+
+    // frees the block at thread exit; later callers get the heap
+    struct guard {
+        ~guard() {
+            trim();
+            local().gone = true;
+        }
+    };
+
+    static state& local() noexcept {
+        static thread_local state s = {nullptr, 0, false, false};
+        return s;
+    }
+
+    static bool grow(state& s, size_t bytes) noexcept {
+        static thread_local guard g;
+        (void)g;
+        size_t new_bytes = s.bytes < min_bytes ? min_bytes : s.bytes;
+        while (new_bytes < bytes) {
+            new_bytes = new_bytes > max_bytes / 2 ? max_bytes : new_bytes * 2;
+        }
+        mystl::aligned_deallocate(s.data, align);
+        s.data = nullptr;
+        s.bytes = 0;
+        try {
+            s.data = mystl::aligned_allocate(new_bytes, align);
+        } catch (...) {
+            return false;
+        }
+        s.bytes = new_bytes;
+        return true;
+    }
+};
+
 // get / release temporary buffer
+// the thread's scratch_arena when it is free, otherwise the heap, halving
+// the length until an allocation succeeds
 template <class T>
 pair<T*, ptrdiff_t> get_buffer_helper(ptrdiff_t len, T*) {
     if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T))) {
         len = INT_MAX / sizeof(T);
     }
+    if (len > 0 && alignof(T) <= scratch_arena::align) {
+        void* p = scratch_arena::acquire(static_cast<size_t>(len) * sizeof(T));
+        if (p) {
+            return pair<T*, ptrdiff_t>(static_cast<T*>(p), len);
+        }
+    }
     while (len > 0) {
-        /* code */
-        T* tmp = static_cast<T*>(malloc(static_cast<size_t>(len) * sizeof(T)));
-        if (tmp) {
+        try {
+            T* tmp = static_cast<T*>(mystl::aligned_allocate(
+                static_cast<size_t>(len) * sizeof(T), alignof(T)));
             return pair<T*, ptrdiff_t>(tmp, len);
+        } catch (...) {
+            len /= 2;
         }
-        len /= 2;
     }
     return pair<T*, ptrdiff_t>(nullptr, 0);
 }
@@ -71,7 +174,9 @@ pair<T*, ptrdiff_t> get_temporary_buffer(ptrdiff_t len, T*) {
 
 template <class T>
 void release_temporary_buffer(T* ptr) {
-    free(ptr);
+    if (!scratch_arena::release(ptr)) {
+        mystl::aligned_deallocate(ptr, alignof(T));
+    }
 }
 
 // template class: temporary_buffer
@@ -86,7 +191,7 @@ class temporary_buffer {
     temporary_buffer(ForwardIterator first, ForwardIterator last);
     ~temporary_buffer() {
         mystl::destroy(buffer, buffer + len);
-        free(buffer);
+        mystl::release_temporary_buffer(buffer);
     }
 
    public:
@@ -109,7 +214,8 @@ class temporary_buffer {
 
 template <class ForwardIterator, class T>
 temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first,
-                                                       ForwardIterator last) {
+                                                       ForwardIterator last)
+    : original_len(0), len(0), buffer(nullptr) {
     try {
         len = mystl::distance(first, last);
         allocate_buffer();
@@ -118,7 +224,7 @@ temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first,
                               std::is_trivially_default_constructible<T>());
         }
     } catch (...) {
-        free(buffer);
+        mystl::release_temporary_buffer(buffer);
         buffer = nullptr;
         len = 0;
     }
@@ -127,16 +233,9 @@ temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first,
 template <class ForwardIterator, class T>
 void temporary_buffer<ForwardIterator, T>::allocate_buffer() {
     original_len = len;
-    if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T))) {
-        len = INT_MAX / sizeof(T);
-    }
-    while (len > 0) {
-        buffer = static_cast<T*>(malloc(len * sizeof(T)));
-        if (buffer) {
-            break;
-        }
-        len /= 2;
-    }
+    auto result = mystl::get_temporary_buffer<T>(len);
+    buffer = result.first;
+    len = result.second;
 }
 
 // auto_ptr
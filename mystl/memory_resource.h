@@ -0,0 +1,622 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MEMORY_RESOURCE_H_
+#define MYSTL_MEMORY_RESOURCE_H_
+
+// polymorphic memory resources, modeled on std::pmr:
+//   memory_resource               abstract interface
+//   new_delete_resource()         ::operator new / ::operator delete
+//   null_memory_resource()        throws on every allocation
+//   monotonic_buffer_resource     bump pointer, memory only comes back on
+//                                 release() or destruction
+//   unsynchronized_pool_resource  power-of-two size-class pools
+//   synchronized_pool_resource    the same, guarded by a mutex
+// polymorphic_allocator<T> adapts a memory_resource* to the allocator
+// interface; containers using it are aliased in mystl::pmr by the container
+// headers (pmr::vector, pmr::map, pmr::unordered_map).
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include "allocator.h"
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl {
+namespace pmr {
+
+constexpr size_t max_align = alignof(std::max_align_t);
+
+inline size_t round_up(size_t bytes, size_t align) {
+    return (bytes + align - 1) & ~(align - 1);
+}
+
+// class: memory_resource
+class memory_resource {
+   public:
+    virtual ~memory_resource() {}
+
+    void* allocate(size_t bytes, size_t align = max_align) {
+        return do_allocate(bytes, align);
+    }
+    void deallocate(void* p, size_t bytes, size_t align = max_align) {
+        do_deallocate(p, bytes, align);
+    }
+    bool is_equal(const memory_resource& other) const noexcept {
+        return do_is_equal(other);
+    }
+
+   private:
+    virtual void* do_allocate(size_t bytes, size_t align) = 0;
+    virtual void do_deallocate(void* p, size_t bytes, size_t align) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& lhs,
+                       const memory_resource& rhs) noexcept {
+    return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource& lhs,
+                       const memory_resource& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+namespace detail {
+
+// the plain heap, every request goes through mystl::aligned_allocate
+class new_delete_resource_impl : public memory_resource {
+   private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        return mystl::aligned_allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t, size_t align) override {
+        mystl::aligned_deallocate(p, align);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+class null_memory_resource_impl : public memory_resource {
+   private:
+    void* do_allocate(size_t, size_t) override { throw std::bad_alloc(); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+inline std::atomic<memory_resource*>& default_resource_slot();
+
+}  // namespace detail
+
+inline memory_resource* new_delete_resource() noexcept {
+    static detail::new_delete_resource_impl instance;
+    return &instance;
+}
+
+inline memory_resource* null_memory_resource() noexcept {
+    static detail::null_memory_resource_impl instance;
+    return &instance;
+}
+
+inline std::atomic<memory_resource*>& detail::default_resource_slot() {
+    static std::atomic<memory_resource*> slot(new_delete_resource());
+    return slot;
+}
+
+inline memory_resource* get_default_resource() noexcept {
+    return detail::default_resource_slot().load(std::memory_order_acquire);
+}
+
+// returns the previous default, a null argument restores new_delete_resource
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+    if (r == nullptr) {
+        r = new_delete_resource();
+    }
+    return detail::default_resource_slot().exchange(r,
+                                                     std::memory_order_acq_rel);
+}
+
+// class: monotonic_buffer_resource
+// hands out memory from the initial buffer, then from geometrically growing
+// blocks taken from upstream; deallocate is a no-op
+class monotonic_buffer_resource : public memory_resource {
+   private:
+    struct block {
+        block* next;
+        size_t bytes;
+        size_t align;
+    };
+
+    static constexpr size_t default_initial_size = 1024;
+    static constexpr size_t growth_factor = 2;
+
+   public:
+    monotonic_buffer_resource()
+        : monotonic_buffer_resource(get_default_resource()) {}
+    explicit monotonic_buffer_resource(memory_resource* upstream)
+        : monotonic_buffer_resource(default_initial_size, upstream) {}
+    explicit monotonic_buffer_resource(
+        size_t initial_size, memory_resource* upstream = get_default_resource())
+        : upstream_(upstream),
+          initial_buffer_(nullptr),
+          initial_size_(0),
+          cur_(nullptr),
+          space_(0),
+          first_size_(initial_size == 0 ? 1 : initial_size),
+          next_size_(first_size_),
+          blocks_(nullptr) {}
+    monotonic_buffer_resource(
+        void* buffer, size_t buffer_size,
+        memory_resource* upstream = get_default_resource())
+        : upstream_(upstream),
+          initial_buffer_(buffer),
+          initial_size_(buffer_size),
+          cur_(static_cast<char*>(buffer)),
+          space_(buffer_size),
+          first_size_(buffer_size == 0 ? 1 : buffer_size * growth_factor),
+          next_size_(first_size_),
+          blocks_(nullptr) {}
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) =
+        delete;
+
+    ~monotonic_buffer_resource() override { release(); }
+
+    // give every upstream block back and start over on the initial buffer
+    void release();
+
+    memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+   private:
+    void* do_allocate(size_t bytes, size_t align) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void new_block(size_t bytes, size_t align);
+
+   private:
+    memory_resource* upstream_;
+    void* initial_buffer_;
+    size_t initial_size_;
+    char* cur_;
+    size_t space_;
+    size_t first_size_;  // size of the first upstream block
+    size_t next_size_;
+    block* blocks_;
+};
+
+inline void monotonic_buffer_resource::release() {
+    while (blocks_) {
+        block* next = blocks_->next;
+        upstream_->deallocate(blocks_, blocks_->bytes, blocks_->align);
+        blocks_ = next;
+    }
+    cur_ = static_cast<char*>(initial_buffer_);
+    space_ = initial_size_;
+    next_size_ = first_size_;
+}
+
+inline void* monotonic_buffer_resource::do_allocate(size_t bytes,
+                                                    size_t align) {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    uintptr_t addr = reinterpret_cast<uintptr_t>(cur_);
+    size_t pad = round_up(addr, align) - addr;
+    if (cur_ == nullptr || bytes > space_ || pad > space_ - bytes) {
+        new_block(bytes, align);
+        addr = reinterpret_cast<uintptr_t>(cur_);
+        pad = round_up(addr, align) - addr;
+    }
+    char* p = cur_ + pad;
+    cur_ = p + bytes;
+    space_ -= pad + bytes;
+    return p;
+}
+
+inline void monotonic_buffer_resource::new_block(size_t bytes, size_t align) {
+    const size_t block_align = align > max_align ? align : max_align;
+    const size_t header = round_up(sizeof(block), block_align);
+    // header + bytes, rounded up to block_align, must not wrap around
+    if (bytes > static_cast<size_t>(-1) - header - (block_align - 1)) {
+        throw std::bad_alloc();
+    }
+    size_t size = next_size_;
+    if (size < header + bytes) {
+        size = header + bytes;
+    }
+    size = round_up(size, block_align);
+    block* b = static_cast<block*>(upstream_->allocate(size, block_align));
+    b->next = blocks_;
+    b->bytes = size;
+    b->align = block_align;
+    blocks_ = b;
+    cur_ = reinterpret_cast<char*>(b) + header;
+    space_ = size - header;
+    next_size_ = size > static_cast<size_t>(-1) / growth_factor
+                     ? size
+                     : size * growth_factor;
+}
+
+// struct: pool_options
+// max_blocks_per_chunk caps how many blocks one upstream chunk holds,
+// largest_required_pool_block is the largest request served from a pool;
+// zero picks the default
+struct pool_options {
+    size_t max_blocks_per_chunk = 0;
+    size_t largest_required_pool_block = 0;
+};
+
+// class: unsynchronized_pool_resource
+// one free list per power-of-two block size from 8 bytes up to
+// largest_required_pool_block; larger or over-aligned requests go straight to
+// upstream and are tracked so that release() can return them
+class unsynchronized_pool_resource : public memory_resource {
+   private:
+    static constexpr size_t min_block = 8;
+    static constexpr size_t default_largest_block = 4096;
+    static constexpr size_t default_max_blocks = 1024;
+    static constexpr size_t first_chunk_blocks = 16;
+    static constexpr size_t max_pools = 32;
+
+    struct free_block {
+        free_block* next;
+    };
+
+    struct chunk {
+        chunk* next;
+        size_t bytes;
+    };
+
+    struct pool {
+        free_block* free_list;
+        chunk* chunks;
+        size_t next_blocks;
+    };
+
+    // header of an oversized allocation, doubly linked for O(1) removal
+    struct big_block {
+        big_block* prev;
+        big_block* next;
+        size_t bytes;
+        size_t align;
+    };
+
+   public:
+    unsynchronized_pool_resource()
+        : unsynchronized_pool_resource(pool_options(), get_default_resource()) {
+    }
+    explicit unsynchronized_pool_resource(memory_resource* upstream)
+        : unsynchronized_pool_resource(pool_options(), upstream) {}
+    explicit unsynchronized_pool_resource(const pool_options& opts)
+        : unsynchronized_pool_resource(opts, get_default_resource()) {}
+    unsynchronized_pool_resource(const pool_options& opts,
+                                 memory_resource* upstream);
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(
+        const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override { release(); }
+
+    // give every chunk and oversized block back to upstream
+    void release();
+
+    memory_resource* upstream_resource() const noexcept { return upstream_; }
+    pool_options options() const noexcept { return opts_; }
+
+   protected:
+    void* do_allocate(size_t bytes, size_t align) override;
+    void do_deallocate(void* p, size_t bytes, size_t align) override;
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   private:
+    // index of the pool serving bytes/align, pool_num_ if none does
+    size_t pool_index(size_t bytes, size_t align) const noexcept;
+    void refill(size_t index);
+    void* allocate_big(size_t bytes, size_t align);
+    void deallocate_big(void* p, size_t align);
+
+    static size_t big_header(size_t align) noexcept {
+        return round_up(sizeof(big_block),
+                        align > max_align ? align : max_align);
+    }
+
+   private:
+    memory_resource* upstream_;
+    pool_options opts_;
+    size_t pool_num_;
+    pool pools_[max_pools];
+    big_block* big_;
+};
+
+inline unsynchronized_pool_resource::unsynchronized_pool_resource(
+    const pool_options& opts, memory_resource* upstream)
+    : upstream_(upstream), opts_(opts), pool_num_(0), big_(nullptr) {
+    if (opts_.max_blocks_per_chunk == 0) {
+        opts_.max_blocks_per_chunk = default_max_blocks;
+    }
+    if (opts_.largest_required_pool_block == 0) {
+        opts_.largest_required_pool_block = default_largest_block;
+    }
+    size_t block = min_block;
+    while (block < opts_.largest_required_pool_block &&
+           pool_num_ + 1 < max_pools) {
+        block <<= 1;
+        ++pool_num_;
+    }
+    ++pool_num_;
+    opts_.largest_required_pool_block = block;
+    for (size_t i = 0; i < pool_num_; ++i) {
+        pools_[i].free_list = nullptr;
+        pools_[i].chunks = nullptr;
+        pools_[i].next_blocks = first_chunk_blocks < opts_.max_blocks_per_chunk
+                                    ? first_chunk_blocks
+                                    : opts_.max_blocks_per_chunk;
+    }
+}
+
+inline void unsynchronized_pool_resource::release() {
+    for (size_t i = 0; i < pool_num_; ++i) {
+        chunk* c = pools_[i].chunks;
+        while (c) {
+            chunk* next = c->next;
+            upstream_->deallocate(c, c->bytes, max_align);
+            c = next;
+        }
+        pools_[i].free_list = nullptr;
+        pools_[i].chunks = nullptr;
+    }
+    while (big_) {
+        big_block* next = big_->next;
+        const size_t header = big_header(big_->align);
+        const size_t align = big_->align > max_align ? big_->align : max_align;
+        upstream_->deallocate(big_, header + big_->bytes, align);
+        big_ = next;
+    }
+}
+
+inline size_t unsynchronized_pool_resource::pool_index(
+    size_t bytes, size_t align) const noexcept {
+    if (align > max_align || bytes > opts_.largest_required_pool_block) {
+        return pool_num_;
+    }
+    size_t need = bytes > align ? bytes : align;
+    size_t index = 0;
+    size_t block = min_block;
+    while (block < need) {
+        block <<= 1;
+        ++index;
+    }
+    return index;
+}
+
+inline void* unsynchronized_pool_resource::do_allocate(size_t bytes,
+                                                       size_t align) {
+    const size_t index = pool_index(bytes, align);
+    if (index == pool_num_) {
+        return allocate_big(bytes, align);
+    }
+    pool& p = pools_[index];
+    if (p.free_list == nullptr) {
+        refill(index);
+    }
+    free_block* result = p.free_list;
+    p.free_list = result->next;
+    return result;
+}
+
+inline void unsynchronized_pool_resource::do_deallocate(void* ptr,
+                                                        size_t bytes,
+                                                        size_t align) {
+    if (ptr == nullptr) {
+        return;
+    }
+    const size_t index = pool_index(bytes, align);
+    if (index == pool_num_) {
+        deallocate_big(ptr, align);
+        return;
+    }
+    free_block* b = static_cast<free_block*>(ptr);
+    b->next = pools_[index].free_list;
+    pools_[index].free_list = b;
+}
+
+// new chunk for pools_[index]; every chunk is twice as big as the last one up
+// to max_blocks_per_chunk blocks
+inline void unsynchronized_pool_resource::refill(size_t index) {
+    pool& p = pools_[index];
+    const size_t block = min_block << index;
+    const size_t header = round_up(sizeof(chunk), max_align);
+    const size_t bytes = header + p.next_blocks * block;
+    chunk* c = static_cast<chunk*>(upstream_->allocate(bytes, max_align));
+    c->next = p.chunks;
+    c->bytes = bytes;
+    p.chunks = c;
+    char* first = reinterpret_cast<char*>(c) + header;
+    free_block* head = p.free_list;
+    for (size_t i = p.next_blocks; i > 0; --i) {
+        free_block* b = reinterpret_cast<free_block*>(first + (i - 1) * block);
+        b->next = head;
+        head = b;
+    }
+    p.free_list = head;
+    if (p.next_blocks < opts_.max_blocks_per_chunk) {
+        p.next_blocks *= 2;
+        if (p.next_blocks > opts_.max_blocks_per_chunk) {
+            p.next_blocks = opts_.max_blocks_per_chunk;
+        }
+    }
+}
+
+inline void* unsynchronized_pool_resource::allocate_big(size_t bytes,
+                                                        size_t align) {
+    const size_t header = big_header(align);
+    char* raw = static_cast<char*>(upstream_->allocate(
+        header + bytes, align > max_align ? align : max_align));
+    big_block* b = reinterpret_cast<big_block*>(raw);
+    b->prev = nullptr;
+    b->next = big_;
+    b->bytes = bytes;
+    b->align = align;
+    if (big_) {
+        big_->prev = b;
+    }
+    big_ = b;
+    return raw + header;
+}
+
+inline void unsynchronized_pool_resource::deallocate_big(void* p,
+                                                         size_t align) {
+    const size_t header = big_header(align);
+    big_block* b =
+        reinterpret_cast<big_block*>(static_cast<char*>(p) - header);
+    if (b->prev) {
+        b->prev->next = b->next;
+    } else {
+        big_ = b->next;
+    }
+    if (b->next) {
+        b->next->prev = b->prev;
+    }
+    upstream_->deallocate(b, header + b->bytes,
+                          align > max_align ? align : max_align);
+}
+
+// class: synchronized_pool_resource
+// unsynchronized_pool_resource behind a mutex; a spin lock would do for the
+// pool hits but refills call upstream, which can be slow
+class synchronized_pool_resource : public unsynchronized_pool_resource {
+   public:
+    synchronized_pool_resource() {}
+    explicit synchronized_pool_resource(memory_resource* upstream)
+        : unsynchronized_pool_resource(upstream) {}
+    explicit synchronized_pool_resource(const pool_options& opts)
+        : unsynchronized_pool_resource(opts) {}
+    synchronized_pool_resource(const pool_options& opts,
+                               memory_resource* upstream)
+        : unsynchronized_pool_resource(opts, upstream) {}
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unsynchronized_pool_resource::release();
+    }
+
+   private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return unsynchronized_pool_resource::do_allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unsynchronized_pool_resource::do_deallocate(p, bytes, align);
+    }
+
+   private:
+    std::mutex mutex_;
+};
+
+// template class: polymorphic_allocator
+// a memory_resource* wearing the allocator interface. It does not propagate
+// on copy / move / swap, so containers with different resources move element
+// by element; a copied container goes back to the default resource.
+template <class T>
+class polymorphic_allocator {
+    template <class U>
+    friend class polymorphic_allocator;
+
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef polymorphic_allocator<U> other;
+    };
+
+   public:
+    polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+    polymorphic_allocator(memory_resource* r) noexcept : resource_(r) {}
+    template <class U>
+    polymorphic_allocator(const polymorphic_allocator<U>& rhs) noexcept
+        : resource_(rhs.resource_) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+   public:
+    T* allocate(size_type n) {
+        THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / sizeof(T),
+                              "polymorphic_allocator<T>'s size too big");
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_type n) {
+        resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    polymorphic_allocator select_on_container_copy_construction() const {
+        return polymorphic_allocator();
+    }
+
+    memory_resource* resource() const noexcept { return resource_; }
+
+   private:
+    memory_resource* resource_;
+};
+
+template <class T, class U>
+bool operator==(const polymorphic_allocator<T>& lhs,
+                const polymorphic_allocator<U>& rhs) noexcept {
+    return *lhs.resource() == *rhs.resource();
+}
+
+template <class T, class U>
+bool operator!=(const polymorphic_allocator<T>& lhs,
+                const polymorphic_allocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace pmr
+}  // namespace mystl
+#endif
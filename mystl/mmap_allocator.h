@@ -0,0 +1,342 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MMAP_ALLOCATOR_H_
+#define MYSTL_MMAP_ALLOCATOR_H_
+
+// mmap backed allocator for very large arrays (vector storage, hashtable
+// buckets). Blocks of at least mmap_threshold bytes are mapped straight from
+// the kernel, aligned to and rounded up to 2 MB and marked MADV_HUGEPAGE so
+// that transparent huge pages can back them; Populate also pre-faults the
+// whole mapping up front instead of taking a fault storm on first touch.
+// reallocate() resizes such a block with mremap, in place or into a range
+// reserved at a 2 MB boundary, which vector uses for trivially copyable
+// elements; with Populate the pages it grows by are pre-faulted as well.
+// Smaller blocks, and every block on systems
+// without mmap, come from ::operator new.
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define MYSTL_HAS_MMAP 1
+#else
+#define MYSTL_HAS_MMAP 0
+#endif
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace mystl {
+
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+// blocks smaller than this are not worth a system call
+constexpr size_t mmap_threshold = huge_page_size;
+
+// template class: mmap_allocator
+template <class T, bool Populate = false>
+class mmap_allocator {
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef mmap_allocator<U, Populate> other;
+    };
+
+   public:
+    mmap_allocator() noexcept {}
+    template <class U>
+    mmap_allocator(const mmap_allocator<U, Populate>&) noexcept {}
+
+   public:
+    static T* allocate();
+    static T* allocate(size_type n);
+    // a mapped block reports its whole 2 MB rounded mapping
+    static allocation_result<T*> allocate_at_least(size_type n);
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+
+    // grow or shrink a block of old_n objects to new_n objects, keeping its
+    // bytes; nullptr if this block can't be resized (the caller then
+    // allocates, relocates and deallocates itself). Only for objects that
+    // can be relocated bitwise.
+    static T* reallocate(T* ptr, size_type old_n, size_type new_n);
+
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+    template <class... Args>
+    static void construct(T* ptr, Args&&... args);
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+
+   private:
+    static bool mapped(size_type n) noexcept {
+        return MYSTL_HAS_MMAP && n * sizeof(T) >= mmap_threshold;
+    }
+    static size_t map_bytes(size_type n) noexcept {
+        return (n * sizeof(T) + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+    static void* map(size_t bytes);
+    static void unmap(void* p, size_t bytes) noexcept;
+#if MYSTL_HAS_MMAP
+    static char* map_aligned(size_t bytes, int prot) noexcept;
+    static void populate(char* p, size_t bytes) noexcept;
+#endif
+};
+
+template <class T, bool Populate>
+T* mmap_allocator<T, Populate>::allocate() {
+    return mystl::heap_allocate<T>(1);
+}
+
+template <class T, bool Populate>
+T* mmap_allocator<T, Populate>::allocate(size_type n) {
+    if (n == 0) {
+        return nullptr;
+    }
+    if (n > static_cast<size_type>(-1) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    if (mapped(n)) {
+        return static_cast<T*>(map(map_bytes(n)));
+    }
+    return mystl::heap_allocate<T>(n);
+}
+
+template <class T, bool Populate>
+allocation_result<T*> mmap_allocator<T, Populate>::allocate_at_least(
+    size_type n) {
+    if (n == 0) {
+        return {nullptr, 0};
+    }
+    if (n > (static_cast<size_type>(-1) - huge_page_size) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    if (mapped(n)) {
+        const size_t bytes = map_bytes(n);
+        return {static_cast<T*>(map(bytes)), bytes / sizeof(T)};
+    }
+    // stay below the threshold, deallocate must not take it for a mapping
+    auto r = mystl::heap_allocate_at_least<T>(n);
+    if (mapped(r.count)) {
+        mystl::heap_deallocate(r.ptr);
+        return {mystl::heap_allocate<T>(n), n};
+    }
+    return r;
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::deallocate(T* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    mystl::heap_deallocate(ptr);
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (mapped(n)) {
+        unmap(ptr, map_bytes(n));
+    } else {
+        mystl::heap_deallocate(ptr);
+    }
+}
+
+template <class T, bool Populate>
+T* mmap_allocator<T, Populate>::reallocate(T* ptr, size_type old_n,
+                                           size_type new_n) {
+#if MYSTL_HAS_MMAP && defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+    if (ptr == nullptr || !mapped(old_n) || !mapped(new_n) ||
+        new_n > static_cast<size_type>(-1) / sizeof(T)) {
+        return nullptr;
+    }
+    const size_t old_bytes = map_bytes(old_n);
+    const size_t new_bytes = map_bytes(new_n);
+    if (old_bytes == new_bytes) {
+        return ptr;
+    }
+    // in place first: a shrink always stays, a growth if the pages after
+    // the block are free
+    void* p = ::mremap(ptr, old_bytes, new_bytes, 0);
+    if (p == MAP_FAILED) {
+        // a plain move may land on any page boundary, so move the block
+        // over a range reserved at a huge page boundary
+        char* target = map_aligned(new_bytes, PROT_NONE);
+        if (target == nullptr) {
+            return nullptr;
+        }
+        p = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED,
+                     target);
+        if (p == MAP_FAILED) {
+            ::munmap(target, new_bytes);
+            return nullptr;
+        }
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(p, new_bytes, MADV_HUGEPAGE);
+#endif
+    // the pages the block grew by are fresh, in place or not
+    if (Populate && new_bytes > old_bytes) {
+        populate(static_cast<char*>(p) + old_bytes, new_bytes - old_bytes);
+    }
+    return static_cast<T*>(p);
+#else
+    (void)ptr;
+    (void)old_n;
+    (void)new_n;
+    return nullptr;
+#endif
+}
+
+#if MYSTL_HAS_MMAP
+// map bytes (a multiple of huge_page_size) at a huge page boundary: map one
+// huge page more than needed and cut off the misaligned head and tail;
+// nullptr if the kernel has no room
+template <class T, bool Populate>
+char* mmap_allocator<T, Populate>::map_aligned(size_t bytes,
+                                               int prot) noexcept {
+    void* raw = ::mmap(nullptr, bytes + huge_page_size, prot,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    char* first = static_cast<char*>(raw);
+    char* aligned = reinterpret_cast<char*>(
+        (reinterpret_cast<size_t>(first) + huge_page_size - 1) &
+        ~(huge_page_size - 1));
+    if (aligned != first) {
+        ::munmap(first, aligned - first);
+    }
+    char* tail = aligned + bytes;
+    char* last = first + bytes + huge_page_size;
+    if (tail != last) {
+        ::munmap(tail, last - tail);
+    }
+    return aligned;
+}
+
+// pre-fault bytes at p after madvise so the kernel can hand out huge pages
+// right away; MAP_POPULATE at mmap time would fault in small ones
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::populate(char* p, size_t bytes) noexcept {
+#ifdef MADV_POPULATE_WRITE
+    if (::madvise(p, bytes, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    volatile char* page = p;
+    for (size_t off = 0; off < bytes; off += 4096) {
+        page[off] = 0;
+    }
+}
+#endif
+
+template <class T, bool Populate>
+void* mmap_allocator<T, Populate>::map(size_t bytes) {
+#if MYSTL_HAS_MMAP
+    char* aligned = map_aligned(bytes, PROT_READ | PROT_WRITE);
+    if (aligned == nullptr) {
+        throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+    if (Populate) {
+        populate(aligned, bytes);
+    }
+    return aligned;
+#else
+    return mystl::aligned_allocate(bytes, alignof(T));
+#endif
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::unmap(void* p, size_t bytes) noexcept {
+#if MYSTL_HAS_MMAP
+    ::munmap(p, bytes);
+#else
+    (void)bytes;
+    mystl::aligned_deallocate(p, alignof(T));
+#endif
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::construct(T* ptr) {
+    mystl::construct(ptr);
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::construct(T* ptr, const T& value) {
+    mystl::construct(ptr, value);
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::construct(T* ptr, T&& value) {
+    mystl::construct(ptr, mystl::move(value));
+}
+
+template <class T, bool Populate>
+template <class... Args>
+void mmap_allocator<T, Populate>::construct(T* ptr, Args&&... args) {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::destroy(T* ptr) {
+    mystl::destroy(ptr);
+}
+
+template <class T, bool Populate>
+void mmap_allocator<T, Populate>::destroy(T* first, T* last) {
+    mystl::destroy(first, last);
+}
+
+template <class T, class U, bool Populate>
+bool operator==(const mmap_allocator<T, Populate>&,
+                const mmap_allocator<U, Populate>&) noexcept {
+    return true;
+}
+
+template <class T, class U, bool Populate>
+bool operator!=(const mmap_allocator<T, Populate>&,
+                const mmap_allocator<U, Populate>&) noexcept {
+    return false;
+}
+
+}  // namespace mystl
+#endif
@@ -0,0 +1,534 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MMAP_VECTOR_H_
+#define MYSTL_MMAP_VECTOR_H_
+
+// mmap_vector<T>: a vector of trivially copyable T whose elements live in a
+// file mapped with mmap(MAP_SHARED), so a table built once can be mapped
+// again by the next process instead of being rebuilt. Opening is O(1), pages
+// are faulted in from the page cache as they are touched.
+//
+// The file is a 64 byte header (magic, sizeof(T), size) followed by the
+// elements. Growing extends the file with ftruncate and the mapping with
+// mremap (munmap + mmap where there is no mremap). sync() writes the size to
+// the header and msyncs the mapping; close() also cuts the file down to
+// size. A vector opened read_only maps the file PROT_READ and throws from
+// every function that would change it; writing through a non-const
+// reference to it is undefined behavior.
+// Iterators are plain pointers, as for vector.
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYSTL_HAS_FILE_MAP 1
+#else
+#define MYSTL_HAS_FILE_MAP 0
+#endif
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+
+#if MYSTL_HAS_FILE_MAP
+
+namespace mystl {
+
+enum class mmap_mode {
+    read_only,   // an existing file, PROT_READ
+    read_write,  // an existing file, or a new empty one
+    truncate     // always starts empty
+};
+
+// template class: mmap_vector
+template <class T>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "mmap_vector needs trivially copyable elements");
+    static_assert(alignof(T) <= 64, "mmap_vector aligns elements to 64");
+
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+   private:
+    struct header {
+        char magic[8];
+        uint64_t elem_size;
+        uint64_t size;
+        char reserved[40];
+    };
+    static_assert(sizeof(header) == 64, "mmap_vector header is 64 bytes");
+
+    char* base_;
+    size_t map_bytes_;
+    T* data_;
+    size_type size_;
+    size_type cap_;
+    int fd_;
+    bool writable_;
+
+   public:
+    // construct and deconstruct functions
+    mmap_vector() noexcept
+        : base_(nullptr),
+          map_bytes_(0),
+          data_(nullptr),
+          size_(0),
+          cap_(0),
+          fd_(-1),
+          writable_(false) {}
+
+    explicit mmap_vector(const char* path,
+                         mmap_mode mode = mmap_mode::read_write)
+        : mmap_vector() {
+        open(path, mode);
+    }
+
+    mmap_vector(const mmap_vector&) = delete;
+    mmap_vector& operator=(const mmap_vector&) = delete;
+
+    mmap_vector(mmap_vector&& rhs) noexcept : mmap_vector() { swap(rhs); }
+
+    mmap_vector& operator=(mmap_vector&& rhs) noexcept {
+        if (this != &rhs) {
+            close_noexcept();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~mmap_vector() { close_noexcept(); }
+
+    void open(const char* path, mmap_mode mode = mmap_mode::read_write);
+    // writes back the size, unmaps and closes the file
+    void close();
+    // the size into the header and the dirty pages to the file; async only
+    // schedules the write
+    void sync(bool async = false);
+
+    bool is_open() const noexcept { return fd_ != -1; }
+    bool read_only() const noexcept { return is_open() && !writable_; }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return data_; }
+
+    const_iterator begin() const noexcept { return data_; }
+
+    iterator end() noexcept { return data_ + size_; }
+
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return size_ == 0; }
+
+    size_type size() const noexcept { return size_; }
+
+    size_type max_size() const noexcept {
+        return (static_cast<size_type>(-1) / 2 - sizeof(header)) / sizeof(T);
+    }
+
+    size_type capacity() const noexcept { return cap_; }
+
+    void reserve(size_type n) {
+        check_writable();
+        if (cap_ < n) {
+            THROW_LENGTH_ERROR_IF(
+                n > max_size(),
+                "n can not larger than max_size() in mmap_vector::reserve()");
+            remap(n);
+        }
+    }
+
+    // cuts the file down to the pages in use
+    void shrink_to_fit() {
+        check_writable();
+        if (cap_ > size_) {
+            remap(size_);
+        }
+    }
+
+    // funciont about element visiting
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size_);
+        return data_[n];
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return data_[n];
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size_),
+                              "mmap_vector<T>::at() subscript out of range");
+        return data_[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size_),
+                              "mmap_vector<T>::at() subscript out of range");
+        return data_[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return data_[0];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return data_[0];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return data_[size_ - 1];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return data_[size_ - 1];
+    }
+
+    pointer data() noexcept { return data_; }
+
+    const_pointer data() const noexcept { return data_; }
+
+    // function about modifying container
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        // built first, args may refer to an element that remap moves
+        T value(mystl::forward<Args>(args)...);
+        reserve_more(1);
+        std::memcpy(static_cast<void*>(data_ + size_), &value, sizeof(T));
+        ++size_;
+    }
+
+    void push_back(const value_type& value) { emplace_back(value); }
+
+    void pop_back() {
+        check_writable();
+        MYSTL_DEBUG(!empty());
+        --size_;
+    }
+
+    // copies [first, last) to the end, one memcpy for a pointer range
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void append(Iter first, Iter last) {
+        append_aux(first, last, iterator_category(first));
+    }
+
+    void append(std::initializer_list<value_type> ilist) {
+        append(ilist.begin(), ilist.end());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        check_writable();
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        T* f = data_ + (first - data_);
+        std::memmove(static_cast<void*>(f), last,
+                     (end() - last) * sizeof(T));
+        size_ -= static_cast<size_type>(last - first);
+        return f;
+    }
+
+    void clear() {
+        check_writable();
+        size_ = 0;
+    }
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+
+    void resize(size_type new_size, const value_type& value) {
+        check_writable();
+        if (new_size > size_) {
+            const T copy = value;
+            reserve(new_size);
+            mystl::uninitialized_fill_n(data_ + size_, new_size - size_, copy);
+        }
+        size_ = new_size;
+    }
+
+    void swap(mmap_vector& rhs) noexcept {
+        mystl::swap(base_, rhs.base_);
+        mystl::swap(map_bytes_, rhs.map_bytes_);
+        mystl::swap(data_, rhs.data_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(cap_, rhs.cap_);
+        mystl::swap(fd_, rhs.fd_);
+        mystl::swap(writable_, rhs.writable_);
+    }
+
+   private:
+    // helper functions
+    static const char* magic() noexcept { return "MYSTLVEC"; }
+
+    static size_t page_size() noexcept {
+        static const size_t n = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return n;
+    }
+
+    header* head() const noexcept { return reinterpret_cast<header*>(base_); }
+
+    void check_writable() const {
+        THROW_RUNTIME_ERROR_IF(!writable_,
+                               "mmap_vector is not open for writing");
+    }
+
+    void reserve_more(size_type n) {
+        check_writable();
+        if (cap_ - size_ < n) {
+            remap(get_new_cap(n));
+        }
+    }
+
+    size_type get_new_cap(size_type add_size) const {
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - add_size,
+                              "mmap_vector<T>'s size too big");
+        if (cap_ > max_size() - cap_ / 2) {
+            return size_ + add_size;
+        }
+        return mystl::max(cap_ + cap_ / 2, size_ + add_size);
+    }
+
+    template <class IIter>
+    void append_aux(IIter first, IIter last, input_iterator_tag) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    template <class FIter>
+    void append_aux(FIter first, FIter last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        if (n != 0) {
+            reserve_more(n);
+            mystl::uninitialized_copy(first, last, data_ + size_);
+            size_ += n;
+        }
+    }
+
+    void set_mapping(void* p, size_t bytes) noexcept {
+        base_ = static_cast<char*>(p);
+        map_bytes_ = bytes;
+        data_ = reinterpret_cast<T*>(base_ + sizeof(header));
+        cap_ = (bytes - sizeof(header)) / sizeof(T);
+    }
+
+    void remap(size_type new_cap);
+    void map_file(size_t bytes, bool writable);
+    void discard() noexcept;
+    void close_noexcept() noexcept;
+};
+
+template <class T>
+void mmap_vector<T>::open(const char* path, mmap_mode mode) {
+    close();
+    const bool writable = mode != mmap_mode::read_only;
+    int flags = writable ? O_RDWR | O_CREAT : O_RDONLY;
+    if (mode == mmap_mode::truncate) {
+        flags |= O_TRUNC;
+    }
+    fd_ = ::open(path, flags, 0644);
+    THROW_RUNTIME_ERROR_IF(fd_ == -1, "mmap_vector: can not open the file");
+    try {
+        struct stat st;
+        THROW_RUNTIME_ERROR_IF(::fstat(fd_, &st) != 0,
+                               "mmap_vector: fstat failed");
+        size_t bytes = static_cast<size_t>(st.st_size);
+        if (bytes == 0 && writable) {
+            // a new file: one page with a fresh header
+            bytes = page_size();
+            THROW_RUNTIME_ERROR_IF(
+                ::ftruncate(fd_, static_cast<off_t>(bytes)) != 0,
+                "mmap_vector: ftruncate failed");
+            map_file(bytes, true);
+            std::memcpy(head()->magic, magic(), sizeof(head()->magic));
+            head()->elem_size = sizeof(T);
+            head()->size = 0;
+        } else {
+            THROW_RUNTIME_ERROR_IF(bytes < sizeof(header),
+                                   "mmap_vector: not an mmap_vector file");
+            map_file(bytes, writable);
+            THROW_RUNTIME_ERROR_IF(
+                std::memcmp(head()->magic, magic(), sizeof(head()->magic)) !=
+                        0 ||
+                    head()->elem_size != sizeof(T) ||
+                    head()->size > cap_,
+                "mmap_vector: not an mmap_vector file of this type");
+        }
+        size_ = static_cast<size_type>(head()->size);
+    } catch (...) {
+        // the file is not ours yet: leave its header and length alone
+        discard();
+        throw;
+    }
+    writable_ = writable;
+}
+
+template <class T>
+void mmap_vector<T>::close() {
+    if (!is_open()) {
+        return;
+    }
+    if (writable_) {
+        head()->size = size_;
+    }
+    if (base_ != nullptr) {
+        ::munmap(base_, map_bytes_);
+    }
+    int fd = fd_;
+    const bool writable = writable_;
+    const off_t bytes = static_cast<off_t>(sizeof(header) + size_ * sizeof(T));
+    base_ = nullptr;
+    data_ = nullptr;
+    map_bytes_ = 0;
+    size_ = cap_ = 0;
+    fd_ = -1;
+    writable_ = false;
+    const bool cut = !writable || ::ftruncate(fd, bytes) == 0;
+    const bool closed = ::close(fd) == 0;
+    THROW_RUNTIME_ERROR_IF(!cut || !closed, "mmap_vector: close failed");
+}
+
+// drop the mapping and the descriptor without writing to the file
+template <class T>
+void mmap_vector<T>::discard() noexcept {
+    if (base_ != nullptr) {
+        ::munmap(base_, map_bytes_);
+    }
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+    base_ = nullptr;
+    data_ = nullptr;
+    map_bytes_ = 0;
+    size_ = cap_ = 0;
+    fd_ = -1;
+    writable_ = false;
+}
+
+template <class T>
+void mmap_vector<T>::close_noexcept() noexcept {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+template <class T>
+void mmap_vector<T>::sync(bool async) {
+    check_writable();
+    head()->size = size_;
+    THROW_RUNTIME_ERROR_IF(
+        ::msync(base_, map_bytes_, async ? MS_ASYNC : MS_SYNC) != 0,
+        "mmap_vector: msync failed");
+}
+
+// map the first bytes of the file, which must be that long
+template <class T>
+void mmap_vector<T>::map_file(size_t bytes, bool writable) {
+    const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* p = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+    THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mmap_vector: mmap failed");
+    set_mapping(p, bytes);
+}
+
+// resize the file to a whole number of pages holding new_cap elements and
+// move the mapping along; the elements stay where they are in the file
+template <class T>
+void mmap_vector<T>::remap(size_type new_cap) {
+    const size_t page = page_size();
+    const size_t bytes =
+        (sizeof(header) + new_cap * sizeof(T) + page - 1) / page * page;
+    if (bytes == map_bytes_) {
+        return;
+    }
+    const size_t old_bytes = map_bytes_;
+    // the file grows before the mapping does and shrinks after it
+    if (bytes > old_bytes) {
+        THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(bytes)) != 0,
+                               "mmap_vector: ftruncate failed");
+    }
+#if defined(MREMAP_MAYMOVE)
+    void* p = ::mremap(base_, old_bytes, bytes, MREMAP_MAYMOVE);
+    THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mmap_vector: mremap failed");
+    set_mapping(p, bytes);
+#else
+    // the file keeps the elements, a new mapping of it sees them again
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "mmap_vector: mmap failed");
+    ::munmap(base_, old_bytes);
+    set_mapping(p, bytes);
+#endif
+    if (bytes < old_bytes) {
+        THROW_RUNTIME_ERROR_IF(::ftruncate(fd_, static_cast<off_t>(bytes)) != 0,
+                               "mmap_vector: ftruncate failed");
+    }
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_HAS_FILE_MAP
+#endif
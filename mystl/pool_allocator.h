@@ -0,0 +1,345 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MYSTL_POOL_ALLOCATOR_H_
+#define MYSTL_POOL_ALLOCATOR_H_
+
+// size-class pool allocator for node based containers (list, rb_tree,
+// hashtable). Every default constructed pool_allocator owns its own arena:
+// one free list per rounded size, refilled a chunk at a time. Copies and
+// rebinds of an allocator share its arena, and the arena gives all of its
+// chunks back when the last of them goes away, so a container using it
+// returns its memory on destruction no matter what other containers hold.
+// An arena is not locked; like the container it serves, it must not be used
+// from two threads at once.
+//
+// Not the default allocator of any container, opt in with e.g.
+//     mystl::map<int, int, mystl::less<int>,
+//                mystl::pool_allocator<mystl::pair<const int, int>>>
+// As a default it would make any two containers unequal in allocator:
+// splice and merge between two lists would leave nodes in an arena that
+// dies with the other list, and containers built from one allocator would
+// share an unlocked arena, so could not be filled from different threads.
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+namespace mystl {
+
+// objects larger than this go straight to ::operator new
+constexpr size_t pool_max_bytes = 256;
+// every chunk starts with a header padded to this alignment, so does the
+// strictest object alignment the pool serves
+constexpr size_t pool_align = 16;
+// chunk size starts small and doubles on every refill up to the upper bound
+constexpr size_t pool_min_chunk_bytes = 4096;
+constexpr size_t pool_max_chunk_bytes = 1024 * 1024;
+
+constexpr size_t pool_round_up(size_t bytes, size_t align) {
+    return (bytes + align - 1) & ~(align - 1);
+}
+
+// a test-and-set lock for short critical sections, a spinning waiter beats
+// parking on a mutex (used by thread_cache_allocator's depots)
+class pool_spin_lock {
+   public:
+    explicit pool_spin_lock(std::atomic_flag& flag) : flag_(flag) {
+        while (flag_.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    ~pool_spin_lock() { flag_.clear(std::memory_order_release); }
+
+    pool_spin_lock(const pool_spin_lock&) = delete;
+    pool_spin_lock& operator=(const pool_spin_lock&) = delete;
+
+   private:
+    std::atomic_flag& flag_;
+};
+
+// rounded size class of T, 8 bytes granularity (16 for over-aligned types)
+template <class T>
+struct pool_size_class {
+    static constexpr size_t align = alignof(T) > 8 ? 16 : 8;
+    static constexpr size_t value =
+        pool_round_up(sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T), align);
+    static constexpr bool use_pool =
+        value <= pool_max_bytes && alignof(T) <= pool_align;
+};
+
+// class: pool_arena
+// the free lists and chunks behind one pool_allocator and its copies,
+// reference counted by them
+class pool_arena {
+   private:
+    struct obj {
+        obj* next;
+    };
+
+    struct chunk {
+        chunk* next;
+        size_t bytes;
+    };
+
+    static constexpr size_t class_num = pool_max_bytes / 8;
+    static constexpr size_t header_bytes = pool_round_up(sizeof(chunk), pool_align);
+
+   public:
+    pool_arena() noexcept : chunks_(nullptr), live_(0), chunk_num_(0), refs_(1) {
+        for (size_t i = 0; i < class_num; ++i) {
+            free_list_[i] = nullptr;
+            next_chunk_bytes_[i] = pool_min_chunk_bytes;
+        }
+    }
+
+    ~pool_arena() { free_chunks(); }
+
+    pool_arena(const pool_arena&) = delete;
+    pool_arena& operator=(const pool_arena&) = delete;
+
+    // size is a pool_size_class value
+    void* allocate(size_t size) {
+        obj*& head = free_list_[index(size)];
+        if (head == nullptr) {
+            refill(size);
+        }
+        obj* result = head;
+        head = result->next;
+        ++live_;
+        return result;
+    }
+
+    void deallocate(void* ptr, size_t size) noexcept {
+        obj* p = static_cast<obj*>(ptr);
+        obj*& head = free_list_[index(size)];
+        p->next = head;
+        head = p;
+        --live_;
+    }
+
+    // give every chunk back once no object is live
+    void release() noexcept {
+        if (live_ == 0) {
+            free_chunks();
+        }
+    }
+
+    size_t live_count() const noexcept { return live_; }
+    size_t chunk_count() const noexcept { return chunk_num_; }
+
+    void add_ref() noexcept { ++refs_; }
+    // true when the last reference is gone
+    bool drop_ref() noexcept { return --refs_ == 0; }
+
+   private:
+    static size_t index(size_t size) noexcept { return size / 8 - 1; }
+
+    void refill(size_t size);
+    void free_chunks() noexcept;
+
+   private:
+    obj* free_list_[class_num];
+    size_t next_chunk_bytes_[class_num];
+    chunk* chunks_;
+    size_t live_;
+    size_t chunk_num_;
+    size_t refs_;
+};
+
+// carve a new chunk for the empty free list of size, in address order
+inline void pool_arena::refill(size_t size) {
+    const size_t i = index(size);
+    size_t bytes = next_chunk_bytes_[i];
+    if (bytes < header_bytes + 16 * size) {
+        bytes = header_bytes + 16 * size;
+    }
+    chunk* c = static_cast<chunk*>(::operator new(bytes));
+    c->next = chunks_;
+    c->bytes = bytes;
+    chunks_ = c;
+    ++chunk_num_;
+    if (next_chunk_bytes_[i] < pool_max_chunk_bytes) {
+        next_chunk_bytes_[i] *= 2;
+    }
+    char* first = reinterpret_cast<char*>(c) + header_bytes;
+    const size_t n = (bytes - header_bytes) / size;
+    obj* head = nullptr;
+    for (size_t k = n; k > 0; --k) {
+        obj* p = reinterpret_cast<obj*>(first + (k - 1) * size);
+        p->next = head;
+        head = p;
+    }
+    free_list_[i] = head;
+}
+
+inline void pool_arena::free_chunks() noexcept {
+    chunk* cur = chunks_;
+    while (cur) {
+        chunk* next = cur->next;
+        ::operator delete(cur);
+        cur = next;
+    }
+    chunks_ = nullptr;
+    chunk_num_ = 0;
+    for (size_t i = 0; i < class_num; ++i) {
+        free_list_[i] = nullptr;
+        next_chunk_bytes_[i] = pool_min_chunk_bytes;
+    }
+}
+
+// template class: pool_allocator
+// single objects come from the arena of the allocator, arrays from the heap.
+// A container copy gets an arena of its own; swap and move assignment carry
+// the arena along with the nodes.
+template <class T>
+class pool_allocator {
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template <class U>
+    struct rebind {
+        typedef pool_allocator<U> other;
+    };
+
+    template <class U>
+    friend class pool_allocator;
+
+   public:
+    pool_allocator() : arena_(new pool_arena) {}
+    pool_allocator(const pool_allocator& rhs) noexcept : arena_(rhs.arena_) {
+        arena_->add_ref();
+    }
+    template <class U>
+    pool_allocator(const pool_allocator<U>& rhs) noexcept : arena_(rhs.arena_) {
+        arena_->add_ref();
+    }
+
+    pool_allocator& operator=(const pool_allocator& rhs) noexcept {
+        pool_allocator tmp(rhs);
+        mystl::swap(arena_, tmp.arena_);
+        return *this;
+    }
+    // rhs keeps an arena, ours
+    pool_allocator& operator=(pool_allocator&& rhs) noexcept {
+        mystl::swap(arena_, rhs.arena_);
+        return *this;
+    }
+
+    ~pool_allocator() { drop(); }
+
+    pool_allocator select_on_container_copy_construction() const {
+        return pool_allocator();
+    }
+
+   private:
+    typedef pool_size_class<T> size_class;
+
+   public:
+    T* allocate(size_type n);
+    allocation_result<T*> allocate_at_least(size_type n);
+    void deallocate(T* ptr, size_type n) noexcept;
+
+    // give the arena's chunks back if none of its objects is live; containers
+    // call it through allocator_traits::release when they go away
+    void release() noexcept { arena_->release(); }
+
+    size_t live_count() const noexcept { return arena_->live_count(); }
+    size_t chunk_count() const noexcept { return arena_->chunk_count(); }
+
+    const pool_arena* arena() const noexcept { return arena_; }
+
+   private:
+    void drop() noexcept {
+        if (arena_->drop_ref()) {
+            delete arena_;
+        }
+    }
+
+   private:
+    pool_arena* arena_;
+};
+
+template <class T>
+T* pool_allocator<T>::allocate(size_type n) {
+    if (n == 0) {
+        return nullptr;
+    }
+    if (n == 1 && size_class::use_pool) {
+        return static_cast<T*>(arena_->allocate(size_class::value));
+    }
+    return mystl::heap_allocate<T>(n);
+}
+
+// arrays are rounded up to the heap chunk, a single object is never rounded
+// up into an array
+template <class T>
+allocation_result<T*> pool_allocator<T>::allocate_at_least(size_type n) {
+    if (n <= 1) {
+        return {allocate(n), n};
+    }
+    return mystl::heap_allocate_at_least<T>(n);
+}
+
+template <class T>
+void pool_allocator<T>::deallocate(T* ptr, size_type n) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (n == 1 && size_class::use_pool) {
+        arena_->deallocate(ptr, size_class::value);
+    } else {
+        mystl::heap_deallocate(ptr);
+    }
+}
+
+template <class T, class U>
+bool operator==(const pool_allocator<T>& lhs, const pool_allocator<U>& rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const pool_allocator<T>& lhs, const pool_allocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+}  // namespace mystl
+#endif
@@ -1,7 +1,27 @@
-#ifndef MYSTL_DEQUE_H
-#define MYSTL_DEQUE_H
-
+#ifndef MYSTL_QUEUE_H_
+#define MYSTL_QUEUE_H_
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MYSTL_HAS_FUTEX 1
+#else
+#define MYSTL_HAS_FUTEX 0
+#endif
+
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "construct.h"
 #include "deque.h"
+#include "exceptdef.h"
 #include "functional.h"
 #include "heap_algo.h"
 #include "vector.h"
@@ -94,10 +114,10 @@ class queue {
     }
 
    public:
-    friend bool operator==(const queue& lsh, const queue& rhs) {
+    friend bool operator==(const queue& lhs, const queue& rhs) {
         return lhs.c_ == rhs.c_;
     }
-    friend bool operator<(const queue& lsh, const queue& rhs) {
+    friend bool operator<(const queue& lhs, const queue& rhs) {
         return lhs.c_ < rhs.c_;
     }
 };
@@ -142,6 +162,324 @@ void swap(queue<T, Container>& lhs,
     lhs.swap(rhs);
 }
 
+// futex_wait blocks while word still holds expected, futex_wake wakes up to
+// n of its sleepers. Without futexes the wait is a yield and the wake a no-op
+inline void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) {
+#if MYSTL_HAS_FUTEX
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+              FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+inline void futex_wake(std::atomic<uint32_t>& word, int n) {
+#if MYSTL_HAS_FUTEX
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+              FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)n;
+#endif
+}
+
+// a slot of mpmc_queue: its sequence number says whose turn it is
+template <class T>
+struct mpmc_cell {
+    std::atomic<size_t> seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+
+    T* ptr() noexcept { return reinterpret_cast<T*>(&data); }
+};
+
+// template class: mpmc_queue
+// a bounded queue for any number of producer and consumer threads (Dmitry
+// Vyukov's design). Slot pos & mask is free for the push of pos when its
+// sequence number is pos and holds the element of pos when it is pos + 1; a
+// thread claims a position with one CAS on the shared index and hands the
+// slot over with one store to its sequence number.
+// try_push / try_pop never block. push / pop first retry spin_count() times,
+// then sleep on a futex until the other side makes room or an element.
+template <class T, class Alloc = mystl::allocator<T>>
+class mpmc_queue
+    : private mystl::alloc_storage<typename mystl::allocator_traits<
+          Alloc>::template rebind_alloc<mpmc_cell<T>>> {
+   public:
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<
+        mpmc_cell<T>>
+        cell_allocator;
+    typedef mystl::allocator_traits<cell_allocator> cell_traits;
+    typedef T value_type;
+    typedef typename cell_traits::size_type size_type;
+
+    static constexpr unsigned default_spins = 64;
+
+   private:
+    typedef mystl::alloc_storage<cell_allocator> alloc_base;
+    typedef mpmc_cell<T> cell;
+
+    // the word threads sleep on until the other side makes progress, bumped
+    // by that side before it wakes them all, and whether anyone may sleep
+    struct sleepers {
+        std::atomic<uint32_t> epoch;
+        std::atomic<uint32_t> waiting;
+    };
+
+    // read only after construction, shared by all threads
+    cell* buf_;
+    size_type mask_;
+    unsigned spins_;
+    char pad0_[cache_line_size];
+    std::atomic<size_type> enqueue_pos_;
+    char pad1_[cache_line_size];
+    std::atomic<size_type> dequeue_pos_;
+    char pad2_[cache_line_size];
+    // read by every push and pop, written only around a sleep
+    sleepers not_empty_;
+    sleepers not_full_;
+    char pad3_[cache_line_size];
+
+    cell_allocator& cell_alloc() noexcept { return alloc_base::get_alloc(); }
+
+   public:
+    // room for capacity elements, rounded up to a power of two (at least 2)
+    explicit mpmc_queue(size_type capacity,
+                        const allocator_type& alloc = allocator_type());
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue();
+
+   public:
+    size_type capacity() const noexcept { return mask_ + 1; }
+
+    // a snapshot, exact only while no thread is running
+    size_type size() const noexcept {
+        const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+        const size_type n = enqueue_pos_.load(std::memory_order_acquire) - head;
+        return n < capacity() ? n : capacity();
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // how often push / pop retry before they go to sleep
+    unsigned spin_count() const noexcept { return spins_; }
+    void set_spin_count(unsigned spins) noexcept { spins_ = spins; }
+
+    // false if the queue is full. An element whose construction may throw
+    // is built before a slot is claimed, so args may be moved from even then
+    template <class... Args>
+    bool try_emplace(Args&&... args) {
+        return try_emplace_aux(
+            std::is_nothrow_constructible<T, Args&&...>(),
+            mystl::forward<Args>(args)...);
+    }
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+
+    bool try_push(value_type&& value) {
+        return try_emplace(mystl::move(value));
+    }
+
+    // false if the queue is empty
+    bool try_pop(value_type& value);
+
+    // wait until there is room
+    template <class... Args>
+    void emplace(Args&&... args) {
+        emplace_aux(std::is_nothrow_constructible<T, Args&&...>(),
+                    mystl::forward<Args>(args)...);
+    }
+
+    void push(const value_type& value) { emplace(value); }
+
+    void push(value_type&& value) { emplace(mystl::move(value)); }
+
+    // wait until there is an element
+    void pop(value_type& value);
+
+   private:
+    // a claimed position can't be given back, so a slot is only claimed for
+    // a construction that can't throw
+    template <class... Args>
+    bool try_emplace_aux(std::true_type, Args&&... args);
+    template <class... Args>
+    bool try_emplace_aux(std::false_type, Args&&... args) {
+        return try_emplace_aux(std::true_type(),
+                               value_type(mystl::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    void emplace_aux(std::true_type, Args&&... args);
+    template <class... Args>
+    void emplace_aux(std::false_type, Args&&... args) {
+        emplace_aux(std::true_type(),
+                    value_type(mystl::forward<Args>(args)...));
+    }
+
+    void notify(sleepers& s);
+};
+
+template <class T, class Alloc>
+constexpr unsigned mpmc_queue<T, Alloc>::default_spins;
+
+template <class T, class Alloc>
+mpmc_queue<T, Alloc>::mpmc_queue(size_type capacity,
+                                 const allocator_type& alloc)
+    : alloc_base(cell_allocator(alloc)),
+      buf_(nullptr),
+      mask_(0),
+      spins_(default_spins),
+      enqueue_pos_(0),
+      dequeue_pos_(0) {
+    THROW_LENGTH_ERROR_IF(capacity > cell_traits::max_size(cell_alloc()) / 2,
+                          "mpmc_queue<T>'s capacity too big");
+    not_empty_.epoch.store(0, std::memory_order_relaxed);
+    not_empty_.waiting.store(0, std::memory_order_relaxed);
+    not_full_.epoch.store(0, std::memory_order_relaxed);
+    not_full_.waiting.store(0, std::memory_order_relaxed);
+    size_type cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    buf_ = cell_traits::allocate(cell_alloc(), cap);
+    mask_ = cap - 1;
+    for (size_type i = 0; i != cap; ++i) {
+        mystl::construct(&buf_[i].seq, i);
+    }
+}
+
+template <class T, class Alloc>
+mpmc_queue<T, Alloc>::~mpmc_queue() {
+    const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type i = dequeue_pos_.load(std::memory_order_relaxed);
+         i != tail; ++i) {
+        mystl::destroy(buf_[i & mask_].ptr());
+    }
+    cell_traits::deallocate(cell_alloc(), buf_, capacity());
+}
+
+template <class T, class Alloc>
+template <class... Args>
+bool mpmc_queue<T, Alloc>::try_emplace_aux(std::true_type, Args&&... args) {
+    static_assert(std::is_nothrow_constructible<T, Args&&...>::value,
+                  "mpmc_queue<T> needs a nothrow move constructor");
+    size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+        c = &buf_[pos & mask_];
+        const size_type seq = c->seq.load(std::memory_order_acquire);
+        const ptrdiff_t dif =
+            static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+        if (dif == 0) {
+            if (enqueue_pos_.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (dif < 0) {
+            // the slot still holds the element of pos - capacity
+            return false;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    mystl::construct(c->ptr(), mystl::forward<Args>(args)...);
+    c->seq.store(pos + 1, std::memory_order_release);
+    notify(not_empty_);
+    return true;
+}
+
+template <class T, class Alloc>
+bool mpmc_queue<T, Alloc>::try_pop(value_type& value) {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+        c = &buf_[pos & mask_];
+        const size_type seq = c->seq.load(std::memory_order_acquire);
+        const ptrdiff_t dif =
+            static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+        if (dif == 0) {
+            if (dequeue_pos_.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return false;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    // the slot is released even if the assignment throws
+    try {
+        value = mystl::move(*c->ptr());
+    } catch (...) {
+        mystl::destroy(c->ptr());
+        c->seq.store(pos + 1 + mask_, std::memory_order_release);
+        notify(not_full_);
+        throw;
+    }
+    mystl::destroy(c->ptr());
+    c->seq.store(pos + 1 + mask_, std::memory_order_release);
+    notify(not_full_);
+    return true;
+}
+
+// raise the waiting flag, look once more, then sleep unless the other side
+// bumped the epoch in between; notify() pairs with the fences
+template <class T, class Alloc>
+template <class... Args>
+void mpmc_queue<T, Alloc>::emplace_aux(std::true_type, Args&&... args) {
+    for (unsigned i = 0; i != spins_; ++i) {
+        if (try_emplace_aux(std::true_type(), mystl::forward<Args>(args)...)) {
+            return;
+        }
+    }
+    for (;;) {
+        const uint32_t epoch = not_full_.epoch.load(std::memory_order_acquire);
+        not_full_.waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (try_emplace_aux(std::true_type(), mystl::forward<Args>(args)...)) {
+            return;
+        }
+        mystl::futex_wait(not_full_.epoch, epoch);
+    }
+}
+
+template <class T, class Alloc>
+void mpmc_queue<T, Alloc>::pop(value_type& value) {
+    for (unsigned i = 0; i != spins_; ++i) {
+        if (try_pop(value)) {
+            return;
+        }
+    }
+    for (;;) {
+        const uint32_t epoch = not_empty_.epoch.load(std::memory_order_acquire);
+        not_empty_.waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (try_pop(value)) {
+            return;
+        }
+        mystl::futex_wait(not_empty_.epoch, epoch);
+    }
+}
+
+// the first push or pop after a thread raised the flag clears it and wakes
+// every sleeper; the ones that find nothing raise it again. A push or pop
+// therefore costs a system call only once per sleep, not once per element
+template <class T, class Alloc>
+void mpmc_queue<T, Alloc>::notify(sleepers& s) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (s.waiting.load(std::memory_order_relaxed) != 0 &&
+        s.waiting.exchange(0, std::memory_order_relaxed) != 0) {
+        s.epoch.fetch_add(1, std::memory_order_release);
+        mystl::futex_wake(s.epoch, INT_MAX);
+    }
+}
+
 // template class : priority_quue
 template <class T, class Container = mystl::vector<T>,
           class Compare = mystl::less<typename Container::value_type>>
@@ -167,12 +505,12 @@ class priority_queue {
     priority_queue(const Compare& c) : c_(), comp_(c) {}
 
     explicit priority_queue(size_type n) : c_(n) {
-        mystl::make_heap(c_.begin(), c_end(), comp_);
+        mystl::make_heap(c_.begin(), c_.end(), comp_);
     }
 
-    explicit priority_queue(size_type n, const value_type& vlaue)
+    explicit priority_queue(size_type n, const value_type& value)
         : c_(n, value) {
-        mystl::make_heap(c_.begin(), c_end(), comp_);
+        mystl::make_heap(c_.begin(), c_.end(), comp_);
     }
 
     template <class IIter>
@@ -187,15 +525,14 @@ class priority_queue {
     priority_queue(const Container& s) : c_(s) {
         mystl::make_heap(c_.begin(), c_.end(), comp_);
     }
-    priority_queue(Container&& s) : c_.(mystl::move(s)) {
+    priority_queue(Container&& s) : c_(mystl::move(s)) {
         mystl::make_heap(c_.begin(), c_.end(), comp_);
     }
     priority_queue(const priority_queue& rhs) : c_(rhs.c_), comp_(rhs.comp_) {
         mystl::make_heap(c_.begin(), c_.end(), comp_);
     }
     priority_queue(priority_queue&& rhs)
-        : c_.(mystl::move(rhs.c_)),
-    comp_(rhs.comp_) {
+        : c_(mystl::move(rhs.c_)), comp_(rhs.comp_) {
         mystl::make_heap(c_.begin(), c_.end(), comp_);
     }
     priority_queue& operator=(const priority_queue& rhs) {
@@ -258,25 +595,25 @@ class priority_queue {
     }
 
    public:
-    friend bool operator==(const priority_queue& rhs,
+    friend bool operator==(const priority_queue& lhs,
                            const priority_queue& rhs) {
         return lhs.c_ == rhs.c_;
     }
-    friend bool operator!=(const priority_queue& rhs,
+    friend bool operator!=(const priority_queue& lhs,
                            const priority_queue& rhs) {
         return lhs.c_ != rhs.c_;
     }
 };
 
 template <class T, class Container, class Compare>
-bool operator==(priority_queue<T, Container, Compare>& lhs,
-                priority_queue<T, Container, Compare>& rhs) {
+bool operator==(const priority_queue<T, Container, Compare>& lhs,
+                const priority_queue<T, Container, Compare>& rhs) {
     return lhs == rhs;
 }
 
 template <class T, class Container, class Compare>
-bool operator!=(priority_queue<T, Container, Compare>& lhs,
-                priority_queue<T, Container, Compare>& rhs) {
+bool operator!=(const priority_queue<T, Container, Compare>& lhs,
+                const priority_queue<T, Container, Compare>& rhs) {
     return lhs != rhs;
 }
 
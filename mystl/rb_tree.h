@@ -64,7 +64,7 @@ struct rb_tree_value_traits_imp {
     }
 
     template <class Ty>
-    static const value_type& get_value(const Ty& vlaue) {
+    static const value_type& get_value(const Ty& value) {
         return value;
     }
 };
@@ -81,7 +81,7 @@ struct rb_tree_value_traits_imp<T, true> {
     }
 
     template <class Ty>
-    static const value_type& get_value(const Ty& vlaue) {
+    static const value_type& get_value(const Ty& value) {
         return value;
     }
 };
@@ -103,7 +103,7 @@ struct rb_tree_value_traits {
 
     template <class Ty>
     static const value_type& get_value(const Ty& value) {
-        return value_traits_type::get_vlaue(value);
+        return value_traits_type::get_value(value);
     }
 };
 
@@ -154,13 +154,13 @@ struct rb_tree_traits {
     typedef rb_tree_value_traits<T> value_traits;
 
     typedef typename value_traits::key_type key_type;
-    typedef typename vlaue_traits::mapped_type mapped_type;
-    typedef typename vlaue_traits::value_type value_type;
+    typedef typename value_traits::mapped_type mapped_type;
+    typedef typename value_traits::value_type value_type;
 
     typedef value_type* pointer;
     typedef value_type& reference;
     typedef const value_type* const_pointer;
-    typedef const vlaue_type& const_reference;
+    typedef const value_type& const_reference;
 
     typedef rb_tree_node_base<T> base_type;
     typedef rb_tree_node<T> node_type;
@@ -176,7 +176,7 @@ struct rb_tree_iterator_base
 
     base_ptr node;
 
-    rb_tree_iterator_base() node(nullptr) {}
+    rb_tree_iterator_base() : node(nullptr) {}
 
     void inc() {
         if (node->right != nullptr) {
@@ -208,11 +208,11 @@ struct rb_tree_iterator_base
         }
     }
 
-    bool operator==(const rb_tree_iterator_base& rhs) {
+    bool operator==(const rb_tree_iterator_base& rhs) const {
         return node == rhs.node;
     }
-    bool operator!=(const rb_tree_iterator_base& rhs) {
-        return node == rhs.node;
+    bool operator!=(const rb_tree_iterator_base& rhs) const {
+        return node != rhs.node;
     }
 };
 
@@ -235,7 +235,6 @@ struct rb_tree_iterator : public rb_tree_iterator_base<T> {
     rb_tree_iterator() {}
     rb_tree_iterator(base_ptr x) { node = x; }
     rb_tree_iterator(node_ptr x) { node = x; }
-    rb_tree_iterator(const iterator& rhs) { node = rhs.node; }
     rb_tree_iterator(const const_iterator& rhs) { node = rhs.node; }
 
     reference operator*() const { return node->get_node_ptr()->value; }
@@ -284,7 +283,6 @@ struct rb_tree_const_iterator : public rb_tree_iterator_base<T> {
     rb_tree_const_iterator(base_ptr x) { node = x; }
     rb_tree_const_iterator(node_ptr x) { node = x; }
     rb_tree_const_iterator(const iterator& rhs) { node = rhs.node; }
-    rb_tree_const_iterator(const const_iterator& rhs) { node = rhs.node; }
 
     reference operator*() const { return node->get_node_ptr()->value; }
     pointer operator->() const { return &(operator*()); }
@@ -501,7 +499,8 @@ NodePtr rb_tree_erase_rebalence(NodePtr z, NodePtr& root, NodePtr& leftmost,
             z->parent->right = y;
         }
         y->parent = z->parent;
-        mystl::swap(y->color, z->color) : y = z;
+        mystl::swap(y->color, z->color);
+        y = z;
     } else {
         xp = y->parent;
         if (x) {
@@ -517,7 +516,8 @@ NodePtr rb_tree_erase_rebalence(NodePtr z, NodePtr& root, NodePtr& leftmost,
 
         if (leftmost == z) {
             leftmost = x == nullptr ? xp : rb_tree_min(x);
-        } else {
+        }
+        if (rightmost == z) {
             rightmost = x == nullptr ? xp : rb_tree_max(x);
         }
     }
@@ -547,7 +547,7 @@ NodePtr rb_tree_erase_rebalence(NodePtr z, NodePtr& root, NodePtr& leftmost,
                         }
                         rb_tree_set_red(brother);
                         rb_tree_rotate_right(brother, root);
-                        brother = xp->ritht;
+                        brother = xp->right;
                     }
                     brother->color = xp->color;
                     rb_tree_set_black(xp);
@@ -599,8 +599,10 @@ NodePtr rb_tree_erase_rebalence(NodePtr z, NodePtr& root, NodePtr& leftmost,
     return y;
 }
 
-template <class T, class Compare>
-class rb_tree {
+template <class T, class Compare, class Alloc = mystl::allocator<T>>
+class rb_tree
+    : private mystl::alloc_storage<typename mystl::allocator_traits<
+          Alloc>::template rebind_alloc<rb_tree_node<T>>> {
    public:
     typedef rb_tree_traits<T> tree_traits;
     typedef rb_tree_value_traits<T> value_traits;
@@ -614,51 +616,82 @@ class rb_tree {
     typedef typename tree_traits::value_type value_type;
     typedef Compare key_compare;
 
-    typedef mystl::allocator<T> allocator_type;
-    typedef mystl::allocator<T> data_allocator;
-    typedef mystl::allocator<base_type> base_allocator;
-    typedef mystl::allocator<node_type> node_allocator;
+    typedef Alloc allocator_type;
+    typedef mystl::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<T> data_allocator;
+    typedef typename alloc_traits::template rebind_alloc<node_type>
+        node_allocator;
+    typedef mystl::allocator_traits<node_allocator> node_alloc_traits;
 
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename node_alloc_traits::size_type size_type;
+    typedef typename node_alloc_traits::difference_type difference_type;
 
     typedef rb_tree_iterator<T> iterator;
     typedef rb_tree_const_iterator<T> const_iterator;
     typedef mystl::reverse_iterator<iterator> reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
 
-    allocator_type get_allocator() const { return node_allocator(); }
+    allocator_type get_allocator() const {
+        return allocator_type(node_alloc());
+    }
     key_compare key_comp() const { return key_comp_; }
 
    private:
-    base_ptr header_;
+    typedef mystl::alloc_storage<node_allocator> alloc_base;
+
+    node_allocator& node_alloc() noexcept { return alloc_base::get_alloc(); }
+    const node_allocator& node_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
+   private:
+    // the header: parent is the root, left and right the smallest and the
+    // largest node. It lives in the tree, so an empty or moved-from tree owns
+    // no node
+    base_type head_;
     size_type node_count_;
     key_compare key_comp_;
 
    private:
-    base_ptr& root() const { return header_->parent; }
-    base_ptr& leftmost() const { return header_->left; }
-    base_ptr& rightmost() const { return header_->right; }
+    base_ptr header() const { return const_cast<base_ptr>(&head_); }
+    base_ptr& root() const { return const_cast<base_ptr&>(head_.parent); }
+    base_ptr& leftmost() const { return const_cast<base_ptr&>(head_.left); }
+    base_ptr& rightmost() const { return const_cast<base_ptr&>(head_.right); }
 
    public:
     rb_tree() { rb_tree_init(); }
+    explicit rb_tree(const allocator_type& alloc)
+        : alloc_base(node_allocator(alloc)), key_comp_() {
+        rb_tree_init();
+    }
+    rb_tree(const key_compare& comp, const allocator_type& alloc)
+        : alloc_base(node_allocator(alloc)), key_comp_(comp) {
+        rb_tree_init();
+    }
     rb_tree(const rb_tree& rhs);
+    rb_tree(const rb_tree& rhs, const allocator_type& alloc);
     rb_tree(rb_tree&& rhs) noexcept;
+    rb_tree(rb_tree&& rhs, const allocator_type& alloc);
 
     rb_tree& operator=(const rb_tree& rhs);
-    rb_tree& operator=(rb_tree&& rhs);
+    rb_tree& operator=(rb_tree&& rhs) noexcept(
+        node_alloc_traits::propagate_on_container_move_assignment::value ||
+        node_alloc_traits::is_always_equal::value);
 
-    ~rb_tree() { clear(); }
+    ~rb_tree() {
+        clear();
+        node_alloc_traits::release(node_alloc());
+    }
 
    public:
     iterator begin() noexcept { return leftmost(); }
     const_iterator begin() const noexcept { return leftmost(); }
-    iterator end() noexcept { return header_; }
-    const_iterator end() const noexcept { return header_; }
+    iterator end() noexcept { return header(); }
+    const_iterator end() const noexcept { return header(); }
 
     reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
     const_reverse_iterator rbegin() const noexcept {
@@ -790,8 +823,10 @@ class rb_tree {
     node_ptr clone_node(base_ptr x);
     void destroy_node(node_ptr p);
 
-    void rb_tree_init();
-    void reset();
+    void rb_tree_init() noexcept;
+    void link_header() noexcept;
+    void copy_tree(const rb_tree& rhs);
+    void steal(rb_tree& rhs) noexcept;
 
     mystl::pair<base_ptr, bool> get_insert_multi_pos(const key_type& key);
     mystl::pair<mystl::pair<base_ptr, bool>, bool> get_insert_unique_pos(
@@ -808,67 +843,100 @@ class rb_tree {
     void erase_since(base_ptr x);
 };
 
-template <class T, class Compare>
-rb_tree<T, Compare>::rb_tree(const rb_tree& rhs) {
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::rb_tree(const rb_tree& rhs)
+    : alloc_base(node_alloc_traits::select_on_container_copy_construction(
+          rhs.node_alloc())),
+      key_comp_(rhs.key_comp_) {
     rb_tree_init();
-    if (rhs.node_count_ != 0) {
-        root() = copy_from(rhs.root(), header_);
-        leftmost() = rb_tree_min(root());
-        rightmost() = rb_tree_max(root());
-    }
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
+    copy_tree(rhs);
 }
 
-template <class T, class Compare>
-rb_tree<T, Compare>::rb_tree(rb_tree&& rhs) noexcept
-    : header_(mystl::move(rhs.header)),
-      node_count_(rhs.node_count_),
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::rb_tree(const rb_tree& rhs,
+                                    const allocator_type& alloc)
+    : alloc_base(node_allocator(alloc)), key_comp_(rhs.key_comp_) {
+    rb_tree_init();
+    copy_tree(rhs);
+}
+
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::rb_tree(rb_tree&& rhs) noexcept
+    : alloc_base(mystl::move(rhs.node_alloc())),
       key_comp_(rhs.key_comp_) {
-    rhs.reset();
+    rb_tree_init();
+    steal(rhs);
 }
 
-template <class T, class Compare>
-rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(const rb_tree& rhs) {
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>::rb_tree(rb_tree&& rhs, const allocator_type& alloc)
+    : alloc_base(node_allocator(alloc)), key_comp_(rhs.key_comp_) {
+    rb_tree_init();
+    if (mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+        steal(rhs);
+    } else {
+        for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+            emplace_multi_use_hint(end(), mystl::move(*it));
+        }
+    }
+}
+
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>& rb_tree<T, Compare, Alloc>::operator=(
+    const rb_tree& rhs) {
     if (this != &rhs) {
         clear();
-
-        if (rhs.node_count_ != 0) {
-            root() = copy_from(rhs.root(), header_);
-            leftmost() = rb_tree_min(root());
-            rightmost() = rb_tree_max(root());
+        if (node_alloc_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+            mystl::alloc_on_copy(node_alloc(), rhs.node_alloc());
         }
-        node_count_ = rhs.node_count_;
         key_comp_ = rhs.key_comp_;
+        copy_tree(rhs);
     }
     return *this;
 }
 
-template <class T, class Compare>
-rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(rb_tree&& rhs) {
+template <class T, class Compare, class Alloc>
+rb_tree<T, Compare, Alloc>& rb_tree<T, Compare, Alloc>::operator=(
+    rb_tree&& rhs) noexcept(node_alloc_traits::
+                                propagate_on_container_move_assignment::value ||
+                            node_alloc_traits::is_always_equal::value) {
+    if (this == &rhs) {
+        return *this;
+    }
     clear();
-    header_ = mystl::move(rhs.header);
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
-    rhs.reset();
+    if (mystl::alloc_equal(node_alloc(), rhs.node_alloc())) {
+        steal(rhs);
+    } else if (node_alloc_traits::propagate_on_container_move_assignment::
+                   value) {
+        mystl::alloc_on_move(node_alloc(), rhs.node_alloc());
+        steal(rhs);
+    } else {
+        // nodes of rhs can't be freed by our allocator, move the values
+        key_comp_ = rhs.key_comp_;
+        for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+            emplace_multi_use_hint(end(), mystl::move(*it));
+        }
+        rhs.clear();
+    }
     return *this;
 }
 
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::emplace_multi(
-    Args&&... args) {
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::emplace_multi(Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1,
                           "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(mystl::forward<Args>(args)...);
-    auto res = get_insert_unique_pos(value_traits::get_key(np->value));
+    auto res = get_insert_multi_pos(value_traits::get_key(np->value));
     return insert_node_at(res.first, np, res.second);
 }
 
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-mystl::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::emplace_unique(Args&&... args) {
+mystl::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::emplace_unique(Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1,
                           "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(mystl::forward<Args>(args)...);
@@ -881,15 +949,16 @@ rb_tree<T, Compare>::emplace_unique(Args&&... args) {
     return mystl::make_pair(iterator(res.first.first), false);
 }
 
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_multi_use_hint(iterator hint, Args&&... args) {
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::emplace_multi_use_hint(iterator hint,
+                                                   Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1,
                           "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(mystl::forward<Args>(args)...);
     if (node_count_ == 0) {
-        return insert_node_at(header_, np, true);
+        return insert_node_at(header(), np, true);
     }
     key_type key = value_traits::get_key(np->value);
     if (hint == begin()) {
@@ -911,15 +980,16 @@ rb_tree<T, Compare>::emplace_multi_use_hint(iterator hint, Args&&... args) {
     return insert_multi_use_hint(hint, key, np);
 }
 
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::emplace_unique_use_hint(iterator hint,
+                                                    Args&&... args) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1,
                           "rb_tree<T, Comp>'s size too big");
     node_ptr np = create_node(mystl::forward<Args>(args)...);
     if (node_count_ == 0) {
-        return insert_node_at(header_, np, true);
+        return insert_node_at(header(), np, true);
     }
     key_type key = value_traits::get_key(np->value);
     if (hint == begin()) {
@@ -941,6 +1011,7 @@ rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
             auto pos = get_insert_unique_pos(key);
             if (!pos.second) {
                 destroy_node(np);
+                return pos.first.first;
             }
             return insert_node_at(pos.first.first, np, pos.first.second);
         }
@@ -948,18 +1019,18 @@ rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
     return insert_unique_use_hint(hint, key, np);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::insert_multi(
-    const value_type& vlaue) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_multi(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1,
                           "rb_tree<T, Comp>'s size too big");
     auto res = get_insert_multi_pos(value_traits::get_key(value));
     return insert_value_at(res.first, value, res.second);
 }
 
-template <class T, class Compare>
-mystl::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::insert_unique(const value_type& value) {
+template <class T, class Compare, class Alloc>
+mystl::pair<typename rb_tree<T, Compare, Alloc>::iterator, bool>
+rb_tree<T, Compare, Alloc>::insert_unique(const value_type& value) {
     THROW_LENGTH_ERROR_IF(node_count_ > max_size() - 1,
                           "rb_tree<T, Comp>'s size too big");
     auto res = get_insert_unique_pos(value_traits::get_key(value));
@@ -970,9 +1041,9 @@ rb_tree<T, Compare>::insert_unique(const value_type& value) {
     return mystl::make_pair(iterator(res.first.first), false);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::erase(
-    iterator hint) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::erase(iterator hint) {
     auto node = hint.node->get_node_ptr();
     iterator next(node);
     ++next;
@@ -983,18 +1054,18 @@ typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::erase(
     return next;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type rb_tree<T, Compare>::erase_multi(
-    const key_type& key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::erase_multi(const key_type& key) {
     auto p = equal_range_multi(key);
     size_type n = mystl::distance(p.first, p.second);
     erase(p.first, p.second);
     return n;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type rb_tree<T, Compare>::erase_unique(
-    const key_type& key) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::size_type
+rb_tree<T, Compare, Alloc>::erase_unique(const key_type& key) {
     auto it = find(key);
     if (it != end()) {
         erase(it);
@@ -1003,8 +1074,8 @@ typename rb_tree<T, Compare>::size_type rb_tree<T, Compare>::erase_unique(
     return 0;
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::erase(iterator first, iterator last) {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::erase(iterator first, iterator last) {
     if (first == begin() && last == end()) {
         clear();
     } else {
@@ -1014,21 +1085,21 @@ void rb_tree<T, Compare>::erase(iterator first, iterator last) {
     }
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::clear() {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::clear() {
     if (node_count_ != 0) {
         erase_since(root());
-        leftmost() = header_;
+        leftmost() = header();
         root() = nullptr;
-        rightmost() = header_;
+        rightmost() = header();
         node_count_ = 0;
     }
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::find(
-    const key_type& key) {
-    auto y = header_;
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::find(const key_type& key) {
+    auto y = header();
     auto x = root();
     while (x != nullptr) {
         if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
@@ -1042,10 +1113,10 @@ typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::find(
                                                                      : j;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::find(
-    const key_type& key) const {
-    auto y = header_;
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::find(const key_type& key) const {
+    auto y = header();
     auto x = root();
     while (x != nullptr) {
         if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
@@ -1059,10 +1130,10 @@ typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::find(
                                                                      : j;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::lower_bound(
-    const key_type& key) {
-    auto y = header_;
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::lower_bound(const key_type& key) {
+    auto y = header();
     auto x = root();
     while (x != nullptr) {
         if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
@@ -1074,10 +1145,10 @@ typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::lower_bound(
     return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::lower_bound(
-    const key_type& key) const {
-    auto y = header_;
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::lower_bound(const key_type& key) const {
+    auto y = header();
     auto x = root();
     while (x != nullptr) {
         if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value),
@@ -1090,10 +1161,10 @@ typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::lower_bound(
     return const_iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::upper_bound(
-    const key_type& key) {
-    auto y = header_;
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::upper_bound(const key_type& key) {
+    auto y = header();
     auto x = root();
     while (x != nullptr) {
         if (key_comp_(key, value_traits::get_key(
@@ -1106,10 +1177,10 @@ typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::upper_bound(
     return iterator(y);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::upper_bound(
-    const key_type& key) const {
-    auto y = header_;
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::const_iterator
+rb_tree<T, Compare, Alloc>::upper_bound(const key_type& key) const {
+    auto y = header();
     auto x = root();
     while (x != nullptr) {
         if (key_comp_(key, value_traits::get_key(
@@ -1122,37 +1193,43 @@ typename rb_tree<T, Compare>::const_iterator rb_tree<T, Compare>::upper_bound(
     return const_iterator(y);
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::swap(rb_tree& rhs) noexcept {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::swap(rb_tree& rhs) noexcept {
     if (this != &rhs) {
-        mystl::swap(header_, rhs.header_);
+        mystl::alloc_on_swap(node_alloc(), rhs.node_alloc());
+        mystl::swap(head_.parent, rhs.head_.parent);
+        mystl::swap(head_.left, rhs.head_.left);
+        mystl::swap(head_.right, rhs.head_.right);
         mystl::swap(node_count_, rhs.node_count_);
         mystl::swap(key_comp_, rhs.key_comp_);
+        link_header();
+        rhs.link_header();
     }
 }
 
 // helper functions
-template <class T, class Compare>
+template <class T, class Compare, class Alloc>
 template <class... Args>
-typename rb_tree<T, Compare>::node_ptr rb_tree<T, Compare>::create_node(
-    Args&&... args) {
-    auto tmp = node_allocator::allocate(1);
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::create_node(Args&&... args) {
+    node_ptr tmp = node_alloc_traits::allocate(node_alloc(), 1);
     try {
-        data_allocator::construct(mystl::address_of(tmp->value),
-                                  mystl::forward<Args>(args)...);
+        node_alloc_traits::construct(node_alloc(),
+                                     mystl::address_of(tmp->value),
+                                     mystl::forward<Args>(args)...);
         tmp->left = nullptr;
         tmp->right = nullptr;
         tmp->parent = nullptr;
     } catch (...) {
-        node_allocator::deallocate(tmp);
+        node_alloc_traits::deallocate(node_alloc(), tmp, 1);
         throw;
     }
     return tmp;
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr rb_tree<T, Compare>::clone_node(
-    base_ptr x) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::node_ptr
+rb_tree<T, Compare, Alloc>::clone_node(base_ptr x) {
     node_ptr tmp = create_node(x->get_node_ptr()->value);
     tmp->color = x->color;
     tmp->left = nullptr;
@@ -1160,33 +1237,61 @@ typename rb_tree<T, Compare>::node_ptr rb_tree<T, Compare>::clone_node(
     return tmp;
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::destroy_node(node_ptr p) {
-    data_allocator::destroy(&p->value);
-    node_allocator::deallocate(p);
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::destroy_node(node_ptr p) {
+    node_alloc_traits::destroy(node_alloc(), mystl::address_of(p->value));
+    node_alloc_traits::deallocate(node_alloc(), p, 1);
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::rb_tree_init() {
-    header_ = base_allocator::allocate(1);
-    header_->color = rb_tree_red;
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::rb_tree_init() noexcept {
+    head_.color = rb_tree_red;
     root() = nullptr;
-    leftmost() = header_;
-    rightmost() = header_;
+    leftmost() = header();
+    rightmost() = header();
     node_count_ = 0;
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset() {
-    header_ = nullptr;
-    node_count_ = 0;
+// point the root, or the ends of an empty tree, back at our header after
+// the header fields were taken from another tree
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::link_header() noexcept {
+    if (root() != nullptr) {
+        root()->parent = header();
+    } else {
+        leftmost() = header();
+        rightmost() = header();
+    }
+}
+
+// copy the nodes of rhs into this empty tree
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::copy_tree(const rb_tree& rhs) {
+    if (rhs.node_count_ != 0) {
+        root() = copy_from(rhs.root(), header());
+        leftmost() = rb_tree_min(root());
+        rightmost() = rb_tree_max(root());
+    }
+    node_count_ = rhs.node_count_;
 }
 
-template <class T, class Compare>
-mystl::pair<typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
+// take the nodes of rhs, this tree must be empty; rhs is left empty
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::steal(rb_tree& rhs) noexcept {
+    head_.parent = rhs.head_.parent;
+    head_.left = rhs.head_.left;
+    head_.right = rhs.head_.right;
+    node_count_ = rhs.node_count_;
+    key_comp_ = rhs.key_comp_;
+    link_header();
+    rhs.rb_tree_init();
+}
+
+template <class T, class Compare, class Alloc>
+mystl::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>
+rb_tree<T, Compare, Alloc>::get_insert_multi_pos(const key_type& key) {
     auto x = root();
-    auto y = header_;
+    auto y = header();
     bool add_to_left = true;
     while (x != nullptr) {
         y = x;
@@ -1197,11 +1302,12 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
     return mystl::make_pair(y, add_to_left);
 }
 
-template <class T, class Compare>
-mystl::pair<mystl::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
+template <class T, class Compare, class Alloc>
+mystl::pair<
+    mystl::pair<typename rb_tree<T, Compare, Alloc>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc>::get_insert_unique_pos(const key_type& key) {
     auto x = root();
-    auto y = header_;
+    auto y = header();
     bool add_to_left = true;
     while (x != nullptr) {
         y = x;
@@ -1211,7 +1317,7 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
     }
     iterator j = iterator(y);
     if (add_to_left) {
-        if (y == header_ || j == begin()) {
+        if (y == header() || j == begin()) {
             return mystl::make_pair(mystl::make_pair(y, true), true);
         } else {
             --j;
@@ -1223,13 +1329,14 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
     return mystl::make_pair(mystl::make_pair(y, add_to_left), false);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::insert_value_at(
-    base_ptr x, const value_type& value, bool add_to_left) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_value_at(base_ptr x, const value_type& value,
+                                            bool add_to_left) {
     node_ptr node = create_node(value);
     node->parent = x;
     auto base_node = node->get_base_ptr();
-    if (x == header_) {
+    if (x == header()) {
         root() = base_node;
         leftmost() = base_node;
         rightmost() = base_node;
@@ -1249,12 +1356,13 @@ typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::insert_value_at(
     return iterator(node);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::insert_node_at(
-    base_ptr x, node_ptr node, bool add_to_left) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_node_at(base_ptr x, node_ptr node,
+                                           bool add_to_left) {
     node->parent = x;
     auto base_node = node->get_base_ptr();
-    if (x == header_) {
+    if (x == header()) {
         root() = base_node;
         leftmost() = base_node;
         rightmost() = base_node;
@@ -1265,15 +1373,16 @@ typename rb_tree<T, Compare>::iterator rb_tree<T, Compare>::insert_node_at(
         x->right = base_node;
         if (rightmost() == x) rightmost() = base_node;
     }
-    rb_tree_insert_rebalance(base_node, root());
+    rb_tree_insert_rebalence(base_node, root());
     ++node_count_;
     return iterator(node);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key,
-                                           node_ptr node) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_multi_use_hint(iterator hint,
+                                                  key_type key,
+                                                  node_ptr node) {
     auto np = hint.node;
     auto before = hint;
     --before;
@@ -1291,10 +1400,11 @@ rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key,
     return insert_node_at(pos.first, node, pos.second);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key,
-                                            node_ptr node) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::iterator
+rb_tree<T, Compare, Alloc>::insert_unique_use_hint(iterator hint,
+                                                   key_type key,
+                                                   node_ptr node) {
     auto np = hint.node;
     auto before = hint;
     --before;
@@ -1315,9 +1425,9 @@ rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key,
     return insert_node_at(pos.first.first, node, pos.first.second);
 }
 
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr rb_tree<T, Compare>::copy_from(
-    base_ptr x, base_ptr p) {
+template <class T, class Compare, class Alloc>
+typename rb_tree<T, Compare, Alloc>::base_ptr
+rb_tree<T, Compare, Alloc>::copy_from(base_ptr x, base_ptr p) {
     auto top = clone_node(x);
     top->parent = p;
     try {
@@ -1339,8 +1449,8 @@ typename rb_tree<T, Compare>::base_ptr rb_tree<T, Compare>::copy_from(
     return top;
 }
 
-template <class T, class Compare>
-void rb_tree<T, Compare>::erase_since(base_ptr x) {
+template <class T, class Compare, class Alloc>
+void rb_tree<T, Compare, Alloc>::erase_since(base_ptr x) {
     while (x != nullptr) {
         erase_since(x->right);
         auto y = x->left;
@@ -1350,44 +1460,47 @@ void rb_tree<T, Compare>::erase_since(base_ptr x) {
 }
 
 // overload operators
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs,
-                const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator==(const rb_tree<T, Compare, Alloc>& lhs,
+                const rb_tree<T, Compare, Alloc>& rhs) {
     return lhs.size() == rhs.size() &&
            mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator<(const rb_tree<T, Compare, Alloc>& lhs,
+               const rb_tree<T, Compare, Alloc>& rhs) {
     return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
                                           rhs.end());
 }
 
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs,
-                const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator!=(const rb_tree<T, Compare, Alloc>& lhs,
+                const rb_tree<T, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator>(const rb_tree<T, Compare, Alloc>& lhs,
+               const rb_tree<T, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs,
-                const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator<=(const rb_tree<T, Compare, Alloc>& lhs,
+                const rb_tree<T, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs,
-                const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc>
+bool operator>=(const rb_tree<T, Compare, Alloc>& lhs,
+                const rb_tree<T, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept {
+template <class T, class Compare, class Alloc>
+void swap(rb_tree<T, Compare, Alloc>& lhs,
+          rb_tree<T, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
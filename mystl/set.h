@@ -30,7 +30,8 @@
 
 namespace mystl {
 
-template <class Key, class Compare = mystl::less<Key>>
+template <class Key, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<Key>>
 class set {
    public:
     typedef Key key_type;
@@ -39,7 +40,7 @@ class set {
     typedef Compare value_compare;
 
    private:
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -57,25 +58,40 @@ class set {
     typedef typename base_type::allocator_type allocator_type;
 
    public:
-    set() default;
+    set() = default;
+
+    explicit set(const key_compare& comp,
+                 const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit set(const allocator_type& alloc) : tree_(alloc) {}
 
     template <class InputIterator>
-    set(InputIterator first, InputIterator last) : tree_() {
+    set(InputIterator first, InputIterator last,
+        const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_unique(first, last);
     }
 
-    set(std::initializer_list<value_type> ilist) : tree_() {
+    set(std::initializer_list<value_type> ilist,
+        const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_unique(ilist.begin(), ilist.end());
     }
 
     set(const set& rhs) : tree_(rhs.tree_) {}
     set(set&& rhs) noexcept : tree_(mystl::move(rhs.tree_)) {}
+    set(const set& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {}
+    set(set&& rhs, const allocator_type& alloc)
+        : tree_(mystl::move(rhs.tree_), alloc) {}
 
     set& operator=(const set& rhs) {
         tree_ = rhs.tree_;
         return *this;
     }
-    set& operator=(set& rhs) {
+    set& operator=(set&& rhs) {
         tree_ = mystl::move(rhs.tree_);
         return *this;
     }
@@ -136,7 +152,7 @@ class set {
     }
 
     iterator insert(iterator hint, value_type&& value) {
-        return tree_.insert_unique(hint, mystl::mode(value));
+        return tree_.insert_unique(hint, mystl::move(value));
     }
 
     template <class InputIterator>
@@ -187,43 +203,51 @@ class set {
     }
 };
 
-template <class Key, class Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator==(const set<Key,
+                Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<(const set<Key,
+               Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator!=(const set<Key,
+                Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>(const set<Key,
+               Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<=(const set<Key,
+                Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>=(const set<Key,
+                Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class Key, class Compare>
-void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept {
+template <class Key, class Compare, class Alloc>
+void swap(set<Key,
+          Compare, Alloc>& lhs, set<Key, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 // tempalte class: multiset, which allow repeat key
-template <class Key, class Compare = mystl::less<Key>>
+template <class Key, class Compare = mystl::less<Key>,
+          class Alloc = mystl::allocator<Key>>
 class multiset {
    public:
     typedef Key key_type;
@@ -232,7 +256,7 @@ class multiset {
     typedef Compare value_compare;
 
    private:
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc> base_type;
     base_type tree_;
 
    public:
@@ -252,16 +276,31 @@ class multiset {
    public:
     multiset() = default;
 
+    explicit multiset(const key_compare& comp,
+                      const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+    explicit multiset(const allocator_type& alloc) : tree_(alloc) {}
+
     template <class InputIterator>
-    multiset(InputIterator first, InputIterator last) : tree_() {
+    multiset(InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+                 const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_multi(first, last);
     }
-    multiset(std::initializer_list<value_type> ilist) : tree_() {
+    multiset(std::initializer_list<value_type> ilist,
+             const key_compare& comp = key_compare(),
+                 const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {
         tree_.insert_multi(ilist.begin(), ilist.end());
     }
 
     multiset(const multiset& rhs) : tree_(rhs.tree_) {}
     multiset(multiset&& rhs) noexcept : tree_(mystl::move(rhs.tree_)) {}
+    multiset(const multiset& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc) {}
+    multiset(multiset&& rhs, const allocator_type& alloc)
+        : tree_(mystl::move(rhs.tree_), alloc) {}
 
     multiset& operator=(const multiset& rhs) {
         tree_ = rhs.tree_;
@@ -377,44 +416,45 @@ class multiset {
     }
 };
 
-template <class Key, class Compare>
-bool operator==(const multiset<Key, Compare>& lhs,
-                const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator==(const multiset<Key, Compare, Alloc>& lhs,
+                const multiset<Key, Compare, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class Compare>
-bool operator<(const multiset<Key, Compare>& lhs,
-               const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<(const multiset<Key, Compare, Alloc>& lhs,
+               const multiset<Key, Compare, Alloc>& rhs) {
     return lhs < rhs;
 }
 
-template <class Key, class Compare>
-bool operator!=(const multiset<Key, Compare>& lhs,
-                const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator!=(const multiset<Key, Compare, Alloc>& lhs,
+                const multiset<Key, Compare, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class Key, class Compare>
-bool operator>(const multiset<Key, Compare>& lhs,
-               const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>(const multiset<Key, Compare, Alloc>& lhs,
+               const multiset<Key, Compare, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class Key, class Compare>
-bool operator<=(const multiset<Key, Compare>& lhs,
-                const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator<=(const multiset<Key, Compare, Alloc>& lhs,
+                const multiset<Key, Compare, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class Key, class Compare>
-bool operator>=(const multiset<Key, Compare>& lhs,
-                const multiset<Key, Compare>& rhs) {
+template <class Key, class Compare, class Alloc>
+bool operator>=(const multiset<Key, Compare, Alloc>& lhs,
+                const multiset<Key, Compare, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class Key, class Compare>
-void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept {
+template <class Key, class Compare, class Alloc>
+void swap(multiset<Key,
+          Compare, Alloc>& lhs, multiset<Key, Compare, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
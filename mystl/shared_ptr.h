@@ -0,0 +1,816 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SHARED_PTR_H_
+#define MYSTL_SHARED_PTR_H_
+
+// shared_ptr / weak_ptr, make_shared and their single-threaded siblings
+// local_shared_ptr / local_weak_ptr. Both are basic_shared_ptr with a
+// different count policy: atomic counts, or plain counts for hot paths that
+// never share ownership across threads.
+// make_shared puts the control block and the object in one allocation.
+// A handle is two raw pointers to outside storage, so it is trivially
+// relocatable and vector moves it with memcpy.
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "functional.h"
+#include "type_traits.h"
+#include "unique_ptr.h"
+#include "util.h"
+
+namespace mystl {
+
+// class: bad_weak_ptr, thrown when a shared_ptr is made from an expired
+// weak_ptr
+class bad_weak_ptr : public std::exception {
+   public:
+    const char* what() const noexcept override { return "mystl::bad_weak_ptr"; }
+};
+
+// reference count policies
+
+struct sp_atomic_count {
+    typedef std::atomic<long> count_type;
+
+    static void increment(count_type& c) noexcept {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+    // the count after the decrement
+    static long decrement(count_type& c) noexcept {
+        return c.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+    static bool increment_if_nonzero(count_type& c) noexcept {
+        long n = c.load(std::memory_order_relaxed);
+        while (n != 0) {
+            if (c.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    static long load(const count_type& c) noexcept {
+        return c.load(std::memory_order_relaxed);
+    }
+    // for a count that only the caller can still change
+    static long load_acquire(const count_type& c) noexcept {
+        return c.load(std::memory_order_acquire);
+    }
+};
+
+struct sp_local_count {
+    typedef long count_type;
+
+    static void increment(count_type& c) noexcept { ++c; }
+    static long decrement(count_type& c) noexcept { return --c; }
+    static bool increment_if_nonzero(count_type& c) noexcept {
+        if (c == 0) {
+            return false;
+        }
+        ++c;
+        return true;
+    }
+    static long load(const count_type& c) noexcept { return c; }
+    static long load_acquire(const count_type& c) noexcept { return c; }
+};
+
+template <class T, class Policy>
+class basic_shared_ptr;
+template <class T, class Policy>
+class basic_weak_ptr;
+template <class T>
+class enable_shared_from_this;
+struct sp_access;
+// selects the private constructor that adopts a reference already taken
+struct sp_adopt_tag {};
+
+template <class T>
+using shared_ptr = basic_shared_ptr<T, sp_atomic_count>;
+template <class T>
+using weak_ptr = basic_weak_ptr<T, sp_atomic_count>;
+template <class T>
+using local_shared_ptr = basic_shared_ptr<T, sp_local_count>;
+template <class T>
+using local_weak_ptr = basic_weak_ptr<T, sp_local_count>;
+
+// control block: the strong count, and the weak count plus one while any
+// strong reference is left. dispose() ends the object, destroy() frees the
+// block itself.
+template <class Policy>
+class sp_control {
+   public:
+    sp_control() noexcept : uses_(1), weaks_(1) {}
+    sp_control(const sp_control&) = delete;
+    sp_control& operator=(const sp_control&) = delete;
+
+    void add_ref() noexcept { Policy::increment(uses_); }
+    bool add_ref_lock() noexcept { return Policy::increment_if_nonzero(uses_); }
+    // always two decrements: the counts are separate words, so checking
+    // both for 1 first would race with a weak_ptr::lock() on another thread
+    void release() noexcept {
+        if (Policy::decrement(uses_) == 0) {
+            dispose();
+            weak_release();
+        }
+    }
+
+    void weak_add_ref() noexcept { Policy::increment(weaks_); }
+    void weak_release() noexcept {
+        if (Policy::decrement(weaks_) == 0) {
+            destroy();
+        }
+    }
+
+    long use_count() const noexcept { return Policy::load(uses_); }
+
+   protected:
+    ~sp_control() {}
+
+   private:
+    virtual void dispose() noexcept = 0;
+    virtual void destroy() noexcept = 0;
+
+   private:
+    typename Policy::count_type uses_;
+    typename Policy::count_type weaks_;
+};
+
+// control block for a pointer adopted from outside: deleter D and the
+// allocator A the block itself comes from
+template <class Policy, class P, class D, class A>
+class sp_pointer_block final : public sp_control<Policy>,
+                               private alloc_storage<A> {
+    typedef typename allocator_traits<A>::template rebind_alloc<
+        sp_pointer_block>
+        block_alloc;
+    typedef allocator_traits<block_alloc> block_traits;
+
+   public:
+    // if the block can't be allocated, p is deleted before rethrowing
+    static sp_pointer_block* create(P p, D d, const A& a) {
+        try {
+            return adopt(p, d, a);
+        } catch (...) {
+            d(p);
+            throw;
+        }
+    }
+
+    // if the block can't be allocated, p stays with the caller
+    static sp_pointer_block* adopt(P p, D& d, const A& a) {
+        block_alloc ba(a);
+        sp_pointer_block* b = block_traits::allocate(ba, 1);
+        ::new (static_cast<void*>(b)) sp_pointer_block(p, mystl::move(d), a);
+        return b;
+    }
+
+   private:
+    sp_pointer_block(P p, D&& d, const A& a)
+        : alloc_storage<A>(a), p_(p), d_(mystl::move(d)) {}
+    ~sp_pointer_block() {}
+
+    void dispose() noexcept override { d_(p_); }
+    void destroy() noexcept override {
+        block_alloc ba(this->get_alloc());
+        this->~sp_pointer_block();
+        block_traits::deallocate(ba, this, 1);
+    }
+
+   private:
+    P p_;
+    D d_;
+};
+
+// control block with the object in it, for make_shared / allocate_shared
+template <class Policy, class T, class A>
+class sp_inplace_block final : public sp_control<Policy>,
+                               private alloc_storage<A> {
+    typedef typename std::remove_cv<T>::type value_type;
+    typedef typename allocator_traits<A>::template rebind_alloc<
+        sp_inplace_block>
+        block_alloc;
+    typedef allocator_traits<block_alloc> block_traits;
+    typedef typename allocator_traits<A>::template rebind_alloc<value_type>
+        value_alloc;
+    typedef allocator_traits<value_alloc> value_traits;
+
+   public:
+    template <class... Args>
+    static sp_inplace_block* create(const A& a, Args&&... args) {
+        block_alloc ba(a);
+        sp_inplace_block* b = block_traits::allocate(ba, 1);
+        try {
+            ::new (static_cast<void*>(b))
+                sp_inplace_block(a, mystl::forward<Args>(args)...);
+        } catch (...) {
+            block_traits::deallocate(ba, b, 1);
+            throw;
+        }
+        return b;
+    }
+
+    value_type* get() noexcept {
+        return reinterpret_cast<value_type*>(&storage_);
+    }
+
+   private:
+    template <class... Args>
+    explicit sp_inplace_block(const A& a, Args&&... args)
+        : alloc_storage<A>(a) {
+        value_alloc va(this->get_alloc());
+        value_traits::construct(va, get(), mystl::forward<Args>(args)...);
+    }
+    ~sp_inplace_block() {}
+
+    void dispose() noexcept override {
+        value_alloc va(this->get_alloc());
+        value_traits::destroy(va, get());
+    }
+    void destroy() noexcept override {
+        block_alloc ba(this->get_alloc());
+        this->~sp_inplace_block();
+        block_traits::deallocate(ba, this, 1);
+    }
+
+   private:
+    typename std::aligned_storage<sizeof(value_type),
+                                  alignof(value_type)>::type storage_;
+};
+
+// template class: basic_shared_ptr
+template <class T, class Policy>
+class basic_shared_ptr {
+   public:
+    typedef T element_type;
+    typedef basic_weak_ptr<T, Policy> weak_type;
+
+   private:
+    typedef sp_control<Policy> control;
+    // the allocator control blocks come from unless one is given
+    typedef mystl::allocator<char> default_alloc;
+
+    template <class Y>
+    using if_convertible = typename std::enable_if<
+        std::is_convertible<Y*, T*>::value>::type;
+
+   public:
+    constexpr basic_shared_ptr() noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+    constexpr basic_shared_ptr(std::nullptr_t) noexcept
+        : ptr_(nullptr), ctrl_(nullptr) {}
+
+    template <class Y, class = if_convertible<Y>>
+    explicit basic_shared_ptr(Y* p)
+        : ptr_(p),
+          ctrl_(sp_pointer_block<Policy, Y*, default_delete<Y>,
+                                 default_alloc>::create(p, default_delete<Y>(),
+                                                        default_alloc())) {
+        enable_shared_from(p);
+    }
+
+    template <class Y, class D, class = if_convertible<Y>>
+    basic_shared_ptr(Y* p, D d)
+        : ptr_(p),
+          ctrl_(sp_pointer_block<Policy, Y*, D, default_alloc>::create(
+              p, mystl::move(d), default_alloc())) {
+        enable_shared_from(p);
+    }
+
+    template <class Y, class D, class A, class = if_convertible<Y>>
+    basic_shared_ptr(Y* p, D d, const A& a)
+        : ptr_(p),
+          ctrl_(sp_pointer_block<Policy, Y*, D, A>::create(p, mystl::move(d),
+                                                           a)) {
+        enable_shared_from(p);
+    }
+
+    template <class D>
+    basic_shared_ptr(std::nullptr_t, D d)
+        : ptr_(nullptr),
+          ctrl_(sp_pointer_block<Policy, std::nullptr_t, D,
+                                 default_alloc>::create(nullptr,
+                                                        mystl::move(d),
+                                                        default_alloc())) {}
+
+    template <class D, class A>
+    basic_shared_ptr(std::nullptr_t, D d, const A& a)
+        : ptr_(nullptr),
+          ctrl_(sp_pointer_block<Policy, std::nullptr_t, D, A>::create(
+              nullptr, mystl::move(d), a)) {}
+
+    // aliasing: shares r's ownership, points to p
+    template <class Y>
+    basic_shared_ptr(const basic_shared_ptr<Y, Policy>& r, T* p) noexcept
+        : ptr_(p), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) {
+            ctrl_->add_ref();
+        }
+    }
+
+    basic_shared_ptr(const basic_shared_ptr& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) {
+            ctrl_->add_ref();
+        }
+    }
+
+    template <class Y, class = if_convertible<Y>>
+    basic_shared_ptr(const basic_shared_ptr<Y, Policy>& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) {
+            ctrl_->add_ref();
+        }
+    }
+
+    basic_shared_ptr(basic_shared_ptr&& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    template <class Y, class = if_convertible<Y>>
+    basic_shared_ptr(basic_shared_ptr<Y, Policy>&& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    template <class Y, class = if_convertible<Y>>
+    explicit basic_shared_ptr(const basic_weak_ptr<Y, Policy>& r)
+        : ptr_(nullptr), ctrl_(nullptr) {
+        if (r.ctrl_ == nullptr || !r.ctrl_->add_ref_lock()) {
+            throw bad_weak_ptr();
+        }
+        ptr_ = r.ptr_;
+        ctrl_ = r.ctrl_;
+    }
+
+    template <class Y, class D, class = if_convertible<Y>>
+    basic_shared_ptr(unique_ptr<Y, D>&& r) : ptr_(nullptr), ctrl_(nullptr) {
+        typedef typename std::remove_reference<D>::type deleter;
+        if (r.get() != nullptr) {
+            // r keeps p until the block exists, so a failed allocation
+            // leaves it untouched
+            Y* p = r.get();
+            deleter d = r.get_deleter();
+            ctrl_ = sp_pointer_block<Policy, Y*, deleter, default_alloc>::
+                adopt(p, d, default_alloc());
+            ptr_ = r.release();
+            enable_shared_from(p);
+        }
+    }
+
+    ~basic_shared_ptr() {
+        if (ctrl_ != nullptr) {
+            ctrl_->release();
+        }
+    }
+
+    basic_shared_ptr& operator=(const basic_shared_ptr& r) noexcept {
+        basic_shared_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    basic_shared_ptr& operator=(const basic_shared_ptr<Y, Policy>& r) noexcept {
+        basic_shared_ptr(r).swap(*this);
+        return *this;
+    }
+
+    basic_shared_ptr& operator=(basic_shared_ptr&& r) noexcept {
+        basic_shared_ptr(mystl::move(r)).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    basic_shared_ptr& operator=(basic_shared_ptr<Y, Policy>&& r) noexcept {
+        basic_shared_ptr(mystl::move(r)).swap(*this);
+        return *this;
+    }
+
+    template <class Y, class D>
+    basic_shared_ptr& operator=(unique_ptr<Y, D>&& r) {
+        basic_shared_ptr(mystl::move(r)).swap(*this);
+        return *this;
+    }
+
+   public:
+    void reset() noexcept { basic_shared_ptr().swap(*this); }
+    template <class Y>
+    void reset(Y* p) {
+        basic_shared_ptr(p).swap(*this);
+    }
+    template <class Y, class D>
+    void reset(Y* p, D d) {
+        basic_shared_ptr(p, mystl::move(d)).swap(*this);
+    }
+    template <class Y, class D, class A>
+    void reset(Y* p, D d, const A& a) {
+        basic_shared_ptr(p, mystl::move(d), a).swap(*this);
+    }
+
+    void swap(basic_shared_ptr& r) noexcept {
+        mystl::swap(ptr_, r.ptr_);
+        mystl::swap(ctrl_, r.ctrl_);
+    }
+
+    T* get() const noexcept { return ptr_; }
+    typename std::add_lvalue_reference<T>::type operator*() const noexcept {
+        return *ptr_;
+    }
+    T* operator->() const noexcept { return ptr_; }
+
+    long use_count() const noexcept {
+        return ctrl_ != nullptr ? ctrl_->use_count() : 0;
+    }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    // ownership order, for keys of ordered containers
+    template <class Y>
+    bool owner_before(const basic_shared_ptr<Y, Policy>& r) const noexcept {
+        return mystl::less<const void*>()(ctrl_, r.ctrl_);
+    }
+    template <class Y>
+    bool owner_before(const basic_weak_ptr<Y, Policy>& r) const noexcept {
+        return mystl::less<const void*>()(ctrl_, r.ctrl_);
+    }
+
+   private:
+    template <class, class>
+    friend class basic_shared_ptr;
+    template <class, class>
+    friend class basic_weak_ptr;
+    friend struct sp_access;
+
+    // takes over one reference the caller already holds
+    basic_shared_ptr(sp_adopt_tag, T* p, control* c) noexcept
+        : ptr_(p), ctrl_(c) {}
+
+    // point an enable_shared_from_this base of *p at this owner
+    template <class Y>
+    void enable_shared_from(Y* p) noexcept {
+        enable_shared_from_aux(
+            p, p, typename std::is_same<Policy, sp_atomic_count>::type());
+    }
+    template <class U, class Y>
+    void enable_shared_from_aux(const enable_shared_from_this<U>* e, Y* p,
+                                std::true_type) noexcept;
+    template <class Y>
+    void enable_shared_from_aux(const void*, Y*, std::true_type) noexcept {}
+    template <class Y>
+    void enable_shared_from_aux(const void*, Y*, std::false_type) noexcept {}
+
+   private:
+    T* ptr_;
+    control* ctrl_;
+};
+
+// template class: basic_weak_ptr
+template <class T, class Policy>
+class basic_weak_ptr {
+   public:
+    typedef T element_type;
+
+   private:
+    typedef sp_control<Policy> control;
+
+    template <class Y>
+    using if_convertible = typename std::enable_if<
+        std::is_convertible<Y*, T*>::value>::type;
+
+   public:
+    constexpr basic_weak_ptr() noexcept : ptr_(nullptr), ctrl_(nullptr) {}
+
+    basic_weak_ptr(const basic_weak_ptr& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) {
+            ctrl_->weak_add_ref();
+        }
+    }
+
+    // the pointee may be gone already, so convert through lock()
+    template <class Y, class = if_convertible<Y>>
+    basic_weak_ptr(const basic_weak_ptr<Y, Policy>& r) noexcept
+        : ptr_(r.lock().get()), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) {
+            ctrl_->weak_add_ref();
+        }
+    }
+
+    template <class Y, class = if_convertible<Y>>
+    basic_weak_ptr(const basic_shared_ptr<Y, Policy>& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        if (ctrl_ != nullptr) {
+            ctrl_->weak_add_ref();
+        }
+    }
+
+    basic_weak_ptr(basic_weak_ptr&& r) noexcept
+        : ptr_(r.ptr_), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    template <class Y, class = if_convertible<Y>>
+    basic_weak_ptr(basic_weak_ptr<Y, Policy>&& r) noexcept
+        : ptr_(r.lock().get()), ctrl_(r.ctrl_) {
+        r.ptr_ = nullptr;
+        r.ctrl_ = nullptr;
+    }
+
+    ~basic_weak_ptr() {
+        if (ctrl_ != nullptr) {
+            ctrl_->weak_release();
+        }
+    }
+
+    basic_weak_ptr& operator=(const basic_weak_ptr& r) noexcept {
+        basic_weak_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    basic_weak_ptr& operator=(const basic_weak_ptr<Y, Policy>& r) noexcept {
+        basic_weak_ptr(r).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    basic_weak_ptr& operator=(const basic_shared_ptr<Y, Policy>& r) noexcept {
+        basic_weak_ptr(r).swap(*this);
+        return *this;
+    }
+
+    basic_weak_ptr& operator=(basic_weak_ptr&& r) noexcept {
+        basic_weak_ptr(mystl::move(r)).swap(*this);
+        return *this;
+    }
+
+    template <class Y>
+    basic_weak_ptr& operator=(basic_weak_ptr<Y, Policy>&& r) noexcept {
+        basic_weak_ptr(mystl::move(r)).swap(*this);
+        return *this;
+    }
+
+   public:
+    void reset() noexcept { basic_weak_ptr().swap(*this); }
+
+    void swap(basic_weak_ptr& r) noexcept {
+        mystl::swap(ptr_, r.ptr_);
+        mystl::swap(ctrl_, r.ctrl_);
+    }
+
+    long use_count() const noexcept {
+        return ctrl_ != nullptr ? ctrl_->use_count() : 0;
+    }
+    bool expired() const noexcept { return use_count() == 0; }
+
+    basic_shared_ptr<T, Policy> lock() const noexcept {
+        if (ctrl_ != nullptr && ctrl_->add_ref_lock()) {
+            return basic_shared_ptr<T, Policy>(sp_adopt_tag(), ptr_, ctrl_);
+        }
+        return basic_shared_ptr<T, Policy>();
+    }
+
+    template <class Y>
+    bool owner_before(const basic_shared_ptr<Y, Policy>& r) const noexcept {
+        return mystl::less<const void*>()(ctrl_, r.ctrl_);
+    }
+    template <class Y>
+    bool owner_before(const basic_weak_ptr<Y, Policy>& r) const noexcept {
+        return mystl::less<const void*>()(ctrl_, r.ctrl_);
+    }
+
+   private:
+    template <class, class>
+    friend class basic_shared_ptr;
+    template <class, class>
+    friend class basic_weak_ptr;
+
+   private:
+    T* ptr_;
+    control* ctrl_;
+};
+
+// template class: enable_shared_from_this
+// a base that lets an object owned by shared_ptr hand out more owners of
+// itself; local_shared_ptr does not hook it up
+template <class T>
+class enable_shared_from_this {
+   protected:
+    constexpr enable_shared_from_this() noexcept {}
+    enable_shared_from_this(const enable_shared_from_this&) noexcept {}
+    enable_shared_from_this& operator=(const enable_shared_from_this&) noexcept {
+        return *this;
+    }
+    ~enable_shared_from_this() {}
+
+   public:
+    shared_ptr<T> shared_from_this() { return shared_ptr<T>(weak_this_); }
+    shared_ptr<const T> shared_from_this() const {
+        return shared_ptr<const T>(weak_this_);
+    }
+
+    weak_ptr<T> weak_from_this() noexcept { return weak_this_; }
+    weak_ptr<const T> weak_from_this() const noexcept { return weak_this_; }
+
+   private:
+    template <class, class>
+    friend class basic_shared_ptr;
+
+    mutable weak_ptr<T> weak_this_;
+};
+
+template <class T, class Policy>
+template <class U, class Y>
+void basic_shared_ptr<T, Policy>::enable_shared_from_aux(
+    const enable_shared_from_this<U>* e, Y* p, std::true_type) noexcept {
+    if (e != nullptr && e->weak_this_.expired()) {
+        typedef typename std::remove_cv<U>::type base;
+        e->weak_this_ = shared_ptr<base>(
+            *this, const_cast<base*>(static_cast<const U*>(p)));
+    }
+}
+
+// builds the handles make_shared and friends return
+struct sp_access {
+    template <class T, class Policy, class A, class... Args>
+    static basic_shared_ptr<T, Policy> make(const A& a, Args&&... args) {
+        typedef sp_inplace_block<Policy, T, A> block;
+        block* b = block::create(a, mystl::forward<Args>(args)...);
+        basic_shared_ptr<T, Policy> r(sp_adopt_tag(), b->get(), b);
+        r.enable_shared_from(r.get());
+        return r;
+    }
+};
+
+// make_shared / allocate_shared: one allocation for the control block and
+// the object
+
+template <class T, class A, class... Args>
+shared_ptr<T> allocate_shared(const A& a, Args&&... args) {
+    return sp_access::make<T, sp_atomic_count>(a,
+                                               mystl::forward<Args>(args)...);
+}
+
+template <class T, class... Args>
+shared_ptr<T> make_shared(Args&&... args) {
+    return sp_access::make<T, sp_atomic_count>(mystl::allocator<char>(),
+                                               mystl::forward<Args>(args)...);
+}
+
+template <class T, class A, class... Args>
+local_shared_ptr<T> allocate_local_shared(const A& a, Args&&... args) {
+    return sp_access::make<T, sp_local_count>(a,
+                                              mystl::forward<Args>(args)...);
+}
+
+template <class T, class... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    return sp_access::make<T, sp_local_count>(mystl::allocator<char>(),
+                                              mystl::forward<Args>(args)...);
+}
+
+// pointer casts
+
+template <class T, class U, class Policy>
+basic_shared_ptr<T, Policy> static_pointer_cast(
+    const basic_shared_ptr<U, Policy>& r) noexcept {
+    return basic_shared_ptr<T, Policy>(r, static_cast<T*>(r.get()));
+}
+
+template <class T, class U, class Policy>
+basic_shared_ptr<T, Policy> const_pointer_cast(
+    const basic_shared_ptr<U, Policy>& r) noexcept {
+    return basic_shared_ptr<T, Policy>(r, const_cast<T*>(r.get()));
+}
+
+template <class T, class U, class Policy>
+basic_shared_ptr<T, Policy> dynamic_pointer_cast(
+    const basic_shared_ptr<U, Policy>& r) noexcept {
+    T* p = dynamic_cast<T*>(r.get());
+    return p != nullptr ? basic_shared_ptr<T, Policy>(r, p)
+                        : basic_shared_ptr<T, Policy>();
+}
+
+// overload mystl's swap
+template <class T, class Policy>
+void swap(basic_shared_ptr<T, Policy>& lhs,
+          basic_shared_ptr<T, Policy>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <class T, class Policy>
+void swap(basic_weak_ptr<T, Policy>& lhs,
+          basic_weak_ptr<T, Policy>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// overload comparison operators
+template <class T, class U, class Policy>
+bool operator==(const basic_shared_ptr<T, Policy>& lhs,
+                const basic_shared_ptr<U, Policy>& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <class T, class U, class Policy>
+bool operator!=(const basic_shared_ptr<T, Policy>& lhs,
+                const basic_shared_ptr<U, Policy>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <class T, class U, class Policy>
+bool operator<(const basic_shared_ptr<T, Policy>& lhs,
+               const basic_shared_ptr<U, Policy>& rhs) noexcept {
+    typedef typename std::common_type<T*, U*>::type common;
+    return mystl::less<common>()(lhs.get(), rhs.get());
+}
+
+template <class T, class U, class Policy>
+bool operator>(const basic_shared_ptr<T, Policy>& lhs,
+               const basic_shared_ptr<U, Policy>& rhs) noexcept {
+    return rhs < lhs;
+}
+
+template <class T, class U, class Policy>
+bool operator<=(const basic_shared_ptr<T, Policy>& lhs,
+                const basic_shared_ptr<U, Policy>& rhs) noexcept {
+    return !(rhs < lhs);
+}
+
+template <class T, class U, class Policy>
+bool operator>=(const basic_shared_ptr<T, Policy>& lhs,
+                const basic_shared_ptr<U, Policy>& rhs) noexcept {
+    return !(lhs < rhs);
+}
+
+template <class T, class Policy>
+bool operator==(const basic_shared_ptr<T, Policy>& lhs,
+                std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <class T, class Policy>
+bool operator==(std::nullptr_t,
+                const basic_shared_ptr<T, Policy>& rhs) noexcept {
+    return !rhs;
+}
+
+template <class T, class Policy>
+bool operator!=(const basic_shared_ptr<T, Policy>& lhs,
+                std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <class T, class Policy>
+bool operator!=(std::nullptr_t,
+                const basic_shared_ptr<T, Policy>& rhs) noexcept {
+    return static_cast<bool>(rhs);
+}
+
+template <class T, class Policy>
+struct hash<basic_shared_ptr<T, Policy>> {
+    size_t operator()(const basic_shared_ptr<T, Policy>& p) const noexcept {
+        return mystl::hash<T*>()(p.get());
+    }
+};
+
+// both handles are a pointer and a control block pointer, nothing points
+// back into them
+template <class T, class Policy>
+struct is_trivially_relocatable<basic_shared_ptr<T, Policy>>
+    : std::true_type {};
+
+template <class T, class Policy>
+struct is_trivially_relocatable<basic_weak_ptr<T, Policy>> : std::true_type {};
+
+}  // namespace mystl
+#endif
@@ -0,0 +1,989 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SMALL_VECTOR_H_
+#define MYSTL_SMALL_VECTOR_H_
+
+// small_vector<T, N>: a vector that keeps up to N elements in the object
+// itself and only goes to the heap when it outgrows them. Moving or swapping
+// a heap backed small_vector swaps pointers like vector does; inline elements
+// are relocated one container into the other, bitwise when T allows it.
+// Unlike vector it is not trivially relocatable, begin() may point into the
+// object.
+
+#include <cstring>
+#include <initializer_list>
+
+#include "algo.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "util.h"
+
+namespace mystl {
+
+// template class: small_vector
+template <class T, size_t N, class Alloc = mystl::allocator<T>>
+class small_vector
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>> {
+    static_assert(N > 0, "small_vector needs room for an inline element");
+
+   public:
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>
+        data_allocator;
+    typedef mystl::allocator_traits<data_allocator> data_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename data_traits::size_type size_type;
+    typedef typename data_traits::difference_type difference_type;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static constexpr size_type inline_capacity = N;
+
+    allocator_type get_allocator() const {
+        return allocator_type(data_alloc());
+    }
+
+   private:
+    typedef mystl::alloc_storage<data_allocator> alloc_base;
+
+    iterator begin_;
+    iterator end_;
+    iterator cap_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buf_;
+
+    data_allocator& data_alloc() noexcept { return alloc_base::get_alloc(); }
+    const data_allocator& data_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
+   public:
+    // construct and deconstruct functions
+    small_vector() noexcept { reset_inline(); }
+
+    explicit small_vector(const allocator_type& alloc) noexcept
+        : alloc_base(data_allocator(alloc)) {
+        reset_inline();
+    }
+
+    explicit small_vector(size_type n,
+                          const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
+        reset_inline();
+        fill_init(n, value_type());
+    }
+
+    small_vector(size_type n, const value_type& value,
+                 const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
+        reset_inline();
+        fill_init(n, value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    small_vector(Iter first, Iter last,
+                 const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
+        MYSTL_DEBUG(!(last < first));
+        reset_inline();
+        range_init(first, last);
+    }
+
+    small_vector(const small_vector& rhs)
+        : alloc_base(data_traits::select_on_container_copy_construction(
+              rhs.data_alloc())) {
+        reset_inline();
+        range_init(rhs.begin_, rhs.end_);
+    }
+
+    small_vector(const small_vector& rhs, const allocator_type& alloc)
+        : alloc_base(data_allocator(alloc)) {
+        reset_inline();
+        range_init(rhs.begin_, rhs.end_);
+    }
+
+    small_vector(small_vector&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+        : alloc_base(mystl::move(rhs.data_alloc())) {
+        reset_inline();
+        take(rhs);
+    }
+
+    small_vector(small_vector&& rhs, const allocator_type& alloc);
+
+    small_vector(std::initializer_list<value_type> ilist,
+                 const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
+        reset_inline();
+        range_init(ilist.begin(), ilist.end());
+    }
+
+    small_vector& operator=(const small_vector& rhs);
+    small_vector& operator=(small_vector&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value &&
+        (data_traits::propagate_on_container_move_assignment::value ||
+         data_traits::is_always_equal::value));
+    small_vector& operator=(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+        return *this;
+    }
+
+    ~small_vector() {
+        mystl::destroy(begin_, end_);
+        free_heap();
+    }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return begin_; }
+
+    const_iterator begin() const noexcept { return begin_; }
+
+    iterator end() noexcept { return end_; }
+
+    const_iterator end() const noexcept { return end_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return begin_ == end_; }
+
+    size_type size() const noexcept {
+        return static_cast<size_type>(end_ - begin_);
+    }
+
+    size_type max_size() const noexcept {
+        return data_traits::max_size(data_alloc());
+    }
+
+    size_type capacity() const noexcept {
+        return static_cast<size_type>(cap_ - begin_);
+    }
+
+    // whether the elements live in the object itself
+    bool is_inline() const noexcept { return begin_ == inline_data(); }
+
+    void reserve(size_type n);
+    // goes back to the inline buffer when the elements fit in it
+    void shrink_to_fit();
+
+    // funciont about element visiting
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return *(begin_ + n);
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "small_vector<T, N>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "small_vector<T, N>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin_;
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(end_ - 1);
+    }
+
+    pointer data() noexcept { return begin_; }
+
+    const_pointer data() const noexcept { return begin_; }
+
+    // function about modifying container
+    void assign(size_type n, const value_type& value) { fill_assign(n, value); }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void assign(Iter first, Iter last) {
+        MYSTL_DEBUG(!(last < first));
+        copy_assign(first, last, iterator_category(first));
+    }
+
+    void assign(std::initializer_list<value_type> il) {
+        copy_assign(il.begin(), il.end(), mystl::forward_iterator_tag{});
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    template <class... Args>
+    void emplace_back(Args&&... args);
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+    void pop_back();
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return fill_insert(const_cast<iterator>(pos), n, value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
+        copy_insert(const_cast<iterator>(pos), first, last);
+    }
+
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    void clear() { erase(begin(), end()); }
+
+    void resize(size_type new_size) { return resize(new_size, value_type()); }
+
+    void resize(size_type new_size, const value_type& value);
+    void reverse() { mystl::reverse(begin(), end()); }
+
+    void swap(small_vector& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value &&
+        std::is_nothrow_move_assignable<T>::value);
+
+   private:
+    // helper functions
+    pointer inline_data() noexcept { return reinterpret_cast<pointer>(&buf_); }
+    const_pointer inline_data() const noexcept {
+        return reinterpret_cast<const_pointer>(&buf_);
+    }
+    void reset_inline() noexcept {
+        begin_ = end_ = inline_data();
+        cap_ = begin_ + N;
+    }
+    void free_heap() noexcept;
+    void take(small_vector& rhs);
+    void swap_inline(small_vector& rhs);
+    void fill_init(size_type n, const value_type& value);
+    template <class Iter>
+    void range_init(Iter first, Iter last);
+    size_type get_new_cap(size_type add_size);
+    pointer allocate_data(size_type& n);
+    pointer relocate_around(pointer new_begin, iterator pos, size_type n);
+    static void shift_bytes(iterator first, iterator last, iterator result);
+    void fill_assign(size_type n, const value_type& value);
+    template <class IIter>
+    void copy_assign(IIter first, IIter last, input_iterator_tag);
+    template <class FIter>
+    void copy_assign(FIter first, FIter last, forward_iterator_tag);
+    template <class... Args>
+    void reallocate_emplace(iterator pos, Args&&... args);
+    iterator fill_insert(iterator pos, size_type n, const value_type& value);
+    template <class IIter>
+    void copy_insert(iterator pos, IIter first, IIter last);
+};
+
+template <class T, size_t N, class Alloc>
+constexpr typename small_vector<T, N, Alloc>::size_type
+    small_vector<T, N, Alloc>::inline_capacity;
+
+template <class T, size_t N, class Alloc>
+small_vector<T, N, Alloc>::small_vector(small_vector&& rhs,
+                                        const allocator_type& alloc)
+    : alloc_base(data_allocator(alloc)) {
+    reset_inline();
+    if (mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+        take(rhs);
+    } else {
+        reserve(rhs.size());
+        end_ = mystl::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+        rhs.clear();
+    }
+}
+
+template <class T, size_t N, class Alloc>
+small_vector<T, N, Alloc>& small_vector<T, N, Alloc>::operator=(
+    const small_vector& rhs) {
+    if (this != &rhs) {
+        if (data_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            // memory of the old allocator can't outlive it
+            clear();
+            free_heap();
+            reset_inline();
+        }
+        mystl::alloc_on_copy(data_alloc(), rhs.data_alloc());
+        copy_assign(rhs.begin_, rhs.end_, mystl::forward_iterator_tag{});
+    }
+    return *this;
+}
+
+// a heap buffer is stolen when the allocators allow it, inline elements are
+// always relocated one by one
+template <class T, size_t N, class Alloc>
+small_vector<T, N, Alloc>& small_vector<T, N, Alloc>::operator=(
+    small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                 (data_traits::
+                                      propagate_on_container_move_assignment::
+                                          value ||
+                                  data_traits::is_always_equal::value)) {
+    if (this == &rhs) {
+        return *this;
+    }
+    clear();
+    const bool propagate =
+        data_traits::propagate_on_container_move_assignment::value;
+    if (propagate || mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+        if (propagate) {
+            // the buffer belongs to the allocator about to be replaced
+            free_heap();
+            reset_inline();
+        }
+        mystl::alloc_on_move(data_alloc(), rhs.data_alloc());
+        take(rhs);
+    } else {
+        reserve(rhs.size());
+        end_ = mystl::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+        rhs.clear();
+    }
+    return *this;
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::reserve(size_type n) {
+    if (capacity() < n) {
+        THROW_LENGTH_ERROR_IF(
+            n > max_size(),
+            "n can not larger than max_size() in small_vector<T, N>::reserve()");
+        auto tmp = allocate_data(n);
+        try {
+            end_ = relocate_around(tmp, end_, 0);
+        } catch (...) {
+            data_traits::deallocate(data_alloc(), tmp, n);
+            throw;
+        }
+        begin_ = tmp;
+        cap_ = begin_ + n;
+    }
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::shrink_to_fit() {
+    if (is_inline() || end_ == cap_) {
+        return;
+    }
+    if (size() <= N) {
+        const auto old_begin = begin_;
+        const auto old_end = end_;
+        const auto old_cap = capacity();
+        reset_inline();
+        try {
+            end_ = mystl::uninitialized_relocate(old_begin, old_end, begin_);
+        } catch (...) {
+            begin_ = old_begin;
+            end_ = old_end;
+            cap_ = old_begin + old_cap;
+            throw;
+        }
+        data_traits::deallocate(data_alloc(), old_begin, old_cap);
+    } else {
+        size_type cap = size();
+        auto new_begin = allocate_data(cap);
+        try {
+            end_ = relocate_around(new_begin, end_, 0);
+        } catch (...) {
+            data_traits::deallocate(data_alloc(), new_begin, cap);
+            throw;
+        }
+        begin_ = new_begin;
+        cap_ = begin_ + cap;
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class... Args>
+typename small_vector<T, N, Alloc>::iterator small_vector<T, N, Alloc>::emplace(
+    const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    iterator xpos = const_cast<iterator>(pos);
+    const size_type n = xpos - begin_;
+    if (end_ != cap_ && xpos == end_) {
+        data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                               mystl::forward<Args>(args)...);
+        ++end_;
+    } else if (end_ != cap_) {
+        // build the value first, args may refer to an element being moved
+        value_type value_copy(mystl::forward<Args>(args)...);
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(xpos, end_, xpos + 1);
+            try {
+                data_traits::construct(data_alloc(), xpos,
+                                       mystl::move(value_copy));
+            } catch (...) {
+                shift_bytes(xpos + 1, end_ + 1, xpos);
+                throw;
+            }
+            ++end_;
+        } else {
+            data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                                   mystl::move(*(end_ - 1)));
+            ++end_;
+            mystl::move_backward(xpos, end_ - 2, end_ - 1);
+            *xpos = mystl::move(value_copy);
+        }
+    } else {
+        reallocate_emplace(xpos, mystl::forward<Args>(args)...);
+    }
+
+    return begin() + n;
+}
+
+template <class T, size_t N, class Alloc>
+template <class... Args>
+void small_vector<T, N, Alloc>::emplace_back(Args&&... args) {
+    if (end_ < cap_) {
+        data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                               mystl::forward<Args>(args)...);
+        ++end_;
+    } else {
+        reallocate_emplace(end_, mystl::forward<Args>(args)...);
+    }
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    data_traits::destroy(data_alloc(), end_ - 1);
+    --end_;
+}
+
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator small_vector<T, N, Alloc>::erase(
+    const_iterator pos) {
+    MYSTL_DEBUG(pos >= begin() && pos < end());
+    iterator xpos = begin_ + (pos - begin());
+    if (mystl::is_trivially_relocatable<T>::value) {
+        data_traits::destroy(data_alloc(), xpos);
+        shift_bytes(xpos + 1, end_, xpos);
+    } else {
+        mystl::move(xpos + 1, end_, xpos);
+        data_traits::destroy(data_alloc(), end_ - 1);
+    }
+    --end_;
+    return xpos;
+}
+
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator small_vector<T, N, Alloc>::erase(
+    const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+    iterator r = begin_ + (first - begin());
+    if (first == last) {
+        return r;
+    }
+    if (mystl::is_trivially_relocatable<T>::value) {
+        mystl::destroy(r, r + (last - first));
+        shift_bytes(r + (last - first), end_, r);
+    } else {
+        mystl::destroy(mystl::move(r + (last - first), end_, r), end_);
+    }
+    end_ = end_ - (last - first);
+    return r;
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::resize(size_type new_size,
+                                       const value_type& value) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        insert(end(), new_size - size(), value);
+    }
+}
+
+// two heap buffers trade pointers; otherwise the inline elements move over
+// to the other object, which hands its heap buffer (if any) back
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::swap(small_vector& rhs) noexcept(
+    std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value) {
+    if (this == &rhs) {
+        return;
+    }
+    mystl::alloc_on_swap(data_alloc(), rhs.data_alloc());
+    if (!is_inline() && !rhs.is_inline()) {
+        mystl::swap(begin_, rhs.begin_);
+        mystl::swap(end_, rhs.end_);
+        mystl::swap(cap_, rhs.cap_);
+    } else if (is_inline() && rhs.is_inline()) {
+        swap_inline(rhs);
+    } else {
+        small_vector& s = is_inline() ? *this : rhs;
+        small_vector& h = is_inline() ? rhs : *this;
+        // h's inline buffer is free while it is on the heap
+        const auto inline_end =
+            mystl::uninitialized_relocate(s.begin_, s.end_, h.inline_data());
+        s.begin_ = h.begin_;
+        s.end_ = h.end_;
+        s.cap_ = h.cap_;
+        h.reset_inline();
+        h.end_ = inline_end;
+    }
+}
+
+// helper funcitons
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::free_heap() noexcept {
+    if (!is_inline()) {
+        data_traits::deallocate(data_alloc(), begin_, capacity());
+    }
+}
+
+// takes the elements of rhs into this empty inline small_vector, rhs is left
+// empty and inline; the allocators must agree on who owns rhs's buffer
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::take(small_vector& rhs) {
+    MYSTL_DEBUG(empty());
+    if (rhs.is_inline()) {
+        end_ = mystl::uninitialized_relocate(rhs.begin_, rhs.end_, begin_);
+        rhs.end_ = rhs.begin_;
+    } else {
+        free_heap();
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.reset_inline();
+    }
+}
+
+// both inline: swap the common prefix in place, then relocate the tail of
+// the longer one. Trivially relocatable elements swap as bytes.
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::swap_inline(small_vector& rhs) {
+    const size_type lhs_size = size();
+    const size_type rhs_size = rhs.size();
+    if (mystl::is_trivially_relocatable<T>::value) {
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type tmp;
+        std::memcpy(static_cast<void*>(&tmp), static_cast<const void*>(begin_),
+                    lhs_size * sizeof(T));
+        std::memcpy(static_cast<void*>(begin_),
+                    static_cast<const void*>(rhs.begin_), rhs_size * sizeof(T));
+        std::memcpy(static_cast<void*>(rhs.begin_),
+                    static_cast<const void*>(&tmp), lhs_size * sizeof(T));
+        end_ = begin_ + rhs_size;
+        rhs.end_ = rhs.begin_ + lhs_size;
+        return;
+    }
+    small_vector& longer = lhs_size < rhs_size ? rhs : *this;
+    small_vector& shorter = lhs_size < rhs_size ? *this : rhs;
+    const size_type common = shorter.size();
+    mystl::swap_ranges(shorter.begin_, shorter.end_, longer.begin_);
+    shorter.end_ = mystl::uninitialized_move(longer.begin_ + common,
+                                             longer.end_, shorter.end_);
+    mystl::destroy(longer.begin_ + common, longer.end_);
+    longer.end_ = longer.begin_ + common;
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::fill_init(size_type n, const value_type& value) {
+    reserve(n);
+    try {
+        end_ = mystl::uninitialized_fill_n(begin_, n, value);
+    } catch (...) {
+        free_heap();
+        throw;
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class Iter>
+void small_vector<T, N, Alloc>::range_init(Iter first, Iter last) {
+    reserve(static_cast<size_type>(mystl::distance(first, last)));
+    try {
+        end_ = mystl::uninitialized_copy(first, last, begin_);
+    } catch (...) {
+        free_heap();
+        throw;
+    }
+}
+
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::size_type
+small_vector<T, N, Alloc>::get_new_cap(size_type add_size) {
+    const auto old_size = capacity();
+    THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
+                          "small_vector<T, N>'s size too big");
+    if (old_size > max_size() - old_size / 2) {
+        return old_size + add_size;
+    }
+    return mystl::max(old_size + old_size / 2, old_size + add_size);
+}
+
+// allocate room for at least n elements, n is raised to the capacity the
+// allocator really handed out
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::pointer
+small_vector<T, N, Alloc>::allocate_data(size_type& n) {
+    auto r = data_traits::allocate_at_least(data_alloc(), n);
+    n = r.count;
+    return r.ptr;
+}
+
+// move every element into new_begin, leaving n raw slots at pos, and free the
+// old heap buffer; returns the new end. On an exception the old buffer is
+// left as it was.
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::pointer
+small_vector<T, N, Alloc>::relocate_around(pointer new_begin, iterator pos,
+                                           size_type n) {
+    pointer new_end;
+    if (mystl::is_trivially_relocatable<T>::value) {
+        new_end = mystl::uninitialized_relocate(begin_, pos, new_begin) + n;
+        new_end = mystl::uninitialized_relocate(pos, end_, new_end);
+    } else {
+        new_end = mystl::uninitialized_move(begin_, pos, new_begin);
+        try {
+            new_end = mystl::uninitialized_move(pos, end_, new_end + n);
+        } catch (...) {
+            mystl::destroy(new_begin, new_begin + (pos - begin_));
+            throw;
+        }
+        mystl::destroy(begin_, end_);
+    }
+    free_heap();
+    return new_end;
+}
+
+// memmove of [first, last) to result inside the buffer, only used for
+// trivially relocatable elements
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::shift_bytes(iterator first, iterator last,
+                                            iterator result) {
+    if (first != last) {
+        std::memmove(static_cast<void*>(result),
+                     static_cast<const void*>(first),
+                     static_cast<size_t>(last - first) * sizeof(T));
+    }
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::fill_assign(size_type n,
+                                            const value_type& value) {
+    if (n > capacity()) {
+        // value may be one of the elements
+        const value_type value_copy = value;
+        clear();
+        reserve(n);
+        end_ = mystl::uninitialized_fill_n(begin_, n, value_copy);
+    } else if (n > size()) {
+        mystl::fill(begin(), end(), value);
+        end_ = mystl::uninitialized_fill_n(end_, n - size(), value);
+    } else {
+        erase(mystl::fill_n(begin_, n, value), end_);
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class IIter>
+void small_vector<T, N, Alloc>::copy_assign(IIter first, IIter last,
+                                            input_iterator_tag) {
+    auto cur = begin_;
+    for (; first != last && cur != end_; ++first, ++cur) {
+        *cur = *first;
+    }
+
+    if (first == last) {
+        erase(cur, end_);
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class FIter>
+void small_vector<T, N, Alloc>::copy_assign(FIter first, FIter last,
+                                            forward_iterator_tag) {
+    const size_type len = mystl::distance(first, last);
+    if (len > capacity()) {
+        clear();
+        reserve(len);
+        end_ = mystl::uninitialized_copy(first, last, begin_);
+    } else if (size() >= len) {
+        auto new_end = mystl::copy(first, last, begin_);
+        mystl::destroy(new_end, end_);
+        end_ = new_end;
+    } else {
+        auto mid = first;
+        mystl::advance(mid, size());
+        mystl::copy(first, mid, begin_);
+        end_ = mystl::uninitialized_copy(mid, last, end_);
+    }
+}
+
+template <class T, size_t N, class Alloc>
+template <class... Args>
+void small_vector<T, N, Alloc>::reallocate_emplace(iterator pos,
+                                                   Args&&... args) {
+    auto new_size = get_new_cap(1);
+    auto new_begin = allocate_data(new_size);
+    const size_type xpos = pos - begin_;
+    try {
+        data_traits::construct(data_alloc(),
+                               mystl::address_of(*(new_begin + xpos)),
+                               mystl::forward<Args>(args)...);
+    } catch (...) {
+        data_traits::deallocate(data_alloc(), new_begin, new_size);
+        throw;
+    }
+    pointer new_end;
+    try {
+        new_end = relocate_around(new_begin, pos, 1);
+    } catch (...) {
+        data_traits::destroy(data_alloc(), new_begin + xpos);
+        data_traits::deallocate(data_alloc(), new_begin, new_size);
+        throw;
+    }
+
+    begin_ = new_begin;
+    end_ = new_end;
+    cap_ = new_begin + new_size;
+}
+
+template <class T, size_t N, class Alloc>
+typename small_vector<T, N, Alloc>::iterator
+small_vector<T, N, Alloc>::fill_insert(iterator pos, size_type n,
+                                       const value_type& value) {
+    if (n == 0) {
+        return pos;
+    }
+
+    const size_type xpos = pos - begin_;
+    const value_type value_copy = value;
+    if (static_cast<size_type>(cap_ - end_) >= n) {
+        const size_type after_elems = end_ - pos;
+        auto old_end = end_;
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(pos, end_, pos + n);
+            try {
+                mystl::uninitialized_fill_n(pos, n, value_copy);
+            } catch (...) {
+                shift_bytes(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
+            end_ = mystl::uninitialized_move(end_ - n, end_, end_);
+            mystl::move_backward(pos, old_end - n, old_end);
+            mystl::fill_n(pos, n, value_copy);
+        } else {
+            end_ =
+                mystl::uninitialized_fill_n(end_, n - after_elems, value_copy);
+            end_ = mystl::uninitialized_move(pos, old_end, end_);
+            mystl::fill_n(pos, after_elems, value_copy);
+        }
+    } else {
+        auto new_size = get_new_cap(n);
+        auto new_begin = allocate_data(new_size);
+        pointer new_end;
+        try {
+            mystl::uninitialized_fill_n(new_begin + xpos, n, value_copy);
+        } catch (...) {
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
+            throw;
+        }
+        try {
+            new_end = relocate_around(new_begin, pos, n);
+        } catch (...) {
+            mystl::destroy(new_begin + xpos, new_begin + xpos + n);
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
+            throw;
+        }
+
+        begin_ = new_begin;
+        end_ = new_end;
+        cap_ = begin_ + new_size;
+    }
+
+    return begin_ + xpos;
+}
+
+template <class T, size_t N, class Alloc>
+template <class IIter>
+void small_vector<T, N, Alloc>::copy_insert(iterator pos, IIter first,
+                                            IIter last) {
+    if (first == last) {
+        return;
+    }
+
+    const auto n = mystl::distance(first, last);
+    if ((cap_ - end_) >= n) {
+        const auto after_elems = end_ - pos;
+        auto old_end = end_;
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(pos, end_, pos + n);
+            try {
+                mystl::uninitialized_copy(first, last, pos);
+            } catch (...) {
+                shift_bytes(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
+            end_ = mystl::uninitialized_move(end_ - n, end_, end_);
+            mystl::move_backward(pos, old_end - n, old_end);
+            mystl::copy(first, last, pos);
+        } else {
+            auto mid = first;
+            mystl::advance(mid, after_elems);
+            end_ = mystl::uninitialized_copy(mid, last, end_);
+            end_ = mystl::uninitialized_move(pos, old_end, end_);
+            mystl::copy(first, mid, pos);
+        }
+    } else {
+        auto new_size = get_new_cap(n);
+        auto new_begin = allocate_data(new_size);
+        const auto xpos = pos - begin_;
+        pointer new_end;
+        try {
+            mystl::uninitialized_copy(first, last, new_begin + xpos);
+        } catch (...) {
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
+            throw;
+        }
+        try {
+            new_end = relocate_around(new_begin, pos, n);
+        } catch (...) {
+            mystl::destroy(new_begin + xpos, new_begin + xpos + n);
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
+            throw;
+        }
+
+        begin_ = new_begin;
+        end_ = new_end;
+        cap_ = begin_ + new_size;
+    }
+}
+
+template <class T, size_t N, class Alloc>
+bool operator==(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+    return lhs.size() == rhs.size() &&
+           mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<(const small_vector<T, N, Alloc>& lhs,
+               const small_vector<T, N, Alloc>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                          rhs.end());
+}
+
+template <class T, size_t N, class Alloc>
+bool operator!=(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>(const small_vector<T, N, Alloc>& lhs,
+               const small_vector<T, N, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<=(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>=(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, size_t N, class Alloc>
+void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+template <class T, size_t N>
+using small_vector = mystl::small_vector<T, N, polymorphic_allocator<T>>;
+}  // namespace pmr
+
+}  // namespace mystl
+#endif
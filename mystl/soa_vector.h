@@ -0,0 +1,928 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SOA_VECTOR_H_
+#define MYSTL_SOA_VECTOR_H_
+
+// soa_vector<Fields...>: a sequence of records (std::tuple<Fields...>) kept
+// as a struct of arrays, one contiguous column per field, so that a loop over
+// one field only pulls that field into the cache. All columns live in a
+// single block and share one capacity and growth policy. The block comes
+// from Alloc, rebound to a unit as aligned as the strictest field;
+// soa_vector<Fields...> is basic_soa_vector with mystl::allocator.
+//
+// column<I>() is a span over field I. Iterators zip the columns: *it is a
+// soa_reference, a tuple of references into the row, and value_type is the
+// std::tuple of the fields, so the random access algorithms of algo.h
+// (sort, nth_element, ...) work on whole rows. A comparator can take
+// const_reference, which binds to rows and to value_type alike.
+
+#include <cstring>
+#include <initializer_list>
+#include <tuple>
+
+#include "algo.h"
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "span.h"
+#include "util.h"
+
+namespace mystl {
+
+namespace soa_detail {
+
+template <size_t... I>
+struct index_sequence {};
+
+template <size_t N, size_t... I>
+struct make_index_sequence : make_index_sequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct make_index_sequence<0, I...> : index_sequence<I...> {};
+
+// expands a pack of expressions in order: (void)swallow{0, (expr, 0)...}
+typedef int swallow[];
+
+template <bool...>
+struct bool_pack {};
+
+template <bool... B>
+struct all_of
+    : std::is_same<bool_pack<true, B...>, bool_pack<B..., true>> {};
+
+template <class... Ts>
+struct max_align;
+
+template <>
+struct max_align<> : std::integral_constant<size_t, 1> {};
+
+template <class T, class... Ts>
+struct max_align<T, Ts...>
+    : std::integral_constant<size_t, (alignof(T) > max_align<Ts...>::value
+                                          ? alignof(T)
+                                          : max_align<Ts...>::value)> {};
+
+// the allocation unit of a block, so that the allocator hands out memory
+// aligned for every column
+template <size_t Align>
+struct alignas(Align) block_unit {
+    unsigned char bytes[Align];
+};
+
+template <class Alloc, class... Fields>
+using block_allocator = typename allocator_traits<Alloc>::template rebind_alloc<
+    block_unit<max_align<Fields...>::value>>;
+
+}  // namespace soa_detail
+
+// soa_reference: proxy for one row, a std::tuple of references to its fields
+template <class... Ts>
+class soa_reference : public std::tuple<Ts&...> {
+    typedef std::tuple<Ts&...> base;
+    typedef soa_detail::make_index_sequence<sizeof...(Ts)> indices;
+
+   public:
+    typedef std::tuple<typename std::remove_const<Ts>::type...> value_type;
+
+    explicit soa_reference(Ts&... fields) noexcept : base(fields...) {}
+    soa_reference(const soa_reference&) = default;
+    // row to const row
+    template <class... Us,
+              typename std::enable_if<
+                  soa_detail::all_of<std::is_convertible<
+                      Us&, Ts&>::value...>::value,
+                  int>::type = 0>
+    soa_reference(const soa_reference<Us...>& rhs) noexcept
+        : base(rhs) {}
+    // a const row can also refer to a value_type
+    template <class V,
+              typename std::enable_if<
+                  std::is_same<V, value_type>::value &&
+                      soa_detail::all_of<std::is_const<Ts>::value...>::value,
+                  int>::type = 0>
+    soa_reference(const V& value) noexcept : base(value) {}
+
+    // assignment writes through to the row
+    soa_reference& operator=(const soa_reference& rhs) {
+        base::operator=(static_cast<const base&>(rhs));
+        return *this;
+    }
+    template <class... Us>
+    soa_reference& operator=(const soa_reference<Us...>& rhs) {
+        base::operator=(static_cast<const std::tuple<Us&...>&>(rhs));
+        return *this;
+    }
+    soa_reference& operator=(const value_type& value) {
+        base::operator=(value);
+        return *this;
+    }
+    soa_reference& operator=(value_type&& value) {
+        base::operator=(mystl::move(value));
+        return *this;
+    }
+
+    // swaps the fields of two rows
+    void swap(const soa_reference& rhs) const { swap_aux(rhs, indices()); }
+
+   private:
+    template <size_t... I>
+    void swap_aux(const soa_reference& rhs,
+                  soa_detail::index_sequence<I...>) const {
+        using mystl::swap;
+        (void)soa_detail::swallow{
+            0, (swap(std::get<I>(*this), std::get<I>(rhs)), 0)...};
+    }
+};
+
+template <class... Ts>
+void swap(soa_reference<Ts...> lhs, soa_reference<Ts...> rhs) {
+    lhs.swap(rhs);
+}
+
+// soa_iterator: the column pointers and a row index
+template <bool IsConst, class... Fields>
+class soa_iterator
+    : public iterator<
+          random_access_iterator_tag, std::tuple<Fields...>, ptrdiff_t,
+          typename std::conditional<IsConst, soa_reference<const Fields...>,
+                                    soa_reference<Fields...>>::type*,
+          typename std::conditional<IsConst, soa_reference<const Fields...>,
+                                    soa_reference<Fields...>>::type> {
+    template <bool, class...>
+    friend class soa_iterator;
+
+   public:
+    typedef typename std::conditional<IsConst, soa_reference<const Fields...>,
+                                      soa_reference<Fields...>>::type
+        reference;
+    typedef typename std::conditional<IsConst, std::tuple<const Fields*...>,
+                                      std::tuple<Fields*...>>::type
+        columns;
+    typedef ptrdiff_t difference_type;
+    typedef soa_iterator self;
+
+   public:
+    soa_iterator() noexcept : cols_(), idx_(0) {}
+    soa_iterator(const columns& cols, difference_type idx) noexcept
+        : cols_(cols), idx_(idx) {}
+    // iterator to const_iterator
+    template <bool C, typename std::enable_if<IsConst && !C, int>::type = 0>
+    soa_iterator(const soa_iterator<C, Fields...>& rhs) noexcept
+        : cols_(rhs.cols_), idx_(rhs.idx_) {}
+
+    reference operator*() const noexcept {
+        return deref(soa_detail::make_index_sequence<sizeof...(Fields)>());
+    }
+    reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+    difference_type index() const noexcept { return idx_; }
+
+    self& operator++() noexcept {
+        ++idx_;
+        return *this;
+    }
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++idx_;
+        return tmp;
+    }
+    self& operator--() noexcept {
+        --idx_;
+        return *this;
+    }
+    self operator--(int) noexcept {
+        self tmp = *this;
+        --idx_;
+        return tmp;
+    }
+    self& operator+=(difference_type n) noexcept {
+        idx_ += n;
+        return *this;
+    }
+    self& operator-=(difference_type n) noexcept {
+        idx_ -= n;
+        return *this;
+    }
+    self operator+(difference_type n) const noexcept {
+        return self(cols_, idx_ + n);
+    }
+    self operator-(difference_type n) const noexcept {
+        return self(cols_, idx_ - n);
+    }
+    difference_type operator-(const self& rhs) const noexcept {
+        return idx_ - rhs.idx_;
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return idx_ == rhs.idx_;
+    }
+    bool operator!=(const self& rhs) const noexcept { return idx_ != rhs.idx_; }
+    bool operator<(const self& rhs) const noexcept { return idx_ < rhs.idx_; }
+    bool operator>(const self& rhs) const noexcept { return idx_ > rhs.idx_; }
+    bool operator<=(const self& rhs) const noexcept {
+        return idx_ <= rhs.idx_;
+    }
+    bool operator>=(const self& rhs) const noexcept {
+        return idx_ >= rhs.idx_;
+    }
+
+   private:
+    template <size_t... I>
+    reference deref(soa_detail::index_sequence<I...>) const noexcept {
+        return reference(std::get<I>(cols_)[idx_]...);
+    }
+
+   private:
+    columns cols_;
+    difference_type idx_;
+};
+
+template <bool IsConst, class... Fields>
+soa_iterator<IsConst, Fields...> operator+(
+    ptrdiff_t n, const soa_iterator<IsConst, Fields...>& it) noexcept {
+    return it + n;
+}
+
+// template class: basic_soa_vector
+template <class Alloc, class... Fields>
+class basic_soa_vector
+    : private mystl::alloc_storage<
+          soa_detail::block_allocator<Alloc, Fields...>> {
+    static_assert(sizeof...(Fields) != 0, "soa_vector needs a field");
+
+   public:
+    typedef Alloc allocator_type;
+    typedef std::tuple<Fields...> value_type;
+    typedef soa_reference<Fields...> reference;
+    typedef soa_reference<const Fields...> const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef soa_iterator<false, Fields...> iterator;
+    typedef soa_iterator<true, Fields...> const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    template <size_t I>
+    using column_type = typename std::tuple_element<I, value_type>::type;
+
+    static constexpr size_t column_count = sizeof...(Fields);
+
+   private:
+    typedef std::tuple<Fields*...> columns;
+    typedef soa_detail::make_index_sequence<sizeof...(Fields)> indices;
+    // alignment of the block, every column starts on its own alignment
+    static constexpr size_t block_align = soa_detail::max_align<Fields...>::value;
+
+    typedef soa_detail::block_allocator<Alloc, Fields...> block_allocator;
+    typedef mystl::allocator_traits<block_allocator> block_traits;
+    typedef soa_detail::block_unit<block_align> block_unit;
+    typedef mystl::alloc_storage<block_allocator> alloc_base;
+
+    columns cols_;
+    block_unit* block_;
+    size_type size_;
+    size_type cap_;
+
+    block_allocator& block_alloc() noexcept { return alloc_base::get_alloc(); }
+    const block_allocator& block_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
+   public:
+    // construct and deconstruct functions
+    basic_soa_vector() noexcept
+        : cols_(), block_(nullptr), size_(0), cap_(0) {}
+
+    explicit basic_soa_vector(const allocator_type& alloc) noexcept
+        : alloc_base(block_allocator(alloc)),
+          cols_(),
+          block_(nullptr),
+          size_(0),
+          cap_(0) {}
+
+    explicit basic_soa_vector(size_type n,
+                              const allocator_type& alloc = allocator_type())
+        : basic_soa_vector(alloc) {
+        resize(n);
+    }
+
+    basic_soa_vector(size_type n, const value_type& value,
+                     const allocator_type& alloc = allocator_type())
+        : basic_soa_vector(alloc) {
+        reserve(n);
+        for (; size_ < n; ++size_) {
+            construct_row(size_, value, indices());
+        }
+    }
+
+    basic_soa_vector(std::initializer_list<value_type> ilist,
+                     const allocator_type& alloc = allocator_type())
+        : basic_soa_vector(alloc) {
+        reserve(ilist.size());
+        for (auto& value : ilist) {
+            construct_row(size_, value, indices());
+            ++size_;
+        }
+    }
+
+    basic_soa_vector(const basic_soa_vector& rhs)
+        : basic_soa_vector(rhs, allocator_type(
+                                    block_traits::
+                                        select_on_container_copy_construction(
+                                            rhs.block_alloc()))) {}
+
+    basic_soa_vector(const basic_soa_vector& rhs, const allocator_type& alloc)
+        : basic_soa_vector(alloc) {
+        reserve(rhs.size_);
+        copy_columns(rhs, indices());
+        size_ = rhs.size_;
+    }
+
+    basic_soa_vector(basic_soa_vector&& rhs) noexcept
+        : alloc_base(mystl::move(rhs.block_alloc())),
+          cols_(rhs.cols_),
+          block_(rhs.block_),
+          size_(rhs.size_),
+          cap_(rhs.cap_) {
+        rhs.reset();
+    }
+
+    basic_soa_vector(basic_soa_vector&& rhs, const allocator_type& alloc)
+        : basic_soa_vector(alloc) {
+        if (mystl::alloc_equal(block_alloc(), rhs.block_alloc())) {
+            swap_data(rhs);
+        } else {
+            move_from(rhs);
+        }
+    }
+
+    basic_soa_vector& operator=(const basic_soa_vector& rhs);
+    basic_soa_vector& operator=(basic_soa_vector&& rhs) noexcept(
+        block_traits::propagate_on_container_move_assignment::value ||
+        block_traits::is_always_equal::value);
+
+    ~basic_soa_vector() {
+        clear();
+        free_block();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(block_alloc());
+    }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return iterator(cols_, 0); }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(const_columns(indices()), 0);
+    }
+
+    iterator end() noexcept { return iterator(cols_, size_); }
+
+    const_iterator end() const noexcept {
+        return const_iterator(const_columns(indices()), size_);
+    }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return size_ == 0; }
+
+    size_type size() const noexcept { return size_; }
+
+    size_type capacity() const noexcept { return cap_; }
+
+    size_type max_size() const noexcept {
+        return (static_cast<size_type>(-1) / 2 - column_count * block_align) /
+               row_bytes();
+    }
+
+    void reserve(size_type n) {
+        if (cap_ < n) {
+            THROW_LENGTH_ERROR_IF(
+                n > max_size(),
+                "n can not larger than max_size() in soa_vector::reserve()");
+            reallocate(n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (cap_ > size_) {
+            reallocate(size_);
+        }
+    }
+
+    // columns
+    template <size_t I>
+    column_type<I>* data() noexcept {
+        return std::get<I>(cols_);
+    }
+
+    template <size_t I>
+    const column_type<I>* data() const noexcept {
+        return std::get<I>(cols_);
+    }
+
+    template <size_t I>
+    span<column_type<I>> column() noexcept {
+        return span<column_type<I>>(std::get<I>(cols_), size_);
+    }
+
+    template <size_t I>
+    span<const column_type<I>> column() const noexcept {
+        return span<const column_type<I>>(std::get<I>(cols_), size_);
+    }
+
+    // rows
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size_);
+        return *(begin() + n);
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return *(begin() + n);
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size_),
+                              "soa_vector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size_),
+                              "soa_vector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size_ - 1];
+    }
+
+    // function about modifying container
+    void push_back(const value_type& value) {
+        grow_if_full();
+        construct_row(size_, value, indices());
+        ++size_;
+    }
+
+    void push_back(value_type&& value) {
+        grow_if_full();
+        construct_row(size_, mystl::move(value), indices());
+        ++size_;
+    }
+
+    // one argument per field
+    template <class... Args>
+    void emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields),
+                      "soa_vector::emplace_back takes one value per field");
+        grow_if_full();
+        construct_row(size_, std::forward_as_tuple(mystl::forward<Args>(args)...),
+                      indices());
+        ++size_;
+    }
+
+    void pop_back() {
+        MYSTL_DEBUG(!empty());
+        --size_;
+        destroy_rows(size_, size_ + 1, indices());
+    }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos >= cbegin() && pos < cend());
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last);
+
+    void clear() noexcept {
+        destroy_rows(0, size_, indices());
+        size_ = 0;
+    }
+
+    void resize(size_type new_size);
+    void resize(size_type new_size, const value_type& value);
+
+    void swap(basic_soa_vector& rhs) noexcept {
+        if (this != &rhs) {
+            mystl::alloc_on_swap(block_alloc(), rhs.block_alloc());
+            swap_data(rhs);
+        }
+    }
+
+    bool operator==(const basic_soa_vector& rhs) const {
+        return size_ == rhs.size_ && equal_columns(rhs, indices());
+    }
+
+   private:
+    // helper functions
+    void reset() noexcept {
+        cols_ = columns();
+        block_ = nullptr;
+        size_ = 0;
+        cap_ = 0;
+    }
+
+    void swap_data(basic_soa_vector& rhs) noexcept {
+        mystl::swap(cols_, rhs.cols_);
+        mystl::swap(block_, rhs.block_);
+        mystl::swap(size_, rhs.size_);
+        mystl::swap(cap_, rhs.cap_);
+    }
+
+    // units of a block for cap rows
+    static size_type block_units(size_type cap) noexcept {
+        size_type offsets[sizeof...(Fields)];
+        return (layout(cap, offsets) + block_align - 1) / block_align;
+    }
+
+    void free_block() noexcept {
+        if (block_ != nullptr) {
+            block_traits::deallocate(block_alloc(), block_, block_units(cap_));
+        }
+    }
+
+    // the rows of rhs relocated into a block of this allocator, for
+    // allocators that can't take over the block of rhs
+    void move_from(basic_soa_vector& rhs) {
+        reserve(rhs.size_);
+        rhs.relocate_columns(cols_, indices());
+        size_ = rhs.size_;
+        rhs.size_ = 0;
+    }
+
+    static size_type row_bytes() noexcept {
+        size_type n = 0;
+        (void)soa_detail::swallow{0, (n += sizeof(Fields), 0)...};
+        return n;
+    }
+
+    // the column I of a block for cap rows starts at offsets[I]; returns
+    // the size of the block
+    static size_type layout(size_type cap, size_type* offsets) noexcept {
+        const size_type sizes[] = {sizeof(Fields)...};
+        const size_type aligns[] = {alignof(Fields)...};
+        size_type off = 0;
+        for (size_t i = 0; i < column_count; ++i) {
+            off = (off + aligns[i] - 1) & ~(aligns[i] - 1);
+            offsets[i] = off;
+            off += cap * sizes[i];
+        }
+        return off;
+    }
+
+    template <size_t... I>
+    static columns carve(void* block, const size_type* offsets,
+                         soa_detail::index_sequence<I...>) noexcept {
+        return columns(reinterpret_cast<Fields*>(static_cast<char*>(block) +
+                                                 offsets[I])...);
+    }
+
+    template <size_t... I>
+    std::tuple<const Fields*...> const_columns(
+        soa_detail::index_sequence<I...>) const noexcept {
+        return std::tuple<const Fields*...>(std::get<I>(cols_)...);
+    }
+
+    void grow_if_full() {
+        if (size_ == cap_) {
+            reallocate(get_new_cap(1));
+        }
+    }
+
+    size_type get_new_cap(size_type add_size) const;
+    void reallocate(size_type new_cap);
+
+    // construct field I of row n from field I of the tuple, undoing the
+    // fields already built if one throws
+    template <class Tuple, size_t... I>
+    void construct_row(size_type n, Tuple&& t,
+                       soa_detail::index_sequence<I...>) {
+        size_t done = 0;
+        try {
+            (void)soa_detail::swallow{
+                0, (mystl::construct(std::get<I>(cols_) + n,
+                                     std::get<I>(mystl::forward<Tuple>(t))),
+                    ++done, 0)...};
+        } catch (...) {
+            (void)soa_detail::swallow{
+                0, (I < done ? mystl::destroy(std::get<I>(cols_) + n) : void(),
+                    0)...};
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void construct_default_row(size_type n, soa_detail::index_sequence<I...>) {
+        size_t done = 0;
+        try {
+            (void)soa_detail::swallow{
+                0, (mystl::construct(std::get<I>(cols_) + n), ++done, 0)...};
+        } catch (...) {
+            (void)soa_detail::swallow{
+                0, (I < done ? mystl::destroy(std::get<I>(cols_) + n) : void(),
+                    0)...};
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void destroy_rows(size_type first, size_type last,
+                      soa_detail::index_sequence<I...>) noexcept {
+        (void)soa_detail::swallow{
+            0, (mystl::destroy(std::get<I>(cols_) + first,
+                               std::get<I>(cols_) + last),
+                0)...};
+    }
+
+    template <size_t... I>
+    void copy_columns(const basic_soa_vector& rhs,
+                      soa_detail::index_sequence<I...>);
+    template <size_t... I>
+    void relocate_columns(const columns& to, soa_detail::index_sequence<I...>);
+    template <size_t... I>
+    void erase_rows(size_type first, size_type last,
+                    soa_detail::index_sequence<I...>);
+    template <size_t... I>
+    bool equal_columns(const basic_soa_vector& rhs,
+                       soa_detail::index_sequence<I...>) const {
+        bool eq = true;
+        (void)soa_detail::swallow{
+            0, (eq = eq && mystl::equal(std::get<I>(cols_),
+                                        std::get<I>(cols_) + size_,
+                                        std::get<I>(rhs.cols_)),
+                0)...};
+        return eq;
+    }
+};
+
+template <class... Fields>
+using soa_vector =
+    basic_soa_vector<mystl::allocator<std::tuple<Fields...>>, Fields...>;
+
+template <class Alloc, class... Fields>
+constexpr size_t basic_soa_vector<Alloc, Fields...>::column_count;
+
+template <class Alloc, class... Fields>
+constexpr size_t basic_soa_vector<Alloc, Fields...>::block_align;
+
+// memory of the old allocator can't outlive it
+template <class Alloc, class... Fields>
+basic_soa_vector<Alloc, Fields...>&
+basic_soa_vector<Alloc, Fields...>::operator=(const basic_soa_vector& rhs) {
+    if (this != &rhs) {
+        if (block_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(block_alloc(), rhs.block_alloc())) {
+            clear();
+            free_block();
+            reset();
+        }
+        mystl::alloc_on_copy(block_alloc(), rhs.block_alloc());
+        basic_soa_vector tmp(rhs, get_allocator());
+        swap_data(tmp);
+    }
+    return *this;
+}
+
+template <class Alloc, class... Fields>
+basic_soa_vector<Alloc, Fields...>&
+basic_soa_vector<Alloc, Fields...>::operator=(basic_soa_vector&& rhs) noexcept(
+    block_traits::propagate_on_container_move_assignment::value ||
+    block_traits::is_always_equal::value) {
+    if (this == &rhs) {
+        return *this;
+    }
+    clear();
+    if (block_traits::propagate_on_container_move_assignment::value ||
+        mystl::alloc_equal(block_alloc(), rhs.block_alloc())) {
+        free_block();
+        reset();
+        mystl::alloc_on_move(block_alloc(), rhs.block_alloc());
+        swap_data(rhs);
+    } else {
+        move_from(rhs);
+    }
+    return *this;
+}
+
+template <class Alloc, class... Fields>
+typename basic_soa_vector<Alloc, Fields...>::iterator
+basic_soa_vector<Alloc, Fields...>::erase(const_iterator first,
+                                          const_iterator last) {
+    MYSTL_DEBUG(first >= cbegin() && last <= cend() && !(last < first));
+    const size_type f = static_cast<size_type>(first.index());
+    const size_type l = static_cast<size_type>(last.index());
+    if (f != l) {
+        erase_rows(f, l, indices());
+        size_ -= l - f;
+    }
+    return begin() + f;
+}
+
+template <class Alloc, class... Fields>
+void basic_soa_vector<Alloc, Fields...>::resize(size_type new_size) {
+    if (new_size < size_) {
+        destroy_rows(new_size, size_, indices());
+        size_ = new_size;
+        return;
+    }
+    reserve(new_size);
+    for (; size_ < new_size; ++size_) {
+        construct_default_row(size_, indices());
+    }
+}
+
+template <class Alloc, class... Fields>
+void basic_soa_vector<Alloc, Fields...>::resize(size_type new_size,
+                                                const value_type& value) {
+    if (new_size < size_) {
+        destroy_rows(new_size, size_, indices());
+        size_ = new_size;
+        return;
+    }
+    reserve(new_size);
+    for (; size_ < new_size; ++size_) {
+        construct_row(size_, value, indices());
+    }
+}
+
+// the growth policy of vector, for all columns at once
+template <class Alloc, class... Fields>
+typename basic_soa_vector<Alloc, Fields...>::size_type
+basic_soa_vector<Alloc, Fields...>::get_new_cap(size_type add_size) const {
+    const auto old_size = cap_;
+    THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
+                          "soa_vector's size too big");
+    if (old_size > max_size() - old_size / 2) {
+        return old_size + add_size > max_size() - 16 ? old_size + add_size
+                                                     : old_size + add_size + 16;
+    }
+    return old_size == 0
+               ? mystl::max(add_size, static_cast<size_type>(16))
+               : mystl::max(old_size + old_size / 2, old_size + add_size);
+}
+
+// move every column into one new block of new_cap rows
+template <class Alloc, class... Fields>
+void basic_soa_vector<Alloc, Fields...>::reallocate(size_type new_cap) {
+    block_unit* new_block = nullptr;
+    columns new_cols;
+    if (new_cap != 0) {
+        size_type offsets[sizeof...(Fields)];
+        layout(new_cap, offsets);
+        new_block = block_traits::allocate(block_alloc(), block_units(new_cap));
+        new_cols = carve(new_block, offsets, indices());
+    }
+    try {
+        relocate_columns(new_cols, indices());
+    } catch (...) {
+        if (new_block != nullptr) {
+            block_traits::deallocate(block_alloc(), new_block,
+                                     block_units(new_cap));
+        }
+        throw;
+    }
+    free_block();
+    block_ = new_block;
+    cols_ = new_cols;
+    cap_ = new_cap;
+}
+
+// a column is relocated in one go; if a move constructor throws, the columns
+// already moved are lost, so the rows are dropped (basic guarantee)
+template <class Alloc, class... Fields>
+template <size_t... I>
+void basic_soa_vector<Alloc, Fields...>::relocate_columns(
+    const columns& to, soa_detail::index_sequence<I...>) {
+    size_t done = 0;
+    try {
+        (void)soa_detail::swallow{
+            0, (mystl::uninitialized_relocate(std::get<I>(cols_),
+                                              std::get<I>(cols_) + size_,
+                                              std::get<I>(to)),
+                ++done, 0)...};
+    } catch (...) {
+        (void)soa_detail::swallow{
+            0, (I < done ? mystl::destroy(std::get<I>(to),
+                                          std::get<I>(to) + size_)
+                         : mystl::destroy(std::get<I>(cols_),
+                                          std::get<I>(cols_) + size_),
+                0)...};
+        size_ = 0;
+        throw;
+    }
+}
+
+template <class Alloc, class... Fields>
+template <size_t... I>
+void basic_soa_vector<Alloc, Fields...>::copy_columns(
+    const basic_soa_vector& rhs, soa_detail::index_sequence<I...>) {
+    size_t done = 0;
+    try {
+        (void)soa_detail::swallow{
+            0, (mystl::uninitialized_copy(std::get<I>(rhs.cols_),
+                                          std::get<I>(rhs.cols_) + rhs.size_,
+                                          std::get<I>(cols_)),
+                ++done, 0)...};
+    } catch (...) {
+        (void)soa_detail::swallow{
+            0, (I < done ? mystl::destroy(std::get<I>(cols_),
+                                          std::get<I>(cols_) + rhs.size_)
+                         : void(),
+                0)...};
+        throw;
+    }
+}
+
+template <class Alloc, class... Fields>
+template <size_t... I>
+void basic_soa_vector<Alloc, Fields...>::erase_rows(
+    size_type first, size_type last, soa_detail::index_sequence<I...>) {
+    (void)soa_detail::swallow{
+        0, (mystl::move(std::get<I>(cols_) + last, std::get<I>(cols_) + size_,
+                        std::get<I>(cols_) + first),
+            mystl::destroy(std::get<I>(cols_) + (size_ - (last - first)),
+                           std::get<I>(cols_) + size_),
+            0)...};
+}
+
+template <class Alloc, class... Fields>
+bool operator!=(const basic_soa_vector<Alloc, Fields...>& lhs,
+                const basic_soa_vector<Alloc, Fields...>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Alloc, class... Fields>
+void swap(basic_soa_vector<Alloc, Fields...>& lhs,
+          basic_soa_vector<Alloc, Fields...>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// the block is only reached through the column pointers, so the vector
+// relocates as its allocator does
+template <class Alloc, class... Fields>
+struct is_trivially_relocatable<basic_soa_vector<Alloc, Fields...>>
+    : is_trivially_relocatable<soa_detail::block_allocator<Alloc, Fields...>> {
+};
+
+}  // namespace mystl
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SPAN_H_
+#define MYSTL_SPAN_H_
+
+// span<T>: a non owning view of count contiguous objects, a pointer and a
+// length. Used for the columns of soa_vector.
+
+#include <cstddef>
+
+#include "exceptdef.h"
+#include "iterator.h"
+
+namespace mystl {
+
+template <class T>
+class span {
+   public:
+    typedef T element_type;
+    typedef typename std::remove_cv<T>::type value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef T* iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+
+   public:
+    constexpr span() noexcept : data_(nullptr), size_(0) {}
+    constexpr span(pointer p, size_type n) noexcept : data_(p), size_(n) {}
+    template <size_t N>
+    constexpr span(element_type (&a)[N]) noexcept : data_(a), size_(N) {}
+    // span<T> to span<const T>
+    template <class U,
+              typename std::enable_if<
+                  std::is_convertible<U (*)[], T (*)[]>::value, int>::type = 0>
+    constexpr span(const span<U>& rhs) noexcept
+        : data_(rhs.data()), size_(rhs.size()) {}
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+    reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type size_bytes() const noexcept {
+        return size_ * sizeof(T);
+    }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size_);
+        return data_[n];
+    }
+    reference front() const {
+        MYSTL_DEBUG(size_ != 0);
+        return data_[0];
+    }
+    reference back() const {
+        MYSTL_DEBUG(size_ != 0);
+        return data_[size_ - 1];
+    }
+
+    span first(size_type n) const {
+        MYSTL_DEBUG(n <= size_);
+        return span(data_, n);
+    }
+    span last(size_type n) const {
+        MYSTL_DEBUG(n <= size_);
+        return span(data_ + (size_ - n), n);
+    }
+    span subspan(size_type offset, size_type n) const {
+        MYSTL_DEBUG(offset <= size_ && n <= size_ - offset);
+        return span(data_ + offset, n);
+    }
+
+   private:
+    pointer data_;
+    size_type size_;
+};
+
+}  // namespace mystl
+#endif
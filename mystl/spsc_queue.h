@@ -0,0 +1,260 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SPSC_QUEUE_H_
+#define MYSTL_SPSC_QUEUE_H_
+
+// spsc_queue<T>: a bounded ring queue for exactly one producer thread and one
+// consumer thread, wait-free on both sides. The indices run freely and are
+// masked into a power of two capacity. Each side owns its index on its own
+// cache line, next to a cached copy of the other side's index that it only
+// reloads when the cached value says full (or empty), so in steady state a
+// push or pop touches no cache line the other thread writes.
+// try_push_n / try_pop_n move a whole batch for one index update.
+
+#include <atomic>
+#include <cstddef>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "allocator_traits.h"
+#include "exceptdef.h"
+#include "memory.h"
+#include "util.h"
+
+namespace mystl {
+
+// template class: spsc_queue
+template <class T, class Alloc = mystl::allocator<T>>
+class spsc_queue
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>> {
+   public:
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>
+        data_allocator;
+    typedef mystl::allocator_traits<data_allocator> data_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef typename data_traits::size_type size_type;
+
+   private:
+    typedef mystl::alloc_storage<data_allocator> alloc_base;
+
+    // read only after construction, shared by both sides
+    pointer buf_;
+    size_type mask_;
+    char pad0_[cache_line_size];
+    // consumer side
+    std::atomic<size_type> head_;
+    size_type tail_cache_;
+    char pad1_[cache_line_size];
+    // producer side
+    std::atomic<size_type> tail_;
+    size_type head_cache_;
+    char pad2_[cache_line_size];
+
+    data_allocator& data_alloc() noexcept { return alloc_base::get_alloc(); }
+
+   public:
+    // room for capacity elements, rounded up to a power of two
+    explicit spsc_queue(size_type capacity,
+                        const allocator_type& alloc = allocator_type());
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue();
+
+   public:
+    size_type capacity() const noexcept { return mask_ + 1; }
+
+    // exact only while neither side is running
+    size_type size() const noexcept {
+        const size_type head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    // producer side: false and nothing changed if the queue is full
+    template <class... Args>
+    bool try_emplace(Args&&... args);
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+
+    bool try_push(value_type&& value) {
+        return try_emplace(mystl::move(value));
+    }
+
+    // push as many of the n values from first as fit, return how many
+    template <class InputIter>
+    size_type try_push_n(InputIter first, size_type n);
+
+    // consumer side: the oldest element, nullptr if the queue is empty
+    pointer front();
+
+    // remove the element front() returned
+    void pop();
+
+    // false if the queue is empty
+    bool try_pop(value_type& value) {
+        const pointer p = front();
+        if (p == nullptr) {
+            return false;
+        }
+        value = mystl::move(*p);
+        pop();
+        return true;
+    }
+
+    // move up to n of the oldest elements to out, return how many
+    template <class OutputIter>
+    size_type try_pop_n(OutputIter out, size_type n);
+
+   private:
+    // free slots seen by the producer, reloading the consumer's index only
+    // when the cached one shows fewer than n
+    size_type free_slots(size_type tail, size_type n) {
+        size_type room = capacity() - (tail - head_cache_);
+        if (room < n) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            room = capacity() - (tail - head_cache_);
+        }
+        return room;
+    }
+
+    // the same for the elements seen by the consumer
+    size_type ready_slots(size_type head, size_type n) {
+        size_type ready = tail_cache_ - head;
+        if (ready < n) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            ready = tail_cache_ - head;
+        }
+        return ready;
+    }
+};
+
+template <class T, class Alloc>
+spsc_queue<T, Alloc>::spsc_queue(size_type capacity,
+                                 const allocator_type& alloc)
+    : alloc_base(data_allocator(alloc)),
+      buf_(nullptr),
+      mask_(0),
+      head_(0),
+      tail_cache_(0),
+      tail_(0),
+      head_cache_(0) {
+    THROW_LENGTH_ERROR_IF(capacity > data_traits::max_size(data_alloc()) / 2,
+                          "spsc_queue<T>'s capacity too big");
+    size_type cap = 1;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    buf_ = data_traits::allocate(data_alloc(), cap);
+    mask_ = cap - 1;
+}
+
+template <class T, class Alloc>
+spsc_queue<T, Alloc>::~spsc_queue() {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type i = head_.load(std::memory_order_relaxed); i != tail;
+         ++i) {
+        data_traits::destroy(data_alloc(), buf_ + (i & mask_));
+    }
+    data_traits::deallocate(data_alloc(), buf_, capacity());
+}
+
+template <class T, class Alloc>
+template <class... Args>
+bool spsc_queue<T, Alloc>::try_emplace(Args&&... args) {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0) {
+        return false;
+    }
+    data_traits::construct(data_alloc(), buf_ + (tail & mask_),
+                           mystl::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// what was constructed before an exception is still published
+template <class T, class Alloc>
+template <class InputIter>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_push_n(
+    InputIter first, size_type n) {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    n = mystl::min(n, free_slots(tail, n));
+    size_type done = 0;
+    try {
+        for (; done != n; ++done, ++first) {
+            data_traits::construct(data_alloc(), buf_ + ((tail + done) & mask_),
+                                   *first);
+        }
+    } catch (...) {
+        tail_.store(tail + done, std::memory_order_release);
+        throw;
+    }
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+template <class T, class Alloc>
+typename spsc_queue<T, Alloc>::pointer spsc_queue<T, Alloc>::front() {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (ready_slots(head, 1) == 0) {
+        return nullptr;
+    }
+    return buf_ + (head & mask_);
+}
+
+template <class T, class Alloc>
+void spsc_queue<T, Alloc>::pop() {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    MYSTL_DEBUG(head != tail_cache_);
+    data_traits::destroy(data_alloc(), buf_ + (head & mask_));
+    head_.store(head + 1, std::memory_order_release);
+}
+
+// one piece up to the end of the buffer, then the rest from its start
+template <class T, class Alloc>
+template <class OutputIter>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_pop_n(
+    OutputIter out, size_type n) {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    n = mystl::min(n, ready_slots(head, n));
+    const size_type first = head & mask_;
+    const size_type k = mystl::min(n, capacity() - first);
+    out = mystl::move(buf_ + first, buf_ + first + k, out);
+    mystl::move(buf_, buf_ + (n - k), out);
+    mystl::destroy(buf_ + first, buf_ + first + k);
+    mystl::destroy(buf_, buf_ + (n - k));
+    head_.store(head + n, std::memory_order_release);
+    return n;
+}
+
+}  // namespace mystl
+#endif
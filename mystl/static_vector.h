@@ -0,0 +1,678 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_STATIC_VECTOR_H_
+#define MYSTL_STATIC_VECTOR_H_
+
+// static_vector<T, N>: a vector with a compile time capacity of N whose
+// elements always live in the object, it never allocates. It is trivially
+// copyable whenever T is, so a static_vector of such elements can be copied
+// with memcpy and sit in node payloads. Going past N is reported through the
+// OverflowPolicy instead of growing.
+
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+
+#include "algo.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "util.h"
+
+namespace mystl {
+
+// overflow policies, overflow() is called before anything is changed
+
+// throws std::length_error
+struct throw_on_overflow {
+    static void overflow(const char* what) {
+        THROW_LENGTH_ERROR_IF(true, what);
+    }
+};
+
+// ends the program, for code built without exceptions
+struct terminate_on_overflow {
+    static void overflow(const char*) noexcept { std::terminate(); }
+};
+
+// only asserted, overflowing is undefined behavior in release builds
+struct unchecked_overflow {
+    static void overflow(const char*) noexcept { MYSTL_DEBUG(false); }
+};
+
+namespace sv_detail {
+
+// element storage; the implicit copy, move and destructor are trivial here,
+// which makes static_vector trivially copyable for trivially copyable T
+template <class T, size_t N, bool = std::is_trivially_copyable<T>::value>
+class storage {
+   protected:
+    storage() noexcept : size_(0) {}
+
+    T* ptr() noexcept { return reinterpret_cast<T*>(&buf_); }
+    const T* ptr() const noexcept { return reinterpret_cast<const T*>(&buf_); }
+
+   protected:
+    size_t size_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type buf_;
+};
+
+// copies, moves and destroys the elements one by one
+template <class T, size_t N>
+class storage<T, N, false> : public storage<T, N, true> {
+    typedef storage<T, N, true> base;
+
+   protected:
+    storage() noexcept {}
+
+    storage(const storage& rhs) : base() {
+        mystl::uninitialized_copy(rhs.ptr(), rhs.ptr() + rhs.size_,
+                                  this->ptr());
+        this->size_ = rhs.size_;
+    }
+
+    // the elements of rhs are left moved from
+    storage(storage&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+        : base() {
+        mystl::uninitialized_move(rhs.ptr(), rhs.ptr() + rhs.size_,
+                                  this->ptr());
+        this->size_ = rhs.size_;
+    }
+
+    storage& operator=(const storage& rhs) {
+        if (this != &rhs) {
+            if (this->size_ >= rhs.size_) {
+                mystl::copy(rhs.ptr(), rhs.ptr() + rhs.size_, this->ptr());
+                mystl::destroy(this->ptr() + rhs.size_,
+                               this->ptr() + this->size_);
+            } else {
+                mystl::copy(rhs.ptr(), rhs.ptr() + this->size_, this->ptr());
+                mystl::uninitialized_copy(rhs.ptr() + this->size_,
+                                          rhs.ptr() + rhs.size_,
+                                          this->ptr() + this->size_);
+            }
+            this->size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    storage& operator=(storage&& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value &&
+        std::is_nothrow_move_assignable<T>::value) {
+        if (this != &rhs) {
+            if (this->size_ >= rhs.size_) {
+                mystl::move(rhs.ptr(), rhs.ptr() + rhs.size_, this->ptr());
+                mystl::destroy(this->ptr() + rhs.size_,
+                               this->ptr() + this->size_);
+            } else {
+                mystl::move(rhs.ptr(), rhs.ptr() + this->size_, this->ptr());
+                mystl::uninitialized_move(rhs.ptr() + this->size_,
+                                          rhs.ptr() + rhs.size_,
+                                          this->ptr() + this->size_);
+            }
+            this->size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    ~storage() { mystl::destroy(this->ptr(), this->ptr() + this->size_); }
+};
+
+}  // namespace sv_detail
+
+// template class: static_vector
+template <class T, size_t N, class OverflowPolicy = throw_on_overflow>
+class static_vector : private sv_detail::storage<T, N> {
+    static_assert(N > 0, "static_vector needs a capacity");
+
+    typedef sv_detail::storage<T, N> base;
+
+   public:
+    typedef OverflowPolicy overflow_policy;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+    typedef mystl::reverse_iterator<iterator> reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+   public:
+    // construct functions; copy, move and destruction come from the storage
+    static_vector() noexcept {}
+
+    explicit static_vector(size_type n) { fill_init(n, value_type()); }
+
+    static_vector(size_type n, const value_type& value) {
+        fill_init(n, value);
+    }
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    static_vector(Iter first, Iter last) {
+        MYSTL_DEBUG(!(last < first));
+        copy_assign(first, last, iterator_category(first));
+    }
+
+    static_vector(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+    }
+
+    static_vector& operator=(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+        return *this;
+    }
+
+   public:
+    // function about iterator
+    iterator begin() noexcept { return this->ptr(); }
+
+    const_iterator begin() const noexcept { return this->ptr(); }
+
+    iterator end() noexcept { return this->ptr() + this->size_; }
+
+    const_iterator end() const noexcept { return this->ptr() + this->size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // functions about capacity
+    bool empty() const noexcept { return this->size_ == 0; }
+
+    size_type size() const noexcept { return this->size_; }
+
+    static constexpr size_type max_size() noexcept { return N; }
+
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // only checks n against the capacity
+    void reserve(size_type n) {
+        if (n > N) {
+            OverflowPolicy::overflow("static_vector<T, N>::reserve() past N");
+        }
+    }
+    void shrink_to_fit() noexcept {}
+
+    // funciont about element visiting
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return *(begin() + n);
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return *(begin() + n);
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "static_vector<T, N>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "static_vector<T, N>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *begin();
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(end() - 1);
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(end() - 1);
+    }
+
+    pointer data() noexcept { return this->ptr(); }
+
+    const_pointer data() const noexcept { return this->ptr(); }
+
+    // function about modifying container
+    void assign(size_type n, const value_type& value);
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void assign(Iter first, Iter last) {
+        MYSTL_DEBUG(!(last < first));
+        copy_assign(first, last, iterator_category(first));
+    }
+
+    void assign(std::initializer_list<value_type> il) {
+        copy_assign(il.begin(), il.end(), mystl::forward_iterator_tag{});
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        check_room(1);
+        return unchecked_emplace_back(mystl::forward<Args>(args)...);
+    }
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+    // append if there is room; nullptr and nothing changed if full, whatever
+    // the overflow policy
+    template <class... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if (size() == N) {
+            return nullptr;
+        }
+        return mystl::address_of(
+            unchecked_emplace_back(mystl::forward<Args>(args)...));
+    }
+    pointer try_push_back(const value_type& value) {
+        return try_emplace_back(value);
+    }
+    pointer try_push_back(value_type&& value) {
+        return try_emplace_back(mystl::move(value));
+    }
+
+    void pop_back();
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
+        copy_insert(const_cast<iterator>(pos), first, last);
+    }
+
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    void clear() noexcept {
+        mystl::destroy(begin(), end());
+        this->size_ = 0;
+    }
+
+    void resize(size_type new_size) { return resize(new_size, value_type()); }
+
+    void resize(size_type new_size, const value_type& value);
+    void reverse() { mystl::reverse(begin(), end()); }
+
+    void swap(static_vector& rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value &&
+        std::is_nothrow_move_assignable<T>::value);
+
+   private:
+    // helper functions
+    void check_room(size_type n) const {
+        if (n > N - size()) {
+            OverflowPolicy::overflow("static_vector<T, N>'s size past N");
+        }
+    }
+    template <class... Args>
+    reference unchecked_emplace_back(Args&&... args) {
+        mystl::construct(end(), mystl::forward<Args>(args)...);
+        return *(begin() + this->size_++);
+    }
+    void fill_init(size_type n, const value_type& value);
+    template <class IIter>
+    void copy_assign(IIter first, IIter last, input_iterator_tag);
+    template <class FIter>
+    void copy_assign(FIter first, FIter last, forward_iterator_tag);
+    template <class IIter>
+    void copy_insert(iterator pos, IIter first, IIter last);
+    // open n raw slots at pos by moving the tail back
+    void open_gap(iterator pos, size_type n);
+    static void shift_bytes(iterator first, iterator last, iterator result);
+};
+
+template <class T, size_t N, class P>
+void static_vector<T, N, P>::assign(size_type n, const value_type& value) {
+    if (n > N) {
+        P::overflow("static_vector<T, N>::assign() past N");
+    }
+    if (n > size()) {
+        mystl::fill(begin(), end(), value);
+        mystl::uninitialized_fill_n(end(), n - size(), value);
+        this->size_ = n;
+    } else {
+        erase(mystl::fill_n(begin(), n, value), end());
+    }
+}
+
+template <class T, size_t N, class P>
+template <class... Args>
+typename static_vector<T, N, P>::iterator static_vector<T, N, P>::emplace(
+    const_iterator pos, Args&&... args) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    iterator xpos = const_cast<iterator>(pos);
+    check_room(1);
+    if (xpos == end()) {
+        unchecked_emplace_back(mystl::forward<Args>(args)...);
+    } else {
+        // build the value first, args may refer to an element being moved
+        value_type value_copy(mystl::forward<Args>(args)...);
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(xpos, end(), xpos + 1);
+            try {
+                mystl::construct(xpos, mystl::move(value_copy));
+            } catch (...) {
+                shift_bytes(xpos + 1, end() + 1, xpos);
+                throw;
+            }
+            ++this->size_;
+        } else {
+            unchecked_emplace_back(mystl::move(*(end() - 1)));
+            mystl::move_backward(xpos, end() - 2, end() - 1);
+            *xpos = mystl::move(value_copy);
+        }
+    }
+    return xpos;
+}
+
+template <class T, size_t N, class P>
+void static_vector<T, N, P>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    mystl::destroy(end() - 1);
+    --this->size_;
+}
+
+template <class T, size_t N, class P>
+typename static_vector<T, N, P>::iterator static_vector<T, N, P>::insert(
+    const_iterator pos, size_type n, const value_type& value) {
+    MYSTL_DEBUG(pos >= begin() && pos <= end());
+    iterator xpos = const_cast<iterator>(pos);
+    if (n == 0) {
+        return xpos;
+    }
+    check_room(n);
+    const value_type value_copy = value;
+    const size_type after_elems = end() - xpos;
+    const auto old_end = end();
+    if (mystl::is_trivially_relocatable<T>::value) {
+        shift_bytes(xpos, old_end, xpos + n);
+        try {
+            mystl::uninitialized_fill_n(xpos, n, value_copy);
+        } catch (...) {
+            shift_bytes(xpos + n, old_end + n, xpos);
+            throw;
+        }
+        this->size_ += n;
+    } else if (after_elems > n) {
+        mystl::uninitialized_move(old_end - n, old_end, old_end);
+        this->size_ += n;
+        mystl::move_backward(xpos, old_end - n, old_end);
+        mystl::fill_n(xpos, n, value_copy);
+    } else {
+        mystl::uninitialized_fill_n(old_end, n - after_elems, value_copy);
+        this->size_ += n - after_elems;
+        mystl::uninitialized_move(xpos, old_end, end());
+        this->size_ += after_elems;
+        mystl::fill_n(xpos, after_elems, value_copy);
+    }
+    return xpos;
+}
+
+template <class T, size_t N, class P>
+typename static_vector<T, N, P>::iterator static_vector<T, N, P>::erase(
+    const_iterator pos) {
+    MYSTL_DEBUG(pos >= begin() && pos < end());
+    iterator xpos = const_cast<iterator>(pos);
+    if (mystl::is_trivially_relocatable<T>::value) {
+        mystl::destroy(xpos);
+        shift_bytes(xpos + 1, end(), xpos);
+    } else {
+        mystl::move(xpos + 1, end(), xpos);
+        mystl::destroy(end() - 1);
+    }
+    --this->size_;
+    return xpos;
+}
+
+template <class T, size_t N, class P>
+typename static_vector<T, N, P>::iterator static_vector<T, N, P>::erase(
+    const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+    iterator r = const_cast<iterator>(first);
+    if (first == last) {
+        return r;
+    }
+    const size_type n = last - first;
+    if (mystl::is_trivially_relocatable<T>::value) {
+        mystl::destroy(r, r + n);
+        shift_bytes(r + n, end(), r);
+    } else {
+        mystl::destroy(mystl::move(r + n, end(), r), end());
+    }
+    this->size_ -= n;
+    return r;
+}
+
+template <class T, size_t N, class P>
+void static_vector<T, N, P>::resize(size_type new_size,
+                                    const value_type& value) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        insert(end(), new_size - size(), value);
+    }
+}
+
+// swap the common prefix in place, then move the tail of the longer one over
+template <class T, size_t N, class P>
+void static_vector<T, N, P>::swap(static_vector& rhs) noexcept(
+    std::is_nothrow_move_constructible<T>::value &&
+    std::is_nothrow_move_assignable<T>::value) {
+    if (this == &rhs) {
+        return;
+    }
+    static_vector& longer = size() < rhs.size() ? rhs : *this;
+    static_vector& shorter = size() < rhs.size() ? *this : rhs;
+    const size_type common = shorter.size();
+    mystl::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+    mystl::uninitialized_move(longer.begin() + common, longer.end(),
+                              shorter.end());
+    shorter.size_ = longer.size_;
+    mystl::destroy(longer.begin() + common, longer.end());
+    longer.size_ = common;
+}
+
+// helper funcitons
+
+template <class T, size_t N, class P>
+void static_vector<T, N, P>::fill_init(size_type n, const value_type& value) {
+    check_room(n);
+    mystl::uninitialized_fill_n(begin(), n, value);
+    this->size_ = n;
+}
+
+template <class T, size_t N, class P>
+template <class IIter>
+void static_vector<T, N, P>::copy_assign(IIter first, IIter last,
+                                         input_iterator_tag) {
+    auto cur = begin();
+    for (; first != last && cur != end(); ++first, ++cur) {
+        *cur = *first;
+    }
+
+    if (first == last) {
+        erase(cur, end());
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+template <class T, size_t N, class P>
+template <class FIter>
+void static_vector<T, N, P>::copy_assign(FIter first, FIter last,
+                                         forward_iterator_tag) {
+    const size_type len = mystl::distance(first, last);
+    if (len > N) {
+        P::overflow("static_vector<T, N>::assign() past N");
+    }
+    if (size() >= len) {
+        erase(mystl::copy(first, last, begin()), end());
+    } else {
+        auto mid = first;
+        mystl::advance(mid, size());
+        mystl::copy(first, mid, begin());
+        mystl::uninitialized_copy(mid, last, end());
+        this->size_ = len;
+    }
+}
+
+template <class T, size_t N, class P>
+template <class IIter>
+void static_vector<T, N, P>::copy_insert(iterator pos, IIter first,
+                                         IIter last) {
+    if (first == last) {
+        return;
+    }
+    const size_type n = mystl::distance(first, last);
+    check_room(n);
+    const size_type after_elems = end() - pos;
+    const auto old_end = end();
+    if (after_elems > n) {
+        mystl::uninitialized_move(old_end - n, old_end, old_end);
+        this->size_ += n;
+        mystl::move_backward(pos, old_end - n, old_end);
+        mystl::copy(first, last, pos);
+    } else {
+        auto mid = first;
+        mystl::advance(mid, after_elems);
+        mystl::uninitialized_copy(mid, last, old_end);
+        this->size_ += n - after_elems;
+        mystl::uninitialized_move(pos, old_end, end());
+        this->size_ += after_elems;
+        mystl::copy(first, mid, pos);
+    }
+}
+
+// memmove of [first, last) to result inside the buffer, only used for
+// trivially relocatable elements
+template <class T, size_t N, class P>
+void static_vector<T, N, P>::shift_bytes(iterator first, iterator last,
+                                         iterator result) {
+    if (first != last) {
+        std::memmove(static_cast<void*>(result),
+                     static_cast<const void*>(first),
+                     static_cast<size_t>(last - first) * sizeof(T));
+    }
+}
+
+template <class T, size_t N, class P>
+bool operator==(const static_vector<T, N, P>& lhs,
+                const static_vector<T, N, P>& rhs) {
+    return lhs.size() == rhs.size() &&
+           mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class P>
+bool operator<(const static_vector<T, N, P>& lhs,
+               const static_vector<T, N, P>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                          rhs.end());
+}
+
+template <class T, size_t N, class P>
+bool operator!=(const static_vector<T, N, P>& lhs,
+                const static_vector<T, N, P>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N, class P>
+bool operator>(const static_vector<T, N, P>& lhs,
+               const static_vector<T, N, P>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N, class P>
+bool operator<=(const static_vector<T, N, P>& lhs,
+                const static_vector<T, N, P>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N, class P>
+bool operator>=(const static_vector<T, N, P>& lhs,
+                const static_vector<T, N, P>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, size_t N, class P>
+void swap(static_vector<T, N, P>& lhs, static_vector<T, N, P>& rhs) {
+    lhs.swap(rhs);
+}
+
+// no pointers into itself, relocatable bitwise whenever its elements are
+template <class T, size_t N, class P>
+struct is_trivially_relocatable<static_vector<T, N, P>>
+    : is_trivially_relocatable<T> {};
+
+// the name the standard uses
+template <class T, size_t N>
+using inplace_vector = static_vector<T, N>;
+
+}  // namespace mystl
+#endif
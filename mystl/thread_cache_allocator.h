@@ -0,0 +1,643 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_THREAD_CACHE_ALLOCATOR_H_
+#define MYSTL_THREAD_CACHE_ALLOCATOR_H_
+
+// thread-caching allocator for small objects.
+// Every thread keeps two magazines (arrays of free objects) per size class
+// and serves allocate / deallocate from them without any lock. Only when
+// both magazines of a class run empty (or full) does the thread go to the
+// central depot of that class, trading a whole magazine under a spin lock.
+// An object freed on another thread simply lands in that thread's magazine
+// and flows back through the depot, so cross-thread frees need no extra
+// work. A magazine left untouched for a whole trim interval is handed back
+// to the depot, and thread exit flushes everything; each time, and on
+// trim(), the chunks whose objects are all back in the depot are returned
+// to the system.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "pool_allocator.h"
+#include "util.h"
+
+namespace mystl {
+
+// objects larger than this go straight to ::operator new
+constexpr size_t tc_max_bytes = 256;
+// size class granularity, also the alignment every object gets
+constexpr size_t tc_align = 16;
+constexpr size_t tc_class_num = tc_max_bytes / tc_align;
+// objects per magazine
+constexpr size_t tc_magazine_size = 64;
+// a class with this many operations since the last check gets trimmed
+constexpr size_t tc_trim_interval = 4096;
+// chunks are aligned to their size, a power of two
+constexpr size_t tc_chunk_bytes = 64 * 1024;
+
+constexpr size_t tc_class_index(size_t bytes) {
+    return (bytes + tc_align - 1) / tc_align - 1;
+}
+
+struct tc_magazine {
+    tc_magazine* next;
+    size_t count;
+    void* rounds[tc_magazine_size];
+};
+
+// template class: tc_depot
+// the central store, one per size class; Dummy only lets the statics live in
+// a header. Chunks are aligned to their size, so an object finds its chunk
+// by masking its address, and every chunk counts how many of its carved
+// objects sit in the depot. A chunk whose objects are all back is given to
+// the system by release(), whatever the threads still cache elsewhere.
+template <class Dummy = void>
+class tc_depot {
+   private:
+    struct chunk {
+        chunk* prev;
+        chunk* next;
+        size_t carved;    // objects carved so far
+        size_t in_depot;  // of those, objects sitting in full magazines
+    };
+
+    struct depot {
+        tc_magazine* full = nullptr;   // magazines holding objects, maybe not all 64
+        tc_magazine* empty = nullptr;  // spare magazines with no object
+        chunk* chunks = nullptr;
+        chunk* current = nullptr;      // the chunk being carved
+        char* cur = nullptr;           // carving position in current
+        char* end = nullptr;
+        size_t free_chunks = 0;        // chunks with in_depot == carved
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+    };
+
+    static constexpr size_t header_bytes =
+        pool_round_up(sizeof(chunk), tc_align);
+
+   public:
+    // a magazine with at least one object, refilled from chunks if needed
+    static tc_magazine* get_full(size_t index);
+    // an empty magazine for a thread whose loaded magazines are both full
+    static tc_magazine* get_empty(size_t index);
+    // hand a magazine back, empty ones are kept as spares
+    static void put(size_t index, tc_magazine* m);
+
+    // give back every chunk of a class whose objects are all in the depot
+    static void release(size_t index);
+
+    static size_t chunk_count(size_t index);
+
+   private:
+    static tc_magazine* new_magazine();
+    static void carve(depot& d, size_t index, tc_magazine* m);
+
+    static chunk* chunk_of(void* p) {
+        return reinterpret_cast<chunk*>(reinterpret_cast<uintptr_t>(p) &
+                                        ~(tc_chunk_bytes - 1));
+    }
+    static bool is_free(const chunk* c) { return c->in_depot == c->carved; }
+
+    // p enters / leaves the depot, called with the lock held
+    static void add_to_depot(depot& d, void* p) {
+        chunk* c = chunk_of(p);
+        if (++c->in_depot == c->carved) {
+            ++d.free_chunks;
+        }
+    }
+    static void take_from_depot(depot& d, void* p) {
+        chunk* c = chunk_of(p);
+        if (c->in_depot-- == c->carved) {
+            --d.free_chunks;
+        }
+    }
+
+   private:
+    static depot depots_[tc_class_num];
+};
+
+template <class Dummy>
+typename tc_depot<Dummy>::depot tc_depot<Dummy>::depots_[tc_class_num];
+
+template <class Dummy>
+tc_magazine* tc_depot<Dummy>::new_magazine() {
+    tc_magazine* m =
+        static_cast<tc_magazine*>(::operator new(sizeof(tc_magazine)));
+    m->next = nullptr;
+    m->count = 0;
+    return m;
+}
+
+template <class Dummy>
+tc_magazine* tc_depot<Dummy>::get_full(size_t index) {
+    depot& d = depots_[index];
+    tc_magazine* m = nullptr;
+    {
+        pool_spin_lock lock(d.lock);
+        if (d.full) {
+            m = d.full;
+            d.full = m->next;
+            for (size_t i = 0; i < m->count; ++i) {
+                take_from_depot(d, m->rounds[i]);
+            }
+            return m;
+        }
+        m = d.empty;
+        if (m) {
+            d.empty = m->next;
+        }
+    }
+    if (m == nullptr) {
+        m = new_magazine();
+    }
+    pool_spin_lock lock(d.lock);
+    carve(d, index, m);
+    return m;
+}
+
+template <class Dummy>
+tc_magazine* tc_depot<Dummy>::get_empty(size_t index) {
+    depot& d = depots_[index];
+    {
+        pool_spin_lock lock(d.lock);
+        tc_magazine* m = d.empty;
+        if (m) {
+            d.empty = m->next;
+            return m;
+        }
+    }
+    return new_magazine();
+}
+
+template <class Dummy>
+void tc_depot<Dummy>::put(size_t index, tc_magazine* m) {
+    depot& d = depots_[index];
+    pool_spin_lock lock(d.lock);
+    if (m->count == 0) {
+        m->next = d.empty;
+        d.empty = m;
+    } else {
+        m->next = d.full;
+        d.full = m;
+        for (size_t i = 0; i < m->count; ++i) {
+            add_to_depot(d, m->rounds[i]);
+        }
+    }
+}
+
+// called with the lock held, fills m up to tc_magazine_size objects
+template <class Dummy>
+void tc_depot<Dummy>::carve(depot& d, size_t index, tc_magazine* m) {
+    const size_t size = (index + 1) * tc_align;
+    while (m->count < tc_magazine_size) {
+        if (d.cur == nullptr || d.cur + size > d.end) {
+            chunk* c = static_cast<chunk*>(
+                mystl::aligned_allocate(tc_chunk_bytes, tc_chunk_bytes));
+            c->prev = nullptr;
+            c->next = d.chunks;
+            c->carved = 0;
+            c->in_depot = 0;
+            if (d.chunks) {
+                d.chunks->prev = c;
+            }
+            d.chunks = c;
+            d.current = c;
+            ++d.free_chunks;
+            d.cur = reinterpret_cast<char*>(c) + header_bytes;
+            d.end = reinterpret_cast<char*>(c) + tc_chunk_bytes;
+        }
+        chunk* c = d.current;
+        if (is_free(c)) {
+            --d.free_chunks;
+        }
+        ++c->carved;
+        m->rounds[m->count++] = d.cur;
+        d.cur += size;
+    }
+}
+
+template <class Dummy>
+void tc_depot<Dummy>::release(size_t index) {
+    depot& d = depots_[index];
+    chunk* dead = nullptr;
+    tc_magazine* mags = nullptr;
+    {
+        pool_spin_lock lock(d.lock);
+        if (d.free_chunks == 0) {
+            return;
+        }
+        // drop the objects of free chunks from the full magazines
+        tc_magazine** link = &d.full;
+        while (*link) {
+            tc_magazine* m = *link;
+            size_t kept = 0;
+            for (size_t i = 0; i < m->count; ++i) {
+                if (!is_free(chunk_of(m->rounds[i]))) {
+                    m->rounds[kept++] = m->rounds[i];
+                }
+            }
+            m->count = kept;
+            if (kept == 0) {
+                *link = m->next;
+                m->next = d.empty;
+                d.empty = m;
+            } else {
+                link = &m->next;
+            }
+        }
+        // unlink the free chunks
+        chunk* c = d.chunks;
+        while (c) {
+            chunk* next = c->next;
+            if (is_free(c)) {
+                if (c->prev) {
+                    c->prev->next = c->next;
+                } else {
+                    d.chunks = c->next;
+                }
+                if (c->next) {
+                    c->next->prev = c->prev;
+                }
+                if (c == d.current) {
+                    d.current = nullptr;
+                    d.cur = d.end = nullptr;
+                }
+                c->next = dead;
+                dead = c;
+            }
+            c = next;
+        }
+        d.free_chunks = 0;
+        // spare magazines are tiny, free them once the class is empty
+        if (d.chunks == nullptr) {
+            mags = d.empty;
+            d.empty = nullptr;
+        }
+    }
+    while (dead) {
+        chunk* next = dead->next;
+        mystl::aligned_deallocate(dead, tc_chunk_bytes);
+        dead = next;
+    }
+    while (mags) {
+        tc_magazine* next = mags->next;
+        ::operator delete(mags);
+        mags = next;
+    }
+}
+
+template <class Dummy>
+size_t tc_depot<Dummy>::chunk_count(size_t index) {
+    depot& d = depots_[index];
+    pool_spin_lock lock(d.lock);
+    size_t n = 0;
+    for (chunk* c = d.chunks; c; c = c->next) {
+        ++n;
+    }
+    return n;
+}
+
+// class: tc_thread_cache
+// the per-thread part, reached through a thread_local instance
+class tc_thread_cache {
+   private:
+    struct cache {
+        tc_magazine* loaded;
+        tc_magazine* previous;
+        size_t ops;           // operations since the last trim check
+        bool previous_used;   // previous was swapped in since that check
+    };
+
+   public:
+    tc_thread_cache() noexcept {
+        for (size_t i = 0; i < tc_class_num; ++i) {
+            caches_[i] = cache{nullptr, nullptr, 0, false};
+        }
+    }
+    ~tc_thread_cache() {
+        flush();
+        gone() = true;
+    }
+
+    tc_thread_cache(const tc_thread_cache&) = delete;
+    tc_thread_cache& operator=(const tc_thread_cache&) = delete;
+
+    // the cache of the calling thread, nullptr once it has been destroyed
+    // (objects freed by later thread_local or static destructors)
+    static tc_thread_cache* local() {
+        if (gone()) {
+            return nullptr;
+        }
+        static thread_local tc_thread_cache instance;
+        return &instance;
+    }
+
+    // without a cache, single objects are traded through the depot directly
+    static void* allocate_uncached(size_t index) {
+        tc_magazine* m = tc_depot<>::get_full(index);
+        void* p = m->rounds[--m->count];
+        tc_depot<>::put(index, m);
+        return p;
+    }
+
+    static void deallocate_uncached(size_t index, void* p) {
+        tc_magazine* m = tc_depot<>::get_empty(index);
+        m->rounds[m->count++] = p;
+        tc_depot<>::put(index, m);
+    }
+
+    void* allocate(size_t index) {
+        cache& c = caches_[index];
+        if (c.loaded == nullptr || c.loaded->count == 0) {
+            refill(c, index);
+        }
+        tick(c, index);
+        return c.loaded->rounds[--c.loaded->count];
+    }
+
+    void deallocate(size_t index, void* p) {
+        cache& c = caches_[index];
+        if (c.loaded == nullptr || c.loaded->count == tc_magazine_size) {
+            drain(c, index);
+        }
+        tick(c, index);
+        c.loaded->rounds[c.loaded->count++] = p;
+    }
+
+    // give every magazine of this thread back to the depot, and the chunks
+    // that became free with them back to the system
+    void flush() {
+        for (size_t i = 0; i < tc_class_num; ++i) {
+            cache& c = caches_[i];
+            if (c.loaded == nullptr && c.previous == nullptr) {
+                continue;
+            }
+            if (c.loaded) {
+                tc_depot<>::put(i, c.loaded);
+            }
+            if (c.previous) {
+                tc_depot<>::put(i, c.previous);
+            }
+            c = cache{nullptr, nullptr, 0, false};
+            tc_depot<>::release(i);
+        }
+    }
+
+   private:
+    // trivially destructible, so still readable after the cache is gone
+    static bool& gone() {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    // loaded is empty: swap in previous if it has objects, otherwise trade
+    // loaded for a full one from the depot
+    void refill(cache& c, size_t index) {
+        if (c.previous && c.previous->count > 0) {
+            mystl::swap(c.loaded, c.previous);
+            c.previous_used = true;
+            return;
+        }
+        if (c.loaded) {
+            if (c.previous == nullptr) {
+                c.previous = c.loaded;
+            } else {
+                tc_depot<>::put(index, c.loaded);
+            }
+        }
+        c.loaded = tc_depot<>::get_full(index);
+    }
+
+    // loaded is full: swap in previous if it has room, otherwise push loaded
+    // to the depot and start on an empty one
+    void drain(cache& c, size_t index) {
+        if (c.previous && c.previous->count < tc_magazine_size) {
+            mystl::swap(c.loaded, c.previous);
+            c.previous_used = true;
+            return;
+        }
+        if (c.loaded) {
+            if (c.previous == nullptr) {
+                c.previous = c.loaded;
+            } else {
+                tc_depot<>::put(index, c.previous);
+                c.previous = c.loaded;
+            }
+        }
+        c.loaded = tc_depot<>::get_empty(index);
+    }
+
+    // a previous magazine that sat idle for a whole interval goes back to
+    // the depot, where other threads can use its objects; chunks that are
+    // then wholly in the depot go back to the system
+    void tick(cache& c, size_t index) {
+        if (++c.ops < tc_trim_interval) {
+            return;
+        }
+        if (!c.previous_used && c.previous) {
+            tc_depot<>::put(index, c.previous);
+            c.previous = nullptr;
+            tc_depot<>::release(index);
+        }
+        c.ops = 0;
+        c.previous_used = false;
+    }
+
+   private:
+    cache caches_[tc_class_num];
+};
+
+// template class: thread_cache_allocator
+// same static interface as allocator, single small objects come from
+// the calling thread's cache
+template <class T>
+class thread_cache_allocator {
+   public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind {
+        typedef thread_cache_allocator<U> other;
+    };
+
+   public:
+    thread_cache_allocator() noexcept {}
+    template <class U>
+    thread_cache_allocator(const thread_cache_allocator<U>&) noexcept {}
+
+   private:
+    static constexpr bool use_cache =
+        sizeof(T) <= tc_max_bytes && alignof(T) <= tc_align;
+    static constexpr size_t index = tc_class_index(sizeof(T));
+
+   public:
+    static T* allocate();
+    static T* allocate(size_type n);
+    static allocation_result<T*> allocate_at_least(size_type n);
+    static void deallocate(T* ptr);
+    static void deallocate(T* ptr, size_type n);
+    static void construct(T* ptr);
+    static void construct(T* ptr, const T& value);
+    static void construct(T* ptr, T&& value);
+    template <class... Args>
+    static void construct(T* ptr, Args&&... args);
+    static void destroy(T* ptr);
+    static void destroy(T* first, T* last);
+
+    // flush the calling thread's magazines and give back every chunk of T's
+    // size class whose objects are all in the depot; objects other threads
+    // hold or cache only keep their own chunks alive
+    static void trim();
+};
+
+template <class T>
+T* thread_cache_allocator<T>::allocate() {
+    if (use_cache) {
+        tc_thread_cache* cache = tc_thread_cache::local();
+        return static_cast<T*>(
+            cache ? cache->allocate(index)
+                  : tc_thread_cache::allocate_uncached(index));
+    }
+    return mystl::heap_allocate<T>(1);
+}
+
+template <class T>
+T* thread_cache_allocator<T>::allocate(size_type n) {
+    if (n == 0) {
+        return nullptr;
+    }
+    if (n == 1) {
+        return allocate();
+    }
+    return mystl::heap_allocate<T>(n);
+}
+
+// arrays are rounded up to the heap chunk, a single object is never rounded
+// up into an array
+template <class T>
+allocation_result<T*> thread_cache_allocator<T>::allocate_at_least(
+    size_type n) {
+    if (n <= 1) {
+        return {allocate(n), n};
+    }
+    return mystl::heap_allocate_at_least<T>(n);
+}
+
+template <class T>
+void thread_cache_allocator<T>::deallocate(T* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (use_cache) {
+        tc_thread_cache* cache = tc_thread_cache::local();
+        if (cache) {
+            cache->deallocate(index, ptr);
+        } else {
+            tc_thread_cache::deallocate_uncached(index, ptr);
+        }
+    } else {
+        mystl::heap_deallocate(ptr);
+    }
+}
+
+template <class T>
+void thread_cache_allocator<T>::deallocate(T* ptr, size_type n) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (n == 1) {
+        deallocate(ptr);
+    } else {
+        mystl::heap_deallocate(ptr);
+    }
+}
+
+template <class T>
+void thread_cache_allocator<T>::construct(T* ptr) {
+    mystl::construct(ptr);
+}
+
+template <class T>
+void thread_cache_allocator<T>::construct(T* ptr, const T& value) {
+    mystl::construct(ptr, value);
+}
+
+template <class T>
+void thread_cache_allocator<T>::construct(T* ptr, T&& value) {
+    mystl::construct(ptr, mystl::move(value));
+}
+
+template <class T>
+template <class... Args>
+void thread_cache_allocator<T>::construct(T* ptr, Args&&... args) {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
+}
+
+template <class T>
+void thread_cache_allocator<T>::destroy(T* ptr) {
+    mystl::destroy(ptr);
+}
+
+template <class T>
+void thread_cache_allocator<T>::destroy(T* first, T* last) {
+    mystl::destroy(first, last);
+}
+
+template <class T>
+void thread_cache_allocator<T>::trim() {
+    if (use_cache) {
+        tc_thread_cache* cache = tc_thread_cache::local();
+        if (cache) {
+            cache->flush();
+        }
+        tc_depot<>::release(index);
+    }
+}
+
+template <class T, class U>
+bool operator==(const thread_cache_allocator<T>&,
+                const thread_cache_allocator<U>&) noexcept {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const thread_cache_allocator<T>&,
+                const thread_cache_allocator<U>&) noexcept {
+    return false;
+}
+
+}  // namespace mystl
+#endif
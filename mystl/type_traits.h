@@ -48,5 +48,19 @@ struct is_pair : mystl::m_false_type {};
 template <class T1, class T2>
 struct is_pair<mystl::pair<T1, T2>> : mystl::m_true_type {};
 
+// is_trivially_relocatable: moving a T to new storage and ending the life of
+// the old one is the same as copying its bytes. True for trivially copyable
+// types; classes that never point into themselves (containers, smart
+// pointers) opt in with a specialization next to their definition.
+template <class T>
+struct is_trivially_relocatable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+template <class T1, class T2>
+struct is_trivially_relocatable<mystl::pair<T1, T2>>
+    : std::integral_constant<bool,
+                             is_trivially_relocatable<T1>::value &&
+                                 is_trivially_relocatable<T2>::value> {};
+
 }  // namespace mystl
 #endif
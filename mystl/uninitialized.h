@@ -25,6 +25,8 @@
  
 #ifndef MYSTL_UNINITIALIZED_H_
 #define MYSTL_UNINITIALIZED_H_
+#include <cstring>
+
 #include "algobase.h"
 #include "construct.h"
 #include "iterator.h"
@@ -45,13 +47,12 @@ ForwardIter unchecked_uninit_copy(InputIter first, InputIter last,
     auto cur = result;
     try {
         for (; first != last; ++first, ++cur) {
-            mystl::construct(&*cur, first);
+            mystl::construct(&*cur, *first);
         }
 
     } catch (...) {
-        for (; result != cur; --cur) {
-            mystl::destroy(&*cur);
-        }
+        mystl::destroy(result, cur);
+        throw;
     }
 
     return cur;
@@ -79,13 +80,12 @@ ForwardIter unchecked_uninit_copy_n(InputIter first, Size n, ForwardIter result,
     auto cur = result;
     try {
         for (; n > 0; --n, ++cur, ++first) {
-            mystl::construct(&*cur, first);
+            mystl::construct(&*cur, *first);
         }
 
     } catch (...) {
-        for (; result != cur; --cur) {
-            mystl::destroy(&*cur);
-        }
+        mystl::destroy(result, cur);
+        throw;
     }
 
     return cur;
@@ -96,7 +96,7 @@ ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
     return mystl::unchecked_uninit_copy_n(
         first, n, result,
         std::is_trivially_copy_assignable<
-            typename iterator_traits<InputIter>::value_type>{});
+            typename iterator_traits<ForwardIter>::value_type>{});
 }
 
 // uninitialize_fill
@@ -116,9 +116,8 @@ void unchecked_uninit_fill(ForwardIter first, ForwardIter last, const T& value,
         }
 
     } catch (...) {
-        for (; first != cur; ++first) {
-            mystl::destroy(&*first);
-        }
+        mystl::destroy(first, cur);
+        throw;
     }
 }
 
@@ -147,9 +146,8 @@ ForwardIter unchecked_uninit_fill_n(ForwardIter first, Size n, const T& value,
         }
 
     } catch (...) {
-        for (; first != cur; ++first) {
-            mystl::destroy(&*first);
-        }
+        mystl::destroy(first, cur);
+        throw;
     }
 
     return cur;
@@ -181,6 +179,7 @@ ForwardIter unchecked_uninit_move(InputIter first, InputIter last,
 
     } catch (...) {
         mystl::destroy(result, cur);
+        throw;
     }
 
     return cur;
@@ -227,7 +226,34 @@ ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
     return mystl::unchecked_uninit_move_n(
         first, n, result,
         std::is_trivially_move_assignable<
-            typename iterator_traits<InputIter>::value_type>{});
+            typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+// uninitialized_relocate
+// moves [first, last) into raw storage at result and ends the life of the
+// source objects; a single memmove for trivially relocatable types, which
+// also makes overlapping ranges fine in that case
+template <class T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::true_type) {
+    const size_t n = static_cast<size_t>(last - first);
+    if (n != 0) {
+        std::memmove(static_cast<void*>(result),
+                     static_cast<const void*>(first), n * sizeof(T));
+    }
+    return result + n;
+}
+
+template <class T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::false_type) {
+    T* cur = mystl::uninitialized_move(first, last, result);
+    mystl::destroy(first, last);
+    return cur;
+}
+
+template <class T>
+T* uninitialized_relocate(T* first, T* last, T* result) {
+    return mystl::unchecked_uninit_relocate(
+        first, last, result, typename is_trivially_relocatable<T>::type());
 }
 
 }  // namespace mystl
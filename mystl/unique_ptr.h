@@ -0,0 +1,395 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_UNIQUE_PTR_H_
+#define MYSTL_UNIQUE_PTR_H_
+
+// unique_ptr and make_unique. An empty deleter (default_delete, stateless
+// lambdas-in-a-struct, ...) is kept as an empty base, so unique_ptr<T> is
+// exactly one pointer; it is trivially relocatable whenever its deleter is.
+
+#include <cstddef>
+#include <type_traits>
+
+#include "functional.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace mystl {
+
+// template class: default_delete
+template <class T>
+struct default_delete {
+    constexpr default_delete() noexcept = default;
+    template <class U, class = typename std::enable_if<
+                           std::is_convertible<U*, T*>::value>::type>
+    default_delete(const default_delete<U>&) noexcept {}
+
+    void operator()(T* ptr) const {
+        static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+        delete ptr;
+    }
+};
+
+template <class T>
+struct default_delete<T[]> {
+    constexpr default_delete() noexcept = default;
+
+    void operator()(T* ptr) const {
+        static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+        delete[] ptr;
+    }
+};
+
+namespace up_detail {
+
+// D::pointer if the deleter names one, T* otherwise
+template <class T, class D, class = void>
+struct pointer_of {
+    typedef T* type;
+};
+
+template <class T, class D>
+struct pointer_of<
+    T, D,
+    typename std::conditional<
+        true, void,
+        typename std::remove_reference<D>::type::pointer>::type> {
+    typedef typename std::remove_reference<D>::type::pointer type;
+};
+
+// keeps the pointer and the deleter, the deleter as an empty base if it can
+template <class Pointer, class D,
+          bool = std::is_empty<D>::value && !__is_final(D)>
+class ptr_storage : private D {
+   public:
+    ptr_storage() : D(), ptr_() {}
+    template <class E>
+    ptr_storage(Pointer p, E&& d) : D(mystl::forward<E>(d)), ptr_(p) {}
+
+    Pointer& ptr() noexcept { return ptr_; }
+    const Pointer& ptr() const noexcept { return ptr_; }
+    D& deleter() noexcept { return *this; }
+    const D& deleter() const noexcept { return *this; }
+
+   private:
+    Pointer ptr_;
+};
+
+template <class Pointer, class D>
+class ptr_storage<Pointer, D, false> {
+   public:
+    ptr_storage() : ptr_(), d_() {}
+    template <class E>
+    ptr_storage(Pointer p, E&& d) : ptr_(p), d_(mystl::forward<E>(d)) {}
+
+    Pointer& ptr() noexcept { return ptr_; }
+    const Pointer& ptr() const noexcept { return ptr_; }
+    D& deleter() noexcept { return d_; }
+    const D& deleter() const noexcept { return d_; }
+
+   private:
+    Pointer ptr_;
+    D d_;
+};
+
+}  // namespace up_detail
+
+// template class: unique_ptr
+template <class T, class D = default_delete<T>>
+class unique_ptr {
+   public:
+    typedef typename up_detail::pointer_of<T, D>::type pointer;
+    typedef T element_type;
+    typedef D deleter_type;
+
+   private:
+    // the deleter parameter types of the (pointer, deleter) constructors
+    typedef typename std::conditional<
+        std::is_reference<D>::value, D,
+        const typename std::remove_reference<D>::type&>::type deleter_lref;
+    typedef typename std::remove_reference<D>::type&& deleter_rref;
+
+   public:
+    constexpr unique_ptr() noexcept : s_() {}
+    constexpr unique_ptr(std::nullptr_t) noexcept : s_() {}
+    explicit unique_ptr(pointer p) noexcept : s_(p, D()) {}
+    unique_ptr(pointer p, deleter_lref d) noexcept : s_(p, d) {}
+    template <class E = D, class = typename std::enable_if<
+                               !std::is_reference<E>::value>::type>
+    unique_ptr(pointer p, deleter_rref d) noexcept : s_(p, mystl::move(d)) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept
+        : s_(rhs.release(), mystl::forward<D>(rhs.get_deleter())) {}
+
+    template <class U, class E,
+              class = typename std::enable_if<
+                  std::is_convertible<typename unique_ptr<U, E>::pointer,
+                                      pointer>::value &&
+                  !std::is_array<U>::value &&
+                  (std::is_reference<D>::value
+                       ? std::is_same<E, D>::value
+                       : std::is_convertible<E, D>::value)>::type>
+    unique_ptr(unique_ptr<U, E>&& rhs) noexcept
+        : s_(rhs.release(), mystl::forward<E>(rhs.get_deleter())) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    ~unique_ptr() {
+        if (s_.ptr() != nullptr) {
+            s_.deleter()(s_.ptr());
+        }
+    }
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        s_.deleter() = mystl::forward<D>(rhs.get_deleter());
+        return *this;
+    }
+
+    template <class U, class E>
+    typename std::enable_if<
+        std::is_convertible<typename unique_ptr<U, E>::pointer,
+                            pointer>::value &&
+            !std::is_array<U>::value && std::is_assignable<D&, E&&>::value,
+        unique_ptr&>::type
+    operator=(unique_ptr<U, E>&& rhs) noexcept {
+        reset(rhs.release());
+        s_.deleter() = mystl::forward<E>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+   public:
+    typename std::add_lvalue_reference<T>::type operator*() const {
+        return *s_.ptr();
+    }
+    pointer operator->() const noexcept { return s_.ptr(); }
+
+    pointer get() const noexcept { return s_.ptr(); }
+    deleter_type& get_deleter() noexcept { return s_.deleter(); }
+    const deleter_type& get_deleter() const noexcept { return s_.deleter(); }
+
+    explicit operator bool() const noexcept { return s_.ptr() != nullptr; }
+
+    pointer release() noexcept {
+        pointer p = s_.ptr();
+        s_.ptr() = pointer();
+        return p;
+    }
+
+    void reset(pointer p = pointer()) noexcept {
+        pointer old = s_.ptr();
+        s_.ptr() = p;
+        if (old != nullptr) {
+            s_.deleter()(old);
+        }
+    }
+
+    void swap(unique_ptr& rhs) noexcept {
+        mystl::swap(s_.ptr(), rhs.s_.ptr());
+        mystl::swap(s_.deleter(), rhs.s_.deleter());
+    }
+
+   private:
+    up_detail::ptr_storage<pointer, D> s_;
+};
+
+// unique_ptr<T[]>: delete[] and operator[], no conversions between types
+template <class T, class D>
+class unique_ptr<T[], D> {
+   public:
+    typedef typename up_detail::pointer_of<T, D>::type pointer;
+    typedef T element_type;
+    typedef D deleter_type;
+
+   private:
+    typedef typename std::conditional<
+        std::is_reference<D>::value, D,
+        const typename std::remove_reference<D>::type&>::type deleter_lref;
+    typedef typename std::remove_reference<D>::type&& deleter_rref;
+
+   public:
+    constexpr unique_ptr() noexcept : s_() {}
+    constexpr unique_ptr(std::nullptr_t) noexcept : s_() {}
+    explicit unique_ptr(pointer p) noexcept : s_(p, D()) {}
+    unique_ptr(pointer p, deleter_lref d) noexcept : s_(p, d) {}
+    template <class E = D, class = typename std::enable_if<
+                               !std::is_reference<E>::value>::type>
+    unique_ptr(pointer p, deleter_rref d) noexcept : s_(p, mystl::move(d)) {}
+
+    unique_ptr(unique_ptr&& rhs) noexcept
+        : s_(rhs.release(), mystl::forward<D>(rhs.get_deleter())) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    ~unique_ptr() {
+        if (s_.ptr() != nullptr) {
+            s_.deleter()(s_.ptr());
+        }
+    }
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        s_.deleter() = mystl::forward<D>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+   public:
+    T& operator[](size_t i) const { return s_.ptr()[i]; }
+
+    pointer get() const noexcept { return s_.ptr(); }
+    deleter_type& get_deleter() noexcept { return s_.deleter(); }
+    const deleter_type& get_deleter() const noexcept { return s_.deleter(); }
+
+    explicit operator bool() const noexcept { return s_.ptr() != nullptr; }
+
+    pointer release() noexcept {
+        pointer p = s_.ptr();
+        s_.ptr() = pointer();
+        return p;
+    }
+
+    void reset(pointer p = pointer()) noexcept {
+        pointer old = s_.ptr();
+        s_.ptr() = p;
+        if (old != nullptr) {
+            s_.deleter()(old);
+        }
+    }
+
+    void swap(unique_ptr& rhs) noexcept {
+        mystl::swap(s_.ptr(), rhs.s_.ptr());
+        mystl::swap(s_.deleter(), rhs.s_.deleter());
+    }
+
+   private:
+    up_detail::ptr_storage<pointer, D> s_;
+};
+
+// make_unique
+template <class T, class... Args>
+typename std::enable_if<!std::is_array<T>::value, unique_ptr<T>>::type
+make_unique(Args&&... args) {
+    return unique_ptr<T>(new T(mystl::forward<Args>(args)...));
+}
+
+template <class T>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0,
+                        unique_ptr<T>>::type
+make_unique(size_t n) {
+    typedef typename std::remove_extent<T>::type U;
+    return unique_ptr<T>(new U[n]());
+}
+
+template <class T, class... Args>
+typename std::enable_if<std::extent<T>::value != 0>::type make_unique(
+    Args&&...) = delete;
+
+// overload mystl's swap
+template <class T, class D>
+void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// overload comparison operators
+template <class T1, class D1, class T2, class D2>
+bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() == rhs.get();
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator<(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    typedef typename unique_ptr<T1, D1>::pointer pointer1;
+    typedef typename unique_ptr<T2, D2>::pointer pointer2;
+    typedef typename std::common_type<pointer1, pointer2>::type common;
+    return mystl::less<common>()(lhs.get(), rhs.get());
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator>(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator<=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T1, class D1, class T2, class D2>
+bool operator>=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class T, class D>
+bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept {
+    return !lhs;
+}
+
+template <class T, class D>
+bool operator==(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept {
+    return !rhs;
+}
+
+template <class T, class D>
+bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept {
+    return static_cast<bool>(lhs);
+}
+
+template <class T, class D>
+bool operator!=(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept {
+    return static_cast<bool>(rhs);
+}
+
+template <class T, class D>
+struct hash<unique_ptr<T, D>> {
+    size_t operator()(const unique_ptr<T, D>& p) const noexcept {
+        return mystl::hash<typename unique_ptr<T, D>::pointer>()(p.get());
+    }
+};
+
+// a unique_ptr owns its pointee from the outside, moving its bytes is fine
+template <class T, class D>
+struct is_trivially_relocatable<unique_ptr<T, D>>
+    : is_trivially_relocatable<D> {};
+
+}  // namespace mystl
+#endif
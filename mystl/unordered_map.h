@@ -23,14 +23,17 @@
 #define MYSTL_UNORDERED_MAP_H
 
 #include "hashtable.h"
+#include "memory_resource.h"
 
 namespace mystl {
 
 template <class Key, class T, class Hash = mystl::hash<Key>,
-          class KeyEqual = mystl::equal_to<Key>>
+          class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class unordered_map {
    private:
-    typedef hashtable<mystl::pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<mystl::pair<const Key, T>, Hash, KeyEqual, Alloc>
+        base_type;
     base_type ht_;
 
    public:
@@ -59,32 +62,42 @@ class unordered_map {
    public:
     unordered_map() : ht_(100, Hash(), KeyEqual()) {}
 
+    explicit unordered_map(const allocator_type& alloc)
+        : ht_(100, Hash(), KeyEqual(), alloc) {}
+
     explicit unordered_map(size_type bucket_count, const Hash& hash = Hash(),
-                           const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal) {}
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class InputIterator>
     unordered_map(InputIterator first, InputIterator last,
                   const size_type bucket_count = 100, const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count,
                          static_cast<size_type>(mystl::distance(first, last))),
-              hash, equal) {
+              hash, equal, alloc) {
         for (; first != last; ++first) ht_.insert_unique_noresize(*first);
     }
 
     unordered_map(std::initializer_list<value_type> ilist,
                   const size_type bucket_count = 100, const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())),
-              hash, equal) {
+              hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last;
              ++first)
             ht_.insert_unique_noresize(*first);
     }
 
     unordered_map(const unordered_map& rhs) : ht_(rhs.ht_) {}
+    unordered_map(const unordered_map& rhs, const allocator_type& alloc)
+        : ht_(rhs.ht_, alloc) {}
     unordered_map(unordered_map&& rhs) noexcept : ht_(mystl::move(rhs.ht_)) {}
+    unordered_map(unordered_map&& rhs, const allocator_type& alloc)
+        : ht_(mystl::move(rhs.ht_), alloc) {}
 
     unordered_map& operator=(const unordered_map& rhs) {
         ht_ = rhs.ht_;
@@ -245,37 +258,38 @@ class unordered_map {
 
    public:
     friend bool operator==(const unordered_map& lhs, const unordered_map& rhs) {
-        return lhs.ht_.equal_range_unique(rhs.ht_);
+        return lhs.ht_.equal_to_unique(rhs.ht_);
     }
     friend bool operator!=(const unordered_map& lhs, const unordered_map& rhs) {
-        return !lhs.ht_.equal_range_unique(rhs.ht_);
+        return !lhs.ht_.equal_to_unique(rhs.ht_);
     }
 };
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
-          unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
 // template class unordered_multimap
 template <class Key, class T, class Hash = mystl::hash<Key>,
-          class KeyEqual = mystl::equal_to<Key>>
+          class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<mystl::pair<const Key, T>>>
 class unordered_multimap {
    private:
-    typedef hashtable<pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -303,36 +317,47 @@ class unordered_multimap {
    public:
     unordered_multimap() : ht_(100, Hash(), KeyEqual()) {}
 
+    explicit unordered_multimap(const allocator_type& alloc)
+        : ht_(100, Hash(), KeyEqual(), alloc) {}
+
     explicit unordered_multimap(size_type bucket_count,
                                 const Hash& hash = Hash(),
-                                const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal) {}
+                                const KeyEqual& equal = KeyEqual(),
+                                const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class InputIterator>
     unordered_multimap(InputIterator first, InputIterator last,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count,
                          static_cast<size_type>(mystl::distance(first, last))),
-              hash, equal) {
+              hash, equal, alloc) {
         for (; first != last; ++first) ht_.insert_multi_noresize(*first);
     }
 
     unordered_multimap(std::initializer_list<value_type> ilist,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())),
-              hash, equal) {
+              hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last;
              ++first)
             ht_.insert_multi_noresize(*first);
     }
 
     unordered_multimap(const unordered_multimap& rhs) : ht_(rhs.ht_) {}
+    unordered_multimap(const unordered_multimap& rhs,
+                       const allocator_type& alloc)
+        : ht_(rhs.ht_, alloc) {}
     unordered_multimap(unordered_multimap&& rhs) noexcept
         : ht_(mystl::move(rhs.ht_)) {}
+    unordered_multimap(unordered_multimap&& rhs, const allocator_type& alloc)
+        : ht_(mystl::move(rhs.ht_), alloc) {}
 
     unordered_multimap& operator=(const unordered_multimap& rhs) {
         ht_ = rhs.ht_;
@@ -468,32 +493,45 @@ class unordered_multimap {
    public:
     friend bool operator==(const unordered_multimap& lhs,
                            const unordered_multimap& rhs) {
-        return lhs.ht_.equal_range_multi(rhs.ht_);
+        return lhs.ht_.equal_to_multi(rhs.ht_);
     }
     friend bool operator!=(const unordered_multimap& lhs,
                            const unordered_multimap& rhs) {
-        return !lhs.ht_.equal_range_multi(rhs.ht_);
+        return !lhs.ht_.equal_to_multi(rhs.ht_);
     }
 };
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-          unordered_multimap<Key, T, Hash, KeyEqual>& rhs) {
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
+namespace pmr {
+template <class Key, class T, class Hash = mystl::hash<Key>,
+          class KeyEqual = mystl::equal_to<Key>>
+using unordered_map =
+    mystl::unordered_map<Key, T, Hash, KeyEqual,
+                         polymorphic_allocator<mystl::pair<const Key, T>>>;
+template <class Key, class T, class Hash = mystl::hash<Key>,
+          class KeyEqual = mystl::equal_to<Key>>
+using unordered_multimap =
+    mystl::unordered_multimap<Key, T, Hash, KeyEqual,
+                              polymorphic_allocator<mystl::pair<const Key, T>>>;
+}  // namespace pmr
+
 }  // namespace mystl
 
 #endif
\ No newline at end of file
@@ -31,10 +31,11 @@
 namespace mystl {
 
 template <class Key, class Hash = mystl::hash<Key>,
-          class KeyEqual = equal_to<Key>>
+          class KeyEqual = equal_to<Key>,
+          class Alloc = mystl::allocator<Key>>
 class unordered_set {
    private:
-    typedef hashtable<Key, Hash, KeyEqual> base_type;
+    typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -59,19 +60,24 @@ class unordered_set {
     allocator_type get_allocator() const { return ht_.get_allocator(); }
 
    public:
-    unordered_set() : ht_(100, hash(), KeyEqual()) {}
+    unordered_set() : ht_(100, Hash(), KeyEqual()) {}
+
+    explicit unordered_set(const allocator_type& alloc)
+        : ht_(100, Hash(), KeyEqual(), alloc) {}
 
     explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(),
-                           const KeyEqual& equal = Key Equal())
-        : ht_(bucket_count, hash, equal) {}
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class InputIterator>
     unordered_set(InputIterator first, InputIterator last,
                   const size_type bucket_count = 100, const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count,
                          static_cast<size_type>(mystl::distance(first, last))),
-              equal) {
+              hash, equal, alloc) {
         for (; first != last; ++first) {
             ht_.insert_unique_noresize(*first);
         }
@@ -79,16 +85,21 @@ class unordered_set {
 
     unordered_set(std::initializer_list<value_type> ilist,
                   const size_type bucket_count = 100, const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())),
-              hash, equal) {
+              hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last;
              ++first)
             ht_.insert_unique_noresize(*first);
     }
 
     unordered_set(const unordered_set& rhs) : ht_(rhs.ht_) {}
+    unordered_set(const unordered_set& rhs, const allocator_type& alloc)
+        : ht_(rhs.ht_, alloc) {}
     unordered_set(unordered_set&& rhs) noexcept : ht_(mystl::move(rhs.ht_)) {}
+    unordered_set(unordered_set&& rhs, const allocator_type& alloc)
+        : ht_(mystl::move(rhs.ht_), alloc) {}
 
     unordered_set& operator=(const unordered_set& rhs) {
         ht_ = rhs.ht_;
@@ -233,37 +244,38 @@ class unordered_set {
 
    public:
     friend bool operator==(const unordered_set& lhs, const unordered_set& rhs) {
-        return lhs.ht_.equal_range_unique(rhs.ht_);
+        return lhs.ht_.equal_to_unique(rhs.ht_);
     }
     friend bool operator!=(const unordered_set& lhs, const unordered_set& rhs) {
-        return !lhs.ht_.equal_range_unique(rhs.ht_);
+        return !lhs.ht_.equal_to_unique(rhs.ht_);
     }
 };
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator==(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs) {
+bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator!=(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs) {
+bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
-          unordered_set<Key, Hash, KeyEqual>& rhs) {
+void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+          unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
 // template class: unordered_multiset
 template <class Key, class Hash = mystl::hash<Key>,
-          class KeyEqual = mystl::equal_to<Key>>
+          class KeyEqual = mystl::equal_to<Key>,
+          class Alloc = mystl::allocator<Key>>
 class unordered_multiset {
    private:
-    typedef hashtable<Key, Hash, KeyEqual> base_type;
+    typedef hashtable<Key, Hash, KeyEqual, Alloc> base_type;
     base_type ht_;
 
    public:
@@ -290,36 +302,47 @@ class unordered_multiset {
    public:
     unordered_multiset() : ht_(100, Hash(), KeyEqual()) {}
 
+    explicit unordered_multiset(const allocator_type& alloc)
+        : ht_(100, Hash(), KeyEqual(), alloc) {}
+
     explicit unordered_multiset(size_type bucket_count,
                                 const Hash& hash = Hash(),
-                                const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal) {}
+                                const KeyEqual& equal = KeyEqual(),
+                                const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc) {}
 
     template <class InputIterator>
     unordered_multiset(InputIterator first, InputIterator last,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count,
                          static_cast<size_type>(mystl::distance(first, last))),
-              hash, equal) {
+              hash, equal, alloc) {
         for (; first != last; ++first) ht_.insert_multi_noresize(*first);
     }
 
     unordered_multiset(std::initializer_list<value_type> ilist,
                        const size_type bucket_count = 100,
                        const Hash& hash = Hash(),
-                       const KeyEqual& equal = KeyEqual())
+                       const KeyEqual& equal = KeyEqual(),
+                       const allocator_type& alloc = allocator_type())
         : ht_(mystl::max(bucket_count, static_cast<size_type>(ilist.size())),
-              hash, equal) {
+              hash, equal, alloc) {
         for (auto first = ilist.begin(), last = ilist.end(); first != last;
              ++first)
             ht_.insert_multi_noresize(*first);
     }
 
     unordered_multiset(const unordered_multiset& rhs) : ht_(rhs.ht_) {}
+    unordered_multiset(const unordered_multiset& rhs,
+                       const allocator_type& alloc)
+        : ht_(rhs.ht_, alloc) {}
     unordered_multiset(unordered_multiset&& rhs) noexcept
         : ht_(mystl::move(rhs.ht_)) {}
+    unordered_multiset(unordered_multiset&& rhs, const allocator_type& alloc)
+        : ht_(mystl::move(rhs.ht_), alloc) {}
 
     unordered_multiset& operator=(const unordered_multiset& rhs) {
         ht_ = rhs.ht_;
@@ -455,29 +478,29 @@ class unordered_multiset {
    public:
     friend bool operator==(const unordered_multiset& lhs,
                            const unordered_multiset& rhs) {
-        return lhs.ht_.equal_range_multi(rhs.ht_);
+        return lhs.ht_.equal_to_multi(rhs.ht_);
     }
     friend bool operator!=(const unordered_multiset& lhs,
                            const unordered_multiset& rhs) {
-        return !lhs.ht_.equal_range_multi(rhs.ht_);
+        return !lhs.ht_.equal_to_multi(rhs.ht_);
     }
 };
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator==(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs) {
+bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs == rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-bool operator!=(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs) {
+bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs) {
     return lhs != rhs;
 }
 
 template <class Key, class Hash, class KeyEqual, class Alloc>
-void swap(unordered_multiset<Key, Hash, KeyEqual>& lhs,
-          unordered_multiset<Key, Hash, KeyEqual>& rhs) {
+void swap(unordered_multiset<Key, Hash, KeyEqual, Alloc>& lhs,
+          unordered_multiset<Key, Hash, KeyEqual, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
@@ -25,12 +25,15 @@
 
 #ifndef MYSTL_VECTOR_H_
 #define MYSTL_VECTOR_H_
+#include <cstring>
 #include <initializer_list>
 
 #include "algo.h"
+#include "aligned_allocator.h"
 #include "exceptdef.h"
 #include "iterator.h"
 #include "memory.h"
+#include "memory_resource.h"
 #include "util.h"
 namespace mystl {
 #ifdef max
@@ -42,66 +45,108 @@ namespace mystl {
 #undef min
 #endif  // min
 // template class: vector
-template <class T>
-class vector {
-    static_assert(!std::is_same<bool, T>::value,
-                  "vector<boo> is abandoned in mystl");
-
+template <class T, class Alloc = mystl::allocator<T>>
+class vector
+    : private mystl::alloc_storage<
+          typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>> {
    public:
-    typedef mystl::allocator<T> allocator_type;
-    typedef mystl::allocator<T> data_allocator;
-    typedef typename allocator_type::value_type value_type;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::size_type size_type;
-    typedef typename allocator_type::difference_type difference_type;
+    typedef Alloc allocator_type;
+    typedef typename mystl::allocator_traits<Alloc>::template rebind_alloc<T>
+        data_allocator;
+    typedef mystl::allocator_traits<data_allocator> data_traits;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef typename data_traits::size_type size_type;
+    typedef typename data_traits::difference_type difference_type;
     typedef value_type* iterator;
     typedef const value_type* const_iterator;
     typedef mystl::reverse_iterator<iterator> reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
-    allocator_type get_allocator() { return data_allocator(); }
+
+    allocator_type get_allocator() const {
+        return allocator_type(data_alloc());
+    }
 
    private:
+    typedef mystl::alloc_storage<data_allocator> alloc_base;
+
     iterator begin_;
     iterator end_;
     iterator cap_;
 
+    data_allocator& data_alloc() noexcept { return alloc_base::get_alloc(); }
+    const data_allocator& data_alloc() const noexcept {
+        return alloc_base::get_alloc();
+    }
+
    public:
     // construct and deconstruct functions
     vector() noexcept { try_init(); }
 
-    explicit vector(size_type n) { fill_init(n, value_type()); }
+    explicit vector(const allocator_type& alloc) noexcept
+        : alloc_base(data_allocator(alloc)) {
+        try_init();
+    }
+
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
+        fill_init(n, value_type());
+    }
 
-    vector(size_type n, const value_type& value) { fill_init(n, value); }
+    vector(size_type n, const value_type& value,
+           const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
+        fill_init(n, value);
+    }
 
     template <class Iter,
               typename std::enable_if<mystl::is_input_iterator<Iter>::value,
                                       int>::type = 0>
-    vector(Iter first, Iter last) {
+    vector(Iter first, Iter last,
+           const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
         MYSTL_DEBUG(!(last < first));
         range_init(first, last);
     }
 
-    vector(const vector& rhs) { range_init(rhs.begin_, rhs.end_); }
+    vector(const vector& rhs)
+        : alloc_base(
+              data_traits::select_on_container_copy_construction(rhs.data_alloc())) {
+        range_init(rhs.begin_, rhs.end_);
+    }
+
+    vector(const vector& rhs, const allocator_type& alloc)
+        : alloc_base(data_allocator(alloc)) {
+        range_init(rhs.begin_, rhs.end_);
+    }
 
     vector(vector&& rhs) noexcept
-        : begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
+        : alloc_base(mystl::move(rhs.data_alloc())),
+          begin_(rhs.begin_),
+          end_(rhs.end_),
+          cap_(rhs.cap_) {
         rhs.begin_ = nullptr;
         rhs.end_ = nullptr;
         rhs.cap_ = nullptr;
     }
 
-    vector(std::initializer_list<value_type> ilist) {
+    vector(vector&& rhs, const allocator_type& alloc);
+
+    vector(std::initializer_list<value_type> ilist,
+           const allocator_type& alloc = allocator_type())
+        : alloc_base(data_allocator(alloc)) {
         range_init(ilist.begin(), ilist.end());
     }
 
     vector& operator=(const vector& rhs);
-    vector& operator=(vector&& rhs) noexcept;
+    vector& operator=(vector&& rhs) noexcept(
+        data_traits::propagate_on_container_move_assignment::value ||
+        data_traits::is_always_equal::value);
     vector& operator=(std::initializer_list<value_type> ilist) {
-        vector tmp(ilist.begin(), ilist.end());
-        swap(tmp);
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
         return *this;
     }
 
@@ -148,7 +193,7 @@ class vector {
     }
 
     size_type max_size() const noexcept {
-        return static_cast<size_type>(-1) / sizeof(T);
+        return data_traits::max_size(data_alloc());
     }
 
     size_type capacity() const noexcept {
@@ -174,6 +219,12 @@ class vector {
         return (*this)[n];
     }
 
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()),
+                              "vector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
     reference front() {
         MYSTL_DEBUG(!empty());
         return *begin_;
@@ -217,6 +268,15 @@ class vector {
     iterator emplace(const_iterator pos, Args&&... args);
     template <class... Args>
     void emplace_back(Args&&... args);
+    // emplace_back without the capacity check, for loops that already
+    // reserved room for every element they add
+    template <class... Args>
+    void emplace_back_unchecked(Args&&... args) {
+        MYSTL_DEBUG(end_ < cap_);
+        data_traits::construct(data_alloc(), end_,
+                               mystl::forward<Args>(args)...);
+        ++end_;
+    }
     void push_back(const value_type& value);
     void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
 
@@ -239,6 +299,16 @@ class vector {
         copy_insert(const_cast<iterator>(pos), first, last);
     }
 
+    // insert(end(), first, last) with at most one reallocation; a contiguous
+    // range of trivially copyable elements is copied with memcpy. The range
+    // must not be part of this vector.
+    template <class Iter,
+              typename std::enable_if<mystl::is_input_iterator<Iter>::value,
+                                      int>::type = 0>
+    void append(Iter first, Iter last) {
+        append_aux(first, last, iterator_category(first));
+    }
+
     iterator erase(const_iterator pos);
     iterator erase(const_iterator first, const_iterator last);
     void clear() { erase(begin(), end()); }
@@ -246,6 +316,9 @@ class vector {
     void resize(size_type new_size) { return resize(new_size, value_type()); }
 
     void resize(size_type new_szie, const value_type& value);
+    // resize, but new elements are default-initialized: trivial types are
+    // left uninitialized for the caller to write into
+    void resize_default_init(size_type new_size);
     void reverse() { mystl::reverse(begin(), end()); }
 
     void swap(vector& rhs) noexcept;
@@ -259,11 +332,28 @@ class vector {
     void range_init(Iter first, Iter last);
     void destroy_and_recover(iterator first, iterator last, size_type n);
     size_type get_new_cap(size_type add_szie);
+    pointer allocate_data(size_type& n);
+    bool grow_in_place(size_type new_cap);
+    // whether grow_in_place can ever succeed
+    typedef std::integral_constant<bool,
+                                   std::is_trivially_copyable<T>::value &&
+                                       data_traits::can_reallocate::value>
+        remap_tag;
+    template <class... Args>
+    bool grow_back(size_type new_cap, std::true_type, Args&&... args);
+    template <class... Args>
+    bool grow_back(size_type, std::false_type, Args&&...) {
+        return false;
+    }
+    pointer relocate_around(pointer new_begin, iterator pos, size_type n);
+    static void shift_bytes(iterator first, iterator last, iterator result);
     void fill_assign(size_type n, const value_type& value);
     template <class IIter>
     void copy_assign(IIter first, IIter last, input_iterator_tag);
     template <class FIter>
     void copy_assign(FIter first, FIter last, forward_iterator_tag);
+    void move_assign(vector& rhs, std::true_type);
+    void move_assign(vector& rhs, std::false_type);
     template <class... Args>
     void reallocate_emplace(iterator pos, Args&&... args);
     void reallocate_insert(iterator pos, const value_type& value);
@@ -271,81 +361,121 @@ class vector {
     template <class IIter>
     void copy_insert(iterator pos, IIter first, IIter last);
     void reinsert(size_type size);
+    void reserve_more(size_type n);
+    template <class IIter>
+    void append_aux(IIter first, IIter last, input_iterator_tag);
+    template <class FIter>
+    void append_aux(FIter first, FIter last, forward_iterator_tag);
+    template <class FIter>
+    void append_copy(FIter first, FIter last, std::false_type);
+    template <class Ptr>
+    void append_copy(Ptr first, Ptr last, std::true_type);
 };
 
-template <class T>
-vector<T>& vector<T>::operator=(const vector& rhs) {
+template <class T, class Alloc>
+vector<T, Alloc>::vector(vector&& rhs, const allocator_type& alloc)
+    : alloc_base(data_allocator(alloc)) {
+    if (mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.begin_ = nullptr;
+        rhs.end_ = nullptr;
+        rhs.cap_ = nullptr;
+    } else {
+        const size_type len = rhs.size();
+        init_space(len, mystl::max(len, static_cast<size_type>(16)));
+        mystl::uninitialized_move(rhs.begin_, rhs.end_, begin_);
+    }
+}
+
+template <class T, class Alloc>
+vector<T, Alloc>& vector<T, Alloc>::operator=(const vector& rhs) {
     if (this != &rhs) {
-        const auto len = rhs.size();
-        if (len > capacity()) {
-            vector tmp(rhs.begin(), rhs.end());
-            swap(tmp);
-        } else if (size() >= len) {
-            auto i = mystl::copy(rhs.begin(), rhs.end(), begin());
-            data_allocator::destroy(i, end_);
-            end_ = begin_ + len;
-        } else {
-            mystl::copy(rhs.begin(), rhs.begin() + size(), begin_);
-            mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
-            cap_ = end_ = begin_ + len;
+        if (data_traits::propagate_on_container_copy_assignment::value &&
+            !mystl::alloc_equal(data_alloc(), rhs.data_alloc())) {
+            // memory of the old allocator can't outlive it
+            destroy_and_recover(begin_, end_, cap_ - begin_);
+            begin_ = end_ = cap_ = nullptr;
         }
+        mystl::alloc_on_copy(data_alloc(), rhs.data_alloc());
+        copy_assign(rhs.begin_, rhs.end_, mystl::forward_iterator_tag{});
     }
 
     return *this;
 }
 
-template <class T>
-vector<T>& vector<T>::operator=(vector&& rhs) noexcept {
-    destroy_and_recover(begin_, end_, cap_ - begin_);
-    begin_ = rhs.begin_;
-    end_ = rhs.end_;
-    cap_ = rhs.cap_;
-    rhs.begin_ = nullptr;
-    rhs.end_ = nullptr;
-    rhs.cap_ = nullptr;
+template <class T, class Alloc>
+vector<T, Alloc>& vector<T, Alloc>::operator=(vector&& rhs) noexcept(
+    data_traits::propagate_on_container_move_assignment::value ||
+    data_traits::is_always_equal::value) {
+    if (this != &rhs) {
+        move_assign(rhs, std::integral_constant<
+                             bool, data_traits::propagate_on_container_move_assignment::value ||
+                                       data_traits::is_always_equal::value>());
+    }
     return *this;
 }
 
-template <class T>
-void vector<T>::reserve(size_type n) {
+template <class T, class Alloc>
+void vector<T, Alloc>::reserve(size_type n) {
     if (capacity() < n) {
         THROW_LENGTH_ERROR_IF(
             n > max_size(),
             "n can not larger than max_size() in vector<T>::reserve()");
-        const auto old_size = size();
-        auto tmp = data_allocator::allocate(n);
-        mystl::uninitialized_move(begin_, end_, tmp);
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        if (grow_in_place(n)) {
+            return;
+        }
+        auto tmp = allocate_data(n);
+        try {
+            end_ = relocate_around(tmp, end_, 0);
+        } catch (...) {
+            data_traits::deallocate(data_alloc(), tmp, n);
+            throw;
+        }
         begin_ = tmp;
-        end_ = tmp + old_size;
         cap_ = begin_ + n;
     }
 }
 
-template <class T>
-void vector<T>::shrink_to_fit() {
+template <class T, class Alloc>
+void vector<T, Alloc>::shrink_to_fit() {
     if (end_ < cap_) {
         reinsert(size());
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename vector<T>::iterator vector<T>::emplace(const_iterator pos,
-                                                Args&&... args) {
+typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(
+    const_iterator pos, Args&&... args) {
     MYSTL_DEBUG(pos >= begin() && pos <= end());
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = xpos - begin_;
     if (end_ != cap_ && xpos == end_) {
-        data_allocator::construct(mystl::address_of(*end_),
-                                  mystl::forward<Args>(args)...);
+        data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                               mystl::forward<Args>(args)...);
         ++end_;
     } else if (end_ != cap_) {
-        auto new_end = end_;
-        data_allocator::construct(mystl::address_of(*end_), *(end_ - 1));
-        ++new_end;
-        mystl::copy_backward(xpos, end_ - 1, end_);
-        *xpos = value_type(mystl::forward<Args>(args)...);
+        // build the value first, args may refer to an element being moved
+        value_type value_copy(mystl::forward<Args>(args)...);
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(xpos, end_, xpos + 1);
+            try {
+                data_traits::construct(data_alloc(), xpos,
+                                       mystl::move(value_copy));
+            } catch (...) {
+                shift_bytes(xpos + 1, end_ + 1, xpos);
+                throw;
+            }
+            ++end_;
+        } else {
+            data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                                   mystl::move(*(end_ - 1)));
+            ++end_;
+            mystl::move_backward(xpos, end_ - 2, end_ - 1);
+            *xpos = mystl::move(value_copy);
+        }
     } else {
         reallocate_emplace(xpos, mystl::forward<Args>(args)...);
     }
@@ -353,52 +483,63 @@ typename vector<T>::iterator vector<T>::emplace(const_iterator pos,
     return begin() + n;
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-void vector<T>::emplace_back(Args&&... args) {
+void vector<T, Alloc>::emplace_back(Args&&... args) {
     if (end_ < cap_) {
-        data_allocator::construct(mystl::address_of(*end_),
-                                  mystl::forward<Args>(args)...);
+        data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                               mystl::forward<Args>(args)...);
         ++end_;
     } else {
         reallocate_emplace(end_, mystl::forward<Args>(args)...);
     }
 }
 
-template <class T>
-void vector<T>::push_back(const value_type& value) {
+template <class T, class Alloc>
+void vector<T, Alloc>::push_back(const value_type& value) {
     if (end_ != cap_) {
-        data_allocator::construct(mystl::address_of(*end_), value);
+        data_traits::construct(data_alloc(), mystl::address_of(*end_), value);
         ++end_;
     } else {
         reallocate_insert(end_, value);
     }
 }
 
-template <class T>
-void vector<T>::pop_back() {
+template <class T, class Alloc>
+void vector<T, Alloc>::pop_back() {
     MYSTL_DEBUG(!empty());
-    data_allocator::destroy(end_ - 1);
+    data_traits::destroy(data_alloc(), end_ - 1);
     --end_;
 }
 
-template <class T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos,
-                                               const value_type& value) {
+template <class T, class Alloc>
+typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(
+    const_iterator pos, const value_type& value) {
     MYSTL_DEBUG(pos >= begin() && pos <= end());
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = pos - begin_;
     if (end_ != cap_ && xpos == end_) {
-        data_allocator::construct(mystl::address_of(*end_), value);
+        data_traits::construct(data_alloc(), mystl::address_of(*end_), value);
         ++end_;
     } else if (end_ != cap_) {
-        auto new_end = end_;
-        data_allocator::construct(mystl::address_of(*end_), *(end_ - 1));
-        ++new_end;
         auto value_copy = value;
-        mystl::copy_backward(xpos, end_ - 1, end_);
-        *xpos = mystl::move(value_copy);
-        end_ = new_end;
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(xpos, end_, xpos + 1);
+            try {
+                data_traits::construct(data_alloc(), xpos,
+                                       mystl::move(value_copy));
+            } catch (...) {
+                shift_bytes(xpos + 1, end_ + 1, xpos);
+                throw;
+            }
+            ++end_;
+        } else {
+            data_traits::construct(data_alloc(), mystl::address_of(*end_),
+                                   mystl::move(*(end_ - 1)));
+            ++end_;
+            mystl::move_backward(xpos, end_ - 2, end_ - 1);
+            *xpos = mystl::move(value_copy);
+        }
     } else {
         reallocate_insert(xpos, value);
     }
@@ -406,29 +547,43 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos,
     return begin_ + n;
 }
 
-template <class T>
-typename vector<T>::iterator vector<T>::erase(const_iterator pos) {
+template <class T, class Alloc>
+typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(
+    const_iterator pos) {
     MYSTL_DEBUG(pos >= begin() && pos < end());
     iterator xpos = begin_ + (pos - begin());
-    mystl::move(xpos + 1, end_, xpos);
-    data_allocator::destroy(end_ - 1);
+    if (mystl::is_trivially_relocatable<T>::value) {
+        data_traits::destroy(data_alloc(), xpos);
+        shift_bytes(xpos + 1, end_, xpos);
+    } else {
+        mystl::move(xpos + 1, end_, xpos);
+        data_traits::destroy(data_alloc(), end_ - 1);
+    }
     --end_;
     return xpos;
 }
 
-template <class T>
-typename vector<T>::iterator vector<T>::erase(const_iterator first,
-                                              const_iterator last) {
+template <class T, class Alloc>
+typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(
+    const_iterator first, const_iterator last) {
     MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
     const auto n = first - begin();
     iterator r = begin_ + (first - begin());
-    data_allocator::destroy(mystl::move(r + (last - first), end_, r), end_);
+    if (first == last) {
+        return r;
+    }
+    if (mystl::is_trivially_relocatable<T>::value) {
+        mystl::destroy(r, r + (last - first));
+        shift_bytes(r + (last - first), end_, r);
+    } else {
+        mystl::destroy(mystl::move(r + (last - first), end_, r), end_);
+    }
     end_ = end_ - (last - first);
     return begin_ + n;
 }
 
-template <class T>
-void vector<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc>
+void vector<T, Alloc>::resize(size_type new_size, const value_type& value) {
     if (new_size < size()) {
         erase(begin() + new_size, end());
     } else {
@@ -436,9 +591,34 @@ void vector<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
-template <class T>
-void vector<T>::swap(vector<T>& rhs) noexcept {
+template <class T, class Alloc>
+void vector<T, Alloc>::resize_default_init(size_type new_size) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+        return;
+    }
+    const size_type n = new_size - size();
+    reserve_more(n);
+    if (std::is_trivially_default_constructible<T>::value) {
+        end_ += n;
+        return;
+    }
+    auto cur = end_;
+    try {
+        for (; cur != end_ + n; ++cur) {
+            ::new (static_cast<void*>(cur)) T;
+        }
+    } catch (...) {
+        mystl::destroy(end_, cur);
+        throw;
+    }
+    end_ = cur;
+}
+
+template <class T, class Alloc>
+void vector<T, Alloc>::swap(vector& rhs) noexcept {
     if (this != &rhs) {
+        mystl::alloc_on_swap(data_alloc(), rhs.data_alloc());
         mystl::swap(begin_, rhs.begin_);
         mystl::swap(end_, rhs.end_);
         mystl::swap(cap_, rhs.cap_);
@@ -446,12 +626,13 @@ void vector<T>::swap(vector<T>& rhs) noexcept {
 }
 
 // helper funcitons
-template <class T>
-void vector<T>::try_init() noexcept {
+template <class T, class Alloc>
+void vector<T, Alloc>::try_init() noexcept {
     try {
-        begin_ = data_allocator::allocate(16);
+        size_type cap = 16;
+        begin_ = allocate_data(cap);
         end_ = begin_;
-        cap_ = begin_ + 16;
+        cap_ = begin_ + cap;
     } catch (...) {
         begin_ = nullptr;
         end_ = nullptr;
@@ -459,10 +640,10 @@ void vector<T>::try_init() noexcept {
     }
 }
 
-template <class T>
-void vector<T>::init_space(size_type size, size_type cap) {
+template <class T, class Alloc>
+void vector<T, Alloc>::init_space(size_type size, size_type cap) {
     try {
-        begin_ = data_allocator::allocate(cap);
+        begin_ = allocate_data(cap);
         end_ = begin_ + size;
         cap_ = begin_ + cap;
     } catch (...) {
@@ -473,31 +654,34 @@ void vector<T>::init_space(size_type size, size_type cap) {
     }
 }
 
-template <class T>
-void vector<T>::fill_init(size_type n, const value_type& value) {
+template <class T, class Alloc>
+void vector<T, Alloc>::fill_init(size_type n, const value_type& value) {
     const size_type init_size = mystl::max(static_cast<size_type>(16), n);
     init_space(n, init_size);
     mystl::uninitialized_fill_n(begin_, n, value);
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class Iter>
-void vector<T>::range_init(Iter first, Iter last) {
-    const size_type init_size = mystl::max(static_cast<size_type>(last - first),
-                                           static_cast<size_type>(16));
-    init_space(static_cast<size_type>(last - first), init_size);
+void vector<T, Alloc>::range_init(Iter first, Iter last) {
+    const size_type len = mystl::distance(first, last);
+    const size_type init_size = mystl::max(len, static_cast<size_type>(16));
+    init_space(len, init_size);
     mystl::uninitialized_copy(first, last, begin_);
 }
 
-template <class T>
-void vector<T>::destroy_and_recover(iterator first, iterator last,
-                                    size_type n) {
-    data_allocator::destroy(first, last);
-    data_allocator::deallocate(first, n);
+template <class T, class Alloc>
+void vector<T, Alloc>::destroy_and_recover(iterator first, iterator last,
+                                           size_type n) {
+    mystl::destroy(first, last);
+    if (first != nullptr) {
+        data_traits::deallocate(data_alloc(), first, n);
+    }
 }
 
-template <class T>
-typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size) {
+template <class T, class Alloc>
+typename vector<T, Alloc>::size_type vector<T, Alloc>::get_new_cap(
+    size_type add_size) {
     const auto old_size = capacity();
     THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
                           "vector<T>'s size too big");
@@ -513,10 +697,94 @@ typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size) {
     return new_size;
 }
 
-template <class T>
-void vector<T>::fill_assign(size_type n, const value_type& value) {
+// allocate room for at least n elements, n is raised to the capacity the
+// allocator really handed out so that no slack in its size class is lost
+template <class T, class Alloc>
+typename vector<T, Alloc>::pointer vector<T, Alloc>::allocate_data(
+    size_type& n) {
+    auto r = data_traits::allocate_at_least(data_alloc(), n);
+    n = r.count;
+    return r.ptr;
+}
+
+// let the allocator resize the buffer (mmap_allocator remaps it) when the
+// elements can be relocated bitwise; false if it can't, nothing changed then
+template <class T, class Alloc>
+bool vector<T, Alloc>::grow_in_place(size_type new_cap) {
+    if (!std::is_trivially_copyable<T>::value ||
+        !data_traits::can_reallocate::value || begin_ == nullptr) {
+        return false;
+    }
+    const size_type old_size = size();
+    auto p = data_traits::reallocate(data_alloc(), begin_, capacity(), new_cap);
+    if (p == nullptr) {
+        return false;
+    }
+    begin_ = p;
+    end_ = p + old_size;
+    cap_ = p + new_cap;
+    return true;
+}
+
+// append one element after resizing the buffer in place; false, with the
+// arguments untouched, if the allocator can't
+template <class T, class Alloc>
+template <class... Args>
+bool vector<T, Alloc>::grow_back(size_type new_cap, std::true_type,
+                                 Args&&... args) {
+    // args may refer to the old buffer, build the value before resizing
+    const value_type tmp(mystl::forward<Args>(args)...);
+    if (!grow_in_place(new_cap)) {
+        return false;
+    }
+    data_traits::construct(data_alloc(), end_, tmp);
+    ++end_;
+    return true;
+}
+
+// move every element into new_begin, leaving n raw slots at pos, and free the
+// old buffer; returns the new end. Trivially relocatable elements are copied
+// bitwise and need no destruction, the rest are moved and destroyed. On an
+// exception the old buffer is left as it was.
+template <class T, class Alloc>
+typename vector<T, Alloc>::pointer vector<T, Alloc>::relocate_around(
+    pointer new_begin, iterator pos, size_type n) {
+    pointer new_end;
+    if (mystl::is_trivially_relocatable<T>::value) {
+        new_end = mystl::uninitialized_relocate(begin_, pos, new_begin) + n;
+        new_end = mystl::uninitialized_relocate(pos, end_, new_end);
+        if (begin_ != nullptr) {
+            data_traits::deallocate(data_alloc(), begin_, cap_ - begin_);
+        }
+    } else {
+        new_end = mystl::uninitialized_move(begin_, pos, new_begin);
+        try {
+            new_end = mystl::uninitialized_move(pos, end_, new_end + n);
+        } catch (...) {
+            mystl::destroy(new_begin, new_begin + (pos - begin_));
+            throw;
+        }
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+    }
+    return new_end;
+}
+
+// memmove of [first, last) to result inside the buffer, only used for
+// trivially relocatable elements
+template <class T, class Alloc>
+void vector<T, Alloc>::shift_bytes(iterator first, iterator last,
+                                   iterator result) {
+    if (first != last) {
+        std::memmove(static_cast<void*>(result),
+                     static_cast<const void*>(first),
+                     static_cast<size_t>(last - first) * sizeof(T));
+    }
+}
+
+template <class T, class Alloc>
+void vector<T, Alloc>::fill_assign(size_type n, const value_type& value) {
     if (n > capacity()) {
-        vector tmp(n, value);
+        vector tmp(n, value, get_allocator());
         swap(tmp);
     } else if (n > size()) {
         mystl::fill(begin(), end(), value);
@@ -526,9 +794,10 @@ void vector<T>::fill_assign(size_type n, const value_type& value) {
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class IIter>
-void vector<T>::copy_assign(IIter first, IIter last, input_iterator_tag) {
+void vector<T, Alloc>::copy_assign(IIter first, IIter last,
+                                   input_iterator_tag) {
     auto cur = begin_;
     for (; first != last && cur != end_; ++first, ++cur) {
         *cur = *first;
@@ -537,20 +806,23 @@ void vector<T>::copy_assign(IIter first, IIter last, input_iterator_tag) {
     if (first == last) {
         erase(cur, end_);
     } else {
-        insert(end_, first, last);
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
     }
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class FIter>
-void vector<T>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
+void vector<T, Alloc>::copy_assign(FIter first, FIter last,
+                                   forward_iterator_tag) {
     const size_type len = mystl::distance(first, last);
     if (len > capacity()) {
-        vector tmp(first, last);
+        vector tmp(first, last, get_allocator());
         swap(tmp);
     } else if (size() >= len) {
         auto new_end = mystl::copy(first, last, begin_);
-        data_allocator::destroy(new_end, end_);
+        mystl::destroy(new_end, end_);
         end_ = new_end;
     } else {
         auto mid = first;
@@ -561,89 +833,155 @@ void vector<T>::copy_assign(FIter first, FIter last, forward_iterator_tag) {
     }
 }
 
-template <class T>
+// the allocators agree on who owns the buffer: steal it
+template <class T, class Alloc>
+void vector<T, Alloc>::move_assign(vector& rhs, std::true_type) {
+    destroy_and_recover(begin_, end_, cap_ - begin_);
+    mystl::alloc_on_move(data_alloc(), rhs.data_alloc());
+    begin_ = rhs.begin_;
+    end_ = rhs.end_;
+    cap_ = rhs.cap_;
+    rhs.begin_ = nullptr;
+    rhs.end_ = nullptr;
+    rhs.cap_ = nullptr;
+}
+
+// the buffer of rhs can only be stolen if both allocators are equal
+template <class T, class Alloc>
+void vector<T, Alloc>::move_assign(vector& rhs, std::false_type) {
+    if (data_alloc() == rhs.data_alloc()) {
+        move_assign(rhs, std::true_type());
+    } else {
+        const size_type len = rhs.size();
+        if (len > capacity()) {
+            vector tmp(get_allocator());
+            tmp.reserve(len);
+            tmp.end_ = mystl::uninitialized_move(rhs.begin_, rhs.end_, tmp.begin_);
+            swap(tmp);
+        } else if (size() >= len) {
+            erase(mystl::move(rhs.begin_, rhs.end_, begin_), end_);
+        } else {
+            auto mid = rhs.begin_ + size();
+            mystl::move(rhs.begin_, mid, begin_);
+            end_ = mystl::uninitialized_move(mid, rhs.end_, end_);
+        }
+        rhs.clear();
+    }
+}
+
+template <class T, class Alloc>
 template <class... Args>
-void vector<T>::reallocate_emplace(iterator pos, Args&&... args) {
-    const auto new_size = get_new_cap(1);
-    auto new_begin = data_allocator::allocate(new_size);
+void vector<T, Alloc>::reallocate_emplace(iterator pos, Args&&... args) {
+    auto new_size = get_new_cap(1);
+    if (pos == end_ &&
+        grow_back(new_size, remap_tag(), mystl::forward<Args>(args)...)) {
+        return;
+    }
+    auto new_begin = allocate_data(new_size);
     auto new_end = new_begin;
+    const size_type xpos = pos - begin_;
     try {
-        new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(mystl::address_of(*new_end),
-                                  mystl::forward<Args>(args)...);
-        ++new_end;
-        new_end = mystl::uninitialized_move(pos, end_, new_end);
+        data_traits::construct(data_alloc(), mystl::address_of(*(new_begin + xpos)),
+                               mystl::forward<Args>(args)...);
+    } catch (...) {
+        data_traits::deallocate(data_alloc(), new_begin, new_size);
+        throw;
+    }
+    try {
+        new_end = relocate_around(new_begin, pos, 1);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        data_traits::destroy(data_alloc(), new_begin + xpos);
+        data_traits::deallocate(data_alloc(), new_begin, new_size);
         throw;
     }
 
-    destroy_and_recover(begin_, end_, cap_ - begin_);
     begin_ = new_begin;
     end_ = new_end;
     cap_ = new_begin + new_size;
 }
 
-template <class T>
-void vector<T>::reallocate_insert(iterator pos, const value_type& value) {
-    const auto new_size = get_new_cap(1);
-    auto new_begin = data_allocator::allocate(new_size);
+template <class T, class Alloc>
+void vector<T, Alloc>::reallocate_insert(iterator pos,
+                                         const value_type& value) {
+    auto new_size = get_new_cap(1);
+    if (pos == end_ && grow_back(new_size, remap_tag(), value)) {
+        return;
+    }
+    auto new_begin = allocate_data(new_size);
     auto new_end = new_begin;
-    const value_type& value_copy = value;
+    const size_type xpos = pos - begin_;
     try {
-        new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-        data_allocator::construct(mystl::address_of(*new_end), value_copy);
-        ++new_end;
-        new_end = mystl::uninitialized_move(pos, end_, new_end);
+        data_traits::construct(data_alloc(), mystl::address_of(*(new_begin + xpos)),
+                               value);
+    } catch (...) {
+        data_traits::deallocate(data_alloc(), new_begin, new_size);
+        throw;
+    }
+    try {
+        new_end = relocate_around(new_begin, pos, 1);
     } catch (...) {
-        data_allocator::deallocate(new_begin, new_size);
+        data_traits::destroy(data_alloc(), new_begin + xpos);
+        data_traits::deallocate(data_alloc(), new_begin, new_size);
         throw;
     }
 
-    destroy_and_recover(begin_, end_, cap_ - begin_);
     begin_ = new_begin;
     end_ = new_end;
     cap_ = new_begin + new_size;
 }
 
-template <class T>
-typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n,
-                                                    const value_type& value) {
+template <class T, class Alloc>
+typename vector<T, Alloc>::iterator vector<T, Alloc>::fill_insert(
+    iterator pos, size_type n, const value_type& value) {
     if (n == 0) {
         return pos;
     }
 
     const size_type xpos = pos - begin_;
     const value_type value_copy = value;
-    if (static_cast<size_type>(cap_ - end_) >= n) {
+    if (static_cast<size_type>(cap_ - end_) >= n ||
+        grow_in_place(get_new_cap(n))) {
+        pos = begin_ + xpos;
         const size_type after_elems = end_ - pos;
         auto old_end = end_;
-        if (after_elems > n) {
-            mystl::uninitialized_copy(end_ - n, end_, end_);
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(pos, end_, pos + n);
+            try {
+                mystl::uninitialized_fill_n(pos, n, value_copy);
+            } catch (...) {
+                shift_bytes(pos + n, end_ + n, pos);
+                throw;
+            }
             end_ += n;
+        } else if (after_elems > n) {
+            end_ = mystl::uninitialized_move(end_ - n, end_, end_);
             mystl::move_backward(pos, old_end - n, old_end);
-            mystl::uninitialized_fill_n(pos, n, value_copy);
+            mystl::fill_n(pos, n, value_copy);
         } else {
             end_ =
                 mystl::uninitialized_fill_n(end_, n - after_elems, value_copy);
             end_ = mystl::uninitialized_move(pos, old_end, end_);
-            mystl::uninitialized_fill_n(pos, after_elems, value_copy);
+            mystl::fill_n(pos, after_elems, value_copy);
         }
 
     } else {
-        const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator::allocate(new_size);
+        auto new_size = get_new_cap(n);
+        auto new_begin = allocate_data(new_size);
         auto new_end = new_begin;
         try {
-            new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-            new_end = mystl::uninitialized_fill_n(new_end, n, value);
-            new_end = mystl::uninitialized_move(pos, end_, new_end);
+            mystl::uninitialized_fill_n(new_begin + xpos, n, value_copy);
         } catch (...) {
-            destroy_and_recover(new_begin, new_end, new_size);
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
+            throw;
+        }
+        try {
+            new_end = relocate_around(new_begin, pos, n);
+        } catch (...) {
+            mystl::destroy(new_begin + xpos, new_begin + xpos + n);
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
             throw;
         }
 
-        data_allocator::deallocate(begin_, cap_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
@@ -652,9 +990,9 @@ typename vector<T>::iterator vector<T>::fill_insert(iterator pos, size_type n,
     return begin_ + xpos;
 }
 
-template <class T>
+template <class T, class Alloc>
 template <class IIter>
-void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
+void vector<T, Alloc>::copy_insert(iterator pos, IIter first, IIter last) {
     if (first == last) {
         return;
     }
@@ -663,90 +1001,171 @@ void vector<T>::copy_insert(iterator pos, IIter first, IIter last) {
     if ((cap_ - end_) >= n) {
         const auto after_elems = end_ - pos;
         auto old_end = end_;
-        if (after_elems > n) {
-            end_ = mystl::uninitialized_copy(end_ - n, end_, end_);
+        if (mystl::is_trivially_relocatable<T>::value) {
+            shift_bytes(pos, end_, pos + n);
+            try {
+                mystl::uninitialized_copy(first, last, pos);
+            } catch (...) {
+                shift_bytes(pos + n, end_ + n, pos);
+                throw;
+            }
+            end_ += n;
+        } else if (after_elems > n) {
+            end_ = mystl::uninitialized_move(end_ - n, end_, end_);
             mystl::move_backward(pos, old_end - n, old_end);
-            mystl::uninitialized_copy(first, last, pos);
+            mystl::copy(first, last, pos);
         } else {
             auto mid = first;
             mystl::advance(mid, after_elems);
             end_ = mystl::uninitialized_copy(mid, last, end_);
             end_ = mystl::uninitialized_move(pos, old_end, end_);
-            mystl::uninitialized_copy(first, mid, pos);
+            mystl::copy(first, mid, pos);
         }
 
     } else {
-        const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator::allocate(new_size);
+        auto new_size = get_new_cap(n);
+        auto new_begin = allocate_data(new_size);
         auto new_end = new_begin;
+        const auto xpos = pos - begin_;
         try {
-            new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-            new_end = mystl::uninitialized_copy(first, last, new_end);
-            new_end = mystl::uninitialized_move(pos, end_, new_end);
+            mystl::uninitialized_copy(first, last, new_begin + xpos);
         } catch (...) {
-            destroy_and_recover(new_begin, new_end, new_size);
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
+            throw;
+        }
+        try {
+            new_end = relocate_around(new_begin, pos, n);
+        } catch (...) {
+            mystl::destroy(new_begin + xpos, new_begin + xpos + n);
+            data_traits::deallocate(data_alloc(), new_begin, new_size);
             throw;
         }
 
-        data_allocator::deallocate(begin_, cap_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         cap_ = begin_ + new_size;
     }
 }
 
-template <class T>
-void vector<T>::reinsert(size_type size) {
-    auto new_begin = data_allocator::allocate(size);
+template <class T, class Alloc>
+void vector<T, Alloc>::reinsert(size_type size) {
+    size_type cap = size;
+    auto new_begin = allocate_data(cap);
     try {
-        mystl::uninitialized_move(begin_, end_, new_begin);
+        relocate_around(new_begin, end_, 0);
     } catch (...) {
-        data_allocator::deallocate(new_begin, size);
+        data_traits::deallocate(data_alloc(), new_begin, cap);
         throw;
     }
 
-    data_allocator::deallocate(begin_, cap_ - begin_);
     begin_ = new_begin;
     end_ = begin_ + size;
-    cap_ = begin_ + size;
+    cap_ = begin_ + cap;
 }
 
-template <class T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs) {
+// make room for n more elements, growing the way insertion does
+template <class T, class Alloc>
+void vector<T, Alloc>::reserve_more(size_type n) {
+    if (static_cast<size_type>(cap_ - end_) < n) {
+        reserve(get_new_cap(n));
+    }
+}
+
+template <class T, class Alloc>
+template <class IIter>
+void vector<T, Alloc>::append_aux(IIter first, IIter last,
+                                  input_iterator_tag) {
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template <class T, class Alloc>
+template <class FIter>
+void vector<T, Alloc>::append_aux(FIter first, FIter last,
+                                  forward_iterator_tag) {
+    typedef typename std::remove_cv<
+        typename std::remove_pointer<FIter>::type>::type source_type;
+    append_copy(first, last,
+                std::integral_constant<
+                    bool, std::is_pointer<FIter>::value &&
+                              std::is_same<source_type, T>::value &&
+                              std::is_trivially_copyable<T>::value>());
+}
+
+template <class T, class Alloc>
+template <class FIter>
+void vector<T, Alloc>::append_copy(FIter first, FIter last, std::false_type) {
+    reserve_more(static_cast<size_type>(mystl::distance(first, last)));
+    end_ = mystl::uninitialized_copy(first, last, end_);
+}
+
+template <class T, class Alloc>
+template <class Ptr>
+void vector<T, Alloc>::append_copy(Ptr first, Ptr last, std::true_type) {
+    const size_type n = static_cast<size_type>(last - first);
+    if (n == 0) {
+        return;
+    }
+    reserve_more(n);
+    std::memcpy(static_cast<void*>(end_), static_cast<const void*>(first),
+                n * sizeof(T));
+    end_ += n;
+}
+
+template <class T, class Alloc>
+bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
     return lhs.size() == rhs.size() &&
            mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator<(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc>
+bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
     return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
                                           rhs.end());
 }
 
-template <class T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc>
+bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc>
+bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc>
+bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc>
+bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
-template <class T>
-void swap(vector<T>& lhs, vector<T>& rhs) {
+template <class T, class Alloc>
+void swap(vector<T, Alloc>& lhs, vector<T, Alloc>& rhs) {
     lhs.swap(rhs);
 }
 
+// a vector only points at its heap buffer, never into itself
+template <class T, class Alloc>
+struct is_trivially_relocatable<vector<T, Alloc>>
+    : is_trivially_relocatable<Alloc> {};
+
+// vector whose data starts at an Align boundary, a cache line by default
+template <class T, size_t Align = cache_line_size>
+using aligned_vector = vector<T, aligned_allocator<T, Align>>;
+
+namespace pmr {
+template <class T>
+using vector = mystl::vector<T, polymorphic_allocator<T>>;
+}  // namespace pmr
+
 }  // namespace mystl
+
+// the bit packed vector<bool> specialization
+#include "bvector.h"
 #endif
@@ -0,0 +1,176 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_ALIGNED_ALLOCATOR_TEST_H_
+#define MYSTL_ALIGNED_ALLOCATOR_TEST_H_
+
+// unit tests that every allocation path honours alignof(T), and a
+// multithreaded performance test for over-aligned allocation: every thread
+// bumps its own counter in a shared vector. Packed counters share cache
+// lines, alignas(64) counters get one line each now that the allocator
+// honours alignof(T); the table shows the wall time against the threads
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../mystl/allocator.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace aligned_allocator_test {
+
+struct packed_counter {
+    long value = 0;
+};
+
+struct alignas(64) padded_counter {
+    long value = 0;
+};
+
+struct alignas(256) wide_block {
+    char bytes[256];
+};
+
+inline bool aligned_to(const void* p, size_t align) {
+    return reinterpret_cast<uintptr_t>(p) % align == 0;
+}
+
+// allocate, allocate_at_least and a growing vector all return blocks
+// aligned to alignof(T)
+template <class T>
+void alignment_check() {
+    bool ok = true;
+    for (size_t n = 1; n < 40; n += 3) {
+        T* p = mystl::allocator<T>::allocate(n);
+        ok = ok && aligned_to(p, alignof(T));
+        mystl::allocator<T>::deallocate(p, n);
+        auto r = mystl::allocator<T>::allocate_at_least(n);
+        ok = ok && aligned_to(r.ptr, alignof(T)) && r.count >= n;
+        mystl::allocator<T>::deallocate(r.ptr, r.count);
+    }
+    mystl::vector<T> v;
+    for (size_t i = 0; i < 100; ++i) {
+        v.push_back(T());
+        ok = ok && aligned_to(v.data(), alignof(T));
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(aligned_allocator_alignment_test) {
+    alignment_check<packed_counter>();
+    alignment_check<padded_counter>();
+    alignment_check<wide_block>();
+
+    mystl::vector<padded_counter> counters(7);
+    EXPECT_EQ(reinterpret_cast<char*>(&counters[1]) -
+                  reinterpret_cast<char*>(&counters[0]),
+              64);
+
+    bool ok = true;
+    for (size_t align = 8; align <= 4096; align *= 2) {
+        void* p = mystl::aligned_allocate(100, align);
+        ok = ok && aligned_to(p, align);
+        mystl::aligned_deallocate(p, align);
+    }
+    EXPECT_TRUE(ok);
+}
+
+template <class Counter>
+void bump(Counter* counter, size_t count) {
+    volatile long* p = &counter->value;
+    for (size_t i = 0; i < count; ++i) {
+        *p = *p + 1;
+    }
+}
+
+// every one of threads bumps its own slot count times, prints the time
+template <class Counter>
+void counters_test(size_t threads, size_t count) {
+    char buf[16];
+    mystl::vector<Counter> counters(threads);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(bump<Counter>, &counters[t], count);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    int ms = static_cast<int>(
+        std::chrono::duration<double, std::milli>(end - start).count());
+    std::snprintf(buf, sizeof(buf), "%d", ms);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define COUNTERS_ROW(name, counter, count) \
+    std::cout << name;                     \
+    counters_test<counter>(1, count);      \
+    counters_test<counter>(2, count);      \
+    counters_test<counter>(4, count);      \
+    counters_test<counter>(8, count);      \
+    std::cout << std::endl;
+
+void aligned_allocator_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------ Run aligned allocation performance test ----------]"
+        << std::endl;
+    std::cout
+        << "[------------- per thread counters in one vector ---------------]"
+        << std::endl;
+    std::cout << "|       threads       |";
+    std::cout << std::setw(WIDE) << "1       |" << std::setw(WIDE)
+              << "2       |" << std::setw(WIDE) << "4       |"
+              << std::setw(WIDE) << "8       |" << std::endl;
+#if LARGER_TEST_DATA_ON
+    const size_t count = LEN3 _LL;
+#else
+    const size_t count = LEN3 _M;
+#endif
+    COUNTERS_ROW("|   packed counters   |", packed_counter, count);
+    COUNTERS_ROW("| alignas(64) counter |", padded_counter, count);
+    std::cout
+        << "[------------ End aligned allocation performance test ----------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace aligned_allocator_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,218 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_ALLOCATE_AT_LEAST_TEST_H_
+#define MYSTL_ALLOCATE_AT_LEAST_TEST_H_
+
+// unit tests that allocate_at_least hands out at least what was asked
+// and that vector uses the rest, and a reallocation count test for
+// allocate_at_least: how often a vector grows
+// while elements are appended one by one, when it only knows the capacity it
+// asked for and when the allocator reports what it really handed out
+
+#include <cstring>
+
+#include "../mystl/allocator.h"
+#include "../mystl/mmap_allocator.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace allocate_at_least_test {
+
+// forwards to Alloc but hides its allocate_at_least, so the vector records
+// exactly the capacity it asked for
+template <class T, class Alloc = mystl::allocator<T>>
+class exact_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef exact_allocator<U, typename Alloc::template rebind<U>::other>
+            other;
+    };
+
+    static T* allocate(size_t n) { return Alloc::allocate(n); }
+    static void deallocate(T* p, size_t n) { Alloc::deallocate(p, n); }
+    static T* reallocate(T* p, size_t old_n, size_t new_n) {
+        return reallocate_aux(
+            p, old_n, new_n,
+            typename mystl::allocator_traits<Alloc>::can_reallocate());
+    }
+
+   private:
+    static T* reallocate_aux(T* p, size_t old_n, size_t new_n,
+                             std::true_type) {
+        return Alloc::reallocate(p, old_n, new_n);
+    }
+    static T* reallocate_aux(T*, size_t, size_t, std::false_type) {
+        return nullptr;
+    }
+};
+
+template <class T, class A, class U, class B>
+bool operator==(const exact_allocator<T, A>&, const exact_allocator<U, B>&) {
+    return true;
+}
+
+template <class T, class A, class U, class B>
+bool operator!=(const exact_allocator<T, A>&, const exact_allocator<U, B>&) {
+    return false;
+}
+
+typedef mystl::vector<char, exact_allocator<char>> exact_char_vector;
+typedef mystl::vector<char> char_vector;
+typedef mystl::vector<int, exact_allocator<int, mystl::mmap_allocator<int>>>
+    exact_mmap_vector;
+typedef mystl::vector<int, mystl::mmap_allocator<int>> mmap_vector;
+
+// every byte of the count can be written, and the block goes back with it
+template <class Alloc>
+bool at_least_check(size_t n) {
+    Alloc a;
+    auto r = mystl::allocator_traits<Alloc>::allocate_at_least(a, n);
+    const bool ok = r.ptr != nullptr && r.count >= n;
+    if (ok) {
+        std::memset(r.ptr, 0x5a, r.count);
+        mystl::allocator_traits<Alloc>::deallocate(a, r.ptr, r.count);
+    }
+    return ok;
+}
+
+TEST(allocate_at_least_count_test) {
+    bool ok = true;
+    const size_t sizes[] = {1, 7, 24, 100, 4000, 100000};
+    for (size_t n : sizes) {
+        ok = ok && at_least_check<mystl::allocator<char>>(n);
+        ok = ok && at_least_check<mystl::mmap_allocator<char>>(n);
+    }
+    // past the mapping threshold, rounded to whole huge pages
+    ok = ok && at_least_check<mystl::mmap_allocator<char>>(3 << 20);
+    EXPECT_TRUE(ok);
+
+    // an allocator without allocate_at_least gets exactly n
+    exact_allocator<char> e;
+    auto r = mystl::allocator_traits<exact_allocator<char>>::allocate_at_least(
+        e, 13);
+    EXPECT_EQ(r.count, 13u);
+    e.deallocate(r.ptr, r.count);
+}
+
+// the capacity vector records is what it was handed, and filling it up
+// doesn't reallocate
+template <class Vector>
+void slack_check(size_t n) {
+    Vector v;
+    v.reserve(n);
+    EXPECT_GE(v.capacity(), n);
+    const auto data = v.data();
+    const size_t cap = v.capacity();
+    for (size_t i = 0; i < cap; ++i) {
+        v.push_back(static_cast<typename Vector::value_type>(i));
+    }
+    EXPECT_TRUE(v.data() == data);
+    EXPECT_EQ(v.capacity(), cap);
+    v.push_back(0);
+    EXPECT_GT(v.capacity(), cap);
+}
+
+TEST(allocate_at_least_slack_test) {
+    slack_check<char_vector>(10);
+    slack_check<char_vector>(1000);
+    slack_check<exact_char_vector>(10);
+    slack_check<mmap_vector>(1 << 20);
+}
+
+// number of times the capacity changes while n elements are appended
+template <class Vector>
+void grow_count_test(size_t n) {
+    Vector v;
+    size_t grows = 0;
+    auto cap = v.capacity();
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(typename Vector::value_type());
+        if (v.capacity() != cap) {
+            cap = v.capacity();
+            ++grows;
+        }
+    }
+    char buf[10];
+    std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(grows));
+    std::string t = buf;
+    t += "      |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+void allocate_at_least_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[----------- Run allocate_at_least reallocation test -----------]"
+        << std::endl;
+    std::cout
+        << "[------------- vector<char> push_back, allocator ---------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(100, 10000, LEN3 _M, WIDE);
+    std::cout << "|     exact size      |";
+    grow_count_test<exact_char_vector>(100);
+    grow_count_test<exact_char_vector>(10000);
+    grow_count_test<exact_char_vector>(LEN3 _M);
+    std::cout << "\n|  allocate_at_least  |";
+    grow_count_test<char_vector>(100);
+    grow_count_test<char_vector>(10000);
+    grow_count_test<char_vector>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------ vector<int> push_back, mmap_allocator ------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     exact size      |";
+    grow_count_test<exact_mmap_vector>(LEN1 _M);
+    grow_count_test<exact_mmap_vector>(LEN2 _M);
+    grow_count_test<exact_mmap_vector>(LEN3 _M);
+    std::cout << "\n|  allocate_at_least  |";
+    grow_count_test<mmap_vector>(LEN1 _M);
+    grow_count_test<mmap_vector>(LEN2 _M);
+    grow_count_test<mmap_vector>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[----------- End allocate_at_least reallocation test -----------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace allocate_at_least_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,211 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_BIT_VECTOR_TEST_H_
+#define MYSTL_BIT_VECTOR_TEST_H_
+
+// performance test for the bit packed vector<bool>: count, find, fill and an
+// unaligned copy over count bits, std::vector<bool> with std algorithms
+// against mystl::vector<bool> with mystl's word at a time overloads
+
+#include <algorithm>
+#include <vector>
+
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace bit_vector_test {
+
+typedef std::vector<bool> bool_ref;
+
+inline bool same_bits(const mystl::vector<bool>& v, const bool_ref& r) {
+    if (v.size() != r.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < r.size(); ++i) {
+        if (v[i] != r[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the word at a time algorithms against a vector of bools walked one by one,
+// on 300 random bits and ranges that start and end inside words
+TEST(bit_vector_algo_test) {
+    size_t seed = 1;
+    bool_ref ra, rb;
+    mystl::vector<bool> a, b;
+    for (int i = 0; i < 300; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        ra.push_back(((seed >> 40) & 1) != 0);
+        rb.push_back(((seed >> 41) & 3) == 0);
+        a.push_back(ra.back());
+        b.push_back(rb.back());
+    }
+    EXPECT_TRUE(same_bits(a, ra));
+
+    const size_t cuts[][2] = {{0, 300}, {3, 61}, {5, 200}, {64, 128},
+                              {70, 70}, {127, 299}};
+    bool counts = true;
+    bool finds = true;
+    for (const auto& c : cuts) {
+        for (int value = 0; value < 2; ++value) {
+            counts = counts &&
+                     mystl::count(a.begin() + c[0], a.begin() + c[1],
+                                  value != 0) ==
+                         static_cast<size_t>(std::count(
+                             ra.begin() + c[0], ra.begin() + c[1],
+                             value != 0));
+            finds = finds &&
+                    mystl::find(a.begin() + c[0], a.begin() + c[1],
+                                value != 0) - a.begin() ==
+                        std::find(ra.begin() + c[0], ra.begin() + c[1],
+                                  value != 0) - ra.begin();
+        }
+    }
+    EXPECT_TRUE(counts);
+    EXPECT_TRUE(finds);
+    EXPECT_EQ(a.count(), static_cast<size_t>(std::count(ra.begin(), ra.end(),
+                                                        true)));
+
+    // forward and backward copies, overlapping and to other offsets
+    mystl::copy(a.begin() + 5, a.begin() + 200, b.begin() + 77);
+    std::copy(ra.begin() + 5, ra.begin() + 200, rb.begin() + 77);
+    EXPECT_TRUE(same_bits(b, rb));
+    mystl::copy(b.begin() + 10, b.begin() + 290, b.begin() + 3);
+    std::copy(rb.begin() + 10, rb.begin() + 290, rb.begin() + 3);
+    EXPECT_TRUE(same_bits(b, rb));
+    mystl::copy_backward(b.begin() + 1, b.begin() + 250, b.begin() + 299);
+    std::copy_backward(rb.begin() + 1, rb.begin() + 250, rb.begin() + 299);
+    EXPECT_TRUE(same_bits(b, rb));
+    mystl::fill(b.begin() + 9, b.begin() + 140, true);
+    std::fill(rb.begin() + 9, rb.begin() + 140, true);
+    EXPECT_TRUE(same_bits(b, rb));
+
+    mystl::vector<bool> c(a);
+    bool_ref rc(ra);
+    c &= b;
+    for (size_t i = 0; i < rc.size(); ++i) {
+        rc[i] = rc[i] && rb[i];
+    }
+    EXPECT_TRUE(same_bits(c, rc));
+    c |= a;
+    for (size_t i = 0; i < rc.size(); ++i) {
+        rc[i] = rc[i] || ra[i];
+    }
+    EXPECT_TRUE(same_bits(c, rc));
+    c ^= b;
+    c.flip();
+    for (size_t i = 0; i < rc.size(); ++i) {
+        rc[i] = !(rc[i] != rb[i]);
+    }
+    EXPECT_TRUE(same_bits(c, rc));
+}
+
+// a and b hold count bits, the only set bit is the last one of a; stmt runs
+// reps times
+#define BIT_TEST(Vec, stmt, count, reps)                        \
+    do {                                                        \
+        char buf[10];                                           \
+        clock_t start, end;                                     \
+        Vec a(count, false), b(count + 64, false);              \
+        a.back() = true;                                        \
+        size_t sum = 0;                                         \
+        start = clock();                                        \
+        for (int rep = 0; rep < reps; ++rep) {                  \
+            stmt;                                               \
+        }                                                       \
+        end = clock();                                          \
+        volatile size_t sink = sum + b[count / 2];              \
+        (void)sink;                                             \
+        int n = static_cast<int>(static_cast<double>(end - start) /\
+                                 CLOCKS_PER_SEC * 1000);        \
+        std::snprintf(buf, sizeof(buf), "%d", n);               \
+        std::string t = buf;                                    \
+        t += "ms    |";                                         \
+        std::cout << std::setw(WIDE) << t;                      \
+    } while (0)
+
+#define COUNT_BITS(NS) sum += NS::count(a.begin(), a.end(), true)
+#define FIND_BIT(NS) sum += NS::find(a.begin(), a.end(), true) - a.begin()
+#define FILL_BITS(NS) NS::fill(b.begin(), b.end(), (rep & 1) != 0)
+#define COPY_BITS(NS) NS::copy(a.begin(), a.end(), b.begin() + 3)
+
+// one row per library over the three lengths
+#define BIT_ROWS(OP, reps, len1, len2, len3)                          \
+    std::cout << "| orders of magnitude |";                           \
+    TEST_LEN(len1, len2, len3, WIDE);                                 \
+    std::cout << "|  std::vector<bool>  |";                           \
+    BIT_TEST(std::vector<bool>, OP(std), len1, reps);                 \
+    BIT_TEST(std::vector<bool>, OP(std), len2, reps);                 \
+    BIT_TEST(std::vector<bool>, OP(std), len3, reps);                 \
+    std::cout << "\n|    vector<bool>     |";                         \
+    BIT_TEST(mystl::vector<bool>, OP(mystl), len1, reps);             \
+    BIT_TEST(mystl::vector<bool>, OP(mystl), len2, reps);             \
+    BIT_TEST(mystl::vector<bool>, OP(mystl), len3, reps);             \
+    std::cout << std::endl
+
+void bit_vector_test() {
+#if PERFORMANCE_TEST_ON
+    // every run repeats the algorithm 10 times; fill, a word-wide store,
+    // runs 100000 times over a tenth of the length
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run vector<bool> performance test ---------------]"
+        << std::endl;
+    std::cout
+        << "[------------------------- count -------------------------------]"
+        << std::endl;
+    BIT_ROWS(COUNT_BITS, 10, LEN1 _M, LEN2 _M, LEN3 _M);
+    std::cout
+        << "[------------------------- find --------------------------------]"
+        << std::endl;
+    BIT_ROWS(FIND_BIT, 10, LEN1 _M, LEN2 _M, LEN3 _M);
+    std::cout
+        << "[------------------------- fill --------------------------------]"
+        << std::endl;
+    BIT_ROWS(FILL_BITS, 100000, LEN1 _SS, LEN2 _SS, LEN3 _SS);
+    std::cout
+        << "[------------------ copy to bit offset 3 -----------------------]"
+        << std::endl;
+    BIT_ROWS(COPY_BITS, 10, LEN1 _M, LEN2 _M, LEN3 _M);
+    std::cout
+        << "[------------- End vector<bool> performance test ---------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace bit_vector_test
+}  // namespace test
+}  // namespace mystl
+#endif
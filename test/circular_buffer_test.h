@@ -0,0 +1,281 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_CIRCULAR_BUFFER_TEST_H_
+#define MYSTL_CIRCULAR_BUFFER_TEST_H_
+
+// unit tests for overwriting and the two pieces of a wrapped ring, and a
+// performance test for circular_buffer against deque with manual pop_front:
+// a history keeping the last 1024 values, copied out every 1024 pushes, and
+// a sliding window of 256 that is indexed at every step
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+
+#include "../mystl/circular_buffer.h"
+#include "../mystl/deque.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace circular_buffer_test {
+
+const size_t history_len = 1024;
+const size_t window_len = 256;
+
+inline void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// true if [first, last) holds from, from + 1, ..., in order
+template <class Iter>
+bool holds_run(Iter first, Iter last, int from) {
+    for (; first != last; ++first, ++from) {
+        if (*first != from) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// a full ring throws by default; in overwrite mode the oldest element goes
+TEST(circular_buffer_overwrite_test) {
+    mystl::circular_buffer<std::string> strict(3);
+    EXPECT_EQ(strict.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        strict.push_back(std::string(1, static_cast<char>('a' + i)));
+    }
+    EXPECT_TRUE(strict.full());
+    bool thrown = false;
+    try {
+        strict.push_back("e");
+    } catch (const std::length_error&) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    EXPECT_TRUE(strict.try_push_back("e") == nullptr);
+    EXPECT_TRUE(strict.front() == "a" && strict.back() == "d");
+
+    mystl::circular_buffer<int> ring(4, true);
+    for (int i = 0; i < 10; ++i) {
+        ring.push_back(i);
+    }
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_TRUE(holds_run(ring.begin(), ring.end(), 6));
+    ring.push_front(5);
+    EXPECT_TRUE(holds_run(ring.begin(), ring.end(), 5));
+    ring.push_back(ring.front());
+    EXPECT_TRUE(ring.front() == 6 && ring.back() == 5);
+}
+
+// at the wrap point the elements are array_one() then array_two()
+TEST(circular_buffer_array_test) {
+    mystl::circular_buffer<int> ring(8);
+    for (int i = 0; i < 8; ++i) {
+        ring.push_back(i);
+    }
+    EXPECT_EQ(ring.array_one().size(), 8u);
+    EXPECT_EQ(ring.array_two().size(), 0u);
+    ring.pop_front(5);
+    for (int i = 8; i < 11; ++i) {
+        ring.push_back(i);
+    }
+    // slots 5..7 hold 5, 6, 7 and slots 0..2 hold 8, 9, 10
+    auto one = ring.array_one();
+    auto two = ring.array_two();
+    EXPECT_EQ(one.size(), 3u);
+    EXPECT_EQ(two.size(), 3u);
+    EXPECT_TRUE(holds_run(one.data(), one.data() + one.size(), 5));
+    EXPECT_TRUE(holds_run(two.data(), two.data() + two.size(), 8));
+    EXPECT_TRUE(one.data() == &ring[0] && two.data() == &ring[3]);
+
+    ring.push_back(11);
+    ring.push_back(12);
+    EXPECT_EQ(ring.array_one().size(), 3u);
+    EXPECT_EQ(ring.array_two().size(), 5u);
+}
+
+// pop_front(n) drops the oldest n across the wrap point
+TEST(circular_buffer_pop_front_n_test) {
+    mystl::circular_buffer<std::string> ring(8);
+    for (int i = 0; i < 8; ++i) {
+        ring.push_back(std::string(1, static_cast<char>('a' + i)));
+    }
+    ring.pop_front(6);
+    for (int i = 8; i < 12; ++i) {
+        ring.push_back(std::string(1, static_cast<char>('a' + i)));
+    }
+    EXPECT_EQ(ring.array_one().size(), 2u);
+    ring.pop_front(3);
+    EXPECT_EQ(ring.size(), 3u);
+    EXPECT_TRUE(ring[0] == "j" && ring[2] == "l");
+    EXPECT_EQ(ring.array_two().size(), 0u);
+    ring.pop_front(0);
+    EXPECT_EQ(ring.size(), 3u);
+    ring.pop_front(3);
+    EXPECT_TRUE(ring.empty());
+    ring.push_back("m");
+    EXPECT_TRUE(ring.front() == "m");
+}
+
+inline void copy_out(const std::deque<int>& h, mystl::vector<int>& out) {
+    std::copy(h.begin(), h.end(), out.begin());
+}
+
+inline void copy_out(const mystl::deque<int>& h, mystl::vector<int>& out) {
+    mystl::copy(h.begin(), h.end(), out.begin());
+}
+
+// the deque is trimmed by hand
+template <class Con>
+void deque_history_test(size_t count) {
+    Con h;
+    mystl::vector<int> out(history_len);
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        if (h.size() == history_len) {
+            h.pop_front();
+        }
+        h.push_back(static_cast<int>(i));
+        if (i % history_len == 0) {
+            copy_out(h, out);
+            sum += out[0];
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+inline void ring_history_test(size_t count) {
+    mystl::circular_buffer<int> h(history_len, true);
+    mystl::vector<int> out(history_len);
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        h.push_back(static_cast<int>(i));
+        if (i % history_len == 0) {
+            auto one = h.array_one();
+            auto two = h.array_two();
+            std::memcpy(out.data(), one.data(), one.size_bytes());
+            std::memcpy(out.data() + one.size(), two.data(), two.size_bytes());
+            sum += out[0];
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+// the window slides over count elements
+template <class Con>
+void window_test(Con w, size_t count) {
+    for (size_t i = 0; i < window_len; ++i) {
+        w.push_back(static_cast<int>(i));
+    }
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        w.pop_front();
+        w.push_back(static_cast<int>(i));
+        sum += w[(i * 7) % window_len];
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+void circular_buffer_test() {
+#if PERFORMANCE_TEST_ON
+    typedef mystl::circular_buffer<int> ring;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[----------- Run circular_buffer performance test --------------]"
+        << std::endl;
+    std::cout
+        << "[---------------- history of 1024, copied out ------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::deque      |";
+    deque_history_test<std::deque<int>>(LEN1 _M);
+    deque_history_test<std::deque<int>>(LEN2 _M);
+    deque_history_test<std::deque<int>>(LEN3 _M);
+    std::cout << "\n|        deque        |";
+    deque_history_test<mystl::deque<int>>(LEN1 _M);
+    deque_history_test<mystl::deque<int>>(LEN2 _M);
+    deque_history_test<mystl::deque<int>>(LEN3 _M);
+    std::cout << "\n|   circular_buffer   |";
+    ring_history_test(LEN1 _M);
+    ring_history_test(LEN2 _M);
+    ring_history_test(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[---------------- sliding window of 256 ------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::deque      |";
+    window_test(std::deque<int>(), LEN1 _M);
+    window_test(std::deque<int>(), LEN2 _M);
+    window_test(std::deque<int>(), LEN3 _M);
+    std::cout << "\n|        deque        |";
+    window_test(mystl::deque<int>(), LEN1 _M);
+    window_test(mystl::deque<int>(), LEN2 _M);
+    window_test(mystl::deque<int>(), LEN3 _M);
+    std::cout << "\n|   circular_buffer   |";
+    window_test(ring(window_len), LEN1 _M);
+    window_test(ring(window_len), LEN2 _M);
+    window_test(ring(window_len), LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[----------- End circular_buffer performance test --------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace circular_buffer_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,380 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_COW_VECTOR_TEST_H_
+#define MYSTL_COW_VECTOR_TEST_H_
+
+// snapshot cost of cow_vector against copying a vector: a table of count
+// ints gets 0.1% of its elements changed and is then snapshotted, 10 times.
+// Prints the time for the 10 rounds and the memory each new snapshot adds.
+// Then the price of the first write after a snapshot, which copies the page
+// pointers and one page of chunk pointers, against writes to a table this
+// version already owns
+
+#include <vector>
+
+#include "../mystl/cow_vector.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace cow_vector_test {
+
+inline size_t& allocated_bytes() {
+    static size_t n = 0;
+    return n;
+}
+
+// forwards to mystl::allocator and keeps the number of bytes in use
+template <class T>
+class byte_counting_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef byte_counting_allocator<U> other;
+    };
+
+    byte_counting_allocator() noexcept {}
+    template <class U>
+    byte_counting_allocator(const byte_counting_allocator<U>&) noexcept {}
+
+    static T* allocate(size_t n) {
+        allocated_bytes() += n * sizeof(T);
+        return mystl::allocator<T>::allocate(n);
+    }
+    static void deallocate(T* p, size_t n) {
+        allocated_bytes() -= n * sizeof(T);
+        mystl::allocator<T>::deallocate(p, n);
+    }
+};
+
+template <class T, class U>
+bool operator==(const byte_counting_allocator<T>&,
+                const byte_counting_allocator<U>&) {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const byte_counting_allocator<T>&,
+                const byte_counting_allocator<U>&) {
+    return false;
+}
+
+typedef mystl::vector<int, byte_counting_allocator<int>> copy_table;
+typedef mystl::cow_vector<int, byte_counting_allocator<int>> cow_table;
+
+// bytes each of 3 arenas has handed out and not got back
+inline long* arena_bytes() {
+    static long n[3] = {0, 0, 0};
+    return n;
+}
+
+// a stateful allocator that doesn't propagate: allocators of different
+// arenas can't free each other's memory
+template <class T>
+class arena_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef arena_allocator<U> other;
+    };
+
+    explicit arena_allocator(int id = 0) noexcept : id_(id) {}
+    template <class U>
+    arena_allocator(const arena_allocator<U>& rhs) noexcept : id_(rhs.id()) {}
+
+    T* allocate(size_t n) {
+        arena_bytes()[id_] += static_cast<long>(n * sizeof(T));
+        return mystl::allocator<T>::allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        arena_bytes()[id_] -= static_cast<long>(n * sizeof(T));
+        mystl::allocator<T>::deallocate(p, n);
+    }
+
+    int id() const noexcept { return id_; }
+
+   private:
+    int id_;
+};
+
+template <class T, class U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.id() == rhs.id();
+}
+
+template <class T, class U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.id() != rhs.id();
+}
+
+// every arena must get back exactly what it handed out, so no chunk may be
+// shared between cow_vectors of different arenas
+TEST(cow_vector_allocator_test) {
+    typedef mystl::cow_vector<int, arena_allocator<int>> arena_table;
+    {
+        arena_table a(arena_allocator<int>(1));
+        arena_table b(arena_allocator<int>(2));
+        for (int i = 0; i < 3000; ++i) {
+            a.push_back(i);
+            b.push_back(-i);
+        }
+        arena_table c(a);
+        EXPECT_EQ(c.get_allocator().id(), 1);
+        EXPECT_TRUE(c == a);
+
+        b = a;
+        EXPECT_EQ(b.get_allocator().id(), 2);
+        EXPECT_TRUE(b == a);
+
+        b.set(0, 42);
+        b.swap(c);
+        EXPECT_EQ(b.get_allocator().id(), 2);
+        EXPECT_EQ(c.get_allocator().id(), 1);
+        EXPECT_EQ(b[0], 0);
+        EXPECT_EQ(c[0], 42);
+
+        arena_table d(arena_allocator<int>(2));
+        d = mystl::move(c);
+        EXPECT_EQ(d.get_allocator().id(), 2);
+        EXPECT_EQ(d[0], 42);
+        EXPECT_EQ(d.size(), 3000u);
+        EXPECT_TRUE(c.empty());
+    }
+    EXPECT_EQ(arena_bytes()[1], 0);
+    EXPECT_EQ(arena_bytes()[2], 0);
+}
+
+// a snapshot keeps what the table held when it was taken, whatever is done
+// to the table or to other snapshots afterwards
+TEST(cow_vector_snapshot_test) {
+    mystl::cow_vector<int> table;
+    std::vector<int> before;
+    for (int i = 0; i < 3000; ++i) {
+        table.push_back(i);
+        before.push_back(i);
+    }
+    auto snap = table.snapshot();
+
+    table.set(0, -1);
+    table.write(1500) = -2;
+    table.pop_back();
+    table.push_back(-3);
+    table.resize(5000, -4);
+    auto later = table.snapshot();
+    later.set(4999, -5);
+    later.clear();
+
+    std::vector<int> kept;
+    for (auto it = snap.begin(); it != snap.end(); ++it) {
+        kept.push_back(*it);
+    }
+    EXPECT_TRUE(kept == before);
+    EXPECT_EQ(table[0], -1);
+    EXPECT_EQ(table[1500], -2);
+    EXPECT_EQ(table[2999], -3);
+    EXPECT_EQ(table[4999], -4);
+    EXPECT_EQ(table.size(), 5000u);
+    // only the chunks written to stopped being shared with snap
+    EXPECT_TRUE(snap.shared_chunk_count() + 3 >= snap.chunk_count());
+}
+
+// growing and shrinking across pages of the chunk table leaves snapshots
+// alone, and a write unshares only its own page
+TEST(cow_vector_page_test) {
+    typedef mystl::cow_vector<int> table_type;
+    const size_t page = table_type::chunk_size * table_type::page_size;
+    table_type table;
+    for (size_t i = 0; i < 2 * page + 1; ++i) {
+        table.push_back(static_cast<int>(i));
+    }
+    auto snap = table.snapshot();
+    table.set(page + 1, -1);
+    EXPECT_EQ(snap.shared_chunk_count() + 1, snap.chunk_count());
+
+    auto shrunk = table.snapshot();
+    for (size_t i = 0; i < page + 2; ++i) {
+        shrunk.pop_back();
+    }
+    shrunk.push_back(-2);
+    for (size_t i = 0; i < page; ++i) {
+        table.pop_back();
+    }
+    EXPECT_EQ(snap.size(), 2 * page + 1);
+    EXPECT_EQ(snap[page + 1], static_cast<int>(page + 1));
+    EXPECT_EQ(snap[2 * page], static_cast<int>(2 * page));
+    EXPECT_EQ(table.size(), page + 1);
+    EXPECT_EQ(table[page], static_cast<int>(page));
+    EXPECT_EQ(shrunk.size(), page);
+    EXPECT_EQ(shrunk[page - 2], static_cast<int>(page - 2));
+    EXPECT_EQ(shrunk[page - 1], -2);
+    EXPECT_TRUE(snap != table);
+    table.clear();
+    EXPECT_EQ(snap[0], 0);
+}
+
+// empty versions compare equal whether or not they ever had a table
+TEST(cow_vector_empty_equal_test) {
+    mystl::cow_vector<int> a;
+    mystl::cow_vector<int> b;
+    b.push_back(1);
+    b.pop_back();
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(b == a);
+    EXPECT_TRUE(!(a != b));
+    b.push_back(1);
+    EXPECT_TRUE(a != b);
+}
+
+inline void write(copy_table& t, size_t i, int value) { t[i] = value; }
+inline void write(cow_table& t, size_t i, int value) { t.set(i, value); }
+
+// 10 rounds of count / 1000 writes and a snapshot, the last 4 snapshots
+// are kept alive as if readers still held them; prints the time, or the
+// bytes the writes and the snapshot of the last round added when
+// show_memory is set
+template <class Table>
+void snapshot_test(size_t count, bool show_memory) {
+    Table table(count, 1);
+    std::vector<Table> readers;
+    size_t seed = 1;
+    size_t added = 0;
+    clock_t start = clock();
+    for (int rep = 0; rep < 10; ++rep) {
+        const size_t before = allocated_bytes();
+        for (size_t i = 0; i < count / 1000; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            write(table, (seed >> 16) % count, rep);
+        }
+        readers.push_back(table);
+        added = allocated_bytes() - before;
+        if (readers.size() > 4) {
+            readers.erase(readers.begin());
+        }
+    }
+    clock_t end = clock();
+    char buf[16];
+    if (show_memory) {
+        std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(added / 1024));
+        std::string t = buf;
+        t += "KB    |";
+        std::cout << std::setw(WIDE) << t;
+        return;
+    }
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// 1000 single writes to a cow_vector of count ints; with snapshot set,
+// each write is the first after a snapshot and copies the page pointers,
+// one page and one chunk
+void first_write_test(size_t count, bool snapshot) {
+    cow_table table(count, 1);
+    cow_table reader;
+    size_t seed = 1;
+    clock_t start = clock();
+    for (int rep = 0; rep < 1000; ++rep) {
+        if (snapshot) {
+            reader = table.snapshot();
+        }
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        table.set((seed >> 16) % count, rep);
+    }
+    clock_t end = clock();
+    char buf[16];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+void cow_vector_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run cow_vector performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[------------ 0.1% written, then snapshot, 10 times ------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|    vector (time)    |";
+    snapshot_test<copy_table>(LEN1 _M, false);
+    snapshot_test<copy_table>(LEN2 _M, false);
+    snapshot_test<copy_table>(LEN3 _M, false);
+    std::cout << "\n|  cow_vector (time)  |";
+    snapshot_test<cow_table>(LEN1 _M, false);
+    snapshot_test<cow_table>(LEN2 _M, false);
+    snapshot_test<cow_table>(LEN3 _M, false);
+    std::cout << "\n|   vector (memory)   |";
+    snapshot_test<copy_table>(LEN1 _M, true);
+    snapshot_test<copy_table>(LEN2 _M, true);
+    snapshot_test<copy_table>(LEN3 _M, true);
+    std::cout << "\n| cow_vector (memory) |";
+    snapshot_test<cow_table>(LEN1 _M, true);
+    snapshot_test<cow_table>(LEN2 _M, true);
+    snapshot_test<cow_table>(LEN3 _M, true);
+    std::cout << std::endl;
+    std::cout
+        << "[---------------- 1000 writes, cow_vector only -----------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "| snapshot + 1 write  |";
+    first_write_test(LEN1 _M, true);
+    first_write_test(LEN2 _M, true);
+    first_write_test(LEN3 _M, true);
+    std::cout << "\n| write, no snapshot  |";
+    first_write_test(LEN1 _M, false);
+    first_write_test(LEN2 _M, false);
+    first_write_test(LEN3 _M, false);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- End cow_vector performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace cow_vector_test
+}  // namespace test
+}  // namespace mystl
+#endif
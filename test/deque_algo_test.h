@@ -0,0 +1,293 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_DEQUE_ALGO_TEST_H_
+#define MYSTL_DEQUE_ALGO_TEST_H_
+
+// unit tests against a vector model across block boundaries, and a
+// performance test for the segment-aware algorithms on deque iterators:
+// copy, fill, find, for_each, accumulate and equal over count ints,
+// std::deque with std algorithms, then mystl's deque and vector
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../mystl/deque.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace deque_algo_test {
+
+// blocks of 8, the first one only partly used, so ranges start and end at
+// every offset within a block
+typedef mystl::deque<int, mystl::allocator<int>, 8> small_deque;
+
+inline small_deque make_deque(int n) {
+    small_deque d;
+    for (int i = 0; i < 3; ++i) {
+        d.push_back(i);
+    }
+    for (int i = -1; i >= -5; --i) {
+        d.push_front(i);
+    }
+    for (int i = 3; d.size() < static_cast<size_t>(n); ++i) {
+        d.push_back(i);
+    }
+    return d;
+}
+
+template <class Con>
+std::vector<int> model_of(const Con& c) {
+    std::vector<int> v;
+    for (size_t i = 0; i < c.size(); ++i) {
+        v.push_back(c[i]);
+    }
+    return v;
+}
+
+// copy in, out, and within a deque, to the left over itself too
+TEST(deque_algo_copy_test) {
+    const int n = 60;
+    const std::vector<int> src = [] {
+        std::vector<int> v;
+        for (int i = 0; i < 40; ++i) {
+            v.push_back(1000 + i);
+        }
+        return v;
+    }();
+    bool ok = true;
+    for (int from = 0; from < 20; ++from) {
+        for (int len = 0; len < 40 && from + len <= n; len += 3) {
+            small_deque d = make_deque(n);
+            std::vector<int> m = model_of(d);
+            auto r = mystl::copy(src.data(), src.data() + len, d.begin() + from);
+            std::copy(src.begin(), src.begin() + len, m.begin() + from);
+            ok = ok && r == d.begin() + from + len && model_of(d) == m;
+
+            std::vector<int> out(len);
+            int* e = mystl::copy(d.begin() + from, d.begin() + from + len,
+                                 out.data());
+            ok = ok && e == out.data() + len &&
+                 std::equal(out.begin(), out.end(), m.begin() + from);
+
+            // the source starts to the right of the destination
+            const int to = from / 2;
+            const int k = mystl::min(len, n - from);
+            auto q = mystl::copy(d.begin() + from, d.begin() + from + k,
+                                 d.begin() + to);
+            std::copy(m.begin() + from, m.begin() + from + k, m.begin() + to);
+            ok = ok && q == d.begin() + to + k && model_of(d) == m;
+        }
+    }
+    EXPECT_TRUE(ok);
+
+    // blocks of different sizes on both sides
+    small_deque a = make_deque(50);
+    mystl::deque<int, mystl::allocator<int>, 5> b(53, 0);
+    b.pop_front();
+    mystl::copy(a.begin() + 3, a.end(), b.begin() + 2);
+    bool same = true;
+    for (size_t i = 3; i < a.size(); ++i) {
+        same = same && b[i - 1] == a[i];
+    }
+    EXPECT_TRUE(same);
+    EXPECT_EQ(b[1], 0);
+    EXPECT_EQ(b[48], a[49]);
+    EXPECT_EQ(b[49], 0);
+
+    mystl::deque<std::string, mystl::allocator<std::string>, 4> s(10, "x");
+    const std::string words[] = {"a", "b", "c", "d", "e", "f"};
+    mystl::copy(words, words + 6, s.begin() + 3);
+    mystl::copy(s.begin() + 3, s.begin() + 9, s.begin() + 1);
+    EXPECT_TRUE(s[0] == "x" && s[1] == "a" && s[6] == "f" && s[9] == "x");
+}
+
+TEST(deque_algo_fill_find_test) {
+    const int n = 45;
+    bool ok = true;
+    for (int from = 0; from < n; from += 2) {
+        for (int to = from; to <= n; to += 3) {
+            small_deque d = make_deque(n);
+            std::vector<int> m = model_of(d);
+            mystl::fill(d.begin() + from, d.begin() + to, 77);
+            std::fill(m.begin() + from, m.begin() + to, 77);
+            ok = ok && model_of(d) == m;
+        }
+    }
+    EXPECT_TRUE(ok);
+
+    small_deque d = make_deque(n);
+    const std::vector<int> m = model_of(d);
+    for (int i = 0; i < n; ++i) {
+        ok = ok && mystl::find(d.begin(), d.end(), m[i]) == d.begin() + i;
+        ok = ok && mystl::find(d.begin() + i, d.end(), m[i]) == d.begin() + i;
+        ok = ok && mystl::find(d.begin(), d.begin() + i, m[i]) == d.begin() + i;
+    }
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(mystl::find(d.begin(), d.end(), 12345) == d.end());
+    const small_deque& c = d;
+    EXPECT_TRUE(mystl::find(c.begin(), c.end(), m[20]) == c.begin() + 20);
+
+    EXPECT_EQ(mystl::accumulate(d.begin() + 3, d.end() - 4, 0),
+              std::accumulate(m.begin() + 3, m.end() - 4, 0));
+    int calls = 0;
+    mystl::for_each(d.begin() + 1, d.end(), [&calls](int) { ++calls; });
+    EXPECT_EQ(calls, n - 1);
+}
+
+// a difference right before or after any block end is found
+TEST(deque_algo_equal_test) {
+    const int n = 40;
+    small_deque a = make_deque(n);
+    mystl::deque<int, mystl::allocator<int>, 5> b(a.begin(), a.end());
+    const std::vector<int> m = model_of(a);
+    EXPECT_TRUE(mystl::equal(a.begin(), a.end(), m.data()));
+    EXPECT_TRUE(mystl::equal(a.begin(), a.end(), b.begin()));
+    EXPECT_TRUE(mystl::equal(a.begin() + 7, a.end(), b.begin() + 7));
+    bool ok = true;
+    for (int i = 0; i < n; ++i) {
+        b[i] += 1;
+        std::vector<int> w = m;
+        w[i] += 1;
+        ok = ok && !mystl::equal(a.begin(), a.end(), b.begin());
+        ok = ok && !mystl::equal(a.begin(), a.end(), w.data());
+        ok = ok && mystl::equal(a.begin(), a.begin() + i, b.begin());
+        ok = ok && mystl::equal(a.begin() + i + 1, a.end(), b.begin() + i + 1);
+        b[i] -= 1;
+    }
+    EXPECT_TRUE(ok);
+}
+
+// a and b hold count ints, the only non zero one is the last of a
+#define DEQUE_ALGO_TEST(Con, stmt, count)                       \
+    do {                                                        \
+        char buf[10];                                           \
+        clock_t start, end;                                     \
+        Con a(count, 0), b(count, 0);                           \
+        a.back() = 1;                                           \
+        size_t sum = 0;                                         \
+        start = clock();                                        \
+        for (int rep = 0; rep < 10; ++rep) {                    \
+            stmt;                                               \
+        }                                                       \
+        end = clock();                                          \
+        volatile size_t sink = sum + b[count / 2];              \
+        (void)sink;                                             \
+        int n = static_cast<int>(static_cast<double>(end - start) /\
+                                 CLOCKS_PER_SEC * 1000);        \
+        std::snprintf(buf, sizeof(buf), "%d", n);               \
+        std::string t = buf;                                    \
+        t += "ms    |";                                         \
+        std::cout << std::setw(WIDE) << t;                      \
+    } while (0)
+
+#define DEQUE_COPY(NS) NS::copy(a.begin(), a.end(), b.begin())
+#define DEQUE_FILL(NS) NS::fill(b.begin(), b.end(), rep)
+#define DEQUE_FIND(NS) sum += NS::find(a.begin(), a.end(), 1) - a.begin()
+#define DEQUE_FOR_EACH(NS) \
+    NS::for_each(a.begin(), a.end(), [&sum](int x) { sum += x; })
+#define DEQUE_ACCUMULATE(NS) \
+    sum += NS::accumulate(a.begin(), a.end(), static_cast<size_t>(0))
+#define DEQUE_EQUAL(NS) sum += NS::equal(a.begin(), a.end(), b.begin())
+
+// one row per container over the three lengths
+#define DEQUE_ALGO_ROWS(OP)                                           \
+    std::cout << "|   std::deque<int>   |";                           \
+    DEQUE_ALGO_TEST(std::deque<int>, OP(std), LEN1 _M);               \
+    DEQUE_ALGO_TEST(std::deque<int>, OP(std), LEN2 _M);               \
+    DEQUE_ALGO_TEST(std::deque<int>, OP(std), LEN3 _M);               \
+    std::cout << "\n|     deque<int>      |";                         \
+    DEQUE_ALGO_TEST(mystl::deque<int>, OP(mystl), LEN1 _M);           \
+    DEQUE_ALGO_TEST(mystl::deque<int>, OP(mystl), LEN2 _M);           \
+    DEQUE_ALGO_TEST(mystl::deque<int>, OP(mystl), LEN3 _M);           \
+    std::cout << "\n|     vector<int>     |";                         \
+    DEQUE_ALGO_TEST(mystl::vector<int>, OP(mystl), LEN1 _M);          \
+    DEQUE_ALGO_TEST(mystl::vector<int>, OP(mystl), LEN2 _M);          \
+    DEQUE_ALGO_TEST(mystl::vector<int>, OP(mystl), LEN3 _M);          \
+    std::cout << std::endl
+
+void deque_algo_test() {
+#if PERFORMANCE_TEST_ON
+    // every run repeats the algorithm 10 times
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------ Run deque algorithm performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[------------------------- copy --------------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    DEQUE_ALGO_ROWS(DEQUE_COPY);
+    std::cout
+        << "[------------------------- fill --------------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    DEQUE_ALGO_ROWS(DEQUE_FILL);
+    std::cout
+        << "[------------------------- find --------------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    DEQUE_ALGO_ROWS(DEQUE_FIND);
+    std::cout
+        << "[----------------------- for_each ------------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    DEQUE_ALGO_ROWS(DEQUE_FOR_EACH);
+    std::cout
+        << "[---------------------- accumulate -----------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    DEQUE_ALGO_ROWS(DEQUE_ACCUMULATE);
+    std::cout
+        << "[------------------------- equal -------------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    DEQUE_ALGO_ROWS(DEQUE_EQUAL);
+    std::cout
+        << "[------------ End deque algorithm performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace deque_algo_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,261 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_DEQUE_BLOCK_TEST_H_
+#define MYSTL_DEQUE_BLOCK_TEST_H_
+
+// unit tests for moved-from deques and the spare block cache, and a
+// performance test for the deque block size and spare block cache: a FIFO
+// of 64 byte items whose depth swings between 0 and 12, so the front and
+// the back keep crossing block boundaries
+
+#include <deque>
+
+#include "../mystl/deque.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace deque_block_test {
+
+struct item {
+    int v[16];
+};
+
+inline void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// blocks of T in use; the map, allocated through a rebound copy, is not
+// counted
+template <class T>
+long& live_blocks() {
+    static long n = 0;
+    return n;
+}
+
+template <class T>
+class block_counting_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef block_counting_allocator<U> other;
+    };
+
+    block_counting_allocator() noexcept {}
+    template <class U>
+    block_counting_allocator(const block_counting_allocator<U>&) noexcept {}
+
+    static T* allocate(size_t n) {
+        ++live_blocks<T>();
+        return mystl::allocator<T>::allocate(n);
+    }
+    static void deallocate(T* p, size_t n) {
+        --live_blocks<T>();
+        mystl::allocator<T>::deallocate(p, n);
+    }
+};
+
+template <class T, class U>
+bool operator==(const block_counting_allocator<T>&,
+                const block_counting_allocator<U>&) {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const block_counting_allocator<T>&,
+                const block_counting_allocator<U>&) {
+    return false;
+}
+
+// a FIFO crossing block boundaries over and over reuses its freed blocks
+// instead of allocating, and shrink_to_fit hands the spares back
+TEST(deque_spare_block_test) {
+    typedef mystl::deque<int, block_counting_allocator<int>, 16> fifo;
+    {
+        fifo q;
+        int pushed = 0;
+        int popped = 0;
+        bool in_order = true;
+        long peak = 0;
+        for (int round = 0; round < 2000; ++round) {
+            const int burst = 1 + round % 12;
+            for (int j = 0; j < burst; ++j) {
+                q.push_back(pushed++);
+            }
+            for (int j = 0; j < burst; ++j) {
+                in_order = in_order && q.front() == popped++;
+                q.pop_front();
+            }
+            if (round == 100) {
+                peak = live_blocks<int>();
+            }
+        }
+        EXPECT_TRUE(in_order);
+        EXPECT_TRUE(q.empty());
+        // no block was allocated after the warm up
+        EXPECT_EQ(live_blocks<int>(), peak);
+        EXPECT_LE(peak, 1 + DEQUE_SPARE_BLOCKS + 1);
+
+        q.shrink_to_fit();
+        EXPECT_EQ(live_blocks<int>(), 1);
+        q.push_back(1);
+        q.pop_front();
+        EXPECT_EQ(q.size(), 0u);
+    }
+    EXPECT_EQ(live_blocks<int>(), 0);
+
+    // the same at the front
+    {
+        fifo q;
+        for (int round = 0; round < 2000; ++round) {
+            for (int j = 0; j < 20; ++j) {
+                q.push_front(j);
+            }
+            for (int j = 0; j < 20; ++j) {
+                q.pop_back();
+            }
+        }
+        EXPECT_LE(live_blocks<int>(), 2 + DEQUE_SPARE_BLOCKS + 1);
+    }
+    EXPECT_EQ(live_blocks<int>(), 0);
+}
+
+// a moved-from deque is empty and takes new elements; the one it was moved
+// into keeps its own
+TEST(deque_moved_from_test) {
+    mystl::deque<int> c;
+    for (int i = 0; i < 3000; ++i) {
+        c.push_back(i);
+    }
+    mystl::deque<int> d(mystl::move(c));
+    EXPECT_EQ(c.size(), 0u);
+    EXPECT_TRUE(c.empty());
+    c.clear();
+    c.shrink_to_fit();
+    EXPECT_EQ(d.size(), 3000u);
+    EXPECT_EQ(d[0], 0);
+    EXPECT_EQ(d[2999], 2999);
+
+    c.push_back(1);
+    c.push_front(0);
+    c.emplace_back(2);
+    EXPECT_EQ(c.size(), 3u);
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[2], 2);
+
+    mystl::deque<int> e(mystl::move(c), mystl::allocator<int>());
+    c = d;
+    EXPECT_EQ(c.size(), 3000u);
+    EXPECT_EQ(c[1500], 1500);
+    EXPECT_EQ(e.size(), 3u);
+
+    mystl::deque<int> f;
+    f = mystl::move(e);
+    e.insert(e.end(), 5, 7);
+    EXPECT_EQ(e.size(), 5u);
+    EXPECT_EQ(e.back(), 7);
+    EXPECT_EQ(f.back(), 2);
+
+    mystl::deque<int> g(mystl::move(f));
+    f.assign({4, 5, 6});
+    f.resize(10);
+    EXPECT_EQ(f.size(), 10u);
+    EXPECT_EQ(f[2], 6);
+    EXPECT_EQ(g.size(), 3u);
+}
+
+// count pushes and as many pops, in bursts of up to 12
+template <class Con>
+void fifo_test(size_t count) {
+    Con q;
+    item x = item();
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count;) {
+        const size_t burst = 1 + i % 12;
+        for (size_t j = 0; j < burst; ++j) {
+            x.v[0] = static_cast<int>(i + j);
+            q.push_back(x);
+        }
+        for (size_t j = 0; j < burst; ++j) {
+            sum += q.front().v[0];
+            q.pop_front();
+        }
+        i += burst;
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+void deque_block_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------ Run deque block performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[----------------- fifo, bursts of 1 to 12 ---------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|  std::deque<item>   |";
+    fifo_test<std::deque<item>>(LEN1 _M);
+    fifo_test<std::deque<item>>(LEN2 _M);
+    fifo_test<std::deque<item>>(LEN3 _M);
+    std::cout << "\n|   deque<item, 8>    |";
+    fifo_test<mystl::deque<item, mystl::allocator<item>, 8>>(LEN1 _M);
+    fifo_test<mystl::deque<item, mystl::allocator<item>, 8>>(LEN2 _M);
+    fifo_test<mystl::deque<item, mystl::allocator<item>, 8>>(LEN3 _M);
+    std::cout << "\n|     deque<item>     |";
+    fifo_test<mystl::deque<item>>(LEN1 _M);
+    fifo_test<mystl::deque<item>>(LEN2 _M);
+    fifo_test<mystl::deque<item>>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------ End deque block performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace deque_block_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,279 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_DEVECTOR_TEST_H_
+#define MYSTL_DEVECTOR_TEST_H_
+
+// unit tests for the free room at both ends, and a performance test for
+// devector against deque: a FIFO queue that keeps
+// about a thousand elements in flight, and a sliding window that is indexed
+// at every step and summed whenever it has moved by its own length
+
+#include <deque>
+#include <string>
+
+#include "../mystl/deque.h"
+#include "../mystl/devector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace devector_test {
+
+const size_t queue_depth = 1024;
+const size_t window_len = 256;
+
+inline void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// true if d holds first, first + 1, ..., first + n - 1
+template <class Devector>
+bool holds_run(const Devector& d, int first, size_t n) {
+    if (d.size() != n) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (d[i] != first + static_cast<int>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the element for i, as an int or as a string too long for the SSO
+inline int make_value(int i, int) { return i; }
+
+inline std::string make_value(int i, const std::string&) {
+    return std::string(24, '#') + std::to_string(i);
+}
+
+// a short sequence drifting to the front runs out of front room, is
+// recentred in place and keeps going without reallocating
+template <class T>
+void front_gap_check() {
+    mystl::devector<T> d;
+    d.reserve(64);
+    const size_t cap = d.capacity();
+    for (int i = 0; i < 8; ++i) {
+        d.push_back(make_value(i, T()));
+    }
+    int first = 0;
+    bool recentred = false;
+    for (int step = 0; step < 200; ++step) {
+        const size_t before = d.front_free();
+        d.push_front(make_value(--first, T()));
+        d.pop_back();
+        if (before == 0) {
+            recentred = true;
+            EXPECT_GT(d.front_free(), 0u);
+            EXPECT_GT(d.back_free(), 0u);
+        }
+    }
+    EXPECT_TRUE(recentred);
+    EXPECT_EQ(d.capacity(), cap);
+    EXPECT_EQ(d.size(), 8u);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_TRUE(d[i] == make_value(first + static_cast<int>(i), T()));
+    }
+
+    // the other way round through the back
+    for (int step = 0; step < 200; ++step) {
+        d.push_back(make_value(first + 8, T()));
+        d.pop_front();
+        ++first;
+    }
+    EXPECT_EQ(d.capacity(), cap);
+    EXPECT_TRUE(d.front() == make_value(first, T()));
+    EXPECT_TRUE(d.back() == make_value(first + 7, T()));
+}
+
+TEST(devector_front_gap_test) {
+    front_gap_check<int>();
+    front_gap_check<std::string>();
+}
+
+// the empty devector starts over in the middle, and a fuller one grows
+TEST(devector_pop_front_test) {
+    mystl::devector<int> d;
+    d.reserve(32);
+    for (int i = 0; i < 6; ++i) {
+        d.push_front(5 - i);
+    }
+    EXPECT_TRUE(holds_run(d, 0, 6));
+    while (!d.empty()) {
+        d.pop_front();
+    }
+    const size_t gap = d.front_free() > d.back_free()
+                           ? d.front_free() - d.back_free()
+                           : d.back_free() - d.front_free();
+    EXPECT_LE(gap, 1u);
+
+    const size_t cap = d.capacity();
+    for (int i = 0; i < static_cast<int>(cap) + 5; ++i) {
+        d.push_front(-i);
+    }
+    EXPECT_GT(d.capacity(), cap);
+    EXPECT_TRUE(holds_run(d, -static_cast<int>(cap) - 4, cap + 5));
+}
+
+// reserve puts the elements in the middle of the new buffer
+TEST(devector_reserve_recentre_test) {
+    mystl::devector<int> d;
+    for (int i = 0; i < 10; ++i) {
+        d.push_back(i);
+    }
+    d.reserve(200);
+    EXPECT_GE(d.capacity(), 200u);
+    EXPECT_TRUE(holds_run(d, 0, 10));
+    EXPECT_EQ(d.front_free() + d.size() + d.back_free(), d.capacity());
+    const size_t gap = d.front_free() > d.back_free()
+                           ? d.front_free() - d.back_free()
+                           : d.back_free() - d.front_free();
+    EXPECT_LE(gap, 2u);
+
+    // room asked for at one end goes to that end
+    d.reserve_front(300);
+    EXPECT_GE(d.front_free(), 300u);
+    EXPECT_TRUE(holds_run(d, 0, 10));
+    const int* data = d.data();
+    for (int i = 0; i < 300; ++i) {
+        d.push_front(-1 - i);
+    }
+    EXPECT_EQ(d.data(), data - 300);
+    EXPECT_TRUE(holds_run(d, -300, 310));
+}
+
+// count elements pass through the queue
+template <class Con>
+void queue_test(size_t count) {
+    Con q;
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        q.push_back(static_cast<int>(i));
+        if (q.size() > queue_depth) {
+            sum += q.front();
+            q.pop_front();
+        }
+    }
+    while (!q.empty()) {
+        sum += q.front();
+        q.pop_front();
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+// the window slides over count elements
+template <class Con>
+void window_test(size_t count) {
+    Con w;
+    for (size_t i = 0; i < window_len; ++i) {
+        w.push_back(static_cast<int>(i));
+    }
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        w.pop_front();
+        w.push_back(static_cast<int>(i));
+        sum += w[(i * 7) % window_len];
+        if (i % window_len == 0) {
+            for (auto it = w.begin(); it != w.end(); ++it) {
+                sum += *it;
+            }
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+void devector_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[-------------- Run devector performance test ------------------]"
+        << std::endl;
+    std::cout
+        << "[------------------ queue, 1024 in flight ----------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::deque      |";
+    queue_test<std::deque<int>>(LEN1 _M);
+    queue_test<std::deque<int>>(LEN2 _M);
+    queue_test<std::deque<int>>(LEN3 _M);
+    std::cout << "\n|        deque        |";
+    queue_test<mystl::deque<int>>(LEN1 _M);
+    queue_test<mystl::deque<int>>(LEN2 _M);
+    queue_test<mystl::deque<int>>(LEN3 _M);
+    std::cout << "\n|      devector       |";
+    queue_test<mystl::devector<int>>(LEN1 _M);
+    queue_test<mystl::devector<int>>(LEN2 _M);
+    queue_test<mystl::devector<int>>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[---------------- sliding window of 256 ------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::deque      |";
+    window_test<std::deque<int>>(LEN1 _M);
+    window_test<std::deque<int>>(LEN2 _M);
+    window_test<std::deque<int>>(LEN3 _M);
+    std::cout << "\n|        deque        |";
+    window_test<mystl::deque<int>>(LEN1 _M);
+    window_test<mystl::deque<int>>(LEN2 _M);
+    window_test<mystl::deque<int>>(LEN3 _M);
+    std::cout << "\n|      devector       |";
+    window_test<mystl::devector<int>>(LEN1 _M);
+    window_test<mystl::devector<int>>(LEN2 _M);
+    window_test<mystl::devector<int>>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[-------------- End devector performance test ------------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace devector_test
+}  // namespace test
+}  // namespace mystl
+#endif
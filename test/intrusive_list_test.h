@@ -0,0 +1,330 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_INTRUSIVE_LIST_TEST_H_
+#define MYSTL_INTRUSIVE_LIST_TEST_H_
+
+// unit tests for splice, auto-unlink and member hooks, and a performance
+// test for intrusive_list against std::list and list of pointers to a pool
+// of 64K objects owned by a vector: count links and unlinks through a
+// window of half the pool, walks over the whole pool summing a member, and
+// LRU touches moving a random object to the front
+
+#include <list>
+#include <vector>
+
+#include "../mystl/intrusive_list.h"
+#include "../mystl/list.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace intrusive_list_test {
+
+const size_t pool_len = 65536;
+
+struct item : public mystl::list_base_hook<> {
+    int key;
+};
+
+typedef mystl::intrusive_list<item> item_list;
+
+inline void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+inline size_t next_rand(size_t& seed) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed >> 33;
+}
+
+inline void make_pool(std::vector<item>& pool) {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        pool[i].key = static_cast<int>(i);
+    }
+}
+
+template <class List>
+std::vector<int> keys(const List& l) {
+    std::vector<int> v;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+        v.push_back(it->key);
+    }
+    return v;
+}
+
+template <class Iter>
+Iter advanced(Iter it, int n) {
+    while (n-- > 0) {
+        ++it;
+    }
+    return it;
+}
+
+// a range spliced within its own list moves, and the size stays
+TEST(intrusive_list_splice_test) {
+    const std::vector<int> expect = {3, 4, 5, 0, 1, 2, 6, 7, 8, 9};
+    std::vector<item> pool(10);
+    make_pool(pool);
+    item_list l(pool.begin(), pool.end());
+    l.splice(l.begin(), l, advanced(l.begin(), 3), advanced(l.begin(), 6));
+    EXPECT_TRUE(keys(l) == expect);
+    EXPECT_EQ(l.size(), 10u);
+    l.splice(advanced(l.begin(), 6), l, l.begin(), advanced(l.begin(), 3));
+    EXPECT_TRUE(keys(l) == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    l.clear();
+
+    struct value {
+        int key;
+    };
+    mystl::list<value> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(value{i});
+    }
+    v.splice(v.begin(), v, advanced(v.begin(), 3), advanced(v.begin(), 6));
+    EXPECT_TRUE(keys(v) == expect);
+    EXPECT_EQ(v.size(), 10u);
+}
+
+// ranges, single elements and whole lists moved between two lists
+TEST(intrusive_list_splice_across_test) {
+    std::vector<item> pool(10);
+    make_pool(pool);
+    item_list a(pool.begin(), pool.begin() + 5);
+    item_list b(pool.begin() + 5, pool.end());
+    a.splice(advanced(a.begin(), 2), b, advanced(b.begin(), 1),
+             advanced(b.begin(), 4));
+    EXPECT_TRUE(keys(a) == std::vector<int>({0, 1, 6, 7, 8, 2, 3, 4}));
+    EXPECT_TRUE(keys(b) == std::vector<int>({5, 9}));
+    EXPECT_EQ(a.size(), 8u);
+    EXPECT_EQ(b.size(), 2u);
+    a.splice(a.end(), b, b.begin());
+    a.splice(a.begin(), b);
+    EXPECT_TRUE(keys(a) == std::vector<int>({9, 0, 1, 6, 7, 8, 2, 3, 4, 5}));
+    EXPECT_EQ(a.size(), 10u);
+    EXPECT_TRUE(b.empty());
+    a.clear();
+}
+
+struct watched : public mystl::list_base_hook<default_hook_tag, true> {
+    int key;
+    mystl::list_member_hook<> by_key;
+};
+
+// an auto-unlink element leaves its list when it dies or unlinks itself,
+// and a member hook links the same objects into a second list
+TEST(intrusive_list_auto_unlink_test) {
+    typedef mystl::intrusive_list<watched> watch_list;
+    typedef mystl::intrusive_list<
+        watched, mystl::member_hook<watched, mystl::list_member_hook<>,
+                                    &watched::by_key>>
+        key_list;
+    std::vector<watched> pool(4);
+    watch_list l;
+    key_list k;
+    for (size_t i = 0; i < pool.size(); ++i) {
+        pool[i].key = static_cast<int>(i);
+        l.push_back(pool[i]);
+        k.push_front(pool[i]);
+    }
+    {
+        watched temp;
+        temp.key = 9;
+        l.push_back(temp);
+        EXPECT_EQ(l.size(), 5u);
+    }
+    EXPECT_EQ(l.size(), 4u);
+    pool[1].unlink();
+    EXPECT_TRUE(!pool[1].is_linked());
+    EXPECT_TRUE(keys(l) == std::vector<int>({0, 2, 3}));
+    EXPECT_TRUE(keys(k) == std::vector<int>({3, 2, 1, 0}));
+    k.clear();
+    l.clear();
+}
+
+// an object goes back into the list only after it left it
+template <class List>
+void link_test(size_t count) {
+    std::vector<item> pool(pool_len);
+    List l;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        l.push_back(&pool[i & (pool_len - 1)]);
+        if (l.size() > pool_len / 2) {
+            l.pop_front();
+        }
+    }
+    clock_t end = clock();
+    print_time(start, end);
+}
+
+inline void intrusive_link_test(size_t count) {
+    std::vector<item> pool(pool_len);
+    item_list l;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        l.push_back(pool[i & (pool_len - 1)]);
+        if (l.size() > pool_len / 2) {
+            l.pop_front();
+        }
+    }
+    clock_t end = clock();
+    l.clear();
+    print_time(start, end);
+}
+
+template <class List>
+void walk_test(size_t count) {
+    std::vector<item> pool(pool_len);
+    make_pool(pool);
+    List l;
+    for (size_t i = 0; i < pool_len; ++i) {
+        l.push_back(&pool[i]);
+    }
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t rep = 0; rep < count / pool_len; ++rep) {
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            sum += (*it)->key;
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+inline void intrusive_walk_test(size_t count) {
+    std::vector<item> pool(pool_len);
+    make_pool(pool);
+    item_list l(pool.begin(), pool.end());
+    long long sum = 0;
+    clock_t start = clock();
+    for (size_t rep = 0; rep < count / pool_len; ++rep) {
+        for (auto it = l.begin(); it != l.end(); ++it) {
+            sum += it->key;
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    l.clear();
+    print_time(start, end);
+}
+
+// the position of every object is kept on the side
+template <class List>
+void lru_test(size_t count) {
+    std::vector<item> pool(pool_len);
+    List l;
+    std::vector<typename List::iterator> pos;
+    for (size_t i = 0; i < pool_len; ++i) {
+        l.push_back(&pool[i]);
+        pos.push_back(--l.end());
+    }
+    size_t seed = 1;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        l.splice(l.begin(), l, pos[next_rand(seed) & (pool_len - 1)]);
+    }
+    clock_t end = clock();
+    print_time(start, end);
+}
+
+inline void intrusive_lru_test(size_t count) {
+    std::vector<item> pool(pool_len);
+    item_list l(pool.begin(), pool.end());
+    size_t seed = 1;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        l.splice(l.begin(), l,
+                 l.iterator_to(pool[next_rand(seed) & (pool_len - 1)]));
+    }
+    clock_t end = clock();
+    l.clear();
+    print_time(start, end);
+}
+
+// one row per list over the three lengths
+#define INTRUSIVE_LIST_ROWS(name)             \
+    std::cout << "|  std::list<item*>   |";   \
+    name##_test<std::list<item*>>(LEN1 _M);   \
+    name##_test<std::list<item*>>(LEN2 _M);   \
+    name##_test<std::list<item*>>(LEN3 _M);   \
+    std::cout << "\n|     list<item*>     |"; \
+    name##_test<mystl::list<item*>>(LEN1 _M); \
+    name##_test<mystl::list<item*>>(LEN2 _M); \
+    name##_test<mystl::list<item*>>(LEN3 _M); \
+    std::cout << "\n|   intrusive_list    |"; \
+    intrusive_##name##_test(LEN1 _M);         \
+    intrusive_##name##_test(LEN2 _M);         \
+    intrusive_##name##_test(LEN3 _M);         \
+    std::cout << std::endl
+
+void intrusive_list_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[----------- Run intrusive_list performance test ---------------]"
+        << std::endl;
+    std::cout
+        << "[------------- link / unlink, window of 32K --------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    INTRUSIVE_LIST_ROWS(link);
+    std::cout
+        << "[------------- walk over 64K objects, summing ------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    INTRUSIVE_LIST_ROWS(walk);
+    std::cout
+        << "[------------- LRU touch, move to front of 64K -----------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    INTRUSIVE_LIST_ROWS(lru);
+    std::cout
+        << "[----------- End intrusive_list performance test ---------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace intrusive_list_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_LIST_SORT_TEST_H_
+#define MYSTL_LIST_SORT_TEST_H_
+
+// unit test that list::sort is sorted and stable, and a performance test
+// for list::sort on count random, presorted and reversed ints, std::list against mystl::list, and how many times faster mystl's is
+
+#include <cstdlib>
+#include <list>
+
+#include "../mystl/list.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace list_sort_test {
+
+// key and the position it was pushed at
+struct keyed {
+    int key;
+    int seq;
+};
+
+struct key_less {
+    bool operator()(const keyed& a, const keyed& b) const {
+        return a.key < b.key;
+    }
+};
+
+// sorted by key, and equal keys still in push order
+inline bool sorted_and_stable(const mystl::list<keyed>& l) {
+    const keyed* prev = nullptr;
+    for (const keyed& k : l) {
+        if (prev && (k.key < prev->key ||
+                     (k.key == prev->key && k.seq < prev->seq))) {
+            return false;
+        }
+        prev = &k;
+    }
+    return true;
+}
+
+// few distinct keys, so long runs of equal ones, in random, ascending,
+// descending and sawtooth order, at lengths around the merge boundaries
+TEST(list_sort_stable_test) {
+    const size_t lens[] = {0, 1, 2, 3, 15, 16, 17, 63, 64, 65, 1000, 5000};
+    bool ok = true;
+    bool sizes = true;
+    for (size_t len : lens) {
+        for (int pattern = 0; pattern < 4; ++pattern) {
+            mystl::list<keyed> l;
+            for (size_t i = 0; i < len; ++i) {
+                int key = 0;
+                const int n = static_cast<int>(i);
+                switch (pattern) {
+                    case 0: key = std::rand() % 8; break;
+                    case 1: key = n / 10; break;
+                    case 2: key = -n / 10; break;
+                    default: key = n % 7; break;
+                }
+                l.push_back(keyed{key, n});
+            }
+            l.sort(key_less());
+            ok = ok && sorted_and_stable(l);
+            sizes = sizes && l.size() == len;
+        }
+    }
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(sizes);
+
+    mystl::list<int> ints = {5, 3, 9, 1, 3};
+    ints.sort();
+    const int expect[] = {1, 3, 3, 5, 9};
+    EXPECT_TRUE(mystl::equal(ints.begin(), ints.end(), expect));
+}
+
+void list_sort_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[-------------- Run list sort performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[--------------------------- random ----------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    LIST_SORT_TEST(LEN1 _M, LEN2 _M, LEN3 _M, rand());
+    std::cout << std::endl;
+    std::cout
+        << "[------------------------- presorted ---------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    LIST_SORT_TEST(LEN1 _M, LEN2 _M, LEN3 _M, i);
+    std::cout << std::endl;
+    std::cout
+        << "[-------------------------- reversed ---------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    LIST_SORT_TEST(LEN1 _M, LEN2 _M, LEN3 _M, -static_cast<int>(i));
+    std::cout << std::endl;
+    std::cout
+        << "[-------------- End list sort performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace list_sort_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MEMORY_RESOURCE_TEST_H_
+#define MYSTL_MEMORY_RESOURCE_TEST_H_
+
+// unit test for monotonic_buffer_resource rejecting requests it can't size,
+// and a performance test for the pmr resources: every "request" builds a few
+// small maps and vectors that die together, repeated count / 64 times
+
+#include "../mystl/map.h"
+#include "../mystl/memory_resource.h"
+#include "../mystl/unordered_map.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace memory_resource_test {
+
+// a request whose block size would wrap around throws instead of handing
+// out a tiny block, and the resource stays usable
+TEST(monotonic_buffer_overflow_test) {
+    mystl::pmr::monotonic_buffer_resource mr;
+    const size_t huge[] = {static_cast<size_t>(-1), static_cast<size_t>(-1) - 8,
+                           static_cast<size_t>(-1) / 2 + 1};
+    for (size_t bytes : huge) {
+        bool thrown = false;
+        try {
+            mr.allocate(bytes, 64);
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+    }
+    int* p = static_cast<int*>(mr.allocate(sizeof(int), alignof(int)));
+    *p = 7;
+    EXPECT_EQ(*p, 7);
+}
+
+// one request worth of temporaries, 64 elements each
+template <class Vector, class Map, class UMap>
+void handle_request(mystl::pmr::memory_resource* mr) {
+    Vector v(mr);
+    Map m(mr);
+    UMap u(mr);
+    for (int i = 0; i < 64; ++i) {
+        v.push_back(i);
+        m[rand()] = i;
+        u[i] = i;
+    }
+}
+
+template <class Vector, class Map, class UMap>
+void handle_request(std::nullptr_t) {
+    Vector v;
+    Map m;
+    UMap u;
+    for (int i = 0; i < 64; ++i) {
+        v.push_back(i);
+        m[rand()] = i;
+        u[i] = i;
+    }
+}
+
+#define PMR_REQUEST_TEST(setup, arg, count)                         \
+    do {                                                            \
+        srand((int)time(0));                                        \
+        char buf[10];                                               \
+        clock_t start, end;                                         \
+        start = clock();                                            \
+        for (size_t i = 0; i < count / 64; ++i) {                   \
+            setup;                                                  \
+            handle_request<vector_type, map_type, umap_type>(arg);  \
+        }                                                           \
+        end = clock();                                              \
+        int n = static_cast<int>(static_cast<double>(end - start) / \
+                                 CLOCKS_PER_SEC * 1000);            \
+        std::snprintf(buf, sizeof(buf), "%d", n);                   \
+        std::string t = buf;                                        \
+        t += "ms    |";                                             \
+        std::cout << std::setw(WIDE) << t;                          \
+    } while (0)
+
+#define PMR_REQUEST_ROW(name, setup, arg, len1, len2, len3) \
+    std::cout << name;                                      \
+    PMR_REQUEST_TEST(setup, arg, len1);                     \
+    PMR_REQUEST_TEST(setup, arg, len2);                     \
+    PMR_REQUEST_TEST(setup, arg, len3);                     \
+    std::cout << std::endl;
+
+#define PMR_REQUEST_ROWS(len1, len2, len3)                                   \
+    TEST_LEN(len1, len2, len3, WIDE);                                        \
+    {                                                                        \
+        typedef mystl::vector<int> vector_type;                              \
+        typedef mystl::map<int, int> map_type;                               \
+        typedef mystl::unordered_map<int, int> umap_type;                    \
+        PMR_REQUEST_ROW("|   default alloc     |", (void)0, nullptr, len1,   \
+                        len2, len3);                                         \
+    }                                                                        \
+    {                                                                        \
+        typedef mystl::pmr::vector<int> vector_type;                         \
+        typedef mystl::pmr::map<int, int> map_type;                          \
+        typedef mystl::pmr::unordered_map<int, int> umap_type;               \
+        PMR_REQUEST_ROW("|   new_delete        |", (void)0,                  \
+                        mystl::pmr::new_delete_resource(), len1, len2,       \
+                        len3);                                               \
+        PMR_REQUEST_ROW("|   monotonic(stack)  |", char stack_buf[16384];    \
+                        mystl::pmr::monotonic_buffer_resource mr(            \
+                            stack_buf, sizeof(stack_buf)),                   \
+                        &mr, len1, len2, len3);                              \
+        mystl::pmr::unsynchronized_pool_resource pool;                       \
+        PMR_REQUEST_ROW("|   unsync pool       |", (void)0, &pool, len1,     \
+                        len2, len3);                                         \
+    }
+
+void memory_resource_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run memory_resource performance test ------------]"
+        << std::endl;
+    std::cout
+        << "[------ per request: vector, map, unordered_map of 64 ints ------]"
+        << std::endl;
+    std::cout << "|  elements in total  |";
+#if LARGER_TEST_DATA_ON
+    PMR_REQUEST_ROWS(LEN1 _LL, LEN2 _LL, LEN3 _LL);
+#else
+    PMR_REQUEST_ROWS(LEN1 _M, LEN2 _M, LEN3 _M);
+#endif
+    std::cout
+        << "[------------- End memory_resource performance test ------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace memory_resource_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,213 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MMAP_ALLOCATOR_TEST_H_
+#define MYSTL_MMAP_ALLOCATOR_TEST_H_
+
+// unit tests for mmap_allocator::reallocate keeping blocks at huge page
+// boundaries and pre-faulting the pages it grows by, and a performance test for mmap_allocator: a vector<uint64_t>
+// of 16 MB, 128 MB and 1 GB is filled (first touch of every page) and then
+// read at 10M random positions, with allocator, mmap_allocator and
+// pre-faulting mmap_allocator
+
+#include <cstdint>
+#include <vector>
+
+#include "../mystl/mmap_allocator.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace mmap_allocator_test {
+
+constexpr size_t random_reads = 10000000;
+
+// elements of a vector<uint64_t> taking mb megabytes
+constexpr size_t elems(size_t mb) {
+    return mb * 1024 * 1024 / sizeof(uint64_t);
+}
+
+#if MYSTL_HAS_MMAP
+// a block that can't grow in place, because a page was mapped right after
+// it, must still move to a huge page boundary and keep its contents
+// (skipped where the kernel can't place that page at the address asked)
+TEST(mmap_allocator_reallocate_test) {
+#ifdef MAP_FIXED_NOREPLACE
+    typedef mystl::mmap_allocator<uint64_t> alloc;
+    const size_t old_n = elems(4);
+    uint64_t* p = alloc::allocate(old_n);
+    for (size_t i = 0; i < old_n; ++i) {
+        p[i] = i;
+    }
+    void* blocker = ::mmap(p + old_n, 4096, PROT_READ,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                           -1, 0);
+    if (blocker != static_cast<void*>(p + old_n)) {
+        if (blocker != MAP_FAILED) {
+            ::munmap(blocker, 4096);
+        }
+        alloc::deallocate(p, old_n);
+        std::cout << " mmap_allocator_reallocate_test skipped: no blocker page\n";
+        return;
+    }
+    bool aligned = true;
+    size_t n = old_n;
+    for (size_t mb = 8; mb <= 64; mb *= 2) {
+        uint64_t* q = alloc::reallocate(p, n, elems(mb));
+        if (q == nullptr) {
+            break;
+        }
+        aligned = aligned &&
+                  reinterpret_cast<size_t>(q) % mystl::huge_page_size == 0;
+        p = q;
+        n = elems(mb);
+    }
+    bool kept = true;
+    for (size_t i = 0; i < old_n; ++i) {
+        kept = kept && p[i] == i;
+    }
+    EXPECT_EQ(n, elems(64));
+    EXPECT_TRUE(aligned);
+    EXPECT_TRUE(kept);
+    p = alloc::reallocate(p, n, elems(6));
+    EXPECT_TRUE(p != nullptr && p[old_n - 1] == old_n - 1);
+    alloc::deallocate(p, elems(6));
+    ::munmap(blocker, 4096);
+#endif  // MAP_FIXED_NOREPLACE
+}
+
+// with Populate, the pages a block grows by are resident right after
+// reallocate, before anything touches them
+TEST(mmap_allocator_populate_growth_test) {
+    typedef mystl::mmap_allocator<uint64_t, true> alloc;
+    uint64_t* p = alloc::allocate(elems(4));
+    p = alloc::reallocate(p, elems(4), elems(32));
+    EXPECT_TRUE(p != nullptr);
+    if (p == nullptr) {
+        return;
+    }
+    const size_t pages = (elems(32) - elems(4)) * sizeof(uint64_t) / 4096;
+    std::vector<unsigned char> resident(pages);
+    EXPECT_EQ(::mincore(p + elems(4), pages * 4096, resident.data()), 0);
+    size_t missing = 0;
+    for (size_t i = 0; i < pages; ++i) {
+        missing += (resident[i] & 1) == 0;
+    }
+    EXPECT_EQ(missing, 0u);
+    alloc::deallocate(p, elems(32));
+}
+#endif  // MYSTL_HAS_MMAP
+
+#define MMAP_PRINT_MS(start, end)                                   \
+    do {                                                            \
+        char buf[10];                                               \
+        int n = static_cast<int>(static_cast<double>(end - start) / \
+                                 CLOCKS_PER_SEC * 1000);            \
+        std::snprintf(buf, sizeof(buf), "%d", n);                   \
+        std::string t = buf;                                        \
+        t += "ms    |";                                             \
+        std::cout << std::setw(WIDE) << t;                          \
+    } while (0)
+
+// fill time, the page faults land here
+template <class Alloc>
+void fill_test(size_t n) {
+    clock_t start = clock();
+    mystl::vector<uint64_t, Alloc> v(n, 1);
+    clock_t end = clock();
+    MMAP_PRINT_MS(start, end);
+}
+
+// random reads over a filled vector, the TLB misses land here
+template <class Alloc>
+void random_access_test(size_t n) {
+    mystl::vector<uint64_t, Alloc> v(n, 1);
+    uint64_t seed = 88172645463325252ull;
+    uint64_t sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < random_reads; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        sum += v[seed % n];
+    }
+    clock_t end = clock();
+    if (sum == 0) {
+        std::cout << "";
+    }
+    MMAP_PRINT_MS(start, end);
+}
+
+#define MMAP_ROWS(fun)                                                 \
+    std::cout << "|      allocator      |";                            \
+    fun<mystl::allocator<uint64_t>>(elems(16));                        \
+    fun<mystl::allocator<uint64_t>>(elems(128));                       \
+    fun<mystl::allocator<uint64_t>>(elems(1024));                      \
+    std::cout << "\n|    mmap_allocator   |";                          \
+    fun<mystl::mmap_allocator<uint64_t>>(elems(16));                   \
+    fun<mystl::mmap_allocator<uint64_t>>(elems(128));                  \
+    fun<mystl::mmap_allocator<uint64_t>>(elems(1024));                 \
+    std::cout << "\n| mmap_alloc populate |";                          \
+    fun<mystl::mmap_allocator<uint64_t, true>>(elems(16));             \
+    fun<mystl::mmap_allocator<uint64_t, true>>(elems(128));            \
+    fun<mystl::mmap_allocator<uint64_t, true>>(elems(1024));           \
+    std::cout << std::endl;
+
+void mmap_allocator_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run mmap_allocator performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[------------ vector<uint64_t>(n, 1) : fill / first touch ------]"
+        << std::endl;
+    std::cout << "|     vector size     |";
+    std::cout << std::setw(WIDE) << "16MB    |" << std::setw(WIDE)
+              << "128MB    |" << std::setw(WIDE) << "1GB    |" << std::endl;
+    MMAP_ROWS(fill_test);
+    std::cout
+        << "[------------ vector<uint64_t> : 10M random reads --------------]"
+        << std::endl;
+    std::cout << "|     vector size     |";
+    std::cout << std::setw(WIDE) << "16MB    |" << std::setw(WIDE)
+              << "128MB    |" << std::setw(WIDE) << "1GB    |" << std::endl;
+    MMAP_ROWS(random_access_test);
+    std::cout
+        << "[------------- End mmap_allocator performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace mmap_allocator_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MMAP_VECTOR_TEST_H_
+#define MYSTL_MMAP_VECTOR_TEST_H_
+
+// unit tests for mmap_vector reopening its own files and refusing ones it
+// did not write, and a performance test: building a lookup table of count
+// entries in a vector at startup, against writing it once to a file and
+// mapping that file read only again, which only touches the pages used
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "../mystl/mmap_vector.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace mmap_vector_test {
+
+#if MYSTL_HAS_FILE_MAP
+
+const char* const table_file = "mmap_vector_test.bin";
+
+// stands in for the work of computing an entry
+inline uint64_t table_entry(size_t i) {
+    uint64_t x = i * 0x9e3779b97f4a7c15ull;
+    x ^= x >> 31;
+    x *= 0xbf58476d1ce4e5b9ull;
+    return x ^ (x >> 29);
+}
+
+inline void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+inline void rebuild_test(size_t count) {
+    clock_t start = clock();
+    mystl::vector<uint64_t> table;
+    for (size_t i = 0; i < count; ++i) {
+        table.push_back(table_entry(i));
+    }
+    clock_t end = clock();
+    volatile uint64_t sink = table[count / 2];
+    (void)sink;
+    print_time(start, end);
+}
+
+inline void write_file(size_t count) {
+    mystl::mmap_vector<uint64_t> table(table_file, mmap_mode::truncate);
+    for (size_t i = 0; i < count; ++i) {
+        table.push_back(table_entry(i));
+    }
+}
+
+inline void write_file_test(size_t count) {
+    clock_t start = clock();
+    write_file(count);
+    clock_t end = clock();
+    print_time(start, end);
+}
+
+// map a saved table and look up 1000 entries
+inline void map_file_test(size_t count) {
+    write_file(count);
+    clock_t start = clock();
+    mystl::mmap_vector<uint64_t> table(table_file, mmap_mode::read_only);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        sum += table[(i * 7919) % count];
+    }
+    clock_t end = clock();
+    volatile uint64_t sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+const char* const bad_file = "mmap_vector_bad.bin";
+
+inline void write_raw(const char* path, const char* data, size_t n) {
+    std::FILE* f = std::fopen(path, "wb");
+    std::fwrite(data, 1, n, f);
+    std::fclose(f);
+}
+
+inline std::string read_raw(const char* path) {
+    std::string s;
+    std::FILE* f = std::fopen(path, "rb");
+    int c;
+    while ((c = std::fgetc(f)) != EOF) {
+        s += static_cast<char>(c);
+    }
+    std::fclose(f);
+    return s;
+}
+
+template <class T>
+bool open_throws(const char* path, mmap_mode mode) {
+    try {
+        mystl::mmap_vector<T> v(path, mode);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// a file that is not ours must be refused and left as it was
+TEST(mmap_vector_bad_file_test) {
+    const std::string foreign(200, 'x');
+    write_raw(bad_file, foreign.data(), foreign.size());
+    EXPECT_TRUE(open_throws<uint64_t>(bad_file, mmap_mode::read_write));
+    EXPECT_TRUE(open_throws<uint64_t>(bad_file, mmap_mode::read_only));
+    EXPECT_TRUE(read_raw(bad_file) == foreign);
+
+    const std::string shorter(10, 'y');
+    write_raw(bad_file, shorter.data(), shorter.size());
+    EXPECT_TRUE(open_throws<uint64_t>(bad_file, mmap_mode::read_write));
+    EXPECT_TRUE(read_raw(bad_file) == shorter);
+
+    {
+        mystl::mmap_vector<uint32_t> v(bad_file, mmap_mode::truncate);
+        v.push_back(7);
+    }
+    const std::string saved = read_raw(bad_file);
+    EXPECT_TRUE(open_throws<uint64_t>(bad_file, mmap_mode::read_write));
+    EXPECT_TRUE(read_raw(bad_file) == saved);
+    std::remove(bad_file);
+}
+
+template <class Op>
+bool write_throws(Op op) {
+    try {
+        op();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// what was written is there after reopening; a read only mapping refuses
+// every write and leaves the file as it was
+TEST(mmap_vector_reopen_test) {
+    {
+        mystl::mmap_vector<uint64_t> v(table_file, mmap_mode::truncate);
+        for (size_t i = 0; i < 1000; ++i) {
+            v.push_back(table_entry(i));
+        }
+    }
+    {
+        mystl::mmap_vector<uint64_t> v(table_file, mmap_mode::read_write);
+        EXPECT_EQ(v.size(), 1000u);
+        for (size_t i = 1000; i < 5000; ++i) {
+            v.push_back(table_entry(i));
+        }
+        v.pop_back();
+    }
+    const std::string saved = read_raw(table_file);
+    {
+        mystl::mmap_vector<uint64_t> v(table_file, mmap_mode::read_only);
+        EXPECT_TRUE(v.read_only());
+        EXPECT_EQ(v.size(), 4999u);
+        bool same = true;
+        for (size_t i = 0; i < v.size(); ++i) {
+            same = same && v[i] == table_entry(i);
+        }
+        EXPECT_TRUE(same);
+        EXPECT_TRUE(write_throws([&v] { v.push_back(1); }));
+        EXPECT_TRUE(write_throws([&v] { v.pop_back(); }));
+        EXPECT_TRUE(write_throws([&v] { v.reserve(10000); }));
+        EXPECT_TRUE(write_throws([&v] { v.clear(); }));
+        EXPECT_EQ(v.size(), 4999u);
+    }
+    EXPECT_TRUE(read_raw(table_file) == saved);
+    {
+        mystl::mmap_vector<uint64_t> v(table_file, mmap_mode::truncate);
+        EXPECT_TRUE(v.empty());
+    }
+    std::remove(table_file);
+}
+
+#endif  // MYSTL_HAS_FILE_MAP
+
+void mmap_vector_test() {
+#if PERFORMANCE_TEST_ON && MYSTL_HAS_FILE_MAP
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run mmap_vector performance test ----------------]"
+        << std::endl;
+    std::cout
+        << "[------------ startup with a table of 8 byte entries -----------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|   rebuild vector    |";
+    rebuild_test(LEN1 _M);
+    rebuild_test(LEN2 _M);
+    rebuild_test(LEN3 _M);
+    std::cout << "\n|  build + save file  |";
+    write_file_test(LEN1 _M);
+    write_file_test(LEN2 _M);
+    write_file_test(LEN3 _M);
+    std::cout << "\n| map file, 1K reads  |";
+    map_file_test(LEN1 _M);
+    map_file_test(LEN2 _M);
+    map_file_test(LEN3 _M);
+    std::cout << std::endl;
+    std::remove(table_file);
+    std::cout
+        << "[------------- End mmap_vector performance test ----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON && MYSTL_HAS_FILE_MAP
+}
+
+}  // namespace mmap_vector_test
+}  // namespace test
+}  // namespace mystl
+#endif
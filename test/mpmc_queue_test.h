@@ -0,0 +1,222 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_MPMC_QUEUE_TEST_H_
+#define MYSTL_MPMC_QUEUE_TEST_H_
+
+// scaling test for mpmc_queue against a deque behind a mutex and two
+// condition variables, both bounded to 1024 ints: count ints go through
+// the queue from 1, 2 and 4 producers to as many consumers, blocking push
+// and pop on both sides, wall clock ms
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../mystl/deque.h"
+#include "../mystl/queue.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace mpmc_queue_test {
+
+const size_t ring_len = 1024;
+
+// the blocking interface of mpmc_queue the way a thread pool builds it
+class locked_queue {
+   public:
+    explicit locked_queue(size_t capacity) : capacity_(capacity) {}
+
+    void push(int value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return q_.size() < capacity_; });
+        q_.push_back(value);
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    void pop(int& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !q_.empty(); });
+        value = q_.front();
+        q_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    mystl::deque<int> q_;
+    size_t capacity_;
+};
+
+// 3 producers push their own ids through a ring of 4 to 3 consumers; every
+// id must come out exactly once, and each consumer must see the ids of one
+// producer in the order they were pushed
+TEST(mpmc_queue_no_loss_test) {
+    const int per_thread = 30000;
+    const int threads = 3;
+    mystl::mpmc_queue<int> q(4);
+    std::vector<std::vector<int>> seen(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&q, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                if (i % 2 == 0) {
+                    q.push(t * per_thread + i);
+                } else {
+                    while (!q.try_push(t * per_thread + i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }));
+        workers.push_back(std::thread([&q, &seen, t] {
+            int value;
+            for (int i = 0; i < per_thread; ++i) {
+                if (i % 2 == 0) {
+                    q.pop(value);
+                } else {
+                    while (!q.try_pop(value)) {
+                        std::this_thread::yield();
+                    }
+                }
+                seen[t].push_back(value);
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    bool in_order = true;
+    std::vector<int> all;
+    for (int t = 0; t < threads; ++t) {
+        std::vector<int> last(threads, -1);
+        for (size_t i = 0; i < seen[t].size(); ++i) {
+            const int v = seen[t][i];
+            in_order = in_order && v > last[v / per_thread];
+            last[v / per_thread] = v;
+        }
+        all.insert(all.end(), seen[t].begin(), seen[t].end());
+    }
+    std::sort(all.begin(), all.end());
+    bool each_once = all.size() == static_cast<size_t>(threads * per_thread);
+    for (size_t i = 0; each_once && i < all.size(); ++i) {
+        each_once = all[i] == static_cast<int>(i);
+    }
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(each_once);
+    EXPECT_TRUE(q.empty());
+}
+
+template <class Queue>
+void scaling_test(size_t count, size_t threads) {
+    Queue q(ring_len);
+    const size_t per_thread = count / threads;
+    std::vector<std::thread> workers;
+    std::vector<long long> sums(threads, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&q, per_thread] {
+            for (size_t i = 0; i < per_thread; ++i) {
+                q.push(static_cast<int>(i));
+            }
+        }));
+        workers.push_back(std::thread([&q, &sums, t, per_thread] {
+            long long sum = 0;
+            int value;
+            for (size_t i = 0; i < per_thread; ++i) {
+                q.pop(value);
+                sum += value;
+            }
+            sums[t] = sum;
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sums[0];
+    (void)sink;
+    char buf[16];
+    const double ms = std::chrono::duration<double, std::milli>(end - start)
+                          .count();
+    std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(ms));
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define MPMC_QUEUE_ROW(Queue, threads)           \
+    scaling_test<Queue>(LEN1 _M, threads);       \
+    scaling_test<Queue>(LEN2 _M, threads);       \
+    scaling_test<Queue>(LEN3 _M, threads)
+
+void mpmc_queue_test() {
+#if PERFORMANCE_TEST_ON
+    typedef mystl::mpmc_queue<int> ring;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run mpmc_queue performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[------------ producers x consumers, blocking ends -------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "| mutex + cv, 1 x 1   |";
+    MPMC_QUEUE_ROW(locked_queue, 1);
+    std::cout << "\n| mpmc_queue, 1 x 1   |";
+    MPMC_QUEUE_ROW(ring, 1);
+    std::cout << "\n| mutex + cv, 2 x 2   |";
+    MPMC_QUEUE_ROW(locked_queue, 2);
+    std::cout << "\n| mpmc_queue, 2 x 2   |";
+    MPMC_QUEUE_ROW(ring, 2);
+    std::cout << "\n| mutex + cv, 4 x 4   |";
+    MPMC_QUEUE_ROW(locked_queue, 4);
+    std::cout << "\n| mpmc_queue, 4 x 4   |";
+    MPMC_QUEUE_ROW(ring, 4);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- End mpmc_queue performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace mpmc_queue_test
+}  // namespace test
+}  // namespace mystl
+#endif
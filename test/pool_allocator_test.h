@@ -0,0 +1,249 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_POOL_ALLOCATOR_TEST_H_
+#define MYSTL_POOL_ALLOCATOR_TEST_H_
+
+// unit tests for the per-container arena of pool_allocator and a
+// performance test against allocator, using the node types of list and map
+// under an insert/erase churn
+
+#include <vector>
+
+#include "../mystl/list.h"
+#include "../mystl/map.h"
+#include "../mystl/pool_allocator.h"
+#include "../mystl/set.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace pool_allocator_test {
+
+// allocate count nodes, free and reallocate count random ones, free all
+#define ALLOC_CHURN_TEST(alloc, node, count)                        \
+    do {                                                            \
+        srand((int)time(0));                                        \
+        char buf[10];                                               \
+        clock_t start, end;                                         \
+        std::vector<node*> slots(count);                            \
+        start = clock();                                            \
+        {                                                           \
+            alloc<node> a;                                          \
+            for (size_t i = 0; i < count; ++i)                      \
+                slots[i] = a.allocate(1);                           \
+            for (size_t i = 0; i < count; ++i) {                    \
+                size_t k = static_cast<size_t>(rand()) % count;     \
+                a.deallocate(slots[k], 1);                          \
+                slots[k] = a.allocate(1);                           \
+            }                                                       \
+            for (size_t i = 0; i < count; ++i)                      \
+                a.deallocate(slots[i], 1);                          \
+        }                                                           \
+        end = clock();                                              \
+        int n = static_cast<int>(static_cast<double>(end - start) / \
+                                 CLOCKS_PER_SEC * 1000);            \
+        std::snprintf(buf, sizeof(buf), "%d", n);                   \
+        std::string t = buf;                                        \
+        t += "ms    |";                                             \
+        std::cout << std::setw(WIDE) << t;                          \
+    } while (0)
+
+// plain allocator has no arena to give back
+template <class T>
+class plain_allocator : public mystl::allocator<T> {};
+
+#define ALLOC_CHURN_ROWS(node, len1, len2, len3)                \
+    TEST_LEN(len1, len2, len3, WIDE);                           \
+    std::cout << "|      allocator      |";                     \
+    ALLOC_CHURN_TEST(plain_allocator, node, len1);              \
+    ALLOC_CHURN_TEST(plain_allocator, node, len2);              \
+    ALLOC_CHURN_TEST(plain_allocator, node, len3);              \
+    std::cout << "\n|    pool_allocator   |";                   \
+    ALLOC_CHURN_TEST(mystl::pool_allocator, node, len1);        \
+    ALLOC_CHURN_TEST(mystl::pool_allocator, node, len2);        \
+    ALLOC_CHURN_TEST(mystl::pool_allocator, node, len3);        \
+    std::cout << std::endl;
+
+typedef mystl::list_node<int> list_node_type;
+typedef mystl::rb_tree_node<mystl::pair<const int, int>> map_node_type;
+
+typedef mystl::pool_allocator<mystl::pair<const int, int>> pair_pool;
+typedef mystl::map<int, int, mystl::less<int>, pair_pool> pool_map;
+
+// a map gives its chunks back when it is destroyed, even while another map
+// with nodes of the same size is alive
+TEST(pool_allocator_release_test) {
+    pool_map kept;
+    for (int i = 0; i < 1000; ++i) {
+        kept[i] = i;
+    }
+    pair_pool alloc;
+    {
+        pool_map m(alloc);
+        for (int i = 0; i < 100000; ++i) {
+            m[i] = i;
+        }
+        EXPECT_EQ(alloc.live_count(), 100000u);
+        EXPECT_GT(alloc.chunk_count(), 1u);
+        EXPECT_TRUE(m.get_allocator() == alloc);
+        EXPECT_TRUE(kept.get_allocator() != alloc);
+    }
+    EXPECT_EQ(alloc.live_count(), 0u);
+    EXPECT_EQ(alloc.chunk_count(), 0u);
+    EXPECT_GT(kept.get_allocator().chunk_count(), 0u);
+    EXPECT_EQ(kept.size(), 1000u);
+}
+
+// a copy gets an arena of its own, swap carries the arenas along
+TEST(pool_allocator_copy_swap_test) {
+    typedef mystl::list<int, mystl::pool_allocator<int>> pool_list;
+    pool_list a(100, 1);
+    pool_list b(a);
+    EXPECT_TRUE(a.get_allocator() != b.get_allocator());
+    EXPECT_CON_EQ(a, b);
+    pool_list c(10, 2);
+    auto c_alloc = c.get_allocator();
+    a.swap(c);
+    EXPECT_TRUE(a.get_allocator() == c_alloc);
+    EXPECT_EQ(a.size(), 10u);
+    EXPECT_EQ(c.size(), 100u);
+    c = mystl::move(a);
+    EXPECT_TRUE(c.get_allocator() == c_alloc);
+    EXPECT_EQ(c.size(), 10u);
+}
+
+// moved-from lists, maps and sets are empty and take new elements, with the
+// default allocator and with an arena per container
+TEST(node_container_moved_from_test) {
+    typedef mystl::list<int, mystl::pool_allocator<int>> pool_list;
+    mystl::list<int> a(10, 1);
+    mystl::list<int> b(mystl::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(a.begin() == a.end());
+    a.clear();
+    a.push_back(2);
+    a.push_front(1);
+    a.insert(a.end(), 2, 3);
+    a.sort();
+    EXPECT_EQ(a.size(), 4u);
+    EXPECT_EQ(a.front(), 1);
+    EXPECT_EQ(a.back(), 3);
+    mystl::list<int> c(mystl::move(b), mystl::allocator<int>());
+    b.splice(b.end(), c);
+    EXPECT_EQ(b.size(), 10u);
+    EXPECT_TRUE(c.empty());
+    c = b;
+    EXPECT_CON_EQ(b, c);
+
+    pool_list p(5, 4);
+    pool_list q(mystl::move(p));
+    pool_list r;
+    r = mystl::move(q);
+    p.emplace_back(5);
+    q.assign(3, 6);
+    EXPECT_EQ(p.size(), 1u);
+    EXPECT_EQ(q.size(), 3u);
+    EXPECT_EQ(r.size(), 5u);
+
+    mystl::map<int, int> m;
+    for (int i = 0; i < 100; ++i) {
+        m[i] = i;
+    }
+    mystl::map<int, int> n(mystl::move(m));
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.find(1) == m.end());
+    m.clear();
+    m[7] = 7;
+    m.insert(mystl::make_pair(3, 3));
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_EQ(m.begin()->first, 3);
+    EXPECT_EQ(n.size(), 100u);
+    EXPECT_EQ(n[99], 99);
+    m.swap(n);
+    EXPECT_EQ(m.size(), 100u);
+    EXPECT_EQ(n.size(), 2u);
+    EXPECT_EQ((--n.end())->first, 7);
+
+    pool_map pm;
+    pm[1] = 1;
+    pool_map pn(mystl::move(pm));
+    pm[2] = 2;
+    pool_map po;
+    po = mystl::move(pn);
+    pn[3] = 3;
+    EXPECT_EQ(pm.size(), 1u);
+    EXPECT_EQ(pn.begin()->first, 3);
+    EXPECT_EQ(po.begin()->first, 1);
+
+    mystl::set<int> s{3, 1, 2};
+    mystl::set<int> t(mystl::move(s));
+    s.insert(5);
+    s.insert(4);
+    EXPECT_EQ(s.size(), 2u);
+    EXPECT_EQ(*s.begin(), 4);
+    EXPECT_EQ(t.size(), 3u);
+    EXPECT_EQ(*--t.end(), 3);
+}
+
+void pool_allocator_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run pool_allocator performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[------------------ node : list_node<int> ----------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_CHURN_ROWS(list_node_type, LEN1 _LL, LEN2 _LL, LEN3 _LL);
+#else
+    ALLOC_CHURN_ROWS(list_node_type, LEN1 _M, LEN2 _M, LEN3 _M);
+#endif
+    std::cout
+        << "[------------- node : rb_tree_node<pair<int, int>> -------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+#if LARGER_TEST_DATA_ON
+    ALLOC_CHURN_ROWS(map_node_type, LEN1 _LL, LEN2 _LL, LEN3 _LL);
+#else
+    ALLOC_CHURN_ROWS(map_node_type, LEN1 _M, LEN2 _M, LEN3 _M);
+#endif
+    std::cout
+        << "[------------- End pool_allocator performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace pool_allocator_test
+}  // namespace test
+}  // namespace mystl
+#endif
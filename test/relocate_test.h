@@ -0,0 +1,262 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_RELOCATE_TEST_H_
+#define MYSTL_RELOCATE_TEST_H_
+
+// unit tests that relocated elements keep their values and skip the move
+// constructor, and a performance test for trivially relocatable elements:
+// growing a vector,
+// inserting into the middle of a vector and of a deque. Both rows use mystl
+// and the same handle type, only the first one is marked trivially
+// relocatable, so they compare memcpy / memmove relocation against moving
+// element by element.
+
+#include "../mystl/deque.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace relocate_test {
+
+// a handle with user-written copy, move and destructor, like a container or
+// smart pointer; it never points into itself
+template <bool Relocatable>
+class handle {
+   public:
+    handle() noexcept : p_(nullptr), n_(0) {}
+    handle(int* p, size_t n) noexcept : p_(p), n_(n) {}
+    handle(const handle& rhs) noexcept : p_(rhs.p_), n_(rhs.n_) {}
+    handle(handle&& rhs) noexcept : p_(rhs.p_), n_(rhs.n_) {
+        rhs.p_ = nullptr;
+        rhs.n_ = 0;
+    }
+    handle& operator=(const handle& rhs) noexcept {
+        p_ = rhs.p_;
+        n_ = rhs.n_;
+        return *this;
+    }
+    handle& operator=(handle&& rhs) noexcept {
+        p_ = rhs.p_;
+        n_ = rhs.n_;
+        rhs.p_ = nullptr;
+        rhs.n_ = 0;
+        return *this;
+    }
+    ~handle() {}
+
+    int* get() const noexcept { return p_; }
+    size_t size() const noexcept { return n_; }
+
+   private:
+    int* p_;
+    size_t n_;
+};
+
+typedef handle<true> relocatable_handle;
+typedef handle<false> pinned_handle;
+
+inline size_t& move_count() {
+    static size_t n = 0;
+    return n;
+}
+
+// a handle that counts its moves
+template <bool Relocatable>
+class tracked : public handle<Relocatable> {
+   public:
+    tracked() noexcept {}
+    tracked(int* p, size_t n) noexcept : handle<Relocatable>(p, n) {}
+    tracked(const tracked&) = default;
+    tracked(tracked&& rhs) noexcept : handle<Relocatable>(mystl::move(rhs)) {
+        ++move_count();
+    }
+    tracked& operator=(const tracked&) = default;
+    tracked& operator=(tracked&& rhs) noexcept {
+        ++move_count();
+        handle<Relocatable>::operator=(mystl::move(rhs));
+        return *this;
+    }
+};
+
+}  // namespace relocate_test
+}  // namespace test
+
+template <>
+struct is_trivially_relocatable<test::relocate_test::relocatable_handle>
+    : std::true_type {};
+
+template <>
+struct is_trivially_relocatable<test::relocate_test::tracked<true>>
+    : std::true_type {};
+
+namespace test {
+namespace relocate_test {
+
+static int target = 0;
+
+// element i points at pool + i and has size i
+template <class Con>
+bool in_order(const Con& c, int* pool, size_t from = 0) {
+    for (size_t i = 0; i < c.size(); ++i) {
+        if (c[i].get() != pool + from + i || c[i].size() != from + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// growth, middle inserts and erases keep every element's value, and only
+// the non relocatable handle is moved to get there
+template <class Con>
+void identity_check(bool relocatable) {
+    int pool[64];
+    Con c;
+    for (size_t i = 0; i < 32; ++i) {
+        c.push_back(typename Con::value_type(pool + i, i));
+    }
+    move_count() = 0;
+    for (size_t i = 32; i < 64; ++i) {
+        const typename Con::value_type x(pool + i, i);
+        c.push_back(x);
+    }
+    EXPECT_TRUE(in_order(c, pool));
+
+    const typename Con::value_type mid(pool, 0);
+    c.insert(c.begin() + 10, mid);
+    EXPECT_TRUE(c[10].get() == pool && c[11].get() == pool + 10);
+    c.erase(c.begin() + 10);
+    c.erase(c.begin(), c.begin() + 5);
+    EXPECT_TRUE(in_order(c, pool, 5));
+    // elements are copied in and insert may move its own copy into place;
+    // any other move is a relocation
+    if (relocatable) {
+        EXPECT_LE(move_count(), 1u);
+    } else {
+        EXPECT_GT(move_count(), 1u);
+    }
+}
+
+TEST(relocate_identity_test) {
+    identity_check<mystl::vector<tracked<true>>>(true);
+    identity_check<mystl::vector<tracked<false>>>(false);
+    identity_check<mystl::deque<tracked<true>>>(true);
+    identity_check<mystl::deque<tracked<false>>>(false);
+
+    // overlapping relocation to the left is a memmove
+    int pool[8];
+    typename std::aligned_storage<sizeof(relocatable_handle),
+                                  alignof(relocatable_handle)>::type raw[8];
+    relocatable_handle* p = reinterpret_cast<relocatable_handle*>(raw);
+    for (size_t i = 0; i < 6; ++i) {
+        ::new (static_cast<void*>(p + 2 + i)) relocatable_handle(pool + i, i);
+    }
+    relocatable_handle* e = mystl::uninitialized_relocate(p + 2, p + 8, p);
+    EXPECT_TRUE(e == p + 6);
+    bool same = true;
+    for (size_t i = 0; i < 6; ++i) {
+        same = same && p[i].get() == pool + i && p[i].size() == i;
+    }
+    EXPECT_TRUE(same);
+    mystl::destroy(p, e);
+}
+
+typedef mystl::vector<relocatable_handle> relocatable_vector;
+typedef mystl::vector<pinned_handle> pinned_vector;
+typedef mystl::deque<relocatable_handle> relocatable_deque;
+typedef mystl::deque<pinned_handle> pinned_deque;
+
+// insert count elements, each one in the middle of the container
+#define MIDDLE_INSERT_TEST(con, count)                              \
+    do {                                                            \
+        char buf[10];                                               \
+        clock_t start, end;                                         \
+        con c;                                                      \
+        con::value_type x(&target, 4);                              \
+        start = clock();                                            \
+        for (size_t i = 0; i < count; ++i)                          \
+            c.insert(c.begin() + c.size() / 2, x);                  \
+        end = clock();                                              \
+        int n = static_cast<int>(static_cast<double>(end - start) / \
+                                 CLOCKS_PER_SEC * 1000);            \
+        std::snprintf(buf, sizeof(buf), "%d", n);                   \
+        std::string t = buf;                                        \
+        t += "ms    |";                                             \
+        std::cout << std::setw(WIDE) << t;                          \
+    } while (0)
+
+#define RELOCATE_ROWS(test, relocatable, pinned, len1, len2, len3) \
+    std::cout << "| orders of magnitude |";                         \
+    TEST_LEN(len1, len2, len3, WIDE);                               \
+    std::cout << "|     relocatable     |";                         \
+    test(relocatable, len1);                                        \
+    test(relocatable, len2);                                        \
+    test(relocatable, len3);                                        \
+    std::cout << "\n|   move one by one   |";                       \
+    test(pinned, len1);                                             \
+    test(pinned, len2);                                             \
+    test(pinned, len3);                                             \
+    std::cout << std::endl;
+
+#define PUSH_BACK_TEST(con, count) \
+    FUN_TEST_FORMAT1(con, push_back, con::value_type(&target, 4), count)
+
+void relocate_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[--------------- Run relocation performance test ---------------]"
+        << std::endl;
+    std::cout
+        << "[------------------- vector<handle>  push_back -----------------]"
+        << std::endl;
+    RELOCATE_ROWS(PUSH_BACK_TEST, relocatable_vector, pinned_vector,
+                  LEN1 _M, LEN2 _M, LEN3 _M);
+    std::cout
+        << "[--------------- vector<handle>  insert(middle) ----------------]"
+        << std::endl;
+    RELOCATE_ROWS(MIDDLE_INSERT_TEST, relocatable_vector, pinned_vector,
+                  LEN1 _SS, LEN1 _S, LEN2 _SSS);
+    std::cout
+        << "[---------------- deque<handle>  insert(middle) ----------------]"
+        << std::endl;
+    RELOCATE_ROWS(MIDDLE_INSERT_TEST, relocatable_deque, pinned_deque,
+                  LEN1 _SS, LEN1 _S, LEN2 _SSS);
+    std::cout
+        << "[--------------- End relocation performance test ---------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace relocate_test
+}  // namespace test
+}  // namespace mystl
+#endif
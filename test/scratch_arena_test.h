@@ -0,0 +1,189 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SCRATCH_ARENA_TEST_H_
+#define MYSTL_SCRATCH_ARENA_TEST_H_
+
+// unit tests for the reuse, the bound and the heap fallback of the scratch
+// arena, and a performance test for the scratch arena behind
+// get_temporary_buffer: many
+// inplace_merges of small ranges (two sorted halves of 64, 256 and 1024
+// ints), each needing its own temporary buffer. std and mystl with a fresh
+// buffer every call (the arena held elsewhere) pay for malloc and free each
+// time, the reused arena does not
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "../mystl/algo.h"
+#include "../mystl/memory.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace scratch_arena_test {
+
+// two sorted halves, interleaving
+std::vector<int> halves(size_t len) {
+    std::vector<int> v(len);
+    for (size_t i = 0; i < len; ++i) {
+        v[i] = static_cast<int>(i % (len / 2) * 2 + i / (len / 2));
+    }
+    return v;
+}
+
+// a released buffer is handed out again; a second one while the first is
+// out comes from the heap
+TEST(scratch_arena_reuse_test) {
+    mystl::scratch_arena::trim();
+    EXPECT_EQ(mystl::scratch_arena::capacity(), 0u);
+    auto a = mystl::get_temporary_buffer<int>(100);
+    EXPECT_EQ(a.second, 100);
+    EXPECT_GE(mystl::scratch_arena::capacity(), mystl::scratch_arena::min_bytes);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a.first) %
+                  mystl::scratch_arena::align,
+              0u);
+    auto b = mystl::get_temporary_buffer<int>(100);
+    EXPECT_TRUE(b.first != nullptr && b.first != a.first);
+    EXPECT_EQ(b.second, 100);
+    mystl::release_temporary_buffer(b.first);
+    mystl::release_temporary_buffer(a.first);
+
+    auto c = mystl::get_temporary_buffer<double>(200);
+    EXPECT_TRUE(c.first == reinterpret_cast<double*>(a.first));
+    // trim keeps a block that is out
+    mystl::scratch_arena::trim();
+    EXPECT_GT(mystl::scratch_arena::capacity(), 0u);
+    mystl::release_temporary_buffer(c.first);
+    mystl::scratch_arena::trim();
+    EXPECT_EQ(mystl::scratch_arena::capacity(), 0u);
+}
+
+// the block grows up to max_bytes; anything larger goes to the heap and
+// leaves the block as it was
+TEST(scratch_arena_bound_test) {
+    const size_t max = mystl::scratch_arena::max_bytes;
+    auto a = mystl::get_temporary_buffer<char>(static_cast<ptrdiff_t>(max));
+    EXPECT_EQ(mystl::scratch_arena::capacity(), max);
+    mystl::release_temporary_buffer(a.first);
+
+    EXPECT_TRUE(mystl::scratch_arena::acquire(max + 1) == nullptr);
+    auto b = mystl::get_temporary_buffer<char>(static_cast<ptrdiff_t>(max) + 1);
+    EXPECT_TRUE(b.first != nullptr && b.first != a.first);
+    EXPECT_EQ(b.second, static_cast<ptrdiff_t>(max) + 1);
+    b.first[max] = 1;
+    EXPECT_EQ(mystl::scratch_arena::capacity(), max);
+    mystl::release_temporary_buffer(b.first);
+
+    // a merge running while the block is out still merges
+    void* held = mystl::scratch_arena::acquire(16);
+    EXPECT_TRUE(held == a.first);
+    auto v = halves(1000);
+    mystl::inplace_merge(v.data(), v.data() + 500, v.data() + 1000);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_TRUE(mystl::scratch_arena::release(held));
+    EXPECT_TRUE(!mystl::scratch_arena::release(v.data()));
+    mystl::scratch_arena::trim();
+}
+
+#define MERGE_PRINT_MS(start, end)                                          \
+    do {                                                                    \
+        char buf[10];                                                       \
+        int n = static_cast<int>(                                           \
+            std::chrono::duration<double, std::milli>(end - start).count()); \
+        std::snprintf(buf, sizeof(buf), "%d", n);                           \
+        std::string t = buf;                                                \
+        t += "ms    |";                                                     \
+        std::cout << std::setw(WIDE) << t;                                  \
+    } while (0)
+
+void std_merge_test(size_t len, size_t times) {
+    auto v = halves(len);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < times; ++i) {
+        std::inplace_merge(v.begin(), v.begin() + len / 2, v.end());
+    }
+    auto end = std::chrono::steady_clock::now();
+    MERGE_PRINT_MS(start, end);
+}
+
+void mystl_merge_test(size_t len, size_t times, bool reuse) {
+    auto v = halves(len);
+    int* first = v.data();
+    // holding the thread's block sends every merge to the heap
+    void* held = reuse ? nullptr : mystl::scratch_arena::acquire(1);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < times; ++i) {
+        mystl::inplace_merge(first, first + len / 2, first + len);
+    }
+    auto end = std::chrono::steady_clock::now();
+    mystl::scratch_arena::release(held);
+    MERGE_PRINT_MS(start, end);
+}
+
+#define MERGE_ROWS(times, len1, len2, len3) \
+    std::cout << "|         std         |";  \
+    std_merge_test(len1, times);             \
+    std_merge_test(len2, times);             \
+    std_merge_test(len3, times);             \
+    std::cout << "\n|    mystl (fresh)    |";\
+    mystl_merge_test(len1, times, false);    \
+    mystl_merge_test(len2, times, false);    \
+    mystl_merge_test(len3, times, false);    \
+    std::cout << "\n|    mystl (arena)    |";\
+    mystl_merge_test(len1, times, true);     \
+    mystl_merge_test(len2, times, true);     \
+    mystl_merge_test(len3, times, true);     \
+    std::cout << std::endl;
+
+void scratch_arena_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run scratch arena performance test --------------]"
+        << std::endl;
+    std::cout
+        << "[------- inplace_merge of n ints, repeated 1M times ------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(64, 256, 1024, WIDE);
+    MERGE_ROWS(LEN2 _M, 64, 256, 1024);
+    std::cout
+        << "[------------- End scratch arena performance test --------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace scratch_arena_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,288 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SMALL_VECTOR_TEST_H_
+#define MYSTL_SMALL_VECTOR_TEST_H_
+
+// unit tests for the switch between inline and heap storage, and an
+// allocation count and performance test for small_vector: count short lived
+// containers of 4 ints each, built the way a request handler builds its
+// scratch lists. std::vector and vector go to the heap for every one of
+// them, small_vector<int, 8> never does
+
+#include <string>
+#include <vector>
+
+#include "../mystl/small_vector.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace small_vector_test {
+
+inline size_t& allocation_count() {
+    static size_t n = 0;
+    return n;
+}
+
+// forwards to mystl::allocator and counts the calls to allocate
+template <class T>
+class counting_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() noexcept {}
+    template <class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    static T* allocate(size_t n) {
+        ++allocation_count();
+        return mystl::allocator<T>::allocate(n);
+    }
+    static void deallocate(T* p, size_t n) {
+        mystl::allocator<T>::deallocate(p, n);
+    }
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&) {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&) {
+    return false;
+}
+
+typedef std::vector<int, counting_allocator<int>> std_vector_type;
+typedef mystl::vector<int, counting_allocator<int>> mystl_vector_type;
+typedef mystl::small_vector<int, 8, counting_allocator<int>>
+    small_vector_type;
+
+// the N-th element still fits inline, the next one goes to the heap
+TEST(small_vector_inline_switch_test) {
+    allocation_count() = 0;
+    small_vector_type v;
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(allocation_count(), 0u);
+    v.push_back(8);
+    EXPECT_TRUE(!v.is_inline());
+    EXPECT_EQ(allocation_count(), 1u);
+    EXPECT_GT(v.capacity(), 8u);
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+}
+
+// shrink_to_fit goes back to the inline buffer once the elements fit
+TEST(small_vector_shrink_to_fit_test) {
+    mystl::small_vector<std::string, 4> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(std::string(20, static_cast<char>('a' + i)));
+    }
+    v.shrink_to_fit();
+    EXPECT_TRUE(!v.is_inline());
+    EXPECT_EQ(v.capacity(), 10u);
+    v.erase(v.begin() + 3, v.end());
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 4u);
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_TRUE(v[0] == std::string(20, 'a'));
+    EXPECT_TRUE(v[2] == std::string(20, 'c'));
+}
+
+// swapping an inline vector with a heap one trades the heap buffer and
+// relocates the inline elements
+TEST(small_vector_swap_test) {
+    mystl::small_vector<std::string, 4> a;
+    mystl::small_vector<std::string, 4> b;
+    a.push_back("one");
+    a.push_back("two");
+    for (int i = 0; i < 6; ++i) {
+        b.push_back(std::string(1, static_cast<char>('0' + i)));
+    }
+    const std::string* heap = b.data();
+    a.swap(b);
+    EXPECT_TRUE(!a.is_inline());
+    EXPECT_TRUE(a.data() == heap);
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_TRUE(a[5] == "5");
+    EXPECT_TRUE(b.is_inline());
+    EXPECT_EQ(b.size(), 2u);
+    EXPECT_TRUE(b[0] == "one" && b[1] == "two");
+    b.swap(a);
+    EXPECT_TRUE(a.is_inline() && !b.is_inline());
+    EXPECT_TRUE(a[1] == "two" && b[0] == "0");
+}
+
+// a move leaves the source empty and usable, inline or not
+TEST(small_vector_move_test) {
+    mystl::small_vector<std::string, 4> a;
+    a.push_back("x");
+    mystl::small_vector<std::string, 4> b(mystl::move(a));
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(b.size() == 1u && b[0] == "x");
+    for (int i = 0; i < 6; ++i) {
+        b.push_back("y");
+    }
+    const std::string* heap = b.data();
+    mystl::small_vector<std::string, 4> c(mystl::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_TRUE(b.is_inline());
+    EXPECT_TRUE(c.data() == heap);
+    EXPECT_EQ(c.size(), 7u);
+    b.push_back("z");
+    EXPECT_TRUE(b[0] == "z");
+    a = mystl::move(c);
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(a.size(), 7u);
+}
+
+// a range insert within capacity shifts the tail, bitwise for int
+template <class T>
+void insert_range_check(const T* values) {
+    mystl::small_vector<T, 8> v(values, values + 4);
+    v.insert(v.begin() + 1, values + 4, values + 6);
+    EXPECT_EQ(v.size(), 6u);
+    EXPECT_TRUE(v.is_inline());
+    const int order[] = {0, 4, 5, 1, 2, 3};
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(v[i] == values[order[i]]);
+    }
+    v.insert(v.end(), values, values + 2);
+    v.insert(v.begin(), values + 2, values + 3);
+    EXPECT_EQ(v.size(), 9u);
+    EXPECT_TRUE(v[0] == values[2] && v[8] == values[1]);
+}
+
+TEST(small_vector_insert_range_test) {
+    const int ints[] = {10, 11, 12, 13, 14, 15};
+    insert_range_check(ints);
+    const std::string strings[] = {"a", "b", "c", "d", "e", "f"};
+    insert_range_check(strings);
+}
+
+// build count containers of 4 elements; prints the number of heap
+// allocations, or the time taken when show_time is set
+template <class Vector>
+void short_lived_test(size_t count, bool show_time) {
+    char buf[10];
+    allocation_count() = 0;
+    clock_t start = clock();
+    volatile int last = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Vector v;
+        for (int j = 0; j < 4; ++j) {
+            v.push_back(j);
+        }
+        last = v[3];
+    }
+    clock_t end = clock();
+    std::string t;
+    if (show_time) {
+        int n = static_cast<int>(static_cast<double>(end - start) /
+                                 CLOCKS_PER_SEC * 1000);
+        std::snprintf(buf, sizeof(buf), "%d", n);
+        t = buf;
+        t += "ms    |";
+    } else {
+        std::snprintf(buf, sizeof(buf), "%d",
+                      static_cast<int>(allocation_count()));
+        t = buf;
+        t += "    |";
+    }
+    std::cout << std::setw(WIDE) << t;
+    (void)last;
+}
+
+void small_vector_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run small_vector allocation test ----------------]"
+        << std::endl;
+    std::cout
+        << "[--------------- 4 x push_back, heap allocations ---------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::vector     |";
+    short_lived_test<std_vector_type>(LEN1 _M, false);
+    short_lived_test<std_vector_type>(LEN2 _M, false);
+    short_lived_test<std_vector_type>(LEN3 _M, false);
+    std::cout << "\n|       vector        |";
+    short_lived_test<mystl_vector_type>(LEN1 _M, false);
+    short_lived_test<mystl_vector_type>(LEN2 _M, false);
+    short_lived_test<mystl_vector_type>(LEN3 _M, false);
+    std::cout << "\n|  small_vector<, 8>  |";
+    short_lived_test<small_vector_type>(LEN1 _M, false);
+    short_lived_test<small_vector_type>(LEN2 _M, false);
+    short_lived_test<small_vector_type>(LEN3 _M, false);
+    std::cout << std::endl;
+    std::cout
+        << "[------------------- 4 x push_back, time -----------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::vector     |";
+    short_lived_test<std_vector_type>(LEN1 _M, true);
+    short_lived_test<std_vector_type>(LEN2 _M, true);
+    short_lived_test<std_vector_type>(LEN3 _M, true);
+    std::cout << "\n|       vector        |";
+    short_lived_test<mystl_vector_type>(LEN1 _M, true);
+    short_lived_test<mystl_vector_type>(LEN2 _M, true);
+    short_lived_test<mystl_vector_type>(LEN3 _M, true);
+    std::cout << "\n|  small_vector<, 8>  |";
+    short_lived_test<small_vector_type>(LEN1 _M, true);
+    short_lived_test<small_vector_type>(LEN2 _M, true);
+    short_lived_test<small_vector_type>(LEN3 _M, true);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- End small_vector allocation test ----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace small_vector_test
+}  // namespace test
+}  // namespace mystl
+#endif
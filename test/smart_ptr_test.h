@@ -0,0 +1,370 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SMART_PTR_TEST_H_
+#define MYSTL_SMART_PTR_TEST_H_
+
+// unit tests for ownership counts, weak expiry, aliasing,
+// enable_shared_from_this and the single allocation of make_shared, and a
+// performance test for the smart pointers: make_shared, copying a
+// shared_ptr (atomic counts) against a local_shared_ptr (plain counts), and
+// growing a vector of unique_ptr, which mystl relocates with memcpy
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../mystl/shared_ptr.h"
+#include "../mystl/unique_ptr.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace smart_ptr_test {
+
+// live objects and allocated blocks, to see when each goes away
+inline int& live_objects() {
+    static int n = 0;
+    return n;
+}
+
+inline std::atomic<long>& live_blocks() {
+    static std::atomic<long> n(0);
+    return n;
+}
+
+struct counted {
+    int value;
+    explicit counted(int v = 0) : value(v) { ++live_objects(); }
+    ~counted() { --live_objects(); }
+};
+
+// forwards to mystl::allocator and counts the blocks in use
+template <class T>
+class block_counting_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef block_counting_allocator<U> other;
+    };
+
+    block_counting_allocator() noexcept {}
+    template <class U>
+    block_counting_allocator(const block_counting_allocator<U>&) noexcept {}
+
+    static T* allocate(size_t n) {
+        ++live_blocks();
+        return mystl::allocator<T>::allocate(n);
+    }
+    static void deallocate(T* p, size_t n) {
+        --live_blocks();
+        mystl::allocator<T>::deallocate(p, n);
+    }
+};
+
+template <class T, class U>
+bool operator==(const block_counting_allocator<T>&,
+                const block_counting_allocator<U>&) {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const block_counting_allocator<T>&,
+                const block_counting_allocator<U>&) {
+    return false;
+}
+
+// use_count follows copies, moves and resets, for both count policies
+TEST(smart_ptr_use_count_test) {
+    mystl::shared_ptr<int> a = mystl::make_shared<int>(1);
+    EXPECT_EQ(a.use_count(), 1);
+    mystl::shared_ptr<int> b = a;
+    EXPECT_EQ(a.use_count(), 2);
+    mystl::shared_ptr<int> c = mystl::move(b);
+    EXPECT_EQ(a.use_count(), 2);
+    EXPECT_EQ(b.use_count(), 0);
+    EXPECT_TRUE(!b);
+    c.reset();
+    EXPECT_EQ(a.use_count(), 1);
+
+    mystl::local_shared_ptr<int> l(new int(2));
+    mystl::local_shared_ptr<int> m = l;
+    EXPECT_EQ(l.use_count(), 2);
+    m = mystl::local_shared_ptr<int>();
+    EXPECT_EQ(l.use_count(), 1);
+    EXPECT_EQ(*l, 2);
+
+    mystl::unique_ptr<int> u = mystl::make_unique<int>(3);
+    mystl::shared_ptr<int> d(mystl::move(u));
+    EXPECT_TRUE(u.get() == nullptr);
+    EXPECT_EQ(d.use_count(), 1);
+    EXPECT_EQ(*d, 3);
+}
+
+// the object goes with the last shared_ptr, the single block of
+// allocate_shared with the last weak_ptr
+TEST(smart_ptr_weak_expiry_test) {
+    const long blocks = live_blocks();
+    mystl::weak_ptr<counted> w;
+    {
+        mystl::shared_ptr<counted> p = mystl::allocate_shared<counted>(
+            block_counting_allocator<counted>(), 7);
+        EXPECT_EQ(live_blocks(), blocks + 1);
+        EXPECT_EQ(live_objects(), 1);
+        w = p;
+        EXPECT_EQ(w.use_count(), 1);
+        EXPECT_TRUE(!w.expired());
+        EXPECT_EQ(w.lock()->value, 7);
+        EXPECT_EQ(p.use_count(), 1);
+    }
+    EXPECT_EQ(live_objects(), 0);
+    EXPECT_TRUE(w.expired());
+    EXPECT_TRUE(w.lock() == nullptr);
+    EXPECT_EQ(live_blocks(), blocks + 1);
+    bool thrown = false;
+    try {
+        mystl::shared_ptr<counted> q(w);
+    } catch (const mystl::bad_weak_ptr&) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    w.reset();
+    EXPECT_EQ(live_blocks(), blocks);
+
+    // an adopted pointer gets a separate control block
+    mystl::shared_ptr<counted> r(new counted(1), mystl::default_delete<counted>(),
+                                 block_counting_allocator<counted>());
+    EXPECT_EQ(live_blocks(), blocks + 1);
+    r.reset();
+    EXPECT_EQ(live_blocks(), blocks);
+    EXPECT_EQ(live_objects(), 0);
+}
+
+// an aliasing owner keeps the whole object alive and points into it
+TEST(smart_ptr_aliasing_test) {
+    struct two {
+        counted first;
+        counted second;
+    };
+    mystl::shared_ptr<two> p = mystl::make_shared<two>();
+    p->second.value = 5;
+    mystl::shared_ptr<counted> a(p, &p->second);
+    EXPECT_EQ(p.use_count(), 2);
+    EXPECT_TRUE(!a.owner_before(p) && !p.owner_before(a));
+    p.reset();
+    EXPECT_EQ(live_objects(), 2);
+    EXPECT_EQ(a->value, 5);
+    a.reset();
+    EXPECT_EQ(live_objects(), 0);
+}
+
+struct node : mystl::enable_shared_from_this<node> {
+    int value = 0;
+};
+
+// shared_from_this shares the owner's count, before any owner it throws
+TEST(smart_ptr_shared_from_this_test) {
+    mystl::shared_ptr<node> p = mystl::make_shared<node>();
+    mystl::shared_ptr<node> q = p->shared_from_this();
+    EXPECT_TRUE(q == p);
+    EXPECT_EQ(p.use_count(), 2);
+    EXPECT_EQ(p->weak_from_this().use_count(), 2);
+
+    mystl::shared_ptr<node> r(new node);
+    EXPECT_TRUE(r->shared_from_this() == r);
+
+    node unowned;
+    EXPECT_TRUE(unowned.weak_from_this().expired());
+    bool thrown = false;
+    try {
+        unowned.shared_from_this();
+    } catch (const mystl::bad_weak_ptr&) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+// one thread drops the last owner while another keeps locking a weak_ptr:
+// the object and the block must each go exactly once
+TEST(smart_ptr_weak_lock_race_test) {
+    const long blocks = live_blocks();
+    std::atomic<int> destroyed(0);
+    struct noisy {
+        std::atomic<int>* destroyed;
+        explicit noisy(std::atomic<int>* d) : destroyed(d) {}
+        ~noisy() { destroyed->fetch_add(1); }
+    };
+    bool seen_after_expiry = false;
+    for (int round = 0; round < 2000; ++round) {
+        mystl::shared_ptr<noisy> p = mystl::allocate_shared<noisy>(
+            block_counting_allocator<noisy>(), &destroyed);
+        mystl::weak_ptr<noisy> w = p;
+        std::thread t([&w, &seen_after_expiry] {
+            for (int i = 0; i < 100; ++i) {
+                mystl::shared_ptr<noisy> q = w.lock();
+                if (q == nullptr) {
+                    seen_after_expiry = seen_after_expiry || !w.expired();
+                    break;
+                }
+            }
+            w.reset();
+        });
+        p.reset();
+        t.join();
+    }
+    EXPECT_EQ(destroyed.load(), 2000);
+    EXPECT_EQ(live_blocks(), blocks);
+    EXPECT_TRUE(!seen_after_expiry);
+}
+
+// make count objects and push their owners into a growing vector, every
+// reallocation relocates the owners made so far
+#define MAKE_TEST(vec, make, count)                                 \
+    do {                                                            \
+        char buf[10];                                               \
+        clock_t start, end;                                         \
+        vec v;                                                      \
+        start = clock();                                            \
+        for (size_t i = 0; i < count; ++i)                          \
+            v.push_back(make(static_cast<int>(i)));                 \
+        v.clear();                                                  \
+        end = clock();                                              \
+        int n = static_cast<int>(static_cast<double>(end - start) / \
+                                 CLOCKS_PER_SEC * 1000);            \
+        std::snprintf(buf, sizeof(buf), "%d", n);                   \
+        std::string t = buf;                                        \
+        t += "ms    |";                                             \
+        std::cout << std::setw(WIDE) << t;                          \
+    } while (0)
+
+// count copies of one owner, so every copy and destruction touches the same
+// reference count
+#define COPY_TEST(vec, make, count)                                 \
+    do {                                                            \
+        char buf[10];                                               \
+        clock_t start, end;                                         \
+        vec v;                                                      \
+        v.reserve(count);                                           \
+        vec::value_type p = make(1);                                \
+        start = clock();                                            \
+        for (size_t i = 0; i < count; ++i)                          \
+            v.push_back(p);                                         \
+        v.clear();                                                  \
+        end = clock();                                              \
+        int n = static_cast<int>(static_cast<double>(end - start) / \
+                                 CLOCKS_PER_SEC * 1000);            \
+        std::snprintf(buf, sizeof(buf), "%d", n);                   \
+        std::string t = buf;                                        \
+        t += "ms    |";                                             \
+        std::cout << std::setw(WIDE) << t;                          \
+    } while (0)
+
+typedef std::vector<std::shared_ptr<int>> std_shared_vec;
+typedef mystl::vector<mystl::shared_ptr<int>> mystl_shared_vec;
+typedef mystl::vector<mystl::local_shared_ptr<int>> mystl_local_vec;
+typedef std::vector<std::unique_ptr<int>> std_unique_vec;
+typedef mystl::vector<mystl::unique_ptr<int>> mystl_unique_vec;
+
+#define STD_MAKE_SHARED std::make_shared<int>
+#define MYSTL_MAKE_SHARED mystl::make_shared<int>
+#define MYSTL_MAKE_LOCAL mystl::make_local_shared<int>
+#define STD_MAKE_UNIQUE(x) std::unique_ptr<int>(new int(x))
+#define MYSTL_MAKE_UNIQUE mystl::make_unique<int>
+
+void smart_ptr_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[--------------- Run smart pointer performance test ------------]"
+        << std::endl;
+    std::cout
+        << "[------------------------ make_shared --------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|         std         |";
+    MAKE_TEST(std_shared_vec, STD_MAKE_SHARED, LEN1 _M);
+    MAKE_TEST(std_shared_vec, STD_MAKE_SHARED, LEN2 _M);
+    MAKE_TEST(std_shared_vec, STD_MAKE_SHARED, LEN3 _M);
+    std::cout << "\n|        mystl        |";
+    MAKE_TEST(mystl_shared_vec, MYSTL_MAKE_SHARED, LEN1 _M);
+    MAKE_TEST(mystl_shared_vec, MYSTL_MAKE_SHARED, LEN2 _M);
+    MAKE_TEST(mystl_shared_vec, MYSTL_MAKE_SHARED, LEN3 _M);
+    std::cout << "\n|    mystl (local)    |";
+    MAKE_TEST(mystl_local_vec, MYSTL_MAKE_LOCAL, LEN1 _M);
+    MAKE_TEST(mystl_local_vec, MYSTL_MAKE_LOCAL, LEN2 _M);
+    MAKE_TEST(mystl_local_vec, MYSTL_MAKE_LOCAL, LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------------------ copy shared_ptr ----------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|         std         |";
+    COPY_TEST(std_shared_vec, STD_MAKE_SHARED, LEN1 _M);
+    COPY_TEST(std_shared_vec, STD_MAKE_SHARED, LEN2 _M);
+    COPY_TEST(std_shared_vec, STD_MAKE_SHARED, LEN3 _M);
+    std::cout << "\n|        mystl        |";
+    COPY_TEST(mystl_shared_vec, MYSTL_MAKE_SHARED, LEN1 _M);
+    COPY_TEST(mystl_shared_vec, MYSTL_MAKE_SHARED, LEN2 _M);
+    COPY_TEST(mystl_shared_vec, MYSTL_MAKE_SHARED, LEN3 _M);
+    std::cout << "\n|    mystl (local)    |";
+    COPY_TEST(mystl_local_vec, MYSTL_MAKE_LOCAL, LEN1 _M);
+    COPY_TEST(mystl_local_vec, MYSTL_MAKE_LOCAL, LEN2 _M);
+    COPY_TEST(mystl_local_vec, MYSTL_MAKE_LOCAL, LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------------ vector<unique_ptr>  push_back --------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|         std         |";
+    MAKE_TEST(std_unique_vec, STD_MAKE_UNIQUE, LEN1 _M);
+    MAKE_TEST(std_unique_vec, STD_MAKE_UNIQUE, LEN2 _M);
+    MAKE_TEST(std_unique_vec, STD_MAKE_UNIQUE, LEN3 _M);
+    std::cout << "\n|        mystl        |";
+    MAKE_TEST(mystl_unique_vec, MYSTL_MAKE_UNIQUE, LEN1 _M);
+    MAKE_TEST(mystl_unique_vec, MYSTL_MAKE_UNIQUE, LEN2 _M);
+    MAKE_TEST(mystl_unique_vec, MYSTL_MAKE_UNIQUE, LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[--------------- End smart pointer performance test ------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace smart_ptr_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -0,0 +1,391 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SOA_VECTOR_TEST_H_
+#define MYSTL_SOA_VECTOR_TEST_H_
+
+// unit tests for sorting rows, the heap algorithms on move-only values and
+// the allocator of soa_vector, and a performance test: summing one field of
+// count 64 byte records stored as an array of structs against the same
+// records in a struct of arrays, and sorting whole rows by that field
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../mystl/algo.h"
+#include "../mystl/soa_vector.h"
+#include "../mystl/unique_ptr.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace soa_vector_test {
+
+struct record {
+    int key;
+    int flags;
+    double values[7];
+};
+
+typedef mystl::soa_vector<int, int, double, double, double, double, double,
+                          double, double>
+    soa_records;
+
+inline int record_key(size_t i) {
+    return static_cast<int>((i * 2654435761u) % 1000003);
+}
+
+// sorting by the key column must move every other column with it; keys are
+// distinct, so the result is checked column by column against a sorted
+// vector of structs
+TEST(soa_vector_sort_test) {
+    struct row {
+        int key;
+        std::string name;
+        double value;
+    };
+    typedef mystl::soa_vector<int, std::string, double> soa_rows;
+    const int count = 1000;
+    soa_rows v;
+    std::vector<row> rows;
+    for (int i = 0; i < count; ++i) {
+        const int key = static_cast<int>((i * 7919) % count);
+        v.emplace_back(key, std::to_string(i), i * 0.5);
+        rows.push_back(row{key, std::to_string(i), i * 0.5});
+    }
+    mystl::sort(v.begin(), v.end(),
+                [](soa_rows::const_reference a, soa_rows::const_reference b) {
+                    return std::get<0>(a) < std::get<0>(b);
+                });
+    std::sort(rows.begin(), rows.end(),
+              [](const row& a, const row& b) { return a.key < b.key; });
+    bool keys = true, names = true, values = true;
+    for (int i = 0; i < count; ++i) {
+        keys = keys && v.column<0>()[i] == rows[i].key;
+        names = names && v.column<1>()[i] == rows[i].name;
+        values = values && v.column<2>()[i] == rows[i].value;
+    }
+    EXPECT_EQ(v.size(), static_cast<size_t>(count));
+    EXPECT_TRUE(keys);
+    EXPECT_TRUE(names);
+    EXPECT_TRUE(values);
+}
+
+// the heap algorithms move the held value and the holes, so they take
+// move-only values
+TEST(soa_vector_heap_move_only_test) {
+    typedef mystl::unique_ptr<int> ptr;
+    auto less = [](const ptr& a, const ptr& b) { return *a < *b; };
+    const int count = 100;
+    mystl::vector<ptr> v;
+    for (int i = 0; i < count; ++i) {
+        v.emplace_back(mystl::make_unique<int>((i * 37) % count));
+    }
+    mystl::make_heap(v.begin(), v.end(), less);
+    EXPECT_EQ(*v.front(), count - 1);
+    mystl::pop_heap(v.begin(), v.end(), less);
+    EXPECT_EQ(*v.back(), count - 1);
+    mystl::push_heap(v.begin(), v.end(), less);
+    EXPECT_EQ(*v.front(), count - 1);
+    mystl::sort_heap(v.begin(), v.end(), less);
+    bool sorted = true;
+    for (int i = 0; i < count; ++i) {
+        sorted = sorted && v[i] && *v[i] == i;
+    }
+    EXPECT_TRUE(sorted);
+
+    mystl::vector<ptr> w;
+    for (int i = 0; i < count; ++i) {
+        w.emplace_back(mystl::make_unique<int>((i * 37) % count));
+    }
+    mystl::partial_sort(w.begin(), w.begin() + 10, w.end(), less);
+    bool smallest = true, kept = true;
+    for (int i = 0; i < count; ++i) {
+        kept = kept && w[i];
+        smallest = smallest && (i >= 10 || (w[i] && *w[i] == i));
+    }
+    EXPECT_TRUE(kept);
+    EXPECT_TRUE(smallest);
+}
+
+// bytes each of 3 arenas has handed out and not got back
+inline long* arena_bytes() {
+    static long n[3] = {0, 0, 0};
+    return n;
+}
+
+// a stateful allocator that doesn't propagate: a block can only go back to
+// the arena it came from
+template <class T>
+class arena_allocator {
+   public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind {
+        typedef arena_allocator<U> other;
+    };
+
+    explicit arena_allocator(int id = 0) noexcept : id_(id) {}
+    template <class U>
+    arena_allocator(const arena_allocator<U>& rhs) noexcept : id_(rhs.id()) {}
+
+    T* allocate(size_t n) {
+        arena_bytes()[id_] += static_cast<long>(n * sizeof(T));
+        return mystl::allocator<T>::allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        arena_bytes()[id_] -= static_cast<long>(n * sizeof(T));
+        mystl::allocator<T>::deallocate(p, n);
+    }
+
+    int id() const noexcept { return id_; }
+
+   private:
+    int id_;
+};
+
+template <class T, class U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.id() == rhs.id();
+}
+
+template <class T, class U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.id() != rhs.id();
+}
+
+struct alignas(64) wide {
+    int value;
+};
+
+typedef mystl::basic_soa_vector<arena_allocator<int>, int, wide, std::string>
+    arena_rows;
+
+inline bool same_rows(const arena_rows& v, int count) {
+    bool same = v.size() == static_cast<size_t>(count);
+    for (int i = 0; same && i < count; ++i) {
+        same = v.column<0>()[i] == i && v.column<1>()[i].value == -i &&
+               v.column<2>()[i] == std::to_string(i);
+    }
+    return same;
+}
+
+inline void fill_rows(arena_rows& v, int count) {
+    for (int i = 0; i < count; ++i) {
+        v.emplace_back(i, wide{-i}, std::to_string(i));
+    }
+}
+
+// the block comes from the allocator, aligned for the widest field, and
+// goes back to it
+TEST(soa_vector_allocator_test) {
+    {
+        arena_rows v{arena_allocator<int>(1)};
+        fill_rows(v, 100);
+        EXPECT_EQ(v.get_allocator().id(), 1);
+        EXPECT_GT(arena_bytes()[1], 100L * static_cast<long>(sizeof(wide)));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data<1>()) % 64, 0u);
+        EXPECT_TRUE(same_rows(v, 100));
+        arena_rows c(v);
+        EXPECT_EQ(c.get_allocator().id(), 1);
+        EXPECT_TRUE(same_rows(c, 100));
+    }
+    EXPECT_EQ(arena_bytes()[1], 0L);
+}
+
+// a move takes the block over only from an equal allocator; otherwise the
+// rows are relocated into a block of the target's arena
+TEST(soa_vector_allocator_move_test) {
+    {
+        arena_rows a{arena_allocator<int>(1)};
+        fill_rows(a, 50);
+        const int* keys = a.data<0>();
+        arena_rows same(mystl::move(a), arena_allocator<int>(1));
+        EXPECT_TRUE(same.data<0>() == keys);
+        EXPECT_TRUE(same_rows(same, 50));
+        EXPECT_TRUE(a.empty());
+
+        arena_rows other(mystl::move(same), arena_allocator<int>(2));
+        EXPECT_TRUE(other.data<0>() != keys);
+        EXPECT_EQ(other.get_allocator().id(), 2);
+        EXPECT_TRUE(same_rows(other, 50));
+        EXPECT_TRUE(same.empty());
+        EXPECT_GT(arena_bytes()[2], 0L);
+
+        arena_rows b{arena_allocator<int>(1)};
+        fill_rows(b, 5);
+        b = mystl::move(other);
+        EXPECT_EQ(b.get_allocator().id(), 1);
+        EXPECT_TRUE(same_rows(b, 50));
+        EXPECT_TRUE(other.empty());
+
+        b = arena_rows{arena_allocator<int>(2)};
+        EXPECT_TRUE(b.empty());
+        EXPECT_EQ(b.get_allocator().id(), 1);
+    }
+    EXPECT_EQ(arena_bytes()[1], 0L);
+    EXPECT_EQ(arena_bytes()[2], 0L);
+}
+
+inline void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// the key field, 10 times
+template <class Vector>
+void aos_scan_test(size_t count) {
+    Vector v(count);
+    for (size_t i = 0; i < count; ++i) {
+        v[i].key = record_key(i);
+    }
+    long long sum = 0;
+    clock_t start = clock();
+    for (int rep = 0; rep < 10; ++rep) {
+        for (size_t i = 0; i < count; ++i) {
+            sum += v[i].key;
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+inline void soa_scan_test(size_t count) {
+    soa_records v(count);
+    auto keys = v.column<0>();
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = record_key(i);
+    }
+    long long sum = 0;
+    clock_t start = clock();
+    for (int rep = 0; rep < 10; ++rep) {
+        auto col = v.column<0>();
+        for (size_t i = 0; i < col.size(); ++i) {
+            sum += col[i];
+        }
+    }
+    clock_t end = clock();
+    volatile long long sink = sum;
+    (void)sink;
+    print_time(start, end);
+}
+
+inline void aos_sort_test(size_t count) {
+    mystl::vector<record> v(count);
+    for (size_t i = 0; i < count; ++i) {
+        v[i].key = record_key(i);
+    }
+    clock_t start = clock();
+    mystl::sort(v.begin(), v.end(), [](const record& a, const record& b) {
+        return a.key < b.key;
+    });
+    clock_t end = clock();
+    volatile int sink = v[count / 2].key;
+    (void)sink;
+    print_time(start, end);
+}
+
+inline void soa_sort_test(size_t count) {
+    soa_records v(count);
+    auto keys = v.column<0>();
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = record_key(i);
+    }
+    clock_t start = clock();
+    mystl::sort(v.begin(), v.end(),
+                [](soa_records::const_reference a,
+                   soa_records::const_reference b) {
+                    return std::get<0>(a) < std::get<0>(b);
+                });
+    clock_t end = clock();
+    volatile int sink = v.column<0>()[count / 2];
+    (void)sink;
+    print_time(start, end);
+}
+
+void soa_vector_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run soa_vector performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[---------------- sum of one field, 10 times -------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "| std::vector<record> |";
+    aos_scan_test<std::vector<record>>(LEN1 _M);
+    aos_scan_test<std::vector<record>>(LEN2 _M);
+    aos_scan_test<std::vector<record>>(LEN3 _M);
+    std::cout << "\n|   vector<record>    |";
+    aos_scan_test<mystl::vector<record>>(LEN1 _M);
+    aos_scan_test<mystl::vector<record>>(LEN2 _M);
+    aos_scan_test<mystl::vector<record>>(LEN3 _M);
+    std::cout << "\n|     soa_vector      |";
+    soa_scan_test(LEN1 _M);
+    soa_scan_test(LEN2 _M);
+    soa_scan_test(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[--------------------- sort by field ---------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|   vector<record>    |";
+    aos_sort_test(LEN1 _M);
+    aos_sort_test(LEN2 _M);
+    aos_sort_test(LEN3 _M);
+    std::cout << "\n|     soa_vector      |";
+    soa_sort_test(LEN1 _M);
+    soa_sort_test(LEN2 _M);
+    soa_sort_test(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- End soa_vector performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace soa_vector_test
+}  // namespace test
+}  // namespace mystl
+#endif
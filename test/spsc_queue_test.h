@@ -0,0 +1,288 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_SPSC_QUEUE_TEST_H_
+#define MYSTL_SPSC_QUEUE_TEST_H_
+
+// two thread performance test for spsc_queue against queue behind a mutex:
+// throughput of count ints from a producer thread to the consumer, single
+// and in batches of 64, in millions per second; and the round trip time of
+// a ping-pong over two queues, count / 100 times, in ns
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "../mystl/queue.h"
+#include "../mystl/spsc_queue.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace spsc_queue_test {
+
+const size_t ring_len = 1024;
+const size_t batch_len = 64;
+
+// the interface of spsc_queue over queue and a mutex
+class locked_queue {
+   public:
+    explicit locked_queue(size_t) {}
+
+    bool try_push(int value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        q_.push(value);
+        return true;
+    }
+
+    bool try_pop(int& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (q_.empty()) {
+            return false;
+        }
+        value = q_.front();
+        q_.pop();
+        return true;
+    }
+
+   private:
+    std::mutex mutex_;
+    mystl::queue<int> q_;
+};
+
+// a ring of 8 wraps many times; the consumer must see 0, 1, 2, ... with
+// nothing lost or repeated, single and batched calls mixed on both sides
+TEST(spsc_queue_fifo_test) {
+    const int count = 100000;
+    mystl::spsc_queue<int> q(8);
+    std::thread producer([&q] {
+        int batch[5];
+        for (int i = 0; i < count;) {
+            if (i % 3 == 0) {
+                if (!q.try_push(i)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ++i;
+                continue;
+            }
+            const size_t n = mystl::min<size_t>(5, count - i);
+            for (size_t j = 0; j < n; ++j) {
+                batch[j] = i + static_cast<int>(j);
+            }
+            const size_t k = q.try_push_n(batch, n);
+            if (k == 0) {
+                std::this_thread::yield();
+            }
+            i += static_cast<int>(k);
+        }
+    });
+    int expect = 0;
+    bool in_order = true;
+    int batch[3];
+    while (expect < count) {
+        size_t k = 0;
+        if (expect % 2 == 0) {
+            k = q.try_pop(batch[0]) ? 1 : 0;
+        } else {
+            k = q.try_pop_n(batch, 3);
+        }
+        if (k == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t j = 0; j < k; ++j) {
+            in_order = in_order && batch[j] == expect;
+            ++expect;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(expect, count);
+    EXPECT_TRUE(q.empty());
+}
+
+inline void print_rate(size_t count, double sec) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%.1f", count / sec / 1e6);
+    std::string t = buf;
+    t += "M/s   |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+template <class Queue>
+void throughput_test(size_t count) {
+    Queue q(ring_len);
+    long long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&q, count] {
+        for (size_t i = 0; i < count; ++i) {
+            while (!q.try_push(static_cast<int>(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int value;
+    for (size_t i = 0; i < count; ++i) {
+        while (!q.try_pop(value)) {
+            std::this_thread::yield();
+        }
+        sum += value;
+    }
+    producer.join();
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    print_rate(count, std::chrono::duration<double>(end - start).count());
+}
+
+inline void batch_throughput_test(size_t count) {
+    mystl::spsc_queue<int> q(ring_len);
+    long long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&q, count] {
+        int batch[batch_len];
+        for (size_t i = 0; i < count;) {
+            const size_t n = mystl::min(batch_len, count - i);
+            for (size_t j = 0; j < n; ++j) {
+                batch[j] = static_cast<int>(i + j);
+            }
+            for (size_t done = 0; done != n;) {
+                const size_t k = q.try_push_n(batch + done, n - done);
+                if (k == 0) {
+                    std::this_thread::yield();
+                }
+                done += k;
+            }
+            i += n;
+        }
+    });
+    int batch[batch_len];
+    for (size_t i = 0; i < count;) {
+        const size_t k = q.try_pop_n(batch, batch_len);
+        if (k == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t j = 0; j < k; ++j) {
+            sum += batch[j];
+        }
+        i += k;
+    }
+    producer.join();
+    auto end = std::chrono::steady_clock::now();
+    volatile long long sink = sum;
+    (void)sink;
+    print_rate(count, std::chrono::duration<double>(end - start).count());
+}
+
+// the other thread sends every value straight back
+template <class Queue>
+void ping_pong_test(size_t rounds) {
+    Queue ping(ring_len), pong(ring_len);
+    auto start = std::chrono::steady_clock::now();
+    std::thread echo([&ping, &pong, rounds] {
+        int value;
+        for (size_t i = 0; i < rounds; ++i) {
+            while (!ping.try_pop(value)) {
+                std::this_thread::yield();
+            }
+            while (!pong.try_push(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    int value;
+    for (size_t i = 0; i < rounds; ++i) {
+        while (!ping.try_push(static_cast<int>(i))) {
+            std::this_thread::yield();
+        }
+        while (!pong.try_pop(value)) {
+            std::this_thread::yield();
+        }
+    }
+    echo.join();
+    auto end = std::chrono::steady_clock::now();
+    const double ns =
+        std::chrono::duration<double, std::nano>(end - start).count();
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%.0f", ns / rounds);
+    std::string t = buf;
+    t += "ns    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+void spsc_queue_test() {
+#if PERFORMANCE_TEST_ON
+    typedef mystl::spsc_queue<int> ring;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run spsc_queue performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[------------------ throughput, 2 threads ----------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|    queue + mutex    |";
+    throughput_test<locked_queue>(LEN1 _M);
+    throughput_test<locked_queue>(LEN2 _M);
+    throughput_test<locked_queue>(LEN3 _M);
+    std::cout << "\n|     spsc_queue      |";
+    throughput_test<ring>(LEN1 _M);
+    throughput_test<ring>(LEN2 _M);
+    throughput_test<ring>(LEN3 _M);
+    std::cout << "\n| spsc_queue, n = 64  |";
+    batch_throughput_test(LEN1 _M);
+    batch_throughput_test(LEN2 _M);
+    batch_throughput_test(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- ping-pong round trip, count / 100 ---------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|    queue + mutex    |";
+    ping_pong_test<locked_queue>(LEN1 _M / 100);
+    ping_pong_test<locked_queue>(LEN2 _M / 100);
+    ping_pong_test<locked_queue>(LEN3 _M / 100);
+    std::cout << "\n|     spsc_queue      |";
+    ping_pong_test<ring>(LEN1 _M / 100);
+    ping_pong_test<ring>(LEN2 _M / 100);
+    ping_pong_test<ring>(LEN3 _M / 100);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- End spsc_queue performance test -----------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace spsc_queue_test
+}  // namespace test
+}  // namespace mystl
+#endif
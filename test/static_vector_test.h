@@ -0,0 +1,223 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_STATIC_VECTOR_TEST_H_
+#define MYSTL_STATIC_VECTOR_TEST_H_
+
+// unit tests for overflow and trivial copyability, and a performance
+// test for static_vector: building count lists of 16 ints and
+// copying one such list count times. static_vector never allocates and,
+// being trivially copyable, is copied with a single memcpy
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../mystl/small_vector.h"
+#include "../mystl/static_vector.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace static_vector_test {
+
+typedef std::vector<int> std_vector_type;
+typedef mystl::vector<int> mystl_vector_type;
+typedef mystl::small_vector<int, 16> small_vector_type;
+typedef mystl::static_vector<int, 16> static_vector_type;
+
+void print_time(clock_t start, clock_t end) {
+    char buf[10];
+    int n = static_cast<int>(static_cast<double>(end - start) /
+                             CLOCKS_PER_SEC * 1000);
+    std::snprintf(buf, sizeof(buf), "%d", n);
+    std::string t = buf;
+    t += "ms    |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+// a trivially copyable T gives a trivially copyable static_vector
+TEST(static_vector_trivially_copyable_test) {
+    EXPECT_TRUE(std::is_trivially_copyable<static_vector_type>::value);
+    EXPECT_TRUE(
+        (std::is_trivially_copyable<mystl::static_vector<double, 3>>::value));
+    EXPECT_TRUE((!std::is_trivially_copyable<
+                 mystl::static_vector<std::string, 3>>::value));
+
+    static_vector_type a = {1, 2, 3};
+    static_vector_type b;
+    std::memcpy(static_cast<void*>(&b), &a, sizeof(a));
+    EXPECT_EQ(b.size(), 3u);
+    EXPECT_EQ(b[2], 3);
+}
+
+// true if f throws std::length_error naming the overflow
+template <class F>
+bool throws_size_past_n(F f) {
+    try {
+        f();
+    } catch (const std::length_error& e) {
+        return std::strstr(e.what(), "size past N") != nullptr;
+    }
+    return false;
+}
+
+// a full vector throws before changing anything, and accepts elements
+// again once some are erased
+TEST(static_vector_overflow_test) {
+    typedef mystl::static_vector<std::string, 4> strings;
+    strings v = {"a", "b", "c", "d"};
+    EXPECT_TRUE(throws_size_past_n([&v] { v.push_back("e"); }));
+    EXPECT_TRUE(throws_size_past_n([&v] { v.insert(v.begin(), "e"); }));
+    EXPECT_TRUE(throws_size_past_n([&v] { v.insert(v.begin() + 1, 2, "e"); }));
+    const std::string more[] = {"e", "f"};
+    EXPECT_TRUE(throws_size_past_n([&v, &more] {
+        v.insert(v.end(), more, more + 2);
+    }));
+    EXPECT_TRUE(v.try_push_back("e") == nullptr);
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_TRUE(v[0] == "a" && v[3] == "d");
+
+    v.erase(v.begin() + 1);
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_TRUE(v[1] == "c");
+    v.insert(v.begin(), "z");
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_TRUE(v[0] == "z" && v[1] == "a" && v[3] == "d");
+    v.erase(v.begin(), v.end());
+    EXPECT_TRUE(v.empty());
+    v.insert(v.begin(), 4, "y");
+    EXPECT_TRUE(v.size() == 4u && v[3] == "y");
+
+    bool thrown = false;
+    try {
+        v.reserve(5);
+    } catch (const std::length_error&) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+// count short lived lists of 16 elements
+template <class Vector>
+void build_test(size_t count) {
+    volatile int last = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        Vector v;
+        for (int j = 0; j < 16; ++j) {
+            v.push_back(j);
+        }
+        last = v[15];
+    }
+    print_time(start, clock());
+    (void)last;
+}
+
+// count copies of one list of 16 elements
+template <class Vector>
+void copy_test(size_t count) {
+    volatile int last = 0;
+    Vector v;
+    for (int j = 0; j < 16; ++j) {
+        v.push_back(j);
+    }
+    clock_t start = clock();
+    for (size_t i = 0; i < count; ++i) {
+        Vector c(v);
+        last = c[15];
+    }
+    print_time(start, clock());
+    (void)last;
+}
+
+void static_vector_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------- Run static_vector performance test --------------]"
+        << std::endl;
+    std::cout
+        << "[------------------- 16 x push_back ----------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::vector     |";
+    build_test<std_vector_type>(LEN1 _M);
+    build_test<std_vector_type>(LEN2 _M);
+    build_test<std_vector_type>(LEN3 _M);
+    std::cout << "\n|       vector        |";
+    build_test<mystl_vector_type>(LEN1 _M);
+    build_test<mystl_vector_type>(LEN2 _M);
+    build_test<mystl_vector_type>(LEN3 _M);
+    std::cout << "\n| small_vector<, 16>  |";
+    build_test<small_vector_type>(LEN1 _M);
+    build_test<small_vector_type>(LEN2 _M);
+    build_test<small_vector_type>(LEN3 _M);
+    std::cout << "\n| static_vector<, 16> |";
+    build_test<static_vector_type>(LEN1 _M);
+    build_test<static_vector_type>(LEN2 _M);
+    build_test<static_vector_type>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------------- copy 16 elements --------------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|     std::vector     |";
+    copy_test<std_vector_type>(LEN1 _M);
+    copy_test<std_vector_type>(LEN2 _M);
+    copy_test<std_vector_type>(LEN3 _M);
+    std::cout << "\n|       vector        |";
+    copy_test<mystl_vector_type>(LEN1 _M);
+    copy_test<mystl_vector_type>(LEN2 _M);
+    copy_test<mystl_vector_type>(LEN3 _M);
+    std::cout << "\n| small_vector<, 16>  |";
+    copy_test<small_vector_type>(LEN1 _M);
+    copy_test<small_vector_type>(LEN2 _M);
+    copy_test<small_vector_type>(LEN3 _M);
+    std::cout << "\n| static_vector<, 16> |";
+    copy_test<static_vector_type>(LEN1 _M);
+    copy_test<static_vector_type>(LEN2 _M);
+    copy_test<static_vector_type>(LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------- End static_vector performance test --------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace static_vector_test
+}  // namespace test
+}  // namespace mystl
+#endif
@@ -21,6 +21,30 @@
 
 #include "vector_test.h"
 #include "algorithm_performance_test.h"
+#include "pool_allocator_test.h"
+#include "memory_resource_test.h"
+#include "thread_cache_allocator_test.h"
+#include "mmap_allocator_test.h"
+#include "relocate_test.h"
+#include "allocate_at_least_test.h"
+#include "aligned_allocator_test.h"
+#include "scratch_arena_test.h"
+#include "smart_ptr_test.h"
+#include "small_vector_test.h"
+#include "static_vector_test.h"
+#include "vector_bulk_test.h"
+#include "bit_vector_test.h"
+#include "soa_vector_test.h"
+#include "cow_vector_test.h"
+#include "mmap_vector_test.h"
+#include "devector_test.h"
+#include "deque_block_test.h"
+#include "deque_algo_test.h"
+#include "circular_buffer_test.h"
+#include "spsc_queue_test.h"
+#include "mpmc_queue_test.h"
+#include "list_sort_test.h"
+#include "intrusive_list_test.h"
 
 int main() {
     using namespace mystl::test;
@@ -28,5 +52,29 @@ int main() {
 
     RUN_ALL_TESTS();
     algorithm_performance_test::algorithm_performance_test();
+    pool_allocator_test::pool_allocator_test();
+    memory_resource_test::memory_resource_test();
+    thread_cache_allocator_test::thread_cache_allocator_test();
+    mmap_allocator_test::mmap_allocator_test();
+    relocate_test::relocate_test();
+    allocate_at_least_test::allocate_at_least_test();
+    aligned_allocator_test::aligned_allocator_test();
+    scratch_arena_test::scratch_arena_test();
+    smart_ptr_test::smart_ptr_test();
+    small_vector_test::small_vector_test();
+    static_vector_test::static_vector_test();
+    vector_bulk_test::vector_bulk_test();
+    bit_vector_test::bit_vector_test();
+    soa_vector_test::soa_vector_test();
+    cow_vector_test::cow_vector_test();
+    mmap_vector_test::mmap_vector_test();
+    devector_test::devector_test();
+    deque_block_test::deque_block_test();
+    deque_algo_test::deque_algo_test();
+    circular_buffer_test::circular_buffer_test();
+    spsc_queue_test::spsc_queue_test();
+    mpmc_queue_test::mpmc_queue_test();
+    list_sort_test::list_sort_test();
+    intrusive_list_test::intrusive_list_test();
     // vector_test::vector_test();
 }
\ No newline at end of file
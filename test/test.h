@@ -515,22 +515,32 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide) {
     std::cout << std::setw(WIDE) << t;                          \
   } while (0)
 
-#define LIST_SORT_DO_TEST(mode, count)                            \
-  do {                                                            \
-    srand((int)time(0));                                          \
-    clock_t start, end;                                           \
-    mode::list<int> l;                                            \
-    char buf[10];                                                 \
-    for (size_t i = 0; i < count; ++i) l.insert(l.end(), rand()); \
-    start = clock();                                              \
-    l.sort();                                                     \
-    end = clock();                                                \
-    int n = static_cast<int>(static_cast<double>(end - start) /   \
-                             CLOCKS_PER_SEC * 1000);              \
-    std::snprintf(buf, sizeof(buf), "%d", n);                     \
-    std::string t = buf;                                          \
-    t += "ms    |";                                               \
-    std::cout << std::setw(WIDE) << t;                            \
+// value is the i-th of count elements, e.g. rand() or i
+#define LIST_SORT_DO_TEST(mode, count, value, ms)                  \
+  do {                                                             \
+    srand((int)time(0));                                           \
+    clock_t start, end;                                            \
+    mode::list<int> l;                                             \
+    char buf[10];                                                  \
+    for (size_t i = 0; i < count; ++i)                             \
+      l.insert(l.end(), static_cast<int>(value));                  \
+    start = clock();                                               \
+    l.sort();                                                      \
+    end = clock();                                                 \
+    ms = static_cast<double>(end - start) / CLOCKS_PER_SEC * 1000; \
+    std::snprintf(buf, sizeof(buf), "%d", static_cast<int>(ms));   \
+    std::string t = buf;                                           \
+    t += "ms    |";                                                \
+    std::cout << std::setw(WIDE) << t;                             \
+  } while (0)
+
+// how many times faster mystl's sort is
+#define LIST_SORT_SPEEDUP(std_ms, mystl_ms)                              \
+  do {                                                                   \
+    char buf[16];                                                        \
+    std::snprintf(buf, sizeof(buf), "%.2fx     |",                       \
+                  (std_ms) / ((mystl_ms) > 0.001 ? (mystl_ms) : 0.001)); \
+    std::cout << std::setw(WIDE) << buf;                                 \
   } while (0)
 
 #define MAP_EMPLACE_DO_TEST(mode, con, count)                   \
@@ -585,16 +595,23 @@ void test_len(size_t len1, size_t len2, size_t len3, size_t wide) {
   MAP_EMPLACE_DO_TEST(mystl, con, len2);        \
   MAP_EMPLACE_DO_TEST(mystl, con, len3);
 
-#define LIST_SORT_TEST(len1, len2, len3)    \
-  TEST_LEN(len1, len2, len3, WIDE);         \
-  std::cout << "|         std         |";   \
-  LIST_SORT_DO_TEST(std, len1);             \
-  LIST_SORT_DO_TEST(std, len2);             \
-  LIST_SORT_DO_TEST(std, len3);             \
-  std::cout << "\n|        mystl        |"; \
-  LIST_SORT_DO_TEST(mystl, len1);           \
-  LIST_SORT_DO_TEST(mystl, len2);           \
-  LIST_SORT_DO_TEST(mystl, len3);
+#define LIST_SORT_TEST(len1, len2, len3, value)         \
+  TEST_LEN(len1, len2, len3, WIDE);                     \
+  {                                                     \
+    double std_ms[3], mystl_ms[3];                      \
+    std::cout << "|         std         |";             \
+    LIST_SORT_DO_TEST(std, len1, value, std_ms[0]);     \
+    LIST_SORT_DO_TEST(std, len2, value, std_ms[1]);     \
+    LIST_SORT_DO_TEST(std, len3, value, std_ms[2]);     \
+    std::cout << "\n|        mystl        |";           \
+    LIST_SORT_DO_TEST(mystl, len1, value, mystl_ms[0]); \
+    LIST_SORT_DO_TEST(mystl, len2, value, mystl_ms[1]); \
+    LIST_SORT_DO_TEST(mystl, len3, value, mystl_ms[2]); \
+    std::cout << "\n|   speedup vs std    |";           \
+    LIST_SORT_SPEEDUP(std_ms[0], mystl_ms[0]);          \
+    LIST_SORT_SPEEDUP(std_ms[1], mystl_ms[1]);          \
+    LIST_SORT_SPEEDUP(std_ms[2], mystl_ms[2]);          \
+  }
 
 #define TEST(testcase_name) MYSTL_TEST_(testcase_name)
 
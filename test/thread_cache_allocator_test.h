@@ -0,0 +1,190 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_THREAD_CACHE_ALLOCATOR_TEST_H_
+#define MYSTL_THREAD_CACHE_ALLOCATOR_TEST_H_
+
+// unit test for giving chunks back while other threads hold objects, and a
+// multithreaded performance test: every thread churns list nodes through
+// allocator / pool_allocator (one arena per thread) / thread_cache_allocator,
+// the table shows the total allocations per second (millions) against the
+// number of threads
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../mystl/list.h"
+#include "../mystl/pool_allocator.h"
+#include "../mystl/thread_cache_allocator.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace thread_cache_allocator_test {
+
+// plain allocator has no trim to call
+template <class T>
+class plain_allocator : public mystl::allocator<T> {
+   public:
+    static void trim() {}
+};
+
+// every thread owns its pool_allocator arena, which goes away with it
+template <class T>
+class arena_pool_allocator : public mystl::pool_allocator<T> {
+   public:
+    static void trim() {}
+};
+
+// keep 1024 live nodes per thread, free and reallocate count random ones
+template <template <class> class Alloc, class Node>
+void churn(size_t count, unsigned seed) {
+    const size_t live = 1024;
+    Alloc<Node> alloc;
+    std::vector<Node*> slots(live);
+    for (size_t i = 0; i < live; ++i) {
+        slots[i] = alloc.allocate(1);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        size_t k = (seed >> 8) % live;
+        alloc.deallocate(slots[k], 1);
+        slots[k] = alloc.allocate(1);
+    }
+    for (size_t i = 0; i < live; ++i) {
+        alloc.deallocate(slots[i], 1);
+    }
+}
+
+// count allocations split over threads, prints millions of allocations/s
+template <template <class> class Alloc, class Node>
+void threads_test(size_t threads, size_t count) {
+    char buf[16];
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(churn<Alloc, Node>, count / threads,
+                             static_cast<unsigned>(t + 1));
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    Alloc<Node>::trim();
+    double sec = std::chrono::duration<double>(end - start).count();
+    std::snprintf(buf, sizeof(buf), "%.1f", count / sec / 1e6);
+    std::string t = buf;
+    t += "M/s   |";
+    std::cout << std::setw(WIDE) << t;
+}
+
+#define THREADS_ROW(name, alloc, node, count) \
+    std::cout << name;                        \
+    threads_test<alloc, node>(1, count);      \
+    threads_test<alloc, node>(2, count);      \
+    threads_test<alloc, node>(4, count);      \
+    threads_test<alloc, node>(8, count);      \
+    std::cout << std::endl;
+
+typedef mystl::list_node<int> node_type;
+
+// a size class no other test uses
+struct big_obj {
+    char bytes[240];
+};
+
+// two threads allocate, one frees everything it holds and trims: the chunks
+// only it used go back although the other thread still holds its objects
+TEST(thread_cache_release_test) {
+    typedef mystl::thread_cache_allocator<big_obj> alloc;
+    const size_t index = mystl::tc_class_index(sizeof(big_obj));
+    const size_t count = 20000;
+    std::vector<big_obj*> held;
+    std::thread keeper([&held] {
+        for (size_t i = 0; i < 1000; ++i) {
+            held.push_back(alloc::allocate(1));
+        }
+    });
+    keeper.join();
+    const size_t before = mystl::tc_depot<>::chunk_count(index);
+    std::thread worker([count] {
+        std::vector<big_obj*> mine(count);
+        for (size_t i = 0; i < count; ++i) {
+            mine[i] = alloc::allocate(1);
+        }
+        EXPECT_GT(mystl::tc_depot<>::chunk_count(index), 50u);
+        for (size_t i = 0; i < count; ++i) {
+            alloc::deallocate(mine[i], 1);
+        }
+        alloc::trim();
+    });
+    worker.join();
+    EXPECT_LE(mystl::tc_depot<>::chunk_count(index), before + 1);
+    for (size_t i = 0; i < held.size(); ++i) {
+        alloc::deallocate(held[i], 1);
+    }
+    alloc::trim();
+    EXPECT_EQ(mystl::tc_depot<>::chunk_count(index), 0u);
+}
+
+void thread_cache_allocator_test() {
+#if PERFORMANCE_TEST_ON
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[--------- Run thread_cache_allocator performance test ---------]"
+        << std::endl;
+    std::cout
+        << "[------------------ node : list_node<int> ----------------------]"
+        << std::endl;
+    std::cout << "|       threads       |";
+    std::cout << std::setw(WIDE) << "1       |" << std::setw(WIDE)
+              << "2       |" << std::setw(WIDE) << "4       |"
+              << std::setw(WIDE) << "8       |" << std::endl;
+#if LARGER_TEST_DATA_ON
+    const size_t count = LEN3 _LL;
+#else
+    const size_t count = LEN3 _M;
+#endif
+    THREADS_ROW("|      allocator      |", plain_allocator, node_type, count);
+    THREADS_ROW("|    pool_allocator   |", arena_pool_allocator, node_type,
+                count);
+    THREADS_ROW("| thread_cache_alloc  |", mystl::thread_cache_allocator,
+                node_type, count);
+    std::cout
+        << "[--------- End thread_cache_allocator performance test ---------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace thread_cache_allocator_test
+}  // namespace test
+}  // namespace mystl
+#endif
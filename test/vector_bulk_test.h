@@ -0,0 +1,216 @@
+/*
+ * Created on Fri Oct 16 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2021 Chao Shu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MYSTL_VECTOR_BULK_TEST_H_
+#define MYSTL_VECTOR_BULK_TEST_H_
+
+// unit tests for the contents left by the bulk APIs, and a performance
+// test for vector's bulk APIs against push_back loops: filling
+// count ints through resize / resize_default_init and writing them after,
+// and copying count ints from an array with append / emplace_back_unchecked
+
+#include <string>
+#include <vector>
+
+#include "../mystl/list.h"
+#include "../mystl/vector.h"
+#include "test.h"
+
+namespace mystl {
+namespace test {
+namespace vector_bulk_test {
+
+// append keeps the old elements and adds the range in order, with or
+// without memcpy
+TEST(vector_append_test) {
+    const int src[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    mystl::vector<int> v;
+    v.push_back(0);
+    v.append(src, src + 10);
+    EXPECT_EQ(v.size(), 11u);
+    for (int i = 0; i < 11; ++i) {
+        EXPECT_EQ(v[i], i);
+    }
+    v.append(src, src);
+    EXPECT_EQ(v.size(), 11u);
+
+    mystl::list<int> l(src, src + 3);
+    v.append(l.begin(), l.end());
+    EXPECT_EQ(v.size(), 14u);
+    EXPECT_EQ(v[11], 1);
+    EXPECT_EQ(v[13], 3);
+
+    // within capacity, then past it
+    mystl::vector<std::string> s;
+    s.reserve(4);
+    const size_t cap = s.capacity();
+    std::vector<std::string> words;
+    for (size_t i = 0; i < cap + 3; ++i) {
+        words.push_back(std::string(20, static_cast<char>('a' + i % 26)));
+    }
+    s.append(words.data(), words.data() + 2);
+    EXPECT_EQ(s.capacity(), cap);
+    s.append(words.data() + 2, words.data() + words.size());
+    EXPECT_GT(s.capacity(), cap);
+    EXPECT_EQ(s.size(), words.size());
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_TRUE(s[i] == words[i]);
+    }
+}
+
+// resize_default_init keeps the prefix and default-initializes the rest,
+// which for class types is the default constructor
+TEST(vector_resize_default_init_test) {
+    mystl::vector<int> v = {1, 2, 3};
+    v.resize_default_init(1000);
+    EXPECT_EQ(v.size(), 1000u);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v[2], 3);
+    for (size_t i = 3; i < 1000; ++i) {
+        v[i] = static_cast<int>(i);
+    }
+    v.resize_default_init(10);
+    EXPECT_EQ(v.size(), 10u);
+    EXPECT_EQ(v[9], 9);
+
+    mystl::vector<std::string> s(2, "x");
+    s.resize_default_init(5);
+    EXPECT_EQ(s.size(), 5u);
+    EXPECT_TRUE(s[1] == "x");
+    EXPECT_TRUE(s[2].empty() && s[4].empty());
+
+    mystl::vector<int> u;
+    u.reserve(3);
+    u.emplace_back_unchecked(4);
+    u.emplace_back_unchecked(5);
+    EXPECT_EQ(u.size(), 2u);
+    EXPECT_EQ(u[1], 5);
+}
+
+#define BULK_TEST(stmt, count)                                  \
+    do {                                                        \
+        char buf[10];                                           \
+        clock_t start, end;                                     \
+        mystl::vector<int> v;                                   \
+        const int* src = source.data();                         \
+        (void)src;                                              \
+        start = clock();                                        \
+        for (int rep = 0; rep < 10; ++rep) {                    \
+            v.clear();                                          \
+            stmt;                                               \
+        }                                                       \
+        end = clock();                                          \
+        volatile int last = v[count / 2];                       \
+        (void)last;                                             \
+        int n = static_cast<int>(static_cast<double>(end - start) /\
+                                 CLOCKS_PER_SEC * 1000);        \
+        std::snprintf(buf, sizeof(buf), "%d", n);               \
+        std::string t = buf;                                    \
+        t += "ms    |";                                         \
+        std::cout << std::setw(WIDE) << t;                      \
+    } while (0)
+
+#define PUSH_BACK_FILL(count)                  \
+    for (size_t i = 0; i < count; ++i)         \
+        v.push_back(static_cast<int>(i))
+#define RESIZE_FILL(count)                     \
+    v.resize(count);                           \
+    for (size_t i = 0; i < count; ++i)         \
+        v[i] = static_cast<int>(i)
+#define DEFAULT_INIT_FILL(count)               \
+    v.resize_default_init(count);              \
+    for (size_t i = 0; i < count; ++i)         \
+        v[i] = static_cast<int>(i)
+#define PUSH_BACK_COPY(count)                  \
+    for (size_t i = 0; i < count; ++i)         \
+        v.push_back(src[i])
+#define UNCHECKED_COPY(count)                  \
+    v.reserve(count);                          \
+    for (size_t i = 0; i < count; ++i)         \
+        v.emplace_back_unchecked(src[i])
+#define APPEND_COPY(count) v.append(src, src + count)
+
+void vector_bulk_test() {
+#if PERFORMANCE_TEST_ON
+    // every run repeats the fill 10 times on a vector that kept its buffer
+    std::vector<int> source(LEN3 _M);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<int>(i);
+    }
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+    std::cout
+        << "[------------ Run vector bulk API performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[---------------- fill with index, 10 times --------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|      push_back      |";
+    BULK_TEST(PUSH_BACK_FILL(LEN1 _M), LEN1 _M);
+    BULK_TEST(PUSH_BACK_FILL(LEN2 _M), LEN2 _M);
+    BULK_TEST(PUSH_BACK_FILL(LEN3 _M), LEN3 _M);
+    std::cout << "\n|       resize        |";
+    BULK_TEST(RESIZE_FILL(LEN1 _M), LEN1 _M);
+    BULK_TEST(RESIZE_FILL(LEN2 _M), LEN2 _M);
+    BULK_TEST(RESIZE_FILL(LEN3 _M), LEN3 _M);
+    std::cout << "\n| resize_default_init |";
+    BULK_TEST(DEFAULT_INIT_FILL(LEN1 _M), LEN1 _M);
+    BULK_TEST(DEFAULT_INIT_FILL(LEN2 _M), LEN2 _M);
+    BULK_TEST(DEFAULT_INIT_FILL(LEN3 _M), LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[---------------- copy from array, 10 times --------------------]"
+        << std::endl;
+    std::cout << "| orders of magnitude |";
+    TEST_LEN(LEN1 _M, LEN2 _M, LEN3 _M, WIDE);
+    std::cout << "|      push_back      |";
+    BULK_TEST(PUSH_BACK_COPY(LEN1 _M), LEN1 _M);
+    BULK_TEST(PUSH_BACK_COPY(LEN2 _M), LEN2 _M);
+    BULK_TEST(PUSH_BACK_COPY(LEN3 _M), LEN3 _M);
+    std::cout << "\n|  unchecked emplace  |";
+    BULK_TEST(UNCHECKED_COPY(LEN1 _M), LEN1 _M);
+    BULK_TEST(UNCHECKED_COPY(LEN2 _M), LEN2 _M);
+    BULK_TEST(UNCHECKED_COPY(LEN3 _M), LEN3 _M);
+    std::cout << "\n|       append        |";
+    BULK_TEST(APPEND_COPY(LEN1 _M), LEN1 _M);
+    BULK_TEST(APPEND_COPY(LEN2 _M), LEN2 _M);
+    BULK_TEST(APPEND_COPY(LEN3 _M), LEN3 _M);
+    std::cout << std::endl;
+    std::cout
+        << "[------------ End vector bulk API performance test -------------]"
+        << std::endl;
+    std::cout
+        << "[===============================================================]"
+        << std::endl;
+#endif  // PERFORMANCE_TEST_ON
+}
+
+}  // namespace vector_bulk_test
+}  // namespace test
+}  // namespace mystl
+#endif